@@ -0,0 +1,732 @@
+// 无界面性能基准：对示例 .vtu 与生成的规则六面体网格执行与各面板相同的操作
+// （读取、表面提取、剖切、等值面、变形图、流线、拾取），统计冷/热运行耗时与分位数，
+// 并按线程数扫描，结果以 JSON 输出，便于在版本之间比较。
+// --reorder 对每个数据集再测试加载时网格重排后的副本，--shuffle 先打乱生成网格的编号以模拟求解器输出
+//
+// 用法: FEMBenchmark [--data 目录] [--generate 40,80] [--threads 1,4,8]
+//                    [--repeat 10] [--operations clip,contour] [--output result.json]
+//                    [--reorder none,hilbert,rcm] [--shuffle] [文件...]
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkXMLUnstructuredGridReader.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkCellType.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetSurfaceFilter.h>
+#include <vtkClipDataSet.h>
+#include <vtkPlane.h>
+#include <vtkContourFilter.h>
+#include <vtkWarpVector.h>
+#include <vtkStreamTracer.h>
+#include <vtkPointSource.h>
+#include <vtkGenericCell.h>
+#include <vtkMath.h>
+#include <vtkSMPTools.h>
+#include <vtkVersion.h>
+
+#include "core/SpatialIndex.h"
+#include "core/MeshReorderer.h"
+#include "core/MeshTopology.h"
+#include "core/SurfaceExtractor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const char *SAMPLE_FILES[] = {
+    "helical_structure.vtu",
+    "radial_sphere.vtu",
+    "torus_vortex.vtu",
+    "twisted_cylinder.vtu"
+};
+
+const QStringList ALL_OPERATIONS = {
+    "load", "surface", "surface_fast", "clip", "contour", "warp", "streamlines", "pick_point", "pick_cell", "topology"
+};
+
+// 与各面板的默认参数保持一致
+const int CONTOUR_COUNT = 5;            // ContourWidget 自动等值面数量
+const double WARP_SCALE = 1.0;          // VectorFieldWidget 缩放滑块 10 / 10
+const int STREAMLINE_SEEDS = 50;        // 流线数量
+const double STREAMLINE_STEP = 0.01;    // 初始积分步长
+const int STREAMLINE_MAX_STEPS = 2000;  // 最大步数
+const unsigned int RANDOM_SEED = 20240521;
+
+struct Dataset
+{
+    QString name;
+    QString fileName;  // 为空表示生成的网格
+    vtkSmartPointer<vtkUnstructuredGrid> grid;
+    MeshReorderer::Method reorder = MeshReorderer::None;
+    double reorderMs = 0.0;
+};
+
+double elapsedMs(const std::function<void()> &work)
+{
+    QElapsedTimer timer;
+    timer.start();
+    work();
+    return timer.nsecsElapsed() / 1.0e6;
+}
+
+// 线性插值分位数，samples 需已排序
+double percentile(const std::vector<double> &samples, double p)
+{
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const double position = p * (samples.size() - 1);
+    const size_t lower = static_cast<size_t>(std::floor(position));
+    const size_t upper = std::min(lower + 1, samples.size() - 1);
+    const double fraction = position - lower;
+    return samples[lower] + (samples[upper] - samples[lower]) * fraction;
+}
+
+// 冷运行：新建对象后的第一次执行（包含分配与一次性初始化）
+// 热运行：同一对象 Modified() 之后的重复执行
+QJsonObject summarize(double coldMs, std::vector<double> warmMs)
+{
+    std::sort(warmMs.begin(), warmMs.end());
+
+    double sum = 0.0;
+    for (double value : warmMs) {
+        sum += value;
+    }
+
+    QJsonObject warm;
+    warm["runs"] = static_cast<int>(warmMs.size());
+    if (!warmMs.empty()) {
+        warm["minMs"] = warmMs.front();
+        warm["meanMs"] = sum / warmMs.size();
+        warm["p50Ms"] = percentile(warmMs, 0.50);
+        warm["p90Ms"] = percentile(warmMs, 0.90);
+        warm["p99Ms"] = percentile(warmMs, 0.99);
+        warm["maxMs"] = warmMs.back();
+    }
+
+    QJsonObject result;
+    result["coldMs"] = coldMs;
+    result["warm"] = warm;
+    return result;
+}
+
+QJsonObject timeFilter(vtkAlgorithm *filter, int repeats)
+{
+    const double cold = elapsedMs([filter]() { filter->Update(); });
+
+    std::vector<double> warm;
+    warm.reserve(repeats);
+    for (int i = 0; i < repeats; ++i) {
+        filter->Modified();
+        warm.push_back(elapsedMs([filter]() { filter->Update(); }));
+    }
+
+    QJsonObject result = summarize(cold, warm);
+    if (vtkDataSet *output = vtkDataSet::SafeDownCast(filter->GetOutputDataObject(0))) {
+        result["outputPoints"] = static_cast<qint64>(output->GetNumberOfPoints());
+        result["outputCells"] = static_cast<qint64>(output->GetNumberOfCells());
+    }
+    return result;
+}
+
+QJsonObject skipped(const QString &reason)
+{
+    QJsonObject result;
+    result["skipped"] = reason;
+    return result;
+}
+
+// 按名称优先选取点数据数组，找不到时退回到第一个满足分量数的数组
+QString findPointArray(vtkUnstructuredGrid *grid, int components, const QString &preferred)
+{
+    vtkPointData *pointData = grid->GetPointData();
+    QString fallback;
+    for (int i = 0; i < pointData->GetNumberOfArrays(); ++i) {
+        vtkDataArray *array = pointData->GetArray(i);
+        if (!array || !array->GetName() || array->GetNumberOfComponents() != components) {
+            continue;
+        }
+        const QString name = QString::fromUtf8(array->GetName());
+        if (!preferred.isEmpty() && name.contains(preferred, Qt::CaseInsensitive)) {
+            return name;
+        }
+        if (fallback.isEmpty()) {
+            fallback = name;
+        }
+    }
+    return fallback;
+}
+
+double maxExtent(const double bounds[6])
+{
+    return std::max(std::max(bounds[1] - bounds[0], bounds[3] - bounds[2]), bounds[5] - bounds[4]);
+}
+
+// 规则六面体网格（n×n×n 单元），带旋涡速度场、位移场与温度场，
+// 用于在示例文件之外测量更大规模的伸缩性
+vtkSmartPointer<vtkUnstructuredGrid> generateHexGrid(int n)
+{
+    const vtkIdType pointsPerEdge = n + 1;
+    const vtkIdType numPoints = pointsPerEdge * pointsPerEdge * pointsPerEdge;
+    const vtkIdType numCells = static_cast<vtkIdType>(n) * n * n;
+    const double spacing = 4.0 / n;
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataTypeToFloat();
+    points->SetNumberOfPoints(numPoints);
+
+    vtkSmartPointer<vtkFloatArray> temperature = vtkSmartPointer<vtkFloatArray>::New();
+    temperature->SetName("Temperature");
+    temperature->SetNumberOfTuples(numPoints);
+
+    vtkSmartPointer<vtkFloatArray> velocity = vtkSmartPointer<vtkFloatArray>::New();
+    velocity->SetName("Velocity");
+    velocity->SetNumberOfComponents(3);
+    velocity->SetNumberOfTuples(numPoints);
+
+    vtkSmartPointer<vtkFloatArray> displacement = vtkSmartPointer<vtkFloatArray>::New();
+    displacement->SetName("Displacement");
+    displacement->SetNumberOfComponents(3);
+    displacement->SetNumberOfTuples(numPoints);
+
+    vtkSMPTools::For(0, pointsPerEdge, [&](vtkIdType kBegin, vtkIdType kEnd) {
+        for (vtkIdType k = kBegin; k < kEnd; ++k) {
+            for (vtkIdType j = 0; j < pointsPerEdge; ++j) {
+                for (vtkIdType i = 0; i < pointsPerEdge; ++i) {
+                    const vtkIdType id = (k * pointsPerEdge + j) * pointsPerEdge + i;
+                    const double x = -2.0 + i * spacing;
+                    const double y = -2.0 + j * spacing;
+                    const double z = -2.0 + k * spacing;
+                    const double r = std::sqrt(x * x + y * y);
+
+                    points->SetPoint(id, x, y, z);
+                    temperature->SetValue(id, static_cast<float>(300.0 + 50.0 * std::sin(r * 2.0) * std::cos(z)));
+                    velocity->SetTuple3(id, -y + 0.1 * x, x + 0.1 * y, 0.3 * std::cos(r));
+                    displacement->SetTuple3(id, 0.02 * x * z, 0.02 * y * z, 0.01 * r);
+                }
+            }
+        }
+    });
+
+    // 连续偏移/连接数组，避免逐单元 InsertNextCell
+    vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfTuples(numCells + 1);
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfTuples(numCells * 8);
+
+    vtkSMPTools::For(0, n, [&](vtkIdType kBegin, vtkIdType kEnd) {
+        for (vtkIdType k = kBegin; k < kEnd; ++k) {
+            for (vtkIdType j = 0; j < n; ++j) {
+                for (vtkIdType i = 0; i < n; ++i) {
+                    const vtkIdType cellId = (k * n + j) * n + i;
+                    const vtkIdType p0 = (k * pointsPerEdge + j) * pointsPerEdge + i;
+                    const vtkIdType layer = pointsPerEdge * pointsPerEdge;
+                    const vtkIdType ids[8] = {
+                        p0, p0 + 1, p0 + pointsPerEdge + 1, p0 + pointsPerEdge,
+                        p0 + layer, p0 + layer + 1, p0 + layer + pointsPerEdge + 1, p0 + layer + pointsPerEdge
+                    };
+                    offsets->SetValue(cellId, cellId * 8);
+                    for (int c = 0; c < 8; ++c) {
+                        connectivity->SetValue(cellId * 8 + c, ids[c]);
+                    }
+                }
+            }
+        }
+    });
+    offsets->SetValue(numCells, numCells * 8);
+
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(offsets, connectivity);
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grid->SetPoints(points);
+    grid->SetCells(VTK_HEXAHEDRON, cells);
+    grid->GetPointData()->AddArray(temperature);
+    grid->GetPointData()->AddArray(velocity);
+    grid->GetPointData()->AddArray(displacement);
+    grid->GetPointData()->SetActiveScalars("Temperature");
+    return grid;
+}
+
+// 随机打乱点与单元编号，模拟求解器输出中近乎随机的编号；去掉原始编号数组，相当于直接读入的文件
+void shuffleGrid(vtkUnstructuredGrid *grid)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::vector<vtkIdType> pointOrder(static_cast<size_t>(grid->GetNumberOfPoints()));
+    std::vector<vtkIdType> cellOrder(static_cast<size_t>(grid->GetNumberOfCells()));
+    std::iota(pointOrder.begin(), pointOrder.end(), 0);
+    std::iota(cellOrder.begin(), cellOrder.end(), 0);
+    std::shuffle(pointOrder.begin(), pointOrder.end(), generator);
+    std::shuffle(cellOrder.begin(), cellOrder.end(), generator);
+    MeshReorderer::permute(grid, pointOrder, cellOrder);
+    grid->GetPointData()->RemoveArray(MeshReorderer::ORIGINAL_POINT_IDS);
+    grid->GetCellData()->RemoveArray(MeshReorderer::ORIGINAL_CELL_IDS);
+}
+
+QJsonObject benchmarkLoad(const QString &fileName, int repeats)
+{
+    auto readOnce = [&fileName]() {
+        vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+        reader->SetFileName(fileName.toLocal8Bit().constData());
+        reader->Update();
+    };
+
+    // 每次新建读取器：冷运行包含首次打开文件，热运行时文件已在系统缓存中
+    const double cold = elapsedMs(readOnce);
+    std::vector<double> warm;
+    for (int i = 0; i < repeats; ++i) {
+        warm.push_back(elapsedMs(readOnce));
+    }
+
+    QJsonObject result = summarize(cold, warm);
+    result["fileBytes"] = static_cast<qint64>(QFileInfo(fileName).size());
+    return result;
+}
+
+// vtkDataSetMapper 内部对非多边形数据做的表面提取
+QJsonObject benchmarkSurface(vtkUnstructuredGrid *grid, int repeats)
+{
+    vtkSmartPointer<vtkDataSetSurfaceFilter> surface = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+    surface->SetInputData(grid);
+    return timeFilter(surface, repeats);
+}
+
+// 主视图的外表面提取：按单元类型选择的专用路径（混合网格即通用路径），与上面的 vtkDataSetSurfaceFilter 对照
+QJsonObject benchmarkSurfaceFast(vtkUnstructuredGrid *grid, int repeats)
+{
+    SurfaceExtractor::Path path = SurfaceExtractor::Generic;
+    vtkSmartPointer<vtkPolyData> surface;
+    const double cold = elapsedMs([&]() { surface = SurfaceExtractor::extract(grid, &path); });
+    std::vector<double> warm;
+    for (int i = 0; i < repeats; ++i) {
+        warm.push_back(elapsedMs([&]() { surface = SurfaceExtractor::extract(grid); }));
+    }
+
+    QJsonObject result = summarize(cold, warm);
+    result["path"] = SurfaceExtractor::pathName(path);
+    result["polys"] = static_cast<qint64>(surface->GetNumberOfCells());
+    return result;
+}
+
+// ClippingWidget：过包围盒中心、法向 (1,0,0) 的平面，同时生成被剖去部分
+QJsonObject benchmarkClip(vtkUnstructuredGrid *grid, int repeats)
+{
+    double center[3];
+    grid->GetCenter(center);
+
+    vtkSmartPointer<vtkPlane> plane = vtkSmartPointer<vtkPlane>::New();
+    plane->SetOrigin(center);
+    plane->SetNormal(1, 0, 0);
+
+    vtkSmartPointer<vtkClipDataSet> clip = vtkSmartPointer<vtkClipDataSet>::New();
+    clip->SetClipFunction(plane);
+    clip->GenerateClippedOutputOn();
+    clip->SetInputData(grid);
+    return timeFilter(clip, repeats);
+}
+
+// ContourWidget：在数据范围内均匀分布的自动等值面
+QJsonObject benchmarkContour(vtkUnstructuredGrid *grid, int repeats)
+{
+    const QString arrayName = findPointArray(grid, 1, QString());
+    if (arrayName.isEmpty()) {
+        return skipped("没有标量点数据");
+    }
+
+    double range[2];
+    grid->GetPointData()->GetArray(arrayName.toUtf8().constData())->GetRange(range, 0);
+
+    vtkSmartPointer<vtkContourFilter> contour = vtkSmartPointer<vtkContourFilter>::New();
+    contour->SetInputData(grid);
+    contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, arrayName.toUtf8().constData());
+    for (int i = 0; i < CONTOUR_COUNT; ++i) {
+        const double t = static_cast<double>(i + 1) / (CONTOUR_COUNT + 1);
+        contour->SetValue(i, range[0] + t * (range[1] - range[0]));
+    }
+
+    QJsonObject result = timeFilter(contour, repeats);
+    result["array"] = arrayName;
+    return result;
+}
+
+// VectorFieldWidget 变形图
+QJsonObject benchmarkWarp(vtkUnstructuredGrid *grid, int repeats)
+{
+    const QString arrayName = findPointArray(grid, 3, "Displacement");
+    if (arrayName.isEmpty()) {
+        return skipped("没有矢量点数据");
+    }
+
+    vtkSmartPointer<vtkWarpVector> warp = vtkSmartPointer<vtkWarpVector>::New();
+    warp->SetInputData(grid);
+    warp->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, arrayName.toUtf8().constData());
+    warp->SetScaleFactor(WARP_SCALE);
+
+    QJsonObject result = timeFilter(warp, repeats);
+    result["array"] = arrayName;
+    return result;
+}
+
+// VectorFieldWidget 随机种子流线：种子球位于包围盒中心，半径为最大边长的 0.3 倍
+QJsonObject benchmarkStreamlines(vtkUnstructuredGrid *grid, int repeats)
+{
+    const QString arrayName = findPointArray(grid, 3, "Velocity");
+    if (arrayName.isEmpty()) {
+        return skipped("没有矢量点数据");
+    }
+
+    double bounds[6];
+    grid->GetBounds(bounds);
+
+    // 固定随机种子，保证不同版本之间种子点一致
+    vtkMath::RandomSeed(RANDOM_SEED);
+    vtkSmartPointer<vtkPointSource> seeds = vtkSmartPointer<vtkPointSource>::New();
+    seeds->SetNumberOfPoints(STREAMLINE_SEEDS);
+    seeds->SetCenter((bounds[0] + bounds[1]) / 2.0, (bounds[2] + bounds[3]) / 2.0, (bounds[4] + bounds[5]) / 2.0);
+    seeds->SetRadius(maxExtent(bounds) * 0.3);
+    seeds->Update();
+
+    vtkSmartPointer<vtkStreamTracer> tracer = vtkSmartPointer<vtkStreamTracer>::New();
+    tracer->SetInputData(grid);
+    tracer->SetSourceConnection(seeds->GetOutputPort());
+    tracer->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, arrayName.toUtf8().constData());
+    tracer->SetIntegrationDirectionToBoth();
+    tracer->SetIntegratorTypeToRungeKutta4();
+    tracer->SetInitialIntegrationStep(STREAMLINE_STEP);
+    tracer->SetMaximumNumberOfSteps(STREAMLINE_MAX_STEPS);
+
+    QJsonObject result = timeFilter(tracer, repeats);
+    result["array"] = arrayName;
+    return result;
+}
+
+// DataPicker 快速路径：冷运行为定位器构建，热运行为一批最近点/单元查询。
+// 深度缓冲读取需要 OpenGL 上下文，这里用包围盒内的随机位置代替屏幕拾取
+QJsonObject benchmarkPick(vtkUnstructuredGrid *grid, int repeats, int queries, bool cells)
+{
+    double bounds[6];
+    grid->GetBounds(bounds);
+
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> positions(static_cast<size_t>(queries) * 3);
+    for (int q = 0; q < queries; ++q) {
+        for (int c = 0; c < 3; ++c) {
+            positions[q * 3 + c] = bounds[2 * c] + unit(generator) * (bounds[2 * c + 1] - bounds[2 * c]);
+        }
+    }
+
+    SpatialIndex index;
+    index.setData(grid);
+    const double cold = elapsedMs([&index, cells]() {
+        if (cells) {
+            index.cellLocator();
+        } else {
+            index.pointLocator();
+        }
+    });
+
+    vtkSmartPointer<vtkGenericCell> genericCell = vtkSmartPointer<vtkGenericCell>::New();
+    vtkIdType hits = 0;
+    auto queryBatch = [&]() {
+        for (int q = 0; q < queries; ++q) {
+            double *position = &positions[q * 3];
+            if (cells) {
+                double closest[3];
+                vtkIdType cellId = -1;
+                int subId = 0;
+                double dist2 = 0.0;
+                index.cellLocator()->FindClosestPoint(position, closest, genericCell, cellId, subId, dist2);
+                hits += cellId >= 0 ? 1 : 0;
+            } else {
+                hits += index.pointLocator()->FindClosestPoint(position) >= 0 ? 1 : 0;
+            }
+        }
+    };
+
+    std::vector<double> warm;
+    for (int i = 0; i < repeats; ++i) {
+        warm.push_back(elapsedMs(queryBatch));
+    }
+
+    QJsonObject result = summarize(cold, warm);
+    result["queriesPerRun"] = queries;
+    result["hits"] = static_cast<qint64>(hits);
+    if (!warm.empty()) {
+        std::sort(warm.begin(), warm.end());
+        result["p50UsPerQuery"] = percentile(warm, 0.50) * 1000.0 / std::max(queries, 1);
+    }
+    return result;
+}
+
+// SpatialIndex 共享拓扑表：点→单元与面邻居 CSR 的并行构建
+QJsonObject benchmarkTopology(vtkUnstructuredGrid *grid, int repeats)
+{
+    std::shared_ptr<const MeshTopology> topology;
+    const double cold = elapsedMs([&]() { topology = MeshTopology::build(grid); });
+    std::vector<double> warm;
+    for (int i = 0; i < repeats; ++i) {
+        warm.push_back(elapsedMs([&]() { topology = MeshTopology::build(grid); }));
+    }
+
+    QJsonObject result = summarize(cold, warm);
+    if (topology) {
+        result["boundaryFaces"] = static_cast<qint64>(topology->numberOfBoundaryFaces());
+        result["bytes"] = static_cast<qint64>(topology->memorySize());
+    }
+    return result;
+}
+
+QList<int> parseIntList(const QString &text)
+{
+    QList<int> values;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const int value = part.trimmed().toInt(&ok);
+        if (ok && value > 0) {
+            values.append(value);
+        }
+    }
+    return values;
+}
+
+QList<MeshReorderer::Method> parseReorderList(const QString &text)
+{
+    QList<MeshReorderer::Method> methods;
+    for (const QString &part : text.split(',', Qt::SkipEmptyParts)) {
+        const QString name = part.trimmed().toLower();
+        if (name == "none") {
+            methods.append(MeshReorderer::None);
+        } else if (name == "morton") {
+            methods.append(MeshReorderer::Morton);
+        } else if (name == "hilbert") {
+            methods.append(MeshReorderer::Hilbert);
+        } else if (name == "rcm") {
+            methods.append(MeshReorderer::RCM);
+        } else {
+            qWarning() << "FEMBenchmark: 未知重排方式" << name;
+        }
+    }
+    return methods;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("FEMBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("FEM结果查看器性能基准");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "要测试的 .vtu 文件（缺省时使用 --data 目录下的示例文件）", "[文件...]");
+    QCommandLineOption dataOption("data", "示例 .vtu 所在目录", "目录", QDir::currentPath());
+    QCommandLineOption generateOption("generate", "生成规则六面体网格的每边单元数，逗号分隔，0 表示不生成", "列表", "40");
+    QCommandLineOption threadsOption("threads", "SMP 线程数，逗号分隔", "列表",
+                                     QString("1,%1").arg(vtkSMPTools::GetEstimatedDefaultNumberOfThreads()));
+    QCommandLineOption repeatOption("repeat", "每项热运行次数", "次数", "10");
+    QCommandLineOption queriesOption("pick-queries", "每次拾取运行的查询数", "数量", "1000");
+    QCommandLineOption operationsOption("operations", QString("要运行的操作，逗号分隔（%1）").arg(ALL_OPERATIONS.join(',')),
+                                        "列表", ALL_OPERATIONS.join(','));
+    QCommandLineOption outputOption("output", "JSON 输出文件（缺省写到标准输出）", "文件");
+    QCommandLineOption reorderOption("reorder", "每个数据集要测试的加载时重排方式，逗号分隔（none,hilbert,morton,rcm）",
+                                     "列表", "none");
+    QCommandLineOption shuffleOption("shuffle", "随机打乱生成网格的点/单元编号");
+    parser.addOptions({dataOption, generateOption, threadsOption, repeatOption, queriesOption, operationsOption, outputOption,
+                       reorderOption, shuffleOption});
+    parser.process(app);
+
+    const int repeats = std::max(parser.value(repeatOption).toInt(), 1);
+    const int pickQueries = std::max(parser.value(queriesOption).toInt(), 1);
+    const QStringList operations = parser.value(operationsOption).split(',', Qt::SkipEmptyParts);
+    QList<int> threadCounts = parseIntList(parser.value(threadsOption));
+    if (threadCounts.isEmpty()) {
+        threadCounts.append(1);
+    }
+    QList<MeshReorderer::Method> reorderMethods = parseReorderList(parser.value(reorderOption));
+    if (reorderMethods.isEmpty()) {
+        reorderMethods.append(MeshReorderer::None);
+    }
+
+    // 收集数据集
+    std::vector<Dataset> datasets;
+    QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        const QDir dataDir(parser.value(dataOption));
+        for (const char *sample : SAMPLE_FILES) {
+            if (dataDir.exists(sample)) {
+                files.append(dataDir.filePath(sample));
+            }
+        }
+    }
+    for (const QString &fileName : files) {
+        vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+        reader->SetFileName(fileName.toLocal8Bit().constData());
+        reader->Update();
+        if (!reader->GetOutput() || reader->GetOutput()->GetNumberOfCells() == 0) {
+            qWarning() << "FEMBenchmark: 无法读取" << fileName;
+            continue;
+        }
+        Dataset dataset;
+        dataset.name = QFileInfo(fileName).fileName();
+        dataset.fileName = fileName;
+        dataset.grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        dataset.grid->ShallowCopy(reader->GetOutput());
+        datasets.push_back(dataset);
+    }
+    for (int resolution : parseIntList(parser.value(generateOption))) {
+        Dataset dataset;
+        dataset.name = QString("hex_%1^3").arg(resolution);
+        dataset.grid = generateHexGrid(resolution);
+        if (parser.isSet(shuffleOption)) {
+            shuffleGrid(dataset.grid);
+            dataset.name += "_shuffled";
+        }
+        datasets.push_back(dataset);
+    }
+
+    if (datasets.empty()) {
+        qWarning() << "FEMBenchmark: 没有可测试的数据集";
+        return 1;
+    }
+
+    // 每种重排方式一个副本：浅拷贝后重排只替换副本的数组，原数据集保持文件中的编号。
+    // 重排耗时在默认线程数下测量一次
+    std::vector<Dataset> variants;
+    for (const Dataset &dataset : datasets) {
+        for (MeshReorderer::Method method : reorderMethods) {
+            Dataset variant = dataset;
+            variant.reorder = method;
+            if (method != MeshReorderer::None) {
+                variant.grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+                variant.grid->ShallowCopy(dataset.grid);
+                variant.reorderMs = elapsedMs([&variant, method]() { MeshReorderer::reorder(variant.grid, method); });
+            }
+            variants.push_back(variant);
+        }
+    }
+    datasets.swap(variants);
+
+    QJsonArray results;
+    for (int threads : threadCounts) {
+        vtkSMPTools::Initialize(threads);
+        qDebug() << "FEMBenchmark: 线程数" << vtkSMPTools::GetEstimatedNumberOfThreads();
+
+        for (const Dataset &dataset : datasets) {
+            vtkUnstructuredGrid *grid = dataset.grid;
+            qDebug() << "FEMBenchmark:" << dataset.name << MeshReorderer::methodName(dataset.reorder)
+                     << "点数:" << grid->GetNumberOfPoints()
+                     << "单元数:" << grid->GetNumberOfCells();
+
+            QJsonObject timings;
+            for (const QString &operation : operations) {
+                const QString op = operation.trimmed();
+                if (op == "load") {
+                    if (dataset.fileName.isEmpty()) {
+                        timings[op] = skipped("生成的网格");
+                    } else if (dataset.reorder != MeshReorderer::None) {
+                        timings[op] = skipped("读取与重排方式无关");
+                    } else {
+                        timings[op] = benchmarkLoad(dataset.fileName, repeats);
+                    }
+                } else if (op == "surface") {
+                    timings[op] = benchmarkSurface(grid, repeats);
+                } else if (op == "surface_fast") {
+                    timings[op] = benchmarkSurfaceFast(grid, repeats);
+                } else if (op == "clip") {
+                    timings[op] = benchmarkClip(grid, repeats);
+                } else if (op == "contour") {
+                    timings[op] = benchmarkContour(grid, repeats);
+                } else if (op == "warp") {
+                    timings[op] = benchmarkWarp(grid, repeats);
+                } else if (op == "streamlines") {
+                    timings[op] = benchmarkStreamlines(grid, repeats);
+                } else if (op == "pick_point") {
+                    timings[op] = benchmarkPick(grid, repeats, pickQueries, false);
+                } else if (op == "pick_cell") {
+                    timings[op] = benchmarkPick(grid, repeats, pickQueries, true);
+                } else if (op == "topology") {
+                    timings[op] = benchmarkTopology(grid, repeats);
+                } else {
+                    qWarning() << "FEMBenchmark: 未知操作" << op;
+                }
+            }
+
+            QJsonObject entry;
+            entry["dataset"] = dataset.name;
+            entry["points"] = static_cast<qint64>(grid->GetNumberOfPoints());
+            entry["cells"] = static_cast<qint64>(grid->GetNumberOfCells());
+            entry["threads"] = threads;
+            entry["reorder"] = dataset.reorder == MeshReorderer::None ? QString("none")
+                                                                      : MeshReorderer::methodName(dataset.reorder).toLower();
+            if (dataset.reorder != MeshReorderer::None) {
+                entry["reorderMs"] = dataset.reorderMs;
+            }
+            entry["operations"] = timings;
+            results.append(entry);
+        }
+    }
+
+    QJsonObject system;
+    system["os"] = QSysInfo::prettyProductName();
+    system["cpuArchitecture"] = QSysInfo::currentCpuArchitecture();
+    system["hardwareThreads"] = static_cast<int>(std::thread::hardware_concurrency());
+    system["smpBackend"] = QString::fromUtf8(vtkSMPTools::GetBackend());
+    system["vtkVersion"] = QString::fromUtf8(vtkVersion::GetVTKVersion());
+    system["qtVersion"] = QString::fromUtf8(qVersion());
+
+    QJsonObject config;
+    config["repeat"] = repeats;
+    config["pickQueries"] = pickQueries;
+    config["operations"] = QJsonArray::fromStringList(operations);
+    config["shuffle"] = parser.isSet(shuffleOption);
+
+    QJsonObject root;
+    root["benchmark"] = "FEMBenchmark";
+    root["formatVersion"] = 1;
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["system"] = system;
+    root["config"] = config;
+    root["results"] = results;
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "FEMBenchmark: 无法写入" << file.fileName() << file.errorString();
+            return 1;
+        }
+        file.write(json);
+        qDebug() << "FEMBenchmark: 结果已写入" << file.fileName();
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    return 0;
+}
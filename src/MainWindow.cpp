@@ -1,7 +1,14 @@
 #include "MainWindow.h"
+#include "core/TraceRecorder.h"
+#include "io/ReaderRegistry.h"
 #include <QFileInfo>
+#include <QElapsedTimer>
 #include <QMouseEvent>
 #include <QMenuBar>
+#include <QActionGroup>
+#include <QInputDialog>
+#include <QProgressDialog>
+#include <limits>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -16,7 +23,33 @@ MainWindow::MainWindow(QWidget *parent)
     , m_contourWidget(nullptr)
     , m_vectorFieldWidget(nullptr)
     , m_dataPicker(nullptr)
+    , m_selectionWidget(nullptr)
+    , m_selectionDock(nullptr)
+    , m_lineProbeWidget(nullptr)
+    , m_lineProbeDock(nullptr)
+    , m_queryWidget(nullptr)
+    , m_queryDock(nullptr)
+    , m_inspectorWidget(nullptr)
+    , m_inspectorDock(nullptr)
+    , m_pipelineMonitor(nullptr)
+    , m_spatialIndex(nullptr)
+    , m_imageExporter(nullptr)
+    , m_geometryExporter(nullptr)
+    , m_exportProgressBar(nullptr)
+    , m_resultWatcher(nullptr)
+    , m_exactValues(nullptr)
     , m_pickingAction(nullptr)
+    , m_hoverProbeAction(nullptr)
+    , m_derivedFieldAction(nullptr)
+    , m_memoryBudgetAction(nullptr)
+    , m_traceAction(nullptr)
+    , m_screenshotAction(nullptr)
+    , m_imageSequenceAction(nullptr)
+    , m_geometryExportAction(nullptr)
+    , m_watchAction(nullptr)
+    , m_preserveView(false)
+    , m_reorderMethod(MeshReorderer::None)
+    , m_precisionMode(PrecisionReducer::Full)
 {
     setupUI();
     setupVTK();
@@ -25,6 +58,13 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    // 子窗口部件晚于成员析构，先让它们等待访问 m_brickStore 的后台计算结束
+    if (m_clippingWidget) {
+        m_clippingWidget->setBrickStore(nullptr);
+    }
+    if (m_contourWidget) {
+        m_contourWidget->setBrickStore(nullptr);
+    }
 }
 
 void MainWindow::setupUI()
@@ -121,6 +161,8 @@ void MainWindow::setupVTK()
 
     // 创建数据映射器
     m_mapper = vtkSmartPointer<vtkDataSetMapper>::New();
+    // 标量先插值为纹理坐标再查表着色：切换颜色映射只需更新一维颜色纹理
+    m_mapper->InterpolateScalarsBeforeMappingOn();
 
     // 创建主演员（实体显示）
     m_actor = vtkSmartPointer<vtkActor>::New();
@@ -136,12 +178,7 @@ void MainWindow::setupVTK()
 
     // 创建颜色查找表
     m_lookupTable = vtkSmartPointer<vtkLookupTable>::New();
-    m_lookupTable->SetHueRange(0.667, 0.0); // 蓝色到红色
-    m_lookupTable->SetSaturationRange(1.0, 1.0);
-    m_lookupTable->SetValueRange(1.0, 1.0);
-    m_lookupTable->SetAlphaRange(1.0, 1.0);
-    m_lookupTable->SetNumberOfColors(256);
-    m_lookupTable->Build();
+    ColorMaps::apply(ColorMaps::names().first(), m_lookupTable);
 
     // 创建标量条
     m_scalarBar = vtkSmartPointer<vtkScalarBarActor>::New();
@@ -193,6 +230,10 @@ void MainWindow::setupVTK()
 
 void MainWindow::setupDockWidgets()
 {
+    // 共享的网格空间索引与拓扑表
+    m_spatialIndex = new SpatialIndex(this);
+    m_derivedFields.setSpatialIndex(m_spatialIndex);
+    
     // 创建剖切控制停靠窗口
     m_clippingWidget = new ClippingWidget(this);
     m_clippingDock = new QDockWidget("剖切控制", this);
@@ -214,15 +255,51 @@ void MainWindow::setupDockWidgets()
     m_vectorFieldDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
     addDockWidget(Qt::RightDockWidgetArea, m_vectorFieldDock);
     
-    // 将三个停靠窗口标签化
+    // 创建区域选择停靠窗口
+    m_selectionWidget = new SelectionWidget(this);
+    m_selectionDock = new QDockWidget("区域选择统计", this);
+    m_selectionDock->setWidget(m_selectionWidget);
+    m_selectionDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(Qt::RightDockWidgetArea, m_selectionDock);
+    
+    // 创建线探测停靠窗口
+    m_lineProbeWidget = new LineProbeWidget(this);
+    m_lineProbeDock = new QDockWidget("线探测", this);
+    m_lineProbeDock->setWidget(m_lineProbeWidget);
+    m_lineProbeDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(Qt::RightDockWidgetArea, m_lineProbeDock);
+    
+    // 创建数值查询停靠窗口
+    m_queryWidget = new QueryWidget(this);
+    m_queryDock = new QDockWidget("数值查询", this);
+    m_queryDock->setWidget(m_queryWidget);
+    m_queryDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(Qt::RightDockWidgetArea, m_queryDock);
+    
+    // 创建性能监视停靠窗口（不依赖数据类型，始终可用）
+    m_pipelineMonitor = new PipelineMonitor(this);
+    m_inspectorWidget = new PipelineInspectorWidget(this);
+    m_inspectorWidget->setMonitor(m_pipelineMonitor);
+    m_inspectorDock = new QDockWidget("性能监视", this);
+    m_inspectorDock->setWidget(m_inspectorWidget);
+    m_inspectorDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(Qt::RightDockWidgetArea, m_inspectorDock);
+    
+    // 将停靠窗口标签化
     tabifyDockWidget(m_clippingDock, m_contourDock);
-    tabifyDockWidget(m_contourDock, m_vectorFieldDock);
+    tabifyDockWidget(m_contourDock, m_lineProbeDock);
+    tabifyDockWidget(m_lineProbeDock, m_vectorFieldDock);
+    tabifyDockWidget(m_vectorFieldDock, m_selectionDock);
+    tabifyDockWidget(m_selectionDock, m_queryDock);
+    tabifyDockWidget(m_queryDock, m_inspectorDock);
     m_clippingDock->raise(); // 默认显示剖切控制
     
     // 创建数据拾取器
     m_dataPicker = new DataPicker(this);
     connect(m_dataPicker, &DataPicker::pointPicked,
             this, &MainWindow::onPointPicked);
+    connect(m_dataPicker, &DataPicker::hoverProbed,
+            this, &MainWindow::onHoverProbed);
     
     // 连接信号
     connect(m_clippingWidget, &ClippingWidget::clippingChanged,
@@ -231,27 +308,247 @@ void MainWindow::setupDockWidgets()
             this, &MainWindow::onContoursChanged);
     connect(m_vectorFieldWidget, &VectorFieldWidget::vectorVisualizationChanged,
             this, &MainWindow::onVectorVisualizationChanged);
+    connect(m_vectorFieldWidget, &VectorFieldWidget::particleFrameAdvanced,
+            this, &MainWindow::onParticleFrameAdvanced);
+    connect(m_selectionWidget, &SelectionWidget::selectionChanged,
+            this, &MainWindow::onSelectionChanged);
+    connect(m_lineProbeWidget, &LineProbeWidget::probeLineChanged,
+            this, &MainWindow::onProbeLineChanged);
+    connect(m_queryWidget, &QueryWidget::queryResultChanged,
+            this, &MainWindow::onQueryResultChanged);
     
     // 创建菜单栏
     QMenuBar *menuBar = this->menuBar();
     QMenu *viewMenu = menuBar->addMenu("视图");
     viewMenu->addAction(m_clippingDock->toggleViewAction());
     viewMenu->addAction(m_contourDock->toggleViewAction());
+    viewMenu->addAction(m_lineProbeDock->toggleViewAction());
     viewMenu->addAction(m_vectorFieldDock->toggleViewAction());
+    viewMenu->addAction(m_selectionDock->toggleViewAction());
+    viewMenu->addAction(m_queryDock->toggleViewAction());
+    viewMenu->addAction(m_inspectorDock->toggleViewAction());
     
     QMenu *toolsMenu = menuBar->addMenu("工具");
     m_pickingAction = toolsMenu->addAction("启用数据拾取");
     m_pickingAction->setCheckable(true);
     connect(m_pickingAction, &QAction::toggled, m_dataPicker, &DataPicker::enablePicking);
+    m_hoverProbeAction = toolsMenu->addAction("悬停探测数值");
+    m_hoverProbeAction->setCheckable(true);
+    connect(m_hoverProbeAction, &QAction::toggled, m_dataPicker, &DataPicker::enableHover);
+    toolsMenu->addSeparator();
+    m_derivedFieldAction = toolsMenu->addAction("添加派生场...");
+    m_derivedFieldAction->setEnabled(false);
+    connect(m_derivedFieldAction, &QAction::triggered, this, &MainWindow::onAddDerivedField);
+    m_memoryBudgetAction = toolsMenu->addAction("内存预算...");
+    connect(m_memoryBudgetAction, &QAction::triggered, this, &MainWindow::onMemoryBudget);
+    m_traceAction = toolsMenu->addAction("记录性能追踪");
+    m_traceAction->setCheckable(true);
+    connect(m_traceAction, &QAction::toggled, this, &MainWindow::onTraceToggled);
+    
+    // 结果文件监视：文件重写或出现新的时间步文件时在后台重新读取并增量合并
+    m_resultWatcher = new ResultWatcher(this);
+    connect(m_resultWatcher, &ResultWatcher::reloadReady, this, &MainWindow::onResultReloaded);
+    toolsMenu->addSeparator();
+    m_watchAction = toolsMenu->addAction("监视结果文件");
+    m_watchAction->setCheckable(true);
+    m_watchAction->setEnabled(false);
+    connect(m_watchAction, &QAction::toggled, this, &MainWindow::onWatchToggled);
+    
+    // 加载时网格重排：按空间填充曲线或 RCM 重新编号，改善后续各过滤器遍历的缓存局部性
+    QMenu *reorderMenu = toolsMenu->addMenu("加载时重排网格");
+    QActionGroup *reorderGroup = new QActionGroup(this);
+    const MeshReorderer::Method reorderMethods[] = {
+        MeshReorderer::None, MeshReorderer::Hilbert, MeshReorderer::Morton, MeshReorderer::RCM
+    };
+    for (MeshReorderer::Method method : reorderMethods) {
+        QAction *action = reorderMenu->addAction(MeshReorderer::methodName(method));
+        action->setCheckable(true);
+        action->setChecked(method == m_reorderMethod);
+        reorderGroup->addAction(action);
+        connect(action, &QAction::triggered, this, [this, method]() {
+            m_reorderMethod = method;
+            m_resultWatcher->setReorderMethod(method);
+            statusBar()->showMessage(QString("网格重排: %1，下次打开文件时生效").arg(MeshReorderer::methodName(method)), 3000);
+        });
+    }
+    
+    // 降精度加载：float32 或 16 位量化标量，点击拾取时在后台从原文件读取精确值
+    m_exactValues = new ExactValueSource(this);
+    m_dataPicker->setExactValueSource(m_exactValues);
+    QMenu *precisionMenu = toolsMenu->addMenu("加载精度");
+    QActionGroup *precisionGroup = new QActionGroup(this);
+    const PrecisionReducer::Mode precisionModes[] = {
+        PrecisionReducer::Full, PrecisionReducer::Float32, PrecisionReducer::Quantized16
+    };
+    for (PrecisionReducer::Mode mode : precisionModes) {
+        QAction *action = precisionMenu->addAction(PrecisionReducer::modeName(mode));
+        action->setCheckable(true);
+        action->setChecked(mode == m_precisionMode);
+        precisionGroup->addAction(action);
+        connect(action, &QAction::triggered, this, [this, mode]() {
+            m_precisionMode = mode;
+            m_resultWatcher->setPrecisionMode(mode, m_fullPrecisionArrays);
+            statusBar()->showMessage(QString("加载精度: %1，下次打开文件时生效").arg(PrecisionReducer::modeName(mode)), 3000);
+        });
+    }
+    // 需要精确值参与计算或比对的数组（如拾取、线探测关注的结果）可保持文件中的原始精度
+    precisionMenu->addSeparator();
+    QAction *fullPrecisionAction = precisionMenu->addAction("保持完整精度的数组...");
+    connect(fullPrecisionAction, &QAction::triggered, this, [this]() {
+        bool ok = false;
+        const QString text = QInputDialog::getText(this, "加载精度",
+                                                   "保持完整精度的数组（逗号分隔；时间步数组按去掉 _t<步号> 的名称匹配）:",
+                                                   QLineEdit::Normal, m_fullPrecisionArrays.join(", "), &ok);
+        if (!ok) {
+            return;
+        }
+        m_fullPrecisionArrays.clear();
+        for (const QString &name : text.split(',', Qt::SkipEmptyParts)) {
+            if (!name.trimmed().isEmpty()) {
+                m_fullPrecisionArrays << name.trimmed();
+            }
+        }
+        m_resultWatcher->setPrecisionMode(m_precisionMode, m_fullPrecisionArrays);
+        statusBar()->showMessage(QString("保持完整精度的数组: %1，下次打开文件时生效")
+                                 .arg(m_fullPrecisionArrays.isEmpty() ? "无" : m_fullPrecisionArrays.join(", ")), 3000);
+    });
+    
+    // 图像导出：分块渲染在界面线程，PNG 编码在后台线程
+    m_imageExporter = new ImageExporter(this);
+    connect(m_imageExporter, &ImageExporter::imageSaved, this, [this](const QString &fileName, bool ok) {
+        statusBar()->showMessage(ok ? QString("已保存图像: %1").arg(fileName)
+                                    : QString("保存图像失败: %1").arg(fileName), 3000);
+    });
+    QMenu *exportMenu = menuBar->addMenu("导出");
+    m_screenshotAction = exportMenu->addAction("高分辨率截图...");
+    connect(m_screenshotAction, &QAction::triggered, this, &MainWindow::onExportScreenshot);
+    m_imageSequenceAction = exportMenu->addAction("旋转动画帧序列...");
+    connect(m_imageSequenceAction, &QAction::triggered, this, &MainWindow::onExportImageSequence);
+    
+    // 派生几何导出在后台线程写盘，进度显示在状态栏
+    m_geometryExporter = new GeometryExporter(this);
+    m_exportProgressBar = new QProgressBar(this);
+    m_exportProgressBar->setRange(0, 100);
+    m_exportProgressBar->setMaximumWidth(160);
+    m_exportProgressBar->setVisible(false);
+    statusBar()->addPermanentWidget(m_exportProgressBar);
+    connect(m_geometryExporter, &GeometryExporter::progressChanged, m_exportProgressBar, &QProgressBar::setValue);
+    connect(m_geometryExporter, &GeometryExporter::finished, this, &MainWindow::onGeometryExportFinished);
+    exportMenu->addSeparator();
+    m_geometryExportAction = exportMenu->addAction("导出派生几何...");
+    connect(m_geometryExportAction, &QAction::triggered, this, &MainWindow::onExportGeometry);
+    
+    setupMemoryStages();
+    
+    // 观察各过滤器与渲染器的执行，供性能监视面板显示
+    m_pipelineMonitor->watch("剖切", m_clippingWidget->getClipFilter());
+    m_pipelineMonitor->watch("等值面", m_contourWidget->getContourFilter());
+    m_pipelineMonitor->watch("变形图", m_vectorFieldWidget->getWarpFilter());
+    m_pipelineMonitor->watch("流线追踪", m_vectorFieldWidget->getStreamTracer());
+    // 外表面由 SurfaceExtractor 在渲染前提取，单独记为"表面提取(路径)"阶段
+    m_pipelineMonitor->watchRenderer("渲染", m_renderer);
+}
+
+void MainWindow::setupMemoryStages()
+{
+    // 当前数据集常驻，只统计（派生场数组单独计入下一阶段）
+    m_memoryManager.addPinnedStage("当前数据集", [this]() -> size_t {
+        if (!m_currentData) return 0;
+        size_t total = static_cast<size_t>(m_currentData->GetActualMemorySize()) * 1024;
+        size_t derived = m_derivedFields.materializedBytes();
+        return total > derived ? total - derived : 0;
+    });
+    
+    // 派生场缓存：保留正在显示的数组，其余释放后在下次选中时重算
+    m_memoryManager.addStage("派生场缓存",
+        [this]() -> size_t { return m_derivedFields.materializedBytes(); },
+        []() { return false; },
+        [this]() {
+            m_derivedFields.releaseMaterialized(QStringList() << m_currentDataArrayName << m_currentScalarArrayName);
+        });
+    
+    // 显示用外表面：主视图始终绘制它，只在没有非结构网格时才可释放
+    m_memoryManager.addStage("显示表面",
+        [this]() -> size_t { return m_surfaceExtractor.memorySize(); },
+        [this]() { return m_currentData != nullptr; },
+        [this]() { m_surfaceExtractor.release(); });
+    
+    // 拾取用的原文件精确值：释放后在下次点击时重新读取
+    m_memoryManager.addStage("文件精确值缓存",
+        [this]() -> size_t { return m_exactValues->memorySize(); },
+        []() { return false; },
+        [this]() { m_exactValues->release(); });
+    
+    // 分块模型的块缓存：占内存预算的四分之一，释放后剖切、等值面按需重新读入
+    m_brickStore.setCacheBudget(m_memoryManager.budget() / 4);
+    m_memoryManager.addStage("分块缓存",
+        [this]() -> size_t { return m_brickStore.memorySize(); },
+        []() { return false; },
+        [this]() { m_brickStore.release(); });
+    
+    // 查询面板的有序索引：释放后在下次查询时重建
+    m_memoryManager.addStage("查询索引",
+        [this]() -> size_t { return m_queryWidget->indexMemorySize(); },
+        []() { return false; },
+        [this]() { m_queryWidget->releaseIndices(); });
+    
+    // 拓扑表：释放后在下次流线、粒子或节点平均需要时重建
+    m_memoryManager.addStage("网格拓扑表",
+        [this]() -> size_t { return m_spatialIndex->topologyBytes(); },
+        []() { return false; },
+        [this]() { m_spatialIndex->releaseTopology(); });
+    
+    // 各功能的过滤器输出：功能关闭后可释放，重新启用时由管线自动重算
+    m_memoryManager.addAlgorithmStage("剖切结果", m_clippingWidget->getClipFilter(), [this]() {
+        return m_clippingWidget->property("clippingEnabled").toBool();
+    });
+    m_memoryManager.addAlgorithmStage("等值面", m_contourWidget->getContourFilter(), [this]() {
+        return m_contourWidget->property("contourEnabled").toBool() &&
+               m_contourWidget->property("hasContours").toBool();
+    });
+    m_memoryManager.addAlgorithmStage("变形图", m_vectorFieldWidget->getWarpFilter(), [this]() {
+        return m_vectorFieldWidget->property("warpEnabled").toBool();
+    });
+    m_memoryManager.addAlgorithmStage("流线", m_vectorFieldWidget->getStreamTracer(), [this]() {
+        return m_vectorFieldWidget->property("streamlineEnabled").toBool();
+    });
+}
+
+void MainWindow::enforceMemoryBudget()
+{
+    QStringList released = m_memoryManager.enforce();
+    if (!released.isEmpty()) {
+        statusBar()->showMessage(QString("超出内存预算，已释放: %1（当前占用 %2）")
+                                     .arg(released.join("、"))
+                                     .arg(MemoryManager::formatBytes(m_memoryManager.totalBytes())), 5000);
+    }
+}
+
+void MainWindow::onMemoryBudget()
+{
+    const int currentMB = static_cast<int>(m_memoryManager.budget() / (1024 * 1024));
+    bool ok = false;
+    int budgetMB = QInputDialog::getInt(this, "内存预算",
+                                        QString("%1\n\n内存预算 (MB):").arg(m_memoryManager.report()),
+                                        currentMB, 256, std::numeric_limits<int>::max(), 256, &ok);
+    if (!ok) {
+        return;
+    }
+    
+    m_memoryManager.setBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+    m_brickStore.setCacheBudget(m_memoryManager.budget() / 4);
+    enforceMemoryBudget();
+    qDebug() << "MainWindow: 内存预算设置为" << budgetMB << "MB";
 }
 
 void MainWindow::openFile()
 {
+    TRACE_SCOPE("MainWindow::openFile", "ui");
     QString fileName = QFileDialog::getOpenFileName(
         this,
         "打开文件",
         "",
-        "所有支持的文件 (*.vtu *.vtk *.stl *.obj *.ply);;VTK分析文件 (*.vtu *.vtk);;3D模型文件 (*.stl *.obj *.ply);;STL文件 (*.stl);;OBJ文件 (*.obj);;PLY文件 (*.ply);;所有文件 (*.*)"
+        ReaderRegistry::instance().fileDialogFilter()
     );
 
     if (fileName.isEmpty()) {
@@ -265,91 +562,66 @@ void MainWindow::openFile()
     m_currentGeometryData = nullptr;
     m_currentDataType = DATA_TYPE_NONE;
     
-    // 根据文件扩展名选择合适的读取器
-    if (fileName.endsWith(".vtu", Qt::CaseInsensitive)) {
-        // VTK XML格式 - 分析数据
-        m_xmlReader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-        m_xmlReader->SetFileName(fileName.toStdString().c_str());
-        m_xmlReader->Update();
-        
-        if (m_xmlReader->GetOutput()->GetNumberOfCells() == 0) {
-            QMessageBox::warning(this, "错误", "无法读取VTU文件或文件为空");
-            return;
-        }
-        
-        m_currentData = m_xmlReader->GetOutput();
-        m_currentDataType = DATA_TYPE_UNSTRUCTURED_GRID;
-    }
-    else if (fileName.endsWith(".vtk", Qt::CaseInsensitive)) {
-        // VTK Legacy格式 - 分析数据
-        m_legacyReader = vtkSmartPointer<vtkUnstructuredGridReader>::New();
-        m_legacyReader->SetFileName(fileName.toStdString().c_str());
-        m_legacyReader->Update();
-        
-        if (m_legacyReader->GetOutput()->GetNumberOfCells() == 0) {
-            QMessageBox::warning(this, "错误", "无法读取VTK文件或文件为空");
-            return;
-        }
-        
-        m_currentData = m_legacyReader->GetOutput();
+    // 由读取器注册表按文件内容与扩展名选择读取器（VTK 格式与各求解器格式）
+    QElapsedTimer readTimer;
+    readTimer.start();
+    QString readError;
+    vtkSmartPointer<vtkDataObject> data = ReaderRegistry::instance().read(fileName, &readError);
+
+    if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(data)) {
+        // 分析数据
+        m_currentData = grid;
         m_currentDataType = DATA_TYPE_UNSTRUCTURED_GRID;
-    }
-    else if (fileName.endsWith(".stl", Qt::CaseInsensitive)) {
-        // STL格式 - 纯几何数据
-        m_stlReader = vtkSmartPointer<vtkSTLReader>::New();
-        m_stlReader->SetFileName(fileName.toStdString().c_str());
-        m_stlReader->Update();
-        
-        if (m_stlReader->GetOutput()->GetNumberOfCells() == 0) {
-            QMessageBox::warning(this, "错误", "无法读取STL文件或文件为空");
-            return;
-        }
-        
-        m_currentGeometryData = m_stlReader->GetOutput();
+    } else if (vtkPolyData *polyData = vtkPolyData::SafeDownCast(data)) {
+        // 纯几何数据
+        m_currentGeometryData = polyData;
         m_currentDataType = DATA_TYPE_GEOMETRY_ONLY;
+    } else {
+        QMessageBox::warning(this, "错误", QString("无法读取文件: %1\n%2")
+                             .arg(QFileInfo(fileName).fileName())
+                             .arg(readError.isEmpty() ? "不支持的文件格式" : readError));
+        return;
     }
-    else if (fileName.endsWith(".obj", Qt::CaseInsensitive)) {
-        // OBJ格式 - 纯几何数据
-        try {
-            m_objReader = vtkSmartPointer<vtkOBJReader>::New();
-            m_objReader->SetFileName(fileName.toStdString().c_str());
-            m_objReader->Update();
-            
-            if (m_objReader->GetOutput()->GetNumberOfCells() == 0) {
-                QMessageBox::warning(this, "错误", "无法读取OBJ文件或文件为空");
-                return;
-            }
-            
-            m_currentGeometryData = m_objReader->GetOutput();
-            m_currentDataType = DATA_TYPE_GEOMETRY_ONLY;
-        } catch (...) {
-            QMessageBox::warning(this, "错误", "OBJ读取器不可用，请检查VTK安装");
-            return;
+    m_pipelineMonitor->record("读取文件", readTimer.elapsed(),
+                              static_cast<size_t>(data->GetActualMemorySize()) * 1024);
+
+    // 可选的重排在其他模块拿到数据之前完成，拾取等处通过原始编号数组换算回文件编号
+    if (m_currentDataType == DATA_TYPE_UNSTRUCTURED_GRID && m_reorderMethod != MeshReorderer::None) {
+        QElapsedTimer reorderTimer;
+        reorderTimer.start();
+        QString reorderError;
+        if (MeshReorderer::reorder(m_currentData, m_reorderMethod, &reorderError)) {
+            m_pipelineMonitor->record("网格重排", reorderTimer.elapsed(),
+                                      static_cast<size_t>(m_currentData->GetActualMemorySize()) * 1024);
+        } else {
+            statusBar()->showMessage(QString("未重排网格: %1").arg(reorderError), 3000);
         }
     }
-    else if (fileName.endsWith(".ply", Qt::CaseInsensitive)) {
-        // PLY格式 - 纯几何数据
-        try {
-            m_plyReader = vtkSmartPointer<vtkPLYReader>::New();
-            m_plyReader->SetFileName(fileName.toStdString().c_str());
-            m_plyReader->Update();
-            
-            if (m_plyReader->GetOutput()->GetNumberOfCells() == 0) {
-                QMessageBox::warning(this, "错误", "无法读取PLY文件或文件为空");
-                return;
-            }
-            
-            m_currentGeometryData = m_plyReader->GetOutput();
-            m_currentDataType = DATA_TYPE_GEOMETRY_ONLY;
-        } catch (...) {
-            QMessageBox::warning(this, "错误", "PLY读取器不可用，请检查VTK安装");
-            return;
+
+    // 降精度在重排之后进行，原始编号数组保持整数类型
+    if (m_currentDataType == DATA_TYPE_UNSTRUCTURED_GRID && m_precisionMode != PrecisionReducer::Full) {
+        QElapsedTimer precisionTimer;
+        precisionTimer.start();
+        QString precisionError;
+        if (PrecisionReducer::reduce(m_currentData, m_precisionMode, m_fullPrecisionArrays, &precisionError)) {
+            m_pipelineMonitor->record("精度转换", precisionTimer.elapsed(),
+                                      static_cast<size_t>(m_currentData->GetActualMemorySize()) * 1024);
+        } else {
+            statusBar()->showMessage(QString("未转换精度: %1").arg(precisionError), 3000);
         }
     }
-    else {
-        QMessageBox::warning(this, "错误", "不支持的文件格式\\n支持的格式：VTU, VTK, STL, OBJ, PLY");
-        return;
+    // 分块模型：读取器返回的是概览外表面，各块由剖切、等值面按需读入
+    m_brickStore.close();
+    if (m_currentDataType == DATA_TYPE_UNSTRUCTURED_GRID && BrickStore::isIndexFile(fileName)) {
+        QString brickError;
+        if (!m_brickStore.open(fileName, &brickError)) {
+            statusBar()->showMessage(QString("无法打开分块数据: %1").arg(brickError), 5000);
+        }
+        m_brickStore.setPrecisionMode(m_precisionMode, m_fullPrecisionArrays);
     }
+    // 分块模式下打开的是索引与概览，其点/单元编号与各块不对应，不从中读取精确值
+    m_exactValues->setFile(m_currentDataType == DATA_TYPE_UNSTRUCTURED_GRID && m_precisionMode != PrecisionReducer::Full
+                           && !m_brickStore.isOpen() ? fileName : QString());
 
     if (m_currentDataType == DATA_TYPE_GEOMETRY_ONLY) {
         // 几何文件处理（STL、OBJ、PLY等）
@@ -367,11 +639,23 @@ void MainWindow::openFile()
         
         // 禁用颜色映射（几何文件没有标量数据）
         m_colorMapComboBox->setEnabled(false);
+        m_derivedFields.setData(nullptr);
+        m_derivedFieldAction->setEnabled(false);
+        m_surfaceExtractor.setData(nullptr);
         
         // 更新状态
         m_statusLabel->setText(QString("已加载%1: %2").arg(fileExt).arg(QFileInfo(fileName).fileName()));
+        
+        // 纯几何文件没有结果可监视
+        m_watchAction->setChecked(false);
+        m_watchAction->setEnabled(false);
     } else {
         // VTK文件处理
+        // 登记张量/矢量的内置派生场（按需计算）
+        m_derivedFields.setData(m_currentData);
+        m_derivedFieldAction->setEnabled(true);
+        m_surfaceExtractor.setData(m_currentData);
+        
         // 填充数据下拉框
         populateDataComboBox();
         
@@ -381,13 +665,32 @@ void MainWindow::openFile()
         m_opacitySlider->setEnabled(true);
         
         // 更新状态
-        m_statusLabel->setText(QString("已加载: %1").arg(QFileInfo(fileName).fileName()));
+        if (m_brickStore.isOpen()) {
+            m_statusLabel->setText(QString("已加载: %1（分块模式: %2 块，%3 个单元）")
+                                       .arg(QFileInfo(fileName).fileName())
+                                       .arg(m_brickStore.index().bricks.size())
+                                       .arg(m_brickStore.index().numberOfCells));
+        } else {
+            m_statusLabel->setText(QString("已加载: %1").arg(QFileInfo(fileName).fileName()));
+        }
+        
+        // 监视中打开其他文件时改为监视新文件；分块模型由预处理生成，不监视
+        if (m_brickStore.isOpen()) {
+            m_watchAction->setChecked(false);
+        }
+        m_watchAction->setEnabled(!m_brickStore.isOpen());
+        m_resultWatcher->setCurrentData(m_currentData);
+        if (m_resultWatcher->isWatching()) {
+            m_resultWatcher->start(fileName);
+        }
         
         // 如果有数据数组，自动选择第一个
         if (m_dataComboBox->count() > 0) {
             m_dataComboBox->setCurrentIndex(0);
             onDataSelectionChanged(m_dataComboBox->currentText());
         }
+        
+        enforceMemoryBudget();
     }
 }
 
@@ -404,7 +707,8 @@ void MainWindow::populateDataComboBox()
     vtkPointData *pointData = m_currentData->GetPointData();
     for (int i = 0; i < pointData->GetNumberOfArrays(); ++i) {
         vtkDataArray *array = pointData->GetArray(i);
-        if (array && array->GetName()) {
+        if (array && array->GetName() && !MeshReorderer::isIdMapArray(array->GetName())
+            && !m_derivedFields.contains(QString::fromStdString(array->GetName()), true)) {
             QString arrayName = QString::fromStdString(array->GetName());
             int components = array->GetNumberOfComponents();
             
@@ -424,7 +728,8 @@ void MainWindow::populateDataComboBox()
     vtkCellData *cellData = m_currentData->GetCellData();
     for (int i = 0; i < cellData->GetNumberOfArrays(); ++i) {
         vtkDataArray *array = cellData->GetArray(i);
-        if (array && array->GetName()) {
+        if (array && array->GetName() && !MeshReorderer::isIdMapArray(array->GetName())
+            && !m_derivedFields.contains(QString::fromStdString(array->GetName()), false)) {
             QString arrayName = QString::fromStdString(array->GetName());
             int components = array->GetNumberOfComponents();
             
@@ -440,11 +745,21 @@ void MainWindow::populateDataComboBox()
         }
     }
 
+    // 派生场（首次选中时才计算）
+    for (const DerivedFieldRegistry::Field &field : m_derivedFields.fields()) {
+        m_dataComboBox->addItem(QString("%1: %2 (派生: %3)")
+                                    .arg(field.isPointData ? "点数据" : "单元数据")
+                                    .arg(field.name)
+                                    .arg(field.expression),
+                                QVariant::fromValue(QPair<QString, bool>(field.name, field.isPointData)));
+    }
+
     m_dataComboBox->setEnabled(m_dataComboBox->count() > 0);
 }
 
 void MainWindow::onDataSelectionChanged(const QString &displayName)
 {
+    TRACE_SCOPE("MainWindow::onDataSelectionChanged", "ui");
     if (!m_currentData || displayName.isEmpty()) {
         return;
     }
@@ -459,11 +774,17 @@ void MainWindow::onDataSelectionChanged(const QString &displayName)
     QString arrayName = arrayInfo.first;
     bool isPointData = arrayInfo.second;
 
-    m_currentDataArrayName = arrayName;
+    // 派生场在首次选中时计算，输入未变时直接复用
+    if (m_derivedFields.contains(arrayName, isPointData)) {
+        QString error;
+        if (!m_derivedFields.materialize(arrayName, isPointData, &error)) {
+            QMessageBox::warning(this, "派生场", QString("计算派生场失败: %1").arg(error));
+            return;
+        }
+        m_memoryManager.touch("派生场缓存");
+    }
 
-    // 设置映射器的输入数据
-    m_mapper->SetInputData(m_currentData);
-    m_wireframeMapper->SetInputData(m_currentData);
+    m_currentDataArrayName = arrayName;
 
     // 检查是否是矢量数据
     vtkDataArray *dataArray = nullptr;
@@ -474,6 +795,7 @@ void MainWindow::onDataSelectionChanged(const QString &displayName)
     }
 
     bool isVectorData = (dataArray && dataArray->GetNumberOfComponents() == 3);
+    m_currentScalarArrayName = arrayName;
 
     if (isVectorData) {
         // 矢量数据 - 设置为矢量数组
@@ -483,13 +805,20 @@ void MainWindow::onDataSelectionChanged(const QString &displayName)
             m_currentData->GetCellData()->SetActiveVectors(arrayName.toStdString().c_str());
         }
         
-        // 对于矢量数据，使用矢量的大小作为标量进行着色
+        // 对于矢量数据，使用缓存的矢量模数组作为标量着色，等值面、范围计算等共用同一数组
+        QString magnitudeName = DerivedFieldRegistry::magnitudeName(arrayName);
+        if (m_derivedFields.contains(magnitudeName, isPointData) &&
+            m_derivedFields.materialize(magnitudeName, isPointData)) {
+            m_currentScalarArrayName = magnitudeName;
+        }
         if (isPointData) {
             m_mapper->SetScalarModeToUsePointData();
             m_wireframeMapper->SetScalarModeToUsePointData();
+            m_currentData->GetPointData()->SetActiveScalars(m_currentScalarArrayName.toStdString().c_str());
         } else {
             m_mapper->SetScalarModeToUseCellData();
             m_wireframeMapper->SetScalarModeToUseCellData();
+            m_currentData->GetCellData()->SetActiveScalars(m_currentScalarArrayName.toStdString().c_str());
         }
         
         // 启用矢量场可视化面板
@@ -521,21 +850,39 @@ void MainWindow::onDataSelectionChanged(const QString &displayName)
 
     // 更新可视化
     updateVisualization();
+    enforceMemoryBudget();
 }
 
 void MainWindow::updateVisualization()
 {
+    TRACE_SCOPE("MainWindow::updateVisualization", "ui");
     if (!m_currentData) {
         return;
     }
 
-    // 获取数据范围
+    // 获取数据范围（矢量取其模数组的范围，结果由数组自身缓存）
     double range[2];
-    m_currentData->GetScalarRange(range);
+    vtkDataArray *scalars = m_currentData->GetPointData()->GetArray(m_currentScalarArrayName.toStdString().c_str());
+    if (!scalars) {
+        scalars = m_currentData->GetCellData()->GetArray(m_currentScalarArrayName.toStdString().c_str());
+    }
+    if (scalars && scalars->GetNumberOfComponents() == 1) {
+        scalars->GetRange(range, 0);
+    } else {
+        m_currentData->GetScalarRange(range);
+    }
 
-    // 更新查找表范围
+    // 更新查找表范围（颜色表由 ColorMaps 写入，这里不重新 Build）
     m_lookupTable->SetTableRange(range);
-    m_lookupTable->Build();
+
+    // 映射器直接绘制外表面：纯四面体/六面体网格走专用提取路径，拓扑不变时只按原始编号同步数组
+    QElapsedTimer surfaceTimer;
+    surfaceTimer.start();
+    vtkPolyData *surface = m_surfaceExtractor.surface();
+    m_pipelineMonitor->record(QString("表面提取(%1)").arg(SurfaceExtractor::pathName(m_surfaceExtractor.path())),
+                              surfaceTimer.elapsed(), m_surfaceExtractor.memorySize());
+    m_mapper->SetInputData(surface);
+    m_wireframeMapper->SetInputData(surface);
 
     // 设置映射器的查找表
     m_mapper->SetLookupTable(m_lookupTable);
@@ -553,8 +900,10 @@ void MainWindow::updateVisualization()
     // 更新高级功能
     updateAdvancedFeatures();
 
-    // 重置视图
-    resetView();
+    // 重置视图（结果文件重新加载时保留当前相机）
+    if (!m_preserveView) {
+        resetView();
+    }
 }
 
 void MainWindow::resetView()
@@ -576,57 +925,21 @@ void MainWindow::resetView()
 
 void MainWindow::setupColorMaps()
 {
-    // 添加颜色映射选项
-    m_colorMapComboBox->addItem("彩虹 (蓝→红)");
-    m_colorMapComboBox->addItem("热力图 (黑→红→黄)");
-    m_colorMapComboBox->addItem("蓝白红");
-    m_colorMapComboBox->addItem("灰度");
-    m_colorMapComboBox->addItem("绿蓝");
-    m_colorMapComboBox->addItem("紫红");
+    // 添加颜色映射选项（编译期生成的颜色表）
+    m_colorMapComboBox->addItems(ColorMaps::names());
 }
 
 void MainWindow::applyColorMap(const QString &colorMapName)
 {
     if (!m_lookupTable) return;
     
-    if (colorMapName == "彩虹 (蓝→红)") {
-        m_lookupTable->SetHueRange(0.667, 0.0); // 蓝色到红色
-        m_lookupTable->SetSaturationRange(1.0, 1.0);
-        m_lookupTable->SetValueRange(1.0, 1.0);
-    }
-    else if (colorMapName == "热力图 (黑→红→黄)") {
-        m_lookupTable->SetHueRange(0.0, 0.167); // 红色到黄色
-        m_lookupTable->SetSaturationRange(1.0, 1.0);
-        m_lookupTable->SetValueRange(0.0, 1.0); // 从黑到亮
-    }
-    else if (colorMapName == "蓝白红") {
-        m_lookupTable->SetHueRange(0.667, 0.0); // 蓝到红
-        m_lookupTable->SetSaturationRange(1.0, 1.0);
-        m_lookupTable->SetValueRange(0.5, 1.0); // 较亮的颜色
-    }
-    else if (colorMapName == "灰度") {
-        m_lookupTable->SetHueRange(0.0, 0.0); // 无色相
-        m_lookupTable->SetSaturationRange(0.0, 0.0); // 无饱和度
-        m_lookupTable->SetValueRange(0.0, 1.0); // 黑到白
-    }
-    else if (colorMapName == "绿蓝") {
-        m_lookupTable->SetHueRange(0.333, 0.667); // 绿到蓝
-        m_lookupTable->SetSaturationRange(1.0, 1.0);
-        m_lookupTable->SetValueRange(1.0, 1.0);
-    }
-    else if (colorMapName == "紫红") {
-        m_lookupTable->SetHueRange(0.833, 0.0); // 紫到红
-        m_lookupTable->SetSaturationRange(1.0, 1.0);
-        m_lookupTable->SetValueRange(1.0, 1.0);
+    // 只替换查找表内容：映射器据此重建颜色纹理，不重新执行管线，也不重置相机
+    if (!ColorMaps::apply(colorMapName, m_lookupTable)) {
+        return;
     }
     
-    m_lookupTable->SetAlphaRange(1.0, 1.0);
-    m_lookupTable->SetNumberOfColors(256);
-    m_lookupTable->Build();
-    
-    // 更新渲染
-    if (m_currentData) {
-        updateVisualization();
+    if (m_currentData && m_renderWindow) {
+        m_renderWindow->Render();
     }
 }
 
@@ -648,6 +961,7 @@ void MainWindow::updateDisplayMode()
     // 只有VTK文件才添加标量条（STL文件没有标量数据）
     if (m_currentDataType == DATA_TYPE_UNSTRUCTURED_GRID) {
         m_renderer->AddActor2D(m_scalarBar);
+        addOverlayActors(); // 保留选区高亮、已提取对象与探测线
     }
     
     // 刷新渲染
@@ -656,16 +970,19 @@ void MainWindow::updateDisplayMode()
 
 void MainWindow::onDisplayModeChanged(int state)
 {
+    TRACE_SCOPE("MainWindow::onDisplayModeChanged", "ui");
     updateDisplayMode();
 }
 
 void MainWindow::onColorMapChanged(const QString &colorMapName)
 {
+    TRACE_SCOPE("MainWindow::onColorMapChanged", "ui");
     applyColorMap(colorMapName);
 }
 
 void MainWindow::onOpacityChanged(int value)
 {
+    TRACE_SCOPE("MainWindow::onOpacityChanged", "ui");
     if (!m_actor) return;
     
     // 检查是否有矢量场可视化处于活动状态
@@ -673,7 +990,8 @@ void MainWindow::onOpacityChanged(int value)
     if (m_vectorFieldWidget) {
         bool warpEnabled = m_vectorFieldWidget->property("warpEnabled").toBool();
         bool streamlineEnabled = m_vectorFieldWidget->property("streamlineEnabled").toBool();
-        vectorVisualizationActive = warpEnabled || streamlineEnabled;
+        bool particlesEnabled = m_vectorFieldWidget->property("particlesEnabled").toBool();
+        vectorVisualizationActive = warpEnabled || streamlineEnabled || particlesEnabled;
     }
     
     float opacity;
@@ -702,6 +1020,9 @@ void MainWindow::updateAdvancedFeatures()
         if (m_clippingDock) m_clippingDock->setEnabled(false);
         if (m_contourDock) m_contourDock->setEnabled(false);
         if (m_vectorFieldDock) m_vectorFieldDock->setEnabled(false);
+        if (m_selectionDock) m_selectionDock->setEnabled(false);
+        if (m_lineProbeDock) m_lineProbeDock->setEnabled(false);
+        if (m_queryDock) m_queryDock->setEnabled(false);
         
         // 禁用数据拾取功能
         if (m_dataPicker) {
@@ -711,8 +1032,16 @@ void MainWindow::updateAdvancedFeatures()
             m_pickingAction->setEnabled(false);
             m_pickingAction->setChecked(false);
         }
+        if (m_hoverProbeAction) {
+            m_hoverProbeAction->setEnabled(false);
+            m_hoverProbeAction->setChecked(false);
+        }
         
         // 更新状态标签
+        if (m_inspectorWidget) {
+            m_inspectorWidget->setData(nullptr);
+        }
+        
         QString fileExt = QFileInfo(m_currentFileName).suffix().toUpper();
         m_statusLabel->setText(QString("%1几何文件 - 仅支持基本显示功能").arg(fileExt));
         return;
@@ -720,32 +1049,47 @@ void MainWindow::updateAdvancedFeatures()
     
     if (!m_currentData) return;
     
+    // 更新共享空间索引，定位器在后台构建，不阻塞界面
+    if (m_spatialIndex) {
+        m_spatialIndex->setData(m_currentData);
+        m_spatialIndex->buildAsync();
+    }
+    
     // 启用高级功能面板
     if (m_clippingDock) m_clippingDock->setEnabled(true);
     if (m_contourDock) m_contourDock->setEnabled(true);
     if (m_vectorFieldDock) m_vectorFieldDock->setEnabled(true);
+    if (m_selectionDock) m_selectionDock->setEnabled(true);
+    if (m_lineProbeDock) m_lineProbeDock->setEnabled(true);
+    if (m_queryDock) m_queryDock->setEnabled(true);
     
     // 启用数据拾取功能（但不自动开启，由用户控制）
     if (m_pickingAction) {
         m_pickingAction->setEnabled(true);
     }
+    if (m_hoverProbeAction) {
+        m_hoverProbeAction->setEnabled(true);
+    }
     
-    // 更新剖切功能
+    // 更新剖切功能（分块模型先切换为逐块截面）
+    BrickStore *bricks = m_brickStore.isOpen() ? &m_brickStore : nullptr;
     if (m_clippingWidget) {
+        m_clippingWidget->setBrickStore(bricks);
         m_clippingWidget->setData(m_currentData);
         m_clippingWidget->setRenderer(m_renderer);
     }
     
     // 更新等值面功能
     if (m_contourWidget) {
+        m_contourWidget->setBrickStore(bricks);
         m_contourWidget->setData(m_currentData);
         m_contourWidget->setRenderer(m_renderer);
         
         // 设置活动标量数组
-        if (!m_currentDataArrayName.isEmpty()) {
+        if (!m_currentScalarArrayName.isEmpty()) {
             // 检查是否是点数据还是单元数据
-            bool isPointData = m_currentData->GetPointData()->GetArray(m_currentDataArrayName.toStdString().c_str()) != nullptr;
-            m_contourWidget->setActiveScalarArray(m_currentDataArrayName, isPointData);
+            bool isPointData = m_currentData->GetPointData()->GetArray(m_currentScalarArrayName.toStdString().c_str()) != nullptr;
+            m_contourWidget->setActiveScalarArray(m_currentScalarArrayName, isPointData);
         }
         
         qDebug() << "MainWindow: 等值面功能已更新，当前数据数组:" << m_currentDataArrayName;
@@ -755,6 +1099,7 @@ void MainWindow::updateAdvancedFeatures()
     if (m_vectorFieldWidget) {
         m_vectorFieldWidget->setData(m_currentData);
         m_vectorFieldWidget->setRenderer(m_renderer);
+        m_vectorFieldWidget->setSpatialIndex(m_spatialIndex);
         
         qDebug() << "MainWindow: 矢量场功能已更新";
     }
@@ -764,12 +1109,48 @@ void MainWindow::updateAdvancedFeatures()
         m_dataPicker->setData(m_currentData);
         m_dataPicker->setRenderer(m_renderer);
         m_dataPicker->setInteractor(m_renderWindow->GetInteractor());
-        m_dataPicker->setActiveScalarArray(m_currentDataArrayName, true); // 假设是点数据
+        m_dataPicker->setSpatialIndex(m_spatialIndex);
+        bool isPointData = m_currentData->GetPointData()->GetArray(m_currentDataArrayName.toStdString().c_str()) != nullptr;
+        m_dataPicker->setActiveScalarArray(m_currentDataArrayName, isPointData);
+    }
+    
+    // 更新区域选择
+    if (m_selectionWidget) {
+        m_selectionWidget->setData(m_currentData);
+        m_selectionWidget->setRenderer(m_renderer);
+        m_selectionWidget->setInteractor(m_renderWindow->GetInteractor());
+        m_selectionWidget->setMainActor(m_actor);
+        bool isPointData = m_currentData->GetPointData()->GetArray(m_currentScalarArrayName.toStdString().c_str()) != nullptr;
+        m_selectionWidget->setActiveScalarArray(m_currentScalarArrayName, isPointData);
+    }
+    
+    // 更新线探测
+    if (m_lineProbeWidget) {
+        m_lineProbeWidget->setData(m_currentData);
+        m_lineProbeWidget->setRenderer(m_renderer);
+        m_lineProbeWidget->setInteractor(m_renderWindow->GetInteractor());
+        m_lineProbeWidget->setSpatialIndex(m_spatialIndex);
+        bool isPointData = m_currentData->GetPointData()->GetArray(m_currentDataArrayName.toStdString().c_str()) != nullptr;
+        m_lineProbeWidget->setActiveScalarArray(m_currentDataArrayName, isPointData);
+    }
+    
+    // 更新数值查询（跟随数据下拉框中选中的数组）
+    if (m_queryWidget) {
+        m_queryWidget->setData(m_currentData);
+        m_queryWidget->setRenderer(m_renderer);
+        bool isPointData = m_currentData->GetPointData()->GetArray(m_currentScalarArrayName.toStdString().c_str()) != nullptr;
+        m_queryWidget->setActiveScalarArray(m_currentScalarArrayName, isPointData);
+    }
+    
+    // 更新性能监视
+    if (m_inspectorWidget) {
+        m_inspectorWidget->setData(m_currentData);
     }
 }
 
 void MainWindow::onClippingChanged()
 {
+    TRACE_SCOPE("MainWindow::onClippingChanged", "ui");
     if (!m_clippingWidget || !m_renderer) return;
     
     // 移除之前的剖切演员
@@ -798,11 +1179,16 @@ void MainWindow::onClippingChanged()
         updateDisplayMode(); // 这会重新添加原始模型
     }
     
+    // 记录使用并按预算释放其他非活动阶段
+    m_memoryManager.touch("剖切结果");
+    enforceMemoryBudget();
+    
     m_renderWindow->Render();
 }
 
 void MainWindow::onContoursChanged()
 {
+    TRACE_SCOPE("MainWindow::onContoursChanged", "ui");
     if (!m_contourWidget || !m_renderer) return;
     
     // 移除之前的等值面演员
@@ -821,14 +1207,393 @@ void MainWindow::onContoursChanged()
         }
     }
     
+    m_memoryManager.touch("等值面");
+    enforceMemoryBudget();
+    
+    m_renderWindow->Render();
+}
+
+void MainWindow::addOverlayActors()
+{
+    if (m_selectionWidget) {
+        if (m_selectionWidget->property("hasSelection").toBool()) {
+            m_renderer->AddActor(m_selectionWidget->getHighlightActor());
+        }
+        for (const vtkSmartPointer<vtkActor> &actor : m_selectionWidget->getExtractedActors()) {
+            m_renderer->AddActor(actor);
+        }
+    }
+    
+    if (m_lineProbeWidget && m_lineProbeWidget->property("probeLineVisible").toBool()) {
+        m_renderer->AddActor(m_lineProbeWidget->getProbeLineActor());
+    }
+    
+    if (m_queryWidget && m_queryWidget->property("hasHits").toBool()) {
+        m_renderer->AddActor(m_queryWidget->getHighlightActor());
+    }
+}
+
+void MainWindow::onSelectionChanged()
+{
+    TRACE_SCOPE("MainWindow::onSelectionChanged", "ui");
+    if (!m_selectionWidget || !m_renderer) return;
+    
+    // 先移除再按当前状态重新添加
+    m_renderer->RemoveActor(m_selectionWidget->getHighlightActor());
+    for (const vtkSmartPointer<vtkActor> &actor : m_selectionWidget->getExtractedActors()) {
+        m_renderer->RemoveActor(actor);
+    }
+    addOverlayActors();
+    
+    m_renderWindow->Render();
+}
+
+void MainWindow::onProbeLineChanged()
+{
+    TRACE_SCOPE("MainWindow::onProbeLineChanged", "ui");
+    if (!m_lineProbeWidget || !m_renderer) return;
+    
+    m_renderer->RemoveActor(m_lineProbeWidget->getProbeLineActor());
+    if (m_lineProbeWidget->property("probeLineVisible").toBool()) {
+        m_renderer->AddActor(m_lineProbeWidget->getProbeLineActor());
+    }
+    
+    m_renderWindow->Render();
+}
+
+void MainWindow::onQueryResultChanged()
+{
+    TRACE_SCOPE("MainWindow::onQueryResultChanged", "ui");
+    if (!m_queryWidget || !m_renderer) return;
+    
+    m_renderer->RemoveActor(m_queryWidget->getHighlightActor());
+    if (m_queryWidget->property("hasHits").toBool()) {
+        m_renderer->AddActor(m_queryWidget->getHighlightActor());
+    }
+    
+    m_renderWindow->Render();
+}
+
+void MainWindow::onAddDerivedField()
+{
+    if (!m_currentData) return;
+    
+    bool ok = false;
+    QString name = QInputDialog::getText(this, "添加派生场", "派生场名称:", QLineEdit::Normal, "", &ok);
+    if (!ok || name.trimmed().isEmpty()) return;
+    
+    QString expression = QInputDialog::getText(this, "添加派生场",
+        "表达式（如 S11 - S22、sqrt(Vx^2 + Vy^2)、Velocity[0]）:", QLineEdit::Normal, "", &ok);
+    if (!ok || expression.trimmed().isEmpty()) return;
+    
+    QStringList locations;
+    locations << "点数据" << "单元数据";
+    QString location = QInputDialog::getItem(this, "添加派生场", "数据位置:", locations, 0, false, &ok);
+    if (!ok) return;
+    
+    QString error;
+    if (!m_derivedFields.addExpression(name.trimmed(), expression, location == "点数据", &error)) {
+        QMessageBox::warning(this, "派生场", QString("无法添加派生场: %1").arg(error));
+        return;
+    }
+    
+    // 重新填充下拉框并保持当前选择（新派生场在选中时才计算）
+    QString currentText = m_dataComboBox->currentText();
+    m_dataComboBox->blockSignals(true);
+    populateDataComboBox();
+    int index = m_dataComboBox->findText(currentText);
+    m_dataComboBox->setCurrentIndex(index >= 0 ? index : 0);
+    m_dataComboBox->blockSignals(false);
+    
+    m_statusLabel->setText(QString("已添加派生场: %1 = %2").arg(name.trimmed()).arg(expression));
+}
+
+void MainWindow::onTraceToggled(bool enabled)
+{
+    TraceRecorder &recorder = TraceRecorder::instance();
+    if (enabled) {
+        recorder.start();
+        statusBar()->showMessage("正在记录性能追踪，再次点击菜单项结束并保存");
+        return;
+    }
+    
+    recorder.stop();
+    QString fileName = QFileDialog::getSaveFileName(this, "保存性能追踪", "trace.json",
+                                                    "Trace Event JSON (*.json)");
+    if (fileName.isEmpty()) {
+        statusBar()->showMessage("已放弃性能追踪记录", 3000);
+        return;
+    }
+    
+    QString error;
+    if (!recorder.writeJson(fileName, &error)) {
+        QMessageBox::warning(this, "性能追踪", QString("保存失败: %1").arg(error));
+        return;
+    }
+    statusBar()->showMessage(QString("已保存 %1 个追踪事件，可在 Perfetto (ui.perfetto.dev) 中打开")
+                                 .arg(recorder.eventCount()), 5000);
+}
+
+bool MainWindow::askExportSize(int *width, int *height)
+{
+    int *windowSize = m_renderWindow->GetSize();
+    QStringList presets;
+    presets << "1920x1080" << "3840x2160" << "7680x4320"
+            << QString("%1x%2").arg(windowSize[0] * 2).arg(windowSize[1] * 2);
+    
+    bool ok = false;
+    QString text = QInputDialog::getItem(this, "导出图像", "分辨率（宽x高，可直接输入）:",
+                                         presets, 1, true, &ok);
+    if (!ok) {
+        return false;
+    }
+    
+    QStringList parts = text.toLower().split('x');
+    if (parts.size() == 2) {
+        *width = parts[0].trimmed().toInt();
+        *height = parts[1].trimmed().toInt();
+    }
+    if (parts.size() != 2 || *width <= 0 || *height <= 0) {
+        QMessageBox::warning(this, "导出图像", QString("无效的分辨率: %1").arg(text));
+        return false;
+    }
+    return true;
+}
+
+void MainWindow::onExportScreenshot()
+{
+    TRACE_SCOPE("MainWindow::onExportScreenshot", "ui");
+    int width = 0;
+    int height = 0;
+    if (!askExportSize(&width, &height)) {
+        return;
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(this, "保存截图", "screenshot.png", "PNG 图像 (*.png)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    
+    statusBar()->showMessage(QString("正在渲染 %1x%2 ...").arg(width).arg(height));
+    m_imageExporter->exportImage(m_renderWindow, width, height, fileName);
     m_renderWindow->Render();
 }
 
+void MainWindow::onExportImageSequence()
+{
+    TRACE_SCOPE("MainWindow::onExportImageSequence", "ui");
+    int width = 0;
+    int height = 0;
+    if (!askExportSize(&width, &height)) {
+        return;
+    }
+    
+    bool ok = false;
+    int frameCount = QInputDialog::getInt(this, "旋转动画帧序列", "帧数（旋转一周）:", 72, 2, 3600, 1, &ok);
+    if (!ok) {
+        return;
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(this, "帧序列文件名前缀", "frame", "PNG 图像 (*.png)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (fileName.endsWith(".png", Qt::CaseInsensitive)) {
+        fileName.chop(4);
+    }
+    
+    QProgressDialog progress("正在渲染帧序列...", "取消", 0, frameCount, this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(0);
+    connect(m_imageExporter, &ImageExporter::frameRendered, &progress, &QProgressDialog::setValue);
+    connect(&progress, &QProgressDialog::canceled, m_imageExporter, &ImageExporter::cancel);
+    
+    int rendered = m_imageExporter->exportTurntable(m_renderWindow, m_renderer, width, height, frameCount, fileName);
+    
+    disconnect(m_imageExporter, &ImageExporter::frameRendered, &progress, &QProgressDialog::setValue);
+    statusBar()->showMessage(QString("已渲染 %1/%2 帧，后台编码中: %3_0000.png ...")
+                                 .arg(rendered).arg(frameCount).arg(fileName), 5000);
+}
+
+void MainWindow::onExportGeometry()
+{
+    TRACE_SCOPE("MainWindow::onExportGeometry", "ui");
+    if (m_geometryExporter->isRunning()) {
+        if (QMessageBox::question(this, "导出派生几何", "正在导出，是否取消？") == QMessageBox::Yes) {
+            m_geometryExporter->cancel();
+        }
+        return;
+    }
+    
+    // 只列出已经执行过、有输出的派生结果；读取输出对象不会触发管线执行
+    QList<QPair<QString, vtkAlgorithm *>> sources;
+    sources << qMakePair(QString("剖切结果"), m_clippingWidget->getOutputFilter())
+            << qMakePair(QString("等值面"), m_contourWidget->getOutputFilter())
+            << qMakePair(QString("变形图"), m_vectorFieldWidget->getWarpFilter())
+            << qMakePair(QString("流线"), m_vectorFieldWidget->getStreamTracer());
+    QStringList names;
+    QList<vtkDataSet *> outputs;
+    for (const auto &source : sources) {
+        vtkDataSet *output = source.second ? vtkDataSet::SafeDownCast(source.second->GetOutputDataObject(0)) : nullptr;
+        if (output && output->GetNumberOfPoints() > 0) {
+            names << QString("%1（%2 个点，%3 个单元）").arg(source.first)
+                         .arg(output->GetNumberOfPoints()).arg(output->GetNumberOfCells());
+            outputs << output;
+        }
+    }
+    if (outputs.isEmpty()) {
+        QMessageBox::information(this, "导出派生几何", "当前没有剖切、等值面、变形图或流线结果");
+        return;
+    }
+    
+    bool ok = false;
+    QString name = QInputDialog::getItem(this, "导出派生几何", "导出内容:", names, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+    vtkDataSet *output = outputs[names.indexOf(name)];
+    
+    QString fileName = QFileDialog::getSaveFileName(this, "保存派生几何", QString(),
+                                                    GeometryExporter::fileFilter(output));
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (!GeometryExporter::isSupportedFile(fileName)) {
+        fileName += vtkPolyData::SafeDownCast(output) ? ".vtp" : ".vtu";
+    }
+    
+    int compressionLevel = 0;
+    if (fileName.endsWith(".vtu", Qt::CaseInsensitive) || fileName.endsWith(".vtp", Qt::CaseInsensitive)) {
+        compressionLevel = QInputDialog::getInt(this, "导出派生几何", "压缩级别（0 不压缩，9 最小文件）:",
+                                                5, 0, 9, 1, &ok);
+        if (!ok) {
+            return;
+        }
+    }
+    
+    if (!m_geometryExporter->start(output, fileName, compressionLevel)) {
+        QMessageBox::warning(this, "导出派生几何", QString("无法导出到: %1").arg(fileName));
+        return;
+    }
+    m_exportProgressBar->setValue(0);
+    m_exportProgressBar->setVisible(true);
+    m_geometryExportAction->setText("取消派生几何导出");
+    statusBar()->showMessage(QString("正在后台导出: %1").arg(fileName));
+}
+
+void MainWindow::onGeometryExportFinished(const QString &fileName, bool ok, const QString &message)
+{
+    m_exportProgressBar->setVisible(false);
+    m_geometryExportAction->setText("导出派生几何...");
+    if (ok) {
+        statusBar()->showMessage(QString("已导出: %1").arg(fileName), 5000);
+    } else {
+        statusBar()->showMessage(QString("导出失败: %1 (%2)").arg(fileName).arg(message), 5000);
+    }
+}
+
+void MainWindow::onWatchToggled(bool enabled)
+{
+    TRACE_SCOPE("MainWindow::onWatchToggled", "ui");
+    if (enabled && !m_currentFileName.isEmpty() && m_currentDataType == DATA_TYPE_UNSTRUCTURED_GRID) {
+        m_resultWatcher->setCurrentData(m_currentData);
+        m_resultWatcher->start(m_currentFileName);
+        statusBar()->showMessage(QString("正在监视: %1 及所在目录中新的结果文件")
+                                 .arg(QFileInfo(m_currentFileName).fileName()), 5000);
+    } else {
+        m_resultWatcher->stop();
+        if (!enabled) {
+            statusBar()->showMessage("已停止监视结果文件", 3000);
+        }
+    }
+}
+
+void MainWindow::onResultReloaded(const ResultWatcher::Reload &reload)
+{
+    TRACE_SCOPE("MainWindow::onResultReloaded", "ui");
+    const QString shortName = QFileInfo(reload.fileName).fileName();
+    if (!reload.data) {
+        statusBar()->showMessage(QString("重新加载失败: %1 (%2)").arg(shortName).arg(reload.error), 5000);
+        return;
+    }
+    if (m_currentDataType != DATA_TYPE_UNSTRUCTURED_GRID || !m_currentData) {
+        return;
+    }
+
+    QString summary;
+    if (reload.topologyChanged) {
+        // 网格拓扑变化：整体替换数据集，相机与剖切、等值面、矢量面板的设置保持不变
+        m_currentData = reload.data;
+        m_derivedFields.setData(m_currentData);
+        m_surfaceExtractor.setData(m_currentData);
+        summary = reload.step >= 0 ? QString("时间步 %1 的网格与当前模型不同，已作为新模型加载: %2").arg(reload.step).arg(shortName)
+                                   : QString("网格已变化，已重新加载: %1").arg(shortName);
+    } else {
+        // 拓扑相同：只并入新增或内容有变化的数组（新的时间步）与点坐标
+        const int updated = ResultWatcher::merge(m_currentData, reload);
+        if (updated == 0) {
+            statusBar()->showMessage(QString("%1 的结果没有变化").arg(shortName), 3000);
+            return;
+        }
+        m_derivedFields.refresh();
+        summary = QString("已从 %1 更新 %2 个数组%3")
+                      .arg(shortName)
+                      .arg(reload.pointArrays.size() + reload.cellArrays.size() + reload.fieldArrays.size())
+                      .arg(reload.pointsChanged ? "及点坐标" : "");
+    }
+    m_resultWatcher->setCurrentData(m_currentData);
+    if (m_exactValues->isEnabled()) {
+        if (reload.topologyChanged) {
+            // 整个数据集换成了重新读取的文件，数组保持原名
+            m_exactValues->setFile(reload.fileName);
+        } else if (reload.step >= 0) {
+            // 新时间步只并入了 <名称>_t<步号> 数组，原有数组的精确值仍来自原文件
+            m_exactValues->setStepFile(reload.step, reload.fileName);
+        } else {
+            // 原文件被改写，丢弃缓存的精确值
+            m_exactValues->invalidate();
+        }
+    }
+    m_pipelineMonitor->record("重新加载", reload.readMs,
+                              static_cast<size_t>(reload.data->GetActualMemorySize()) * 1024);
+
+    // 重建数据下拉框并保持当前选中的数组
+    const QPair<QString, bool> selected = m_dataComboBox->currentData().value<QPair<QString, bool>>();
+    m_dataComboBox->blockSignals(true);
+    populateDataComboBox();
+    int index = 0;
+    for (int i = 0; i < m_dataComboBox->count(); ++i) {
+        if (m_dataComboBox->itemData(i).value<QPair<QString, bool>>() == selected) {
+            index = i;
+            break;
+        }
+    }
+    m_dataComboBox->setCurrentIndex(index);
+    m_dataComboBox->blockSignals(false);
+
+    // 沿用选择数组时的更新路径（各面板以原有设置重新执行），但不重置相机
+    m_preserveView = true;
+    onDataSelectionChanged(m_dataComboBox->currentText());
+    m_preserveView = false;
+
+    statusBar()->showMessage(summary, 5000);
+}
+
 void MainWindow::onPointPicked(const QString &info)
 {
+    TRACE_SCOPE("MainWindow::onPointPicked", "ui");
     statusBar()->showMessage(info);
 }
 
+void MainWindow::onHoverProbed(const QString &info)
+{
+    if (info.isEmpty()) {
+        statusBar()->clearMessage();
+    } else {
+        statusBar()->showMessage(info);
+    }
+}
+
 void MainWindow::onVTKWidgetMousePress(QMouseEvent *event)
 {
     if (m_dataPicker && m_dataPicker->isPickingEnabled()) {
@@ -880,6 +1645,7 @@ void MainWindow::setupGeometryVisualization()
 
 void MainWindow::onVectorVisualizationChanged()
 {
+    TRACE_SCOPE("MainWindow::onVectorVisualizationChanged", "ui");
     if (!m_vectorFieldWidget || !m_renderer) return;
     
     // 移除之前的矢量场演员
@@ -892,11 +1658,15 @@ void MainWindow::onVectorVisualizationChanged()
     if (m_vectorFieldWidget->getStreamlineActor()) {
         m_renderer->RemoveActor(m_vectorFieldWidget->getStreamlineActor());
     }
+    if (m_vectorFieldWidget->getParticleActor()) {
+        m_renderer->RemoveActor(m_vectorFieldWidget->getParticleActor());
+    }
     
-    // 检查是否启用了变形图或流线
+    // 检查是否启用了变形图、流线或粒子动画
     bool warpEnabled = m_vectorFieldWidget->property("warpEnabled").toBool();
     bool streamlineEnabled = m_vectorFieldWidget->property("streamlineEnabled").toBool();
-    bool vectorVisualizationActive = warpEnabled || streamlineEnabled;
+    bool particlesEnabled = m_vectorFieldWidget->property("particlesEnabled").toBool();
+    bool vectorVisualizationActive = warpEnabled || streamlineEnabled || particlesEnabled;
     
     if (vectorVisualizationActive) {
         // 启用矢量场可视化时，将主几何体透明度降低到10%
@@ -933,6 +1703,13 @@ void MainWindow::onVectorVisualizationChanged()
         }
     }
     
+    // 添加粒子
+    if (particlesEnabled) {
+        if (m_vectorFieldWidget->getParticleActor()) {
+            m_renderer->AddActor(m_vectorFieldWidget->getParticleActor());
+        }
+    }
+    
     // 更新透明度标签显示
     if (vectorVisualizationActive) {
         int currentValue = m_opacitySlider->value();
@@ -942,5 +1719,18 @@ void MainWindow::onVectorVisualizationChanged()
         m_opacityLabel->setText(QString("%1%").arg(currentValue));
     }
     
+    if (warpEnabled) m_memoryManager.touch("变形图");
+    if (streamlineEnabled) m_memoryManager.touch("流线");
+    enforceMemoryBudget();
+    
+    m_renderWindow->Render();
+}
+
+void MainWindow::onParticleFrameAdvanced(double advectionMs, int particleCount, int reinjectedCount)
+{
+    statusBar()->showMessage(QString("粒子: %1 | 平流耗时: %2 ms | 重新注入: %3")
+                             .arg(particleCount)
+                             .arg(advectionMs, 0, 'f', 2)
+                             .arg(reinjectedCount));
     m_renderWindow->Render();
-}
\ No newline at end of file
+}
@@ -18,11 +18,6 @@
 #include <vtkGenericOpenGLRenderWindow.h>
 #include <vtkRenderer.h>
 #include <vtkRenderWindowInteractor.h>
-#include <vtkXMLUnstructuredGridReader.h>
-#include <vtkUnstructuredGridReader.h>
-#include <vtkSTLReader.h>
-#include <vtkOBJReader.h>
-#include <vtkPLYReader.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkPolyData.h>
 #include <vtkDataSetMapper.h>
@@ -44,12 +39,30 @@
 #include <vtkColorSeries.h>
 #include <QDockWidget>
 #include <QStatusBar>
+#include <QProgressBar>
 
 // 包含功能模块
 #include "visualization/ClippingWidget.h"
 #include "visualization/ContourWidget.h"
 #include "visualization/VectorFieldWidget.h"
+#include "visualization/ColorMaps.h"
+#include "visualization/ImageExporter.h"
 #include "interaction/DataPicker.h"
+#include "interaction/SelectionWidget.h"
+#include "visualization/LineProbeWidget.h"
+#include "interaction/QueryWidget.h"
+#include "interaction/PipelineInspectorWidget.h"
+#include "core/SpatialIndex.h"
+#include "core/MemoryManager.h"
+#include "core/PipelineMonitor.h"
+#include "core/GeometryExporter.h"
+#include "core/MeshReorderer.h"
+#include "core/SurfaceExtractor.h"
+#include "core/PrecisionReducer.h"
+#include "io/ResultWatcher.h"
+#include "io/ExactValueSource.h"
+#include "io/BrickStore.h"
+#include "analysis/DerivedFieldRegistry.h"
 
 class MainWindow : public QMainWindow
 {
@@ -68,7 +81,21 @@ private slots:
     void onClippingChanged();
     void onContoursChanged();
     void onVectorVisualizationChanged();
+    void onSelectionChanged();
+    void onProbeLineChanged();
+    void onQueryResultChanged();
+    void onAddDerivedField();
+    void onMemoryBudget();
+    void onTraceToggled(bool enabled);
+    void onExportScreenshot();
+    void onExportImageSequence();
+    void onExportGeometry();
+    void onGeometryExportFinished(const QString &fileName, bool ok, const QString &message);
+    void onWatchToggled(bool enabled);
+    void onResultReloaded(const ResultWatcher::Reload &reload);
+    void onParticleFrameAdvanced(double advectionMs, int particleCount, int reinjectedCount);
     void onPointPicked(const QString &info);
+    void onHoverProbed(const QString &info);
     void onVTKWidgetMousePress(QMouseEvent *event);
 
 private:
@@ -83,6 +110,10 @@ private:
     void updateDisplayMode();
     void updateAdvancedFeatures();
     void setupGeometryVisualization();
+    void addOverlayActors();
+    void setupMemoryStages();
+    void enforceMemoryBudget();
+    bool askExportSize(int *width, int *height);
 
     // UI组件
     QPushButton *m_openFileButton;
@@ -97,11 +128,6 @@ private:
     // VTK组件
     vtkSmartPointer<vtkGenericOpenGLRenderWindow> m_renderWindow;
     vtkSmartPointer<vtkRenderer> m_renderer;
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> m_xmlReader;
-    vtkSmartPointer<vtkUnstructuredGridReader> m_legacyReader;
-    vtkSmartPointer<vtkSTLReader> m_stlReader;
-    vtkSmartPointer<vtkOBJReader> m_objReader;
-    vtkSmartPointer<vtkPLYReader> m_plyReader;
     vtkSmartPointer<vtkPolyDataMapper> m_geometryMapper;
     vtkSmartPointer<vtkDataSetMapper> m_mapper;
     vtkSmartPointer<vtkDataSetMapper> m_wireframeMapper;
@@ -117,14 +143,37 @@ private:
     ContourWidget *m_contourWidget;
     VectorFieldWidget *m_vectorFieldWidget;
     DataPicker *m_dataPicker;
+    SelectionWidget *m_selectionWidget;
+    LineProbeWidget *m_lineProbeWidget;
+    QueryWidget *m_queryWidget;
+    PipelineInspectorWidget *m_inspectorWidget;
+    PipelineMonitor *m_pipelineMonitor;
+    SpatialIndex *m_spatialIndex;
+    ImageExporter *m_imageExporter;
+    GeometryExporter *m_geometryExporter;
+    QProgressBar *m_exportProgressBar;
+    ResultWatcher *m_resultWatcher;
+    ExactValueSource *m_exactValues;
     
     // 停靠窗口
     QDockWidget *m_clippingDock;
     QDockWidget *m_contourDock;
     QDockWidget *m_vectorFieldDock;
+    QDockWidget *m_selectionDock;
+    QDockWidget *m_lineProbeDock;
+    QDockWidget *m_queryDock;
+    QDockWidget *m_inspectorDock;
     
     // 菜单项
     QAction *m_pickingAction;
+    QAction *m_hoverProbeAction;
+    QAction *m_derivedFieldAction;
+    QAction *m_memoryBudgetAction;
+    QAction *m_traceAction;
+    QAction *m_screenshotAction;
+    QAction *m_imageSequenceAction;
+    QAction *m_geometryExportAction;
+    QAction *m_watchAction;
 
     // 数据类型枚举
     enum DataType {
@@ -134,11 +183,20 @@ private:
     };
     
     // 数据
+    DerivedFieldRegistry m_derivedFields;
+    SurfaceExtractor m_surfaceExtractor;   // 主视图绘制的外表面（按单元类型选择提取路径）
+    BrickStore m_brickStore;               // 分块模型的索引与块缓存（打开 .fembricks 时）
+    MemoryManager m_memoryManager;
     vtkSmartPointer<vtkUnstructuredGrid> m_currentData;
     vtkSmartPointer<vtkPolyData> m_currentGeometryData;
     QString m_currentFileName;
     QString m_currentDataArrayName;
+    QString m_currentScalarArrayName;   // 实际着色的标量数组（矢量对应其缓存的模数组）
     DataType m_currentDataType;
+    bool m_preserveView;                // 重新加载时保留相机，不调用 resetView
+    MeshReorderer::Method m_reorderMethod;  // 打开文件后的网格重排方式
+    PrecisionReducer::Mode m_precisionMode; // 打开文件后的数据精度
+    QStringList m_fullPrecisionArrays;      // 降精度加载时保持原样的数组
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
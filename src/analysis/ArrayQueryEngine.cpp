@@ -0,0 +1,143 @@
+#include "ArrayQueryEngine.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vtkSMPTools.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+ArrayQueryEngine::ArrayQueryEngine()
+{
+}
+
+void ArrayQueryEngine::clear()
+{
+    m_indices.clear();
+}
+
+size_t ArrayQueryEngine::memorySize() const
+{
+    size_t bytes = 0;
+    for (const auto &entry : m_indices) {
+        bytes += entry.second->keys.capacity() * sizeof(double) + entry.second->ids.capacity() * sizeof(vtkIdType);
+    }
+    return bytes;
+}
+
+const ArrayQueryEngine::SortedIndex &ArrayQueryEngine::index(vtkDataArray *array, bool isPointData, bool &built)
+{
+    // 数组已被释放的索引不会再命中，先丢弃
+    for (auto it = m_indices.begin(); it != m_indices.end();) {
+        if (!it->second->array) {
+            it = m_indices.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const std::pair<std::string, bool> key(array->GetName() ? array->GetName() : "", isPointData);
+    std::unique_ptr<SortedIndex> &entry = m_indices[key];
+    built = false;
+    // 同名数组被替换后地址不同（地址相同则仍是同一对象，弱指针保证不会是被释放后复用的地址）
+    if (entry && entry->array == array && entry->buildTime >= array->GetMTime()) {
+        return *entry;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 并行计算键值（矢量取模），再并行排序 (值, ID) 对
+    const vtkIdType numTuples = array->GetNumberOfTuples();
+    const int components = array->GetNumberOfComponents();
+    std::vector<std::pair<double, vtkIdType>> pairs(numTuples);
+
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i) {
+            double key = 0.0;
+            if (components == 1) {
+                key = array->GetComponent(i, 0);
+            } else {
+                for (int c = 0; c < components; ++c) {
+                    const double v = array->GetComponent(i, c);
+                    key += v * v;
+                }
+                key = std::sqrt(key);
+            }
+            pairs[i] = std::make_pair(key, i);
+        }
+    });
+
+    // NaN 无法参与比较，排序前移除
+    pairs.erase(std::remove_if(pairs.begin(), pairs.end(),
+                               [](const std::pair<double, vtkIdType> &p) { return std::isnan(p.first); }),
+                pairs.end());
+    vtkSMPTools::Sort(pairs.begin(), pairs.end());
+
+    // 替换同一数组的旧索引
+    entry.reset(new SortedIndex());
+    entry->array = array;
+    entry->keys.resize(pairs.size());
+    entry->ids.resize(pairs.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(pairs.size()), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i) {
+            entry->keys[i] = pairs[i].first;
+            entry->ids[i] = pairs[i].second;
+        }
+    });
+    entry->buildTime = array->GetMTime();
+    built = true;
+
+    qDebug() << "ArrayQueryEngine: 为数组" << array->GetName() << "构建有序索引，元素数:" << numTuples
+             << "耗时(ms):" << timer.elapsed();
+    return *entry;
+}
+
+ArrayQueryEngine::Result ArrayQueryEngine::topK(vtkDataArray *array, bool isPointData, int k, bool largest)
+{
+    TRACE_SCOPE("ArrayQueryEngine::topK", "compute");
+    Result result;
+    if (!array || k <= 0) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const SortedIndex &sorted = index(array, isPointData, result.indexBuilt);
+    const size_t count = std::min(static_cast<size_t>(k), sorted.keys.size());
+    result.ids.resize(count);
+    result.values.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t source = largest ? sorted.keys.size() - 1 - i : i;
+        result.ids[i] = sorted.ids[source];
+        result.values[i] = sorted.keys[source];
+    }
+
+    result.elapsedMs = timer.nsecsElapsed() / 1.0e6;
+    return result;
+}
+
+ArrayQueryEngine::Result ArrayQueryEngine::range(vtkDataArray *array, bool isPointData, double lower, double upper)
+{
+    TRACE_SCOPE("ArrayQueryEngine::range", "compute");
+    Result result;
+    if (!array || lower > upper) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const SortedIndex &sorted = index(array, isPointData, result.indexBuilt);
+    auto first = std::lower_bound(sorted.keys.begin(), sorted.keys.end(), lower);
+    auto last = std::upper_bound(first, sorted.keys.end(), upper);
+    const size_t begin = first - sorted.keys.begin();
+    const size_t end = last - sorted.keys.begin();
+
+    result.ids.assign(sorted.ids.begin() + begin, sorted.ids.begin() + end);
+    result.values.assign(first, last);
+
+    result.elapsedMs = timer.nsecsElapsed() / 1.0e6;
+    return result;
+}
@@ -0,0 +1,55 @@
+#ifndef ARRAYQUERYENGINE_H
+#define ARRAYQUERYENGINE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vtkType.h>
+#include <vtkDataArray.h>
+#include <vtkWeakPointer.h>
+
+// 数组查询引擎：对每个数组构建一次按值排序的索引，
+// 之后的 Top-K 与阈值/范围查询都是对有序索引的二分与切片。
+// 索引按数组名与位置（点/单元）缓存，每个数组只保留一份：数组被替换（重新加载、派生场释放后重算）
+// 或内容修改后重建并替换旧索引，数组已被释放的索引在下次查询时丢弃
+class ArrayQueryEngine
+{
+public:
+    struct Result
+    {
+        std::vector<vtkIdType> ids;    // 命中的点/单元ID
+        std::vector<double> values;    // 对应数值（矢量取模）
+        double elapsedMs = 0.0;
+        bool indexBuilt = false;       // 本次查询是否触发了索引构建
+    };
+
+    ArrayQueryEngine();
+
+    // 最大（或最小）的 k 个元素，按数值从极端到一般排序
+    Result topK(vtkDataArray *array, bool isPointData, int k, bool largest);
+
+    // 数值位于 [lower, upper] 的全部元素，按数值升序
+    Result range(vtkDataArray *array, bool isPointData, double lower, double upper);
+
+    void clear();
+    // 各索引占用的内存（字节），释放后在下次查询时重建
+    size_t memorySize() const;
+
+private:
+    struct SortedIndex
+    {
+        vtkWeakPointer<vtkDataArray> array;  // 构建索引的数组，被释放后为空
+        vtkMTimeType buildTime = 0;
+        std::vector<double> keys;       // 升序，已剔除 NaN
+        std::vector<vtkIdType> ids;
+    };
+
+    const SortedIndex &index(vtkDataArray *array, bool isPointData, bool &built);
+
+    std::map<std::pair<std::string, bool>, std::unique_ptr<SortedIndex>> m_indices;
+};
+
+#endif // ARRAYQUERYENGINE_H
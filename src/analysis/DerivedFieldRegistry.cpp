@@ -0,0 +1,538 @@
+#include "DerivedFieldRegistry.h"
+#include "core/SpatialIndex.h"
+#include "core/MeshReorderer.h"
+#include "core/PrecisionReducer.h"
+#include "core/TraceRecorder.h"
+#include "ExpressionEvaluator.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vtkSMPTools.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const vtkIdType BLOCK_SIZE = 1024;
+
+// 按块把张量拆成六个分量数组（SoA），9分量张量取对称部分
+// 对称张量分量顺序沿用VTK约定：XX, YY, ZZ, XY, YZ, XZ
+void loadTensorBlock(vtkDataArray *tensor, vtkIdType begin, vtkIdType count, double s[6][BLOCK_SIZE])
+{
+    const int components = tensor->GetNumberOfComponents();
+    double t[9];
+    for (vtkIdType i = 0; i < count; ++i) {
+        tensor->GetTuple(begin + i, t);
+        if (components == 6) {
+            for (int c = 0; c < 6; ++c) {
+                s[c][i] = t[c];
+            }
+        } else {
+            s[0][i] = t[0];
+            s[1][i] = t[4];
+            s[2][i] = t[8];
+            s[3][i] = 0.5 * (t[1] + t[3]);
+            s[4][i] = 0.5 * (t[5] + t[7]);
+            s[5][i] = 0.5 * (t[2] + t[6]);
+        }
+    }
+}
+
+struct VonMisesFunctor
+{
+    vtkDataArray *Tensor;
+    double *Output;
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+        double s[6][BLOCK_SIZE];
+        for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+            const vtkIdType n = std::min(BLOCK_SIZE, end - blockBegin);
+            loadTensorBlock(Tensor, blockBegin, n, s);
+
+            double *out = Output + blockBegin;
+            for (vtkIdType i = 0; i < n; ++i) {
+                const double d1 = s[0][i] - s[1][i];
+                const double d2 = s[1][i] - s[2][i];
+                const double d3 = s[2][i] - s[0][i];
+                const double shear = s[3][i] * s[3][i] + s[4][i] * s[4][i] + s[5][i] * s[5][i];
+                out[i] = std::sqrt(0.5 * (d1 * d1 + d2 * d2 + d3 * d3) + 3.0 * shear);
+            }
+        }
+    }
+};
+
+// 主应力：每个元组做一次3x3对称矩阵的闭式特征值求解，只写出需要的量（为空的输出跳过）
+struct PrincipalFunctor
+{
+    vtkDataArray *Tensor;
+    double *Principal1;
+    double *Principal2;
+    double *Principal3;
+    double *Tresca;
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+        double s[6][BLOCK_SIZE];
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+        Eigen::Matrix3d m;
+
+        for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+            const vtkIdType n = std::min(BLOCK_SIZE, end - blockBegin);
+            loadTensorBlock(Tensor, blockBegin, n, s);
+
+            for (vtkIdType i = 0; i < n; ++i) {
+                m << s[0][i], s[3][i], s[5][i],
+                     s[3][i], s[1][i], s[4][i],
+                     s[5][i], s[4][i], s[2][i];
+                solver.computeDirect(m, Eigen::EigenvaluesOnly);
+                const Eigen::Vector3d &ev = solver.eigenvalues(); // 升序
+
+                const vtkIdType id = blockBegin + i;
+                if (Principal1) Principal1[id] = ev(2);
+                if (Principal2) Principal2[id] = ev(1);
+                if (Principal3) Principal3[id] = ev(0);
+                if (Tresca) Tresca[id] = ev(2) - ev(0);
+            }
+        }
+    }
+};
+
+// 矢量模：AOS 浮点数组按块拆成分量后做紧凑循环，便于自动向量化
+template <typename T>
+void splitVectorBlock(const T *data, vtkIdType count, double *x, double *y, double *z)
+{
+    for (vtkIdType i = 0; i < count; ++i) {
+        x[i] = static_cast<double>(data[3 * i]);
+        y[i] = static_cast<double>(data[3 * i + 1]);
+        z[i] = static_cast<double>(data[3 * i + 2]);
+    }
+}
+
+// Component 为 -1 时输出模，否则输出该分量
+struct VectorFunctor
+{
+    vtkDataArray *Vectors;
+    double *Output;
+    int Component;
+
+    void operator()(vtkIdType begin, vtkIdType end) const
+    {
+        vtkFloatArray *floats = vtkFloatArray::FastDownCast(Vectors);
+        vtkDoubleArray *doubles = vtkDoubleArray::FastDownCast(Vectors);
+
+        if (Component >= 0) {
+            for (vtkIdType i = begin; i < end; ++i) {
+                Output[i] = floats ? static_cast<double>(floats->GetPointer(0)[3 * i + Component])
+                          : doubles ? doubles->GetPointer(0)[3 * i + Component]
+                                    : Vectors->GetComponent(i, Component);
+            }
+            return;
+        }
+
+        double x[BLOCK_SIZE];
+        double y[BLOCK_SIZE];
+        double z[BLOCK_SIZE];
+        for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+            const vtkIdType n = std::min(BLOCK_SIZE, end - blockBegin);
+
+            if (floats) {
+                splitVectorBlock(floats->GetPointer(3 * blockBegin), n, x, y, z);
+            } else if (doubles) {
+                splitVectorBlock(doubles->GetPointer(3 * blockBegin), n, x, y, z);
+            } else {
+                for (vtkIdType i = 0; i < n; ++i) {
+                    x[i] = Vectors->GetComponent(blockBegin + i, 0);
+                    y[i] = Vectors->GetComponent(blockBegin + i, 1);
+                    z[i] = Vectors->GetComponent(blockBegin + i, 2);
+                }
+            }
+
+            double *magnitude = Output + blockBegin;
+            for (vtkIdType i = 0; i < n; ++i) {
+                magnitude[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+            }
+        }
+    }
+};
+
+vtkSmartPointer<vtkDoubleArray> newOutputArray(const QString &name, vtkIdType numTuples)
+{
+    vtkSmartPointer<vtkDoubleArray> array = vtkSmartPointer<vtkDoubleArray>::New();
+    array->SetName(name.toUtf8().constData());
+    array->SetNumberOfComponents(1);
+    array->SetNumberOfTuples(numTuples);
+    return array;
+}
+} // namespace
+
+DerivedFieldRegistry::DerivedFieldRegistry()
+    : m_data(nullptr)
+    , m_spatialIndex(nullptr)
+{
+}
+
+void DerivedFieldRegistry::setData(vtkUnstructuredGrid *data)
+{
+    m_data = data;
+    m_fields.clear();
+
+    if (m_data) {
+        registerBuiltins(true);
+        registerBuiltins(false);
+    }
+}
+
+void DerivedFieldRegistry::refresh()
+{
+    if (m_data) {
+        registerBuiltins(true);
+        registerBuiltins(false);
+    }
+}
+
+void DerivedFieldRegistry::addBuiltin(const QString &name, Kind kind, bool isPointData,
+                                      const QString &source, const QString &description)
+{
+    // 与已有数组同名时不登记，避免覆盖原始结果
+    if (findArray(name, isPointData) || contains(name, isPointData)) {
+        return;
+    }
+
+    Field field;
+    field.name = name;
+    field.kind = kind;
+    field.isPointData = isPointData;
+    field.expression = description;
+    field.inputs << source;
+    m_fields.push_back(field);
+}
+
+void DerivedFieldRegistry::registerBuiltins(bool isPointData)
+{
+    vtkFieldData *fields = isPointData ? static_cast<vtkFieldData *>(m_data->GetPointData())
+                                       : static_cast<vtkFieldData *>(m_data->GetCellData());
+
+    for (int i = 0; i < fields->GetNumberOfArrays(); ++i) {
+        vtkDataArray *array = fields->GetArray(i);
+        if (!array || !array->GetName() || MeshReorderer::isIdMapArray(array->GetName())) {
+            continue;
+        }
+
+        const QString name = QString::fromUtf8(array->GetName());
+        const int components = array->GetNumberOfComponents();
+
+        if (components == 6 || components == 9) {
+            addBuiltin(name + "_VonMises", KIND_VON_MISES, isPointData, name, "Von Mises 等效应力");
+            addBuiltin(name + "_Principal1", KIND_PRINCIPAL_1, isPointData, name, "最大主应力");
+            addBuiltin(name + "_Principal2", KIND_PRINCIPAL_2, isPointData, name, "中间主应力");
+            addBuiltin(name + "_Principal3", KIND_PRINCIPAL_3, isPointData, name, "最小主应力");
+            addBuiltin(name + "_Tresca", KIND_TRESCA, isPointData, name, "Tresca 应力");
+        } else if (components == 3) {
+            addBuiltin(magnitudeName(name), KIND_MAGNITUDE, isPointData, name, "矢量模");
+            addBuiltin(name + "_X", KIND_COMPONENT_X, isPointData, name, "X分量");
+            addBuiltin(name + "_Y", KIND_COMPONENT_Y, isPointData, name, "Y分量");
+            addBuiltin(name + "_Z", KIND_COMPONENT_Z, isPointData, name, "Z分量");
+        }
+
+        // 单元结果的节点平均，可用于等值面、流线等只接受点数据的功能
+        if (!isPointData && m_spatialIndex && components <= 9) {
+            addBuiltin(name + "_Nodal", KIND_NODAL_AVERAGE, true, name, "单元值节点平均");
+        }
+    }
+
+    // 量化后移出点/单元数据的标量数组，以原名登记，节点平均以解码结果为输入
+    for (const QString &name : PrecisionReducer::quantizedNames(m_data, isPointData)) {
+        addBuiltin(name, KIND_DEQUANTIZE, isPointData, name, "16位量化");
+        if (!isPointData && m_spatialIndex) {
+            addBuiltin(name + "_Nodal", KIND_NODAL_AVERAGE, true, name, "单元值节点平均");
+        }
+    }
+}
+
+int DerivedFieldRegistry::find(const QString &name, bool isPointData) const
+{
+    for (size_t i = 0; i < m_fields.size(); ++i) {
+        if (m_fields[i].name == name && m_fields[i].isPointData == isPointData) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+vtkDataArray *DerivedFieldRegistry::findArray(const QString &name, bool isPointData) const
+{
+    if (!m_data) {
+        return nullptr;
+    }
+    QByteArray utf8 = name.toUtf8();
+    return isPointData ? m_data->GetPointData()->GetArray(utf8.constData())
+                       : m_data->GetCellData()->GetArray(utf8.constData());
+}
+
+bool DerivedFieldRegistry::addExpression(const QString &name, const QString &expression, bool isPointData, QString *error)
+{
+    if (!m_data) {
+        if (error) *error = "尚未加载数据";
+        return false;
+    }
+    if (name.trimmed().isEmpty()) {
+        if (error) *error = "名称不能为空";
+        return false;
+    }
+    if (contains(name, isPointData) || findArray(name, isPointData)) {
+        if (error) *error = QString("已存在名为 %1 的数组").arg(name);
+        return false;
+    }
+
+    ExpressionEvaluator evaluator;
+    if (!evaluator.compile(expression)) {
+        if (error) *error = evaluator.errorMessage();
+        return false;
+    }
+
+    // 引用的必须是同一位置上已有的数组或已登记的派生场
+    for (const QString &input : evaluator.variableNames()) {
+        if (!findArray(input, isPointData) && !contains(input, isPointData)) {
+            if (error) *error = QString("%1中找不到数组 %2").arg(isPointData ? "点数据" : "单元数据").arg(input);
+            return false;
+        }
+    }
+
+    Field field;
+    field.name = name;
+    field.kind = KIND_EXPRESSION;
+    field.isPointData = isPointData;
+    field.expression = expression;
+    field.inputs = evaluator.variableNames();
+    m_fields.push_back(field);
+
+    qDebug() << "DerivedFieldRegistry: 登记派生场" << name << "=" << expression;
+    return true;
+}
+
+bool DerivedFieldRegistry::inputIsPointData(const Field &field)
+{
+    return field.kind == KIND_NODAL_AVERAGE ? false : field.isPointData;
+}
+
+vtkMTimeType DerivedFieldRegistry::inputTime(const Field &field) const
+{
+    if (field.kind == KIND_DEQUANTIZE) {
+        vtkDataArray *quantized = PrecisionReducer::quantizedArray(m_data, field.name, field.isPointData);
+        return quantized ? quantized->GetMTime() : 0;
+    }
+    vtkMTimeType time = 0;
+    for (const QString &input : field.inputs) {
+        if (vtkDataArray *array = findArray(input, inputIsPointData(field))) {
+            time = std::max(time, array->GetMTime());
+        }
+    }
+    return time;
+}
+
+vtkDataArray *DerivedFieldRegistry::materialize(const QString &name, bool isPointData, QString *error)
+{
+    TRACE_SCOPE("DerivedFieldRegistry::materialize", "compute");
+    const int index = find(name, isPointData);
+    if (index < 0) {
+        return findArray(name, isPointData);
+    }
+
+    // 输入本身是派生场时先计算输入（量化数组的输入是 FieldData 中的同名量化数组）
+    const bool inputPointData = inputIsPointData(m_fields[index]);
+    for (const QString &input : m_fields[index].inputs) {
+        if (m_fields[index].kind != KIND_DEQUANTIZE && contains(input, inputPointData)
+            && !materialize(input, inputPointData, error)) {
+            return nullptr;
+        }
+    }
+
+    Field &field = m_fields[index];
+    const vtkMTimeType currentInputTime = inputTime(field);
+    vtkDataArray *existing = findArray(field.name, isPointData);
+    if (existing && field.evaluatedInputTime >= currentInputTime) {
+        return existing; // 缓存命中
+    }
+    if (existing && field.evaluatedInputTime == 0) {
+        // 登记后数据集中出现了同名的原始数组（如重新加载合并进来的结果），不覆盖
+        return existing;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    vtkDataArray *source = findArray(field.inputs.value(0), inputPointData);
+    const vtkIdType numTuples = isPointData ? m_data->GetNumberOfPoints() : m_data->GetNumberOfCells();
+    vtkFieldData *target = isPointData ? static_cast<vtkFieldData *>(m_data->GetPointData())
+                                       : static_cast<vtkFieldData *>(m_data->GetCellData());
+
+    switch (field.kind) {
+    case KIND_VON_MISES: {
+        vtkSmartPointer<vtkDoubleArray> output = newOutputArray(field.name, numTuples);
+        VonMisesFunctor functor{source, output->GetPointer(0)};
+        vtkSMPTools::For(0, numTuples, BLOCK_SIZE * 16, functor);
+        target->AddArray(output);
+        break;
+    }
+    case KIND_PRINCIPAL_1:
+    case KIND_PRINCIPAL_2:
+    case KIND_PRINCIPAL_3:
+    case KIND_TRESCA:
+        // 只计算选中的量，同一张量的其他派生场按需另行计算，不覆盖文件中的同名数组
+        if (!evaluateTensorField(field, source)) {
+            if (error) *error = QString("无法计算 %1").arg(field.name);
+            return nullptr;
+        }
+        break;
+    case KIND_MAGNITUDE:
+    case KIND_COMPONENT_X:
+    case KIND_COMPONENT_Y:
+    case KIND_COMPONENT_Z:
+        // 只生成选中的模或分量，不覆盖文件中的同名数组
+        if (!evaluateVectorField(field, source)) {
+            if (error) *error = QString("无法计算 %1").arg(field.name);
+            return nullptr;
+        }
+        break;
+    case KIND_NODAL_AVERAGE:
+        if (!evaluateNodalAverage(field, source)) {
+            if (error) *error = QString("无法计算 %1（拓扑表不可用）").arg(field.name);
+            return nullptr;
+        }
+        break;
+    case KIND_DEQUANTIZE: {
+        vtkSmartPointer<vtkFloatArray> output = PrecisionReducer::dequantize(m_data, field.name, isPointData);
+        if (!output) {
+            if (error) *error = QString("找不到量化数组 %1").arg(field.name);
+            return nullptr;
+        }
+        target->AddArray(output);
+        break;
+    }
+    case KIND_EXPRESSION: {
+        ExpressionEvaluator evaluator;
+        evaluator.compile(field.expression);
+        std::vector<vtkDataArray *> variables;
+        for (const QString &input : field.inputs) {
+            variables.push_back(findArray(input, isPointData));
+        }
+        vtkSmartPointer<vtkDoubleArray> output = newOutputArray(field.name, numTuples);
+        if (!evaluator.evaluate(variables, output)) {
+            if (error) *error = QString("表达式 %1 求值失败（数组缺失、长度不一致或分量下标越界）").arg(field.expression);
+            return nullptr;
+        }
+        target->AddArray(output);
+        break;
+    }
+    }
+
+    field.evaluatedInputTime = currentInputTime;
+    qDebug() << "DerivedFieldRegistry: 计算派生场" << field.name << "元素数:" << numTuples
+             << "耗时(ms):" << timer.elapsed();
+    return findArray(field.name, isPointData);
+}
+
+size_t DerivedFieldRegistry::materializedBytes() const
+{
+    size_t total = 0;
+    for (const Field &field : m_fields) {
+        if (field.evaluatedInputTime == 0) {
+            continue;
+        }
+        if (vtkDataArray *array = findArray(field.name, field.isPointData)) {
+            total += static_cast<size_t>(array->GetActualMemorySize()) * 1024;
+        }
+    }
+    return total;
+}
+
+void DerivedFieldRegistry::releaseMaterialized(const QStringList &keepNames)
+{
+    // 正在使用的派生场及其派生输入保留
+    for (Field &field : m_fields) {
+        if (field.evaluatedInputTime == 0 || keepNames.contains(field.name)) {
+            continue;
+        }
+        bool usedAsInput = false;
+        for (const Field &other : m_fields) {
+            if (keepNames.contains(other.name) && other.inputs.contains(field.name)) {
+                usedAsInput = true;
+                break;
+            }
+        }
+        if (usedAsInput) {
+            continue;
+        }
+
+        QByteArray utf8 = field.name.toUtf8();
+        if (field.isPointData) {
+            m_data->GetPointData()->RemoveArray(utf8.constData());
+        } else {
+            m_data->GetCellData()->RemoveArray(utf8.constData());
+        }
+        field.evaluatedInputTime = 0;
+    }
+}
+
+bool DerivedFieldRegistry::evaluateTensorField(const Field &field, vtkDataArray *tensor)
+{
+    if (!tensor) {
+        return false;
+    }
+
+    vtkSmartPointer<vtkDoubleArray> output = newOutputArray(field.name, tensor->GetNumberOfTuples());
+    double *values = output->GetPointer(0);
+    PrincipalFunctor functor{tensor,
+                             field.kind == KIND_PRINCIPAL_1 ? values : nullptr,
+                             field.kind == KIND_PRINCIPAL_2 ? values : nullptr,
+                             field.kind == KIND_PRINCIPAL_3 ? values : nullptr,
+                             field.kind == KIND_TRESCA ? values : nullptr};
+    vtkSMPTools::For(0, tensor->GetNumberOfTuples(), BLOCK_SIZE * 16, functor);
+
+    vtkFieldData *target = field.isPointData ? static_cast<vtkFieldData *>(m_data->GetPointData())
+                                             : static_cast<vtkFieldData *>(m_data->GetCellData());
+    target->AddArray(output);
+    return true;
+}
+
+bool DerivedFieldRegistry::evaluateVectorField(const Field &field, vtkDataArray *vectors)
+{
+    if (!vectors || vectors->GetNumberOfComponents() != 3) {
+        return false;
+    }
+
+    const int component = field.kind == KIND_COMPONENT_X ? 0
+                        : field.kind == KIND_COMPONENT_Y ? 1
+                        : field.kind == KIND_COMPONENT_Z ? 2 : -1;
+    vtkSmartPointer<vtkDoubleArray> output = newOutputArray(field.name, vectors->GetNumberOfTuples());
+    VectorFunctor functor{vectors, output->GetPointer(0), component};
+    vtkSMPTools::For(0, vectors->GetNumberOfTuples(), BLOCK_SIZE * 16, functor);
+
+    vtkFieldData *target = field.isPointData ? static_cast<vtkFieldData *>(m_data->GetPointData())
+                                             : static_cast<vtkFieldData *>(m_data->GetCellData());
+    target->AddArray(output);
+    return true;
+}
+
+bool DerivedFieldRegistry::evaluateNodalAverage(const Field &field, vtkDataArray *cellArray)
+{
+    if (!m_spatialIndex || !cellArray) {
+        return false;
+    }
+    // 拓扑表与定位器共用同一份数据集
+    m_spatialIndex->setData(m_data);
+    std::shared_ptr<const MeshTopology> topology = m_spatialIndex->topology();
+    if (!topology || topology->numberOfPoints() != m_data->GetNumberOfPoints()) {
+        return false;
+    }
+
+    vtkSmartPointer<vtkDoubleArray> output = topology->cellToPoint(cellArray);
+    output->SetName(field.name.toUtf8().constData());
+    m_data->GetPointData()->AddArray(output);
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef DERIVEDFIELDREGISTRY_H
+#define DERIVEDFIELDREGISTRY_H
+
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataArray.h>
+
+class SpatialIndex;
+
+// 派生场注册表：登记由已有点/单元数组计算得到的场（张量等效应力、主应力、表达式等）
+// 派生场在首次被选中时才计算并加入数据集，输入数组修改后自动重算，否则直接复用
+class DerivedFieldRegistry
+{
+public:
+    enum Kind {
+        KIND_VON_MISES,
+        KIND_PRINCIPAL_1,   // 最大主应力
+        KIND_PRINCIPAL_2,
+        KIND_PRINCIPAL_3,   // 最小主应力
+        KIND_TRESCA,        // σ1 - σ3
+        KIND_MAGNITUDE,
+        KIND_COMPONENT_X,
+        KIND_COMPONENT_Y,
+        KIND_COMPONENT_Z,
+        KIND_NODAL_AVERAGE, // 单元数组的节点平均（点数据，输入为单元数据）
+        KIND_DEQUANTIZE,    // 降精度加载时量化为 16 位的数组，选中时解码为 float32
+        KIND_EXPRESSION
+    };
+
+    struct Field
+    {
+        QString name;
+        Kind kind;
+        bool isPointData;
+        QString expression;     // 内置派生场为说明文字
+        QStringList inputs;
+        vtkMTimeType evaluatedInputTime = 0;
+    };
+
+    DerivedFieldRegistry();
+
+    // 节点平均派生场使用其共享的拓扑表（点→单元），未设置时不登记该类派生场
+    void setSpatialIndex(SpatialIndex *spatialIndex) { m_spatialIndex = spatialIndex; }
+
+    // 切换数据集：清空已登记的派生场，并为张量（6/9分量）和矢量数组以及量化数组登记内置派生场
+    void setData(vtkUnstructuredGrid *data);
+    // 数据集增加数组后（结果文件重新加载）为新的张量/矢量数组登记内置派生场，保留已登记的派生场
+    void refresh();
+
+    // 登记表达式派生场，如 "S11 - S22"；引用的数组必须与派生场同为点数据或单元数据
+    bool addExpression(const QString &name, const QString &expression, bool isPointData, QString *error);
+
+    const std::vector<Field> &fields() const { return m_fields; }
+    bool contains(const QString &name, bool isPointData) const { return find(name, isPointData) >= 0; }
+
+    // 按需计算派生场并返回数组；已计算且输入未变时直接返回缓存结果
+    vtkDataArray *materialize(const QString &name, bool isPointData, QString *error = nullptr);
+
+    // 已计算派生场占用的字节数；释放后再次 materialize 时重新计算
+    size_t materializedBytes() const;
+    void releaseMaterialized(const QStringList &keepNames);
+
+    // 矢量数组对应的模派生场名称（供着色、等值面和范围计算复用）
+    static QString magnitudeName(const QString &vectorName) { return vectorName + "_Magnitude"; }
+
+private:
+    int find(const QString &name, bool isPointData) const;
+    void registerBuiltins(bool isPointData);
+    vtkDataArray *findArray(const QString &name, bool isPointData) const;
+    static bool inputIsPointData(const Field &field);
+    vtkMTimeType inputTime(const Field &field) const;
+    bool evaluateTensorField(const Field &field, vtkDataArray *tensor);
+    bool evaluateVectorField(const Field &field, vtkDataArray *vectors);
+    void addBuiltin(const QString &name, Kind kind, bool isPointData, const QString &source, const QString &description);
+    bool evaluateNodalAverage(const Field &field, vtkDataArray *cellArray);
+
+    vtkSmartPointer<vtkUnstructuredGrid> m_data;
+    SpatialIndex *m_spatialIndex;
+    std::vector<Field> m_fields;
+};
+
+#endif // DERIVEDFIELDREGISTRY_H
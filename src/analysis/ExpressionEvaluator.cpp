@@ -0,0 +1,482 @@
+#include "ExpressionEvaluator.h"
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const vtkIdType BLOCK_SIZE = 1024; // 每次处理的元组数，缓冲区可放入L1/L2
+
+// 读取一块数据的某个分量（component < 0 时取模），AOS 浮点数组走指针快速路径
+template <typename T>
+void gatherBlock(const T *data, int components, int component, vtkIdType begin, vtkIdType count, double *out)
+{
+    const T *base = data + begin * components;
+    if (component >= 0) {
+        for (vtkIdType i = 0; i < count; ++i) {
+            out[i] = static_cast<double>(base[i * components + component]);
+        }
+        return;
+    }
+
+    for (vtkIdType i = 0; i < count; ++i) {
+        double sum = 0.0;
+        for (int c = 0; c < components; ++c) {
+            const double v = static_cast<double>(base[i * components + c]);
+            sum += v * v;
+        }
+        out[i] = std::sqrt(sum);
+    }
+}
+
+void loadBlock(vtkDataArray *array, int component, vtkIdType begin, vtkIdType count, double *out)
+{
+    const int components = array->GetNumberOfComponents();
+    if (components == 1) {
+        component = 0;
+    }
+
+    if (vtkDoubleArray *doubles = vtkDoubleArray::FastDownCast(array)) {
+        gatherBlock(doubles->GetPointer(0), components, component, begin, count, out);
+    } else if (vtkFloatArray *floats = vtkFloatArray::FastDownCast(array)) {
+        gatherBlock(floats->GetPointer(0), components, component, begin, count, out);
+    } else if (component >= 0) {
+        for (vtkIdType i = 0; i < count; ++i) {
+            out[i] = array->GetComponent(begin + i, component);
+        }
+    } else {
+        for (vtkIdType i = 0; i < count; ++i) {
+            double sum = 0.0;
+            for (int c = 0; c < components; ++c) {
+                const double v = array->GetComponent(begin + i, c);
+                sum += v * v;
+            }
+            out[i] = std::sqrt(sum);
+        }
+    }
+}
+
+struct EvaluateFunctor
+{
+    const std::vector<ExpressionEvaluator::Instruction> &Program;
+    const std::vector<vtkDataArray *> &Variables;
+    vtkDataArray *Output;
+    int StackDepth;
+
+    vtkSMPThreadLocal<std::vector<double>> Stack;
+
+    EvaluateFunctor(const std::vector<ExpressionEvaluator::Instruction> &program,
+                    const std::vector<vtkDataArray *> &variables, vtkDataArray *output, int stackDepth)
+        : Program(program), Variables(variables), Output(output), StackDepth(stackDepth)
+    {
+    }
+
+    void Initialize()
+    {
+        Stack.Local().assign(static_cast<size_t>(StackDepth) * BLOCK_SIZE, 0.0);
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+        double *stack = Stack.Local().data();
+        vtkDoubleArray *doubleOutput = vtkDoubleArray::FastDownCast(Output);
+
+        for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += BLOCK_SIZE) {
+            const vtkIdType n = std::min(BLOCK_SIZE, end - blockBegin);
+            int top = 0; // 栈中块的数量
+
+            for (const ExpressionEvaluator::Instruction &ins : Program) {
+                double *a = stack + std::max(top - 2, 0) * BLOCK_SIZE; // 二元运算的左操作数
+                double *b = stack + std::max(top - 1, 0) * BLOCK_SIZE; // 一元运算的操作数 / 二元运算的右操作数
+
+                switch (ins.op) {
+                case ExpressionEvaluator::OP_CONST: {
+                    double *dst = stack + top * BLOCK_SIZE;
+                    std::fill(dst, dst + n, ins.constant);
+                    ++top;
+                    break;
+                }
+                case ExpressionEvaluator::OP_VARIABLE:
+                    loadBlock(Variables[ins.variable], ins.component, blockBegin, n, stack + top * BLOCK_SIZE);
+                    ++top;
+                    break;
+                case ExpressionEvaluator::OP_NEGATE:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = -b[i];
+                    break;
+                case ExpressionEvaluator::OP_ADD:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] += b[i];
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_SUBTRACT:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] -= b[i];
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_MULTIPLY:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] *= b[i];
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_DIVIDE:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] /= b[i];
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_POWER:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] = std::pow(a[i], b[i]);
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_MIN:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] = std::min(a[i], b[i]);
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_MAX:
+                    for (vtkIdType i = 0; i < n; ++i) a[i] = std::max(a[i], b[i]);
+                    --top;
+                    break;
+                case ExpressionEvaluator::OP_SQRT:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::sqrt(b[i]);
+                    break;
+                case ExpressionEvaluator::OP_ABS:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::abs(b[i]);
+                    break;
+                case ExpressionEvaluator::OP_EXP:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::exp(b[i]);
+                    break;
+                case ExpressionEvaluator::OP_LOG:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::log(b[i]);
+                    break;
+                case ExpressionEvaluator::OP_SIN:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::sin(b[i]);
+                    break;
+                case ExpressionEvaluator::OP_COS:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::cos(b[i]);
+                    break;
+                case ExpressionEvaluator::OP_TAN:
+                    for (vtkIdType i = 0; i < n; ++i) b[i] = std::tan(b[i]);
+                    break;
+                }
+            }
+
+            // 结果位于栈底
+            if (doubleOutput) {
+                std::copy(stack, stack + n, doubleOutput->GetPointer(blockBegin));
+            } else {
+                for (vtkIdType i = 0; i < n; ++i) {
+                    Output->SetComponent(blockBegin + i, 0, stack[i]);
+                }
+            }
+        }
+    }
+
+    void Reduce()
+    {
+    }
+};
+
+struct FunctionInfo
+{
+    const char *name;
+    ExpressionEvaluator::OpCode op;
+    int arguments;
+};
+
+const FunctionInfo FUNCTIONS[] = {
+    {"sqrt", ExpressionEvaluator::OP_SQRT, 1},
+    {"abs", ExpressionEvaluator::OP_ABS, 1},
+    {"exp", ExpressionEvaluator::OP_EXP, 1},
+    {"log", ExpressionEvaluator::OP_LOG, 1},
+    {"sin", ExpressionEvaluator::OP_SIN, 1},
+    {"cos", ExpressionEvaluator::OP_COS, 1},
+    {"tan", ExpressionEvaluator::OP_TAN, 1},
+    {"min", ExpressionEvaluator::OP_MIN, 2},
+    {"max", ExpressionEvaluator::OP_MAX, 2},
+    {"pow", ExpressionEvaluator::OP_POWER, 2},
+};
+} // namespace
+
+ExpressionEvaluator::ExpressionEvaluator()
+    : m_position(0)
+    , m_maxStackDepth(0)
+{
+}
+
+bool ExpressionEvaluator::fail(const QString &message)
+{
+    if (m_error.isEmpty()) {
+        m_error = QString("%1（位置 %2）").arg(message).arg(m_position + 1);
+    }
+    return false;
+}
+
+void ExpressionEvaluator::skipSpaces()
+{
+    while (m_position < m_source.size() && m_source[m_position].isSpace()) {
+        ++m_position;
+    }
+}
+
+bool ExpressionEvaluator::compile(const QString &expression)
+{
+    m_source = expression;
+    m_position = 0;
+    m_error.clear();
+    m_variableNames.clear();
+    m_program.clear();
+    m_maxStackDepth = 0;
+
+    if (!parseExpression()) {
+        return false;
+    }
+    skipSpaces();
+    if (m_position != m_source.size()) {
+        return fail("表达式末尾有多余字符");
+    }
+
+    // 计算求值所需的最大栈深度
+    int depth = 0;
+    for (const Instruction &ins : m_program) {
+        switch (ins.op) {
+        case OP_CONST:
+        case OP_VARIABLE:
+            ++depth;
+            break;
+        case OP_ADD:
+        case OP_SUBTRACT:
+        case OP_MULTIPLY:
+        case OP_DIVIDE:
+        case OP_POWER:
+        case OP_MIN:
+        case OP_MAX:
+            --depth;
+            break;
+        default:
+            break;
+        }
+        m_maxStackDepth = std::max(m_maxStackDepth, depth);
+    }
+    return true;
+}
+
+bool ExpressionEvaluator::parseExpression()
+{
+    if (!parseTerm()) {
+        return false;
+    }
+
+    for (;;) {
+        skipSpaces();
+        if (m_position >= m_source.size()) {
+            return true;
+        }
+        const QChar c = m_source[m_position];
+        if (c != '+' && c != '-') {
+            return true;
+        }
+        ++m_position;
+        if (!parseTerm()) {
+            return false;
+        }
+        m_program.push_back({c == '+' ? OP_ADD : OP_SUBTRACT, 0.0, -1, -1});
+    }
+}
+
+bool ExpressionEvaluator::parseTerm()
+{
+    if (!parseUnary()) {
+        return false;
+    }
+
+    for (;;) {
+        skipSpaces();
+        if (m_position >= m_source.size()) {
+            return true;
+        }
+        const QChar c = m_source[m_position];
+        if (c != '*' && c != '/') {
+            return true;
+        }
+        ++m_position;
+        if (!parseUnary()) {
+            return false;
+        }
+        m_program.push_back({c == '*' ? OP_MULTIPLY : OP_DIVIDE, 0.0, -1, -1});
+    }
+}
+
+bool ExpressionEvaluator::parseUnary()
+{
+    skipSpaces();
+    if (m_position < m_source.size() && (m_source[m_position] == '-' || m_source[m_position] == '+')) {
+        const bool negate = m_source[m_position] == '-';
+        ++m_position;
+        if (!parseUnary()) {
+            return false;
+        }
+        if (negate) {
+            m_program.push_back({OP_NEGATE, 0.0, -1, -1});
+        }
+        return true;
+    }
+    return parsePower();
+}
+
+bool ExpressionEvaluator::parsePower()
+{
+    if (!parsePrimary()) {
+        return false;
+    }
+
+    skipSpaces();
+    if (m_position < m_source.size() && m_source[m_position] == '^') {
+        ++m_position;
+        // 乘方右结合，且优先级高于一元负号：-a^2 = -(a^2)
+        if (!parseUnary()) {
+            return false;
+        }
+        m_program.push_back({OP_POWER, 0.0, -1, -1});
+    }
+    return true;
+}
+
+bool ExpressionEvaluator::parsePrimary()
+{
+    skipSpaces();
+    if (m_position >= m_source.size()) {
+        return fail("表达式不完整");
+    }
+
+    const QChar c = m_source[m_position];
+
+    // 括号
+    if (c == '(') {
+        ++m_position;
+        if (!parseExpression()) {
+            return false;
+        }
+        skipSpaces();
+        if (m_position >= m_source.size() || m_source[m_position] != ')') {
+            return fail("缺少右括号");
+        }
+        ++m_position;
+        return true;
+    }
+
+    // 数值常量
+    if (c.isDigit() || c == '.') {
+        const int start = m_position;
+        while (m_position < m_source.size() && (m_source[m_position].isDigit() || m_source[m_position] == '.')) {
+            ++m_position;
+        }
+        // 科学计数法
+        if (m_position < m_source.size() && (m_source[m_position] == 'e' || m_source[m_position] == 'E')) {
+            int next = m_position + 1;
+            if (next < m_source.size() && (m_source[next] == '+' || m_source[next] == '-')) {
+                ++next;
+            }
+            if (next < m_source.size() && m_source[next].isDigit()) {
+                m_position = next;
+                while (m_position < m_source.size() && m_source[m_position].isDigit()) {
+                    ++m_position;
+                }
+            }
+        }
+        bool ok = false;
+        const double value = m_source.mid(start, m_position - start).toDouble(&ok);
+        if (!ok) {
+            return fail("无法解析的数值");
+        }
+        m_program.push_back({OP_CONST, value, -1, -1});
+        return true;
+    }
+
+    // 标识符：函数或数组名
+    if (c.isLetter() || c == '_') {
+        const int start = m_position;
+        while (m_position < m_source.size() &&
+               (m_source[m_position].isLetterOrNumber() || m_source[m_position] == '_')) {
+            ++m_position;
+        }
+        const QString identifier = m_source.mid(start, m_position - start);
+        skipSpaces();
+
+        // 函数调用
+        if (m_position < m_source.size() && m_source[m_position] == '(') {
+            for (const FunctionInfo &function : FUNCTIONS) {
+                if (identifier != QLatin1String(function.name)) {
+                    continue;
+                }
+                ++m_position;
+                for (int arg = 0; arg < function.arguments; ++arg) {
+                    if (arg > 0) {
+                        skipSpaces();
+                        if (m_position >= m_source.size() || m_source[m_position] != ',') {
+                            return fail(QString("函数 %1 需要 %2 个参数").arg(identifier).arg(function.arguments));
+                        }
+                        ++m_position;
+                    }
+                    if (!parseExpression()) {
+                        return false;
+                    }
+                }
+                skipSpaces();
+                if (m_position >= m_source.size() || m_source[m_position] != ')') {
+                    return fail(QString("函数 %1 缺少右括号").arg(identifier));
+                }
+                ++m_position;
+                m_program.push_back({function.op, 0.0, -1, -1});
+                return true;
+            }
+            return fail(QString("未知函数 %1").arg(identifier));
+        }
+
+        // 数组变量，可带分量下标
+        int component = -1;
+        if (m_position < m_source.size() && m_source[m_position] == '[') {
+            ++m_position;
+            const int indexStart = m_position;
+            while (m_position < m_source.size() && m_source[m_position].isDigit()) {
+                ++m_position;
+            }
+            if (indexStart == m_position || m_position >= m_source.size() || m_source[m_position] != ']') {
+                return fail("分量下标格式应为 名称[k]");
+            }
+            component = m_source.mid(indexStart, m_position - indexStart).toInt();
+            ++m_position;
+        }
+
+        int variable = m_variableNames.indexOf(identifier);
+        if (variable < 0) {
+            variable = m_variableNames.size();
+            m_variableNames.append(identifier);
+        }
+        m_program.push_back({OP_VARIABLE, 0.0, variable, component});
+        return true;
+    }
+
+    return fail(QString("无法识别的字符 '%1'").arg(c));
+}
+
+bool ExpressionEvaluator::evaluate(const std::vector<vtkDataArray *> &variables, vtkDataArray *output) const
+{
+    if (m_program.empty() || !output || variables.size() != static_cast<size_t>(m_variableNames.size())) {
+        return false;
+    }
+
+    const vtkIdType numTuples = output->GetNumberOfTuples();
+    for (size_t v = 0; v < variables.size(); ++v) {
+        if (!variables[v] || variables[v]->GetNumberOfTuples() != numTuples) {
+            return false;
+        }
+    }
+    for (const Instruction &ins : m_program) {
+        if (ins.op == OP_VARIABLE && ins.component >= variables[ins.variable]->GetNumberOfComponents()) {
+            return false;
+        }
+    }
+
+    EvaluateFunctor functor(m_program, variables, output, std::max(1, m_maxStackDepth));
+    // 粒度取块大小的整数倍，保证每个任务内部按整块处理
+    vtkSMPTools::For(0, numTuples, BLOCK_SIZE * 16, functor);
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef EXPRESSIONEVALUATOR_H
+#define EXPRESSIONEVALUATOR_H
+
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+#include <vtkType.h>
+#include <vtkDataArray.h>
+
+// 派生场表达式：编译为逆波兰指令序列，按数据块并行求值
+// 每条指令在整块数据上执行一次紧凑循环，便于编译器自动向量化
+//
+// 语法：+ - * / ^、括号、一元负号、数值常量，
+//       函数 sqrt abs exp log sin cos tan min max pow，
+//       变量为数组名；多分量数组用 名称[k] 取分量，省略下标时取模
+class ExpressionEvaluator
+{
+public:
+    ExpressionEvaluator();
+
+    // 编译表达式，返回是否成功；失败时 errorMessage() 给出原因
+    bool compile(const QString &expression);
+    const QString &errorMessage() const { return m_error; }
+
+    // 表达式引用的数组名（去重，按出现顺序）
+    const QStringList &variableNames() const { return m_variableNames; }
+
+    // 绑定变量数组（顺序与 variableNames 一致），并求值到 output（单分量，需预先分配）
+    bool evaluate(const std::vector<vtkDataArray *> &variables, vtkDataArray *output) const;
+
+    enum OpCode {
+        OP_CONST,
+        OP_VARIABLE,
+        OP_NEGATE,
+        OP_ADD,
+        OP_SUBTRACT,
+        OP_MULTIPLY,
+        OP_DIVIDE,
+        OP_POWER,
+        OP_SQRT,
+        OP_ABS,
+        OP_EXP,
+        OP_LOG,
+        OP_SIN,
+        OP_COS,
+        OP_TAN,
+        OP_MIN,
+        OP_MAX
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        double constant;
+        int variable;   // variableNames 中的序号
+        int component;  // -1 表示取模
+    };
+
+private:
+    // 递归下降解析
+    bool parseExpression();
+    bool parseTerm();
+    bool parseUnary();
+    bool parsePower();
+    bool parsePrimary();
+    void skipSpaces();
+    bool fail(const QString &message);
+
+    QString m_source;
+    int m_position;
+    QString m_error;
+    QStringList m_variableNames;
+    std::vector<Instruction> m_program;
+    int m_maxStackDepth;
+};
+
+#endif // EXPRESSIONEVALUATOR_H
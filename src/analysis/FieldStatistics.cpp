@@ -0,0 +1,263 @@
+#include "FieldStatistics.h"
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkCell.h>
+#include <vtkMath.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// 每个线程的局部累加量，最后在 Reduce 中合并
+struct Accumulator
+{
+    vtkIdType count = 0;
+    double minimum = std::numeric_limits<double>::max();
+    double maximum = -std::numeric_limits<double>::max();
+    double sum = 0.0;
+    double integral = 0.0;
+    double measure = 0.0;
+
+    void add(double value)
+    {
+        ++count;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+        sum += value;
+    }
+
+    void merge(const Accumulator &other)
+    {
+        count += other.count;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+        sum += other.sum;
+        integral += other.integral;
+        measure += other.measure;
+    }
+};
+
+// 矢量取模，标量直接取值
+inline double tupleValue(vtkDataArray *array, vtkIdType tupleId, double *buffer)
+{
+    const int components = array->GetNumberOfComponents();
+    if (components == 1) {
+        return array->GetComponent(tupleId, 0);
+    }
+
+    array->GetTuple(tupleId, buffer);
+    double sum = 0.0;
+    for (int c = 0; c < components; ++c) {
+        sum += buffer[c] * buffer[c];
+    }
+    return std::sqrt(sum);
+}
+
+struct CellStatisticsFunctor
+{
+    vtkUnstructuredGrid *Data;
+    vtkDataArray *Array;
+    bool IsPointData;
+    const std::vector<vtkIdType> &CellIds;
+
+    vtkSMPThreadLocal<Accumulator> Local;
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+    vtkSMPThreadLocalObject<vtkIdList> ScratchIds;
+    vtkSMPThreadLocalObject<vtkPoints> ScratchPoints;
+    vtkSMPThreadLocal<std::vector<double>> Tuple;
+    Accumulator Result;
+
+    CellStatisticsFunctor(vtkUnstructuredGrid *data, vtkDataArray *array, bool isPointData,
+                          const std::vector<vtkIdType> &cellIds)
+        : Data(data), Array(array), IsPointData(isPointData), CellIds(cellIds)
+    {
+    }
+
+    void Initialize()
+    {
+        Local.Local() = Accumulator();
+        Tuple.Local().assign(Array->GetNumberOfComponents(), 0.0);
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+        Accumulator &acc = Local.Local();
+        vtkGenericCell *cell = Cell.Local();
+        vtkIdList *scratchIds = ScratchIds.Local();
+        vtkPoints *scratchPoints = ScratchPoints.Local();
+        double *tuple = Tuple.Local().data();
+
+        for (vtkIdType i = begin; i < end; ++i) {
+            const vtkIdType cellId = CellIds[i];
+            Data->GetCell(cellId, cell);
+
+            double value = 0.0;
+            if (IsPointData) {
+                // 点数据取单元顶点平均值
+                const vtkIdType numPoints = cell->GetNumberOfPoints();
+                if (numPoints == 0) {
+                    continue;
+                }
+                for (vtkIdType p = 0; p < numPoints; ++p) {
+                    value += tupleValue(Array, cell->GetPointId(p), tuple);
+                }
+                value /= static_cast<double>(numPoints);
+            } else {
+                value = tupleValue(Array, cellId, tuple);
+            }
+
+            const double measure = FieldStatistics::cellMeasure(cell, scratchIds, scratchPoints);
+            acc.add(value);
+            acc.integral += value * measure;
+            acc.measure += measure;
+        }
+    }
+
+    void Reduce()
+    {
+        for (auto it = Local.begin(); it != Local.end(); ++it) {
+            Result.merge(*it);
+        }
+    }
+};
+
+struct PointStatisticsFunctor
+{
+    vtkDataArray *Array;
+    const std::vector<vtkIdType> &PointIds;
+
+    vtkSMPThreadLocal<Accumulator> Local;
+    vtkSMPThreadLocal<std::vector<double>> Tuple;
+    Accumulator Result;
+
+    PointStatisticsFunctor(vtkDataArray *array, const std::vector<vtkIdType> &pointIds)
+        : Array(array), PointIds(pointIds)
+    {
+    }
+
+    void Initialize()
+    {
+        Local.Local() = Accumulator();
+        Tuple.Local().assign(Array->GetNumberOfComponents(), 0.0);
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+        Accumulator &acc = Local.Local();
+        double *tuple = Tuple.Local().data();
+        for (vtkIdType i = begin; i < end; ++i) {
+            acc.add(tupleValue(Array, PointIds[i], tuple));
+        }
+    }
+
+    void Reduce()
+    {
+        for (auto it = Local.begin(); it != Local.end(); ++it) {
+            Result.merge(*it);
+        }
+    }
+};
+
+FieldStatistics fromAccumulator(const Accumulator &acc, bool hasIntegral)
+{
+    FieldStatistics stats;
+    stats.count = acc.count;
+    if (acc.count > 0) {
+        stats.minimum = acc.minimum;
+        stats.maximum = acc.maximum;
+        stats.sum = acc.sum;
+        stats.mean = acc.sum / static_cast<double>(acc.count);
+    }
+    stats.hasIntegral = hasIntegral;
+    stats.integral = acc.integral;
+    stats.measure = acc.measure;
+    return stats;
+}
+} // namespace
+
+FieldStatistics::FieldStatistics()
+    : count(0)
+    , minimum(0.0)
+    , maximum(0.0)
+    , mean(0.0)
+    , sum(0.0)
+    , hasIntegral(false)
+    , integral(0.0)
+    , measure(0.0)
+{
+}
+
+FieldStatistics FieldStatistics::computeOverCells(vtkUnstructuredGrid *data, vtkDataArray *array,
+                                                  bool isPointData, const std::vector<vtkIdType> &cellIds)
+{
+    if (!data || !array || cellIds.empty()) {
+        return FieldStatistics();
+    }
+
+    // 首次调用 GetCell 会构建内部链接，需在并行区之外完成
+    vtkSmartPointer<vtkGenericCell> warmup = vtkSmartPointer<vtkGenericCell>::New();
+    data->GetCell(cellIds.front(), warmup);
+
+    CellStatisticsFunctor functor(data, array, isPointData, cellIds);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(cellIds.size()), functor);
+    return fromAccumulator(functor.Result, true);
+}
+
+FieldStatistics FieldStatistics::computeOverPoints(vtkDataArray *array, const std::vector<vtkIdType> &pointIds)
+{
+    if (!array || pointIds.empty()) {
+        return FieldStatistics();
+    }
+
+    PointStatisticsFunctor functor(array, pointIds);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(pointIds.size()), functor);
+    return fromAccumulator(functor.Result, false);
+}
+
+double FieldStatistics::cellMeasure(vtkGenericCell *cell, vtkIdList *scratchIds, vtkPoints *scratchPoints)
+{
+    const int dimension = cell->GetCellDimension();
+    if (dimension == 0) {
+        return 0.0;
+    }
+
+    // 剖分为单纯形后累加：四面体体积 / 三角形面积 / 线段长度
+    scratchIds->Reset();
+    scratchPoints->Reset();
+    if (!cell->Triangulate(0, scratchIds, scratchPoints)) {
+        return 0.0;
+    }
+
+    const int simplexSize = dimension + 1;
+    const vtkIdType numSimplices = scratchPoints->GetNumberOfPoints() / simplexSize;
+    double measure = 0.0;
+
+    for (vtkIdType s = 0; s < numSimplices; ++s) {
+        double p[4][3];
+        for (int k = 0; k < simplexSize; ++k) {
+            scratchPoints->GetPoint(s * simplexSize + k, p[k]);
+        }
+
+        double a[3], b[3], c[3];
+        vtkMath::Subtract(p[1], p[0], a);
+        if (dimension == 1) {
+            measure += vtkMath::Norm(a);
+            continue;
+        }
+
+        vtkMath::Subtract(p[2], p[0], b);
+        double normal[3];
+        vtkMath::Cross(a, b, normal);
+        if (dimension == 2) {
+            measure += 0.5 * vtkMath::Norm(normal);
+            continue;
+        }
+
+        vtkMath::Subtract(p[3], p[0], c);
+        measure += std::abs(vtkMath::Dot(normal, c)) / 6.0;
+    }
+
+    return measure;
+}
@@ -0,0 +1,38 @@
+#ifndef FIELDSTATISTICS_H
+#define FIELDSTATISTICS_H
+
+#include <vector>
+
+#include <vtkType.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataArray.h>
+#include <vtkGenericCell.h>
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+
+// 选区统计：对一组点或单元上的场做并行归约
+struct FieldStatistics
+{
+    FieldStatistics();
+
+    vtkIdType count;
+    double minimum;
+    double maximum;
+    double mean;
+    double sum;
+    bool hasIntegral;   // 仅单元选区可积分
+    double integral;    // Σ 值 × 单元度量（体积/面积/长度）
+    double measure;     // 选区总度量
+
+    // 单元选区：单元数据直接取值，点数据取单元各点的平均值，并按单元度量积分
+    static FieldStatistics computeOverCells(vtkUnstructuredGrid *data, vtkDataArray *array,
+                                            bool isPointData, const std::vector<vtkIdType> &cellIds);
+
+    // 点选区：仅对点数据统计最小/最大/平均值
+    static FieldStatistics computeOverPoints(vtkDataArray *array, const std::vector<vtkIdType> &pointIds);
+
+    // 单元度量：三维单元为体积，二维为面积，一维为长度
+    static double cellMeasure(vtkGenericCell *cell, vtkIdList *scratchIds, vtkPoints *scratchPoints);
+};
+
+#endif // FIELDSTATISTICS_H
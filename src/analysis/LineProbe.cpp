@@ -0,0 +1,259 @@
+#include "LineProbe.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QMap>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkDataArray.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/FieldInterpolator.h"
+
+namespace
+{
+const int MAX_CACHE_ENTRIES = 8;
+
+vtkDataArray *findArray(vtkUnstructuredGrid *data, const QString &name, bool isPointData)
+{
+    QByteArray utf8 = name.toUtf8();
+    return isPointData ? data->GetPointData()->GetArray(utf8.constData())
+                       : data->GetCellData()->GetArray(utf8.constData());
+}
+
+struct ProbeFunctor
+{
+    const FieldInterpolator &Interpolator;
+    const std::vector<vtkDataArray *> &Arrays;
+    const std::vector<LineProbe::Point> &Polyline;
+    const std::vector<double> &Cumulative;
+    LineProbe::Result &Output;
+
+    vtkSMPThreadLocal<FieldInterpolator::Workspace> Workspace;
+    vtkSMPThreadLocal<std::vector<double>> Tuple;
+
+    ProbeFunctor(const FieldInterpolator &interpolator, const std::vector<vtkDataArray *> &arrays,
+                 const std::vector<LineProbe::Point> &polyline, const std::vector<double> &cumulative,
+                 LineProbe::Result &output)
+        : Interpolator(interpolator), Arrays(arrays), Polyline(polyline), Cumulative(cumulative), Output(output)
+    {
+    }
+
+    void Initialize()
+    {
+        int maxComponents = 1;
+        for (vtkDataArray *array : Arrays) {
+            maxComponents = std::max(maxComponents, array->GetNumberOfComponents());
+        }
+        Tuple.Local().assign(maxComponents, 0.0);
+    }
+
+    static double magnitude(const double *value, int components)
+    {
+        if (components == 1) {
+            return value[0];
+        }
+        double sum = 0.0;
+        for (int c = 0; c < components; ++c) {
+            sum += value[c] * value[c];
+        }
+        return std::sqrt(sum);
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+        FieldInterpolator::Workspace &ws = Workspace.Local();
+        double *tuple = Tuple.Local().data();
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+
+        for (vtkIdType i = begin; i < end; ++i) {
+            // 按弧长定位所在线段
+            const double s = Output.distance[i];
+            size_t segment = std::upper_bound(Cumulative.begin(), Cumulative.end(), s) - Cumulative.begin();
+            segment = std::min(std::max<size_t>(segment, 1), Cumulative.size() - 1) - 1;
+
+            const double length = Cumulative[segment + 1] - Cumulative[segment];
+            const double t = length > 0.0 ? (s - Cumulative[segment]) / length : 0.0;
+            const LineProbe::Point &a = Polyline[segment];
+            const LineProbe::Point &b = Polyline[segment + 1];
+            const double x[3] = {a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]), a[2] + t * (b[2] - a[2])};
+
+            // 同一位置只定位一次单元，其余数组复用插值权重
+            const vtkIdType cellId = Interpolator.interpolate(x, tuple, ws);
+            if (cellId < 0) {
+                for (size_t k = 0; k < Arrays.size(); ++k) {
+                    Output.values[k][i] = nan;
+                }
+                continue;
+            }
+
+            Output.values[0][i] = magnitude(tuple, Arrays[0]->GetNumberOfComponents());
+            for (size_t k = 1; k < Arrays.size(); ++k) {
+                Interpolator.interpolateInCell(Arrays[k], cellId, ws, tuple);
+                Output.values[k][i] = magnitude(tuple, Arrays[k]->GetNumberOfComponents());
+            }
+        }
+    }
+
+    void Reduce()
+    {
+    }
+};
+} // namespace
+
+LineProbe::LineProbe()
+    : m_data(nullptr)
+    , m_spatialIndex(nullptr)
+{
+}
+
+void LineProbe::setData(vtkUnstructuredGrid *data, SpatialIndex *spatialIndex)
+{
+    if (m_data != data) {
+        m_cache.clear();
+    }
+    m_data = data;
+    m_spatialIndex = spatialIndex;
+}
+
+void LineProbe::clearCache()
+{
+    m_cache.clear();
+}
+
+vtkMTimeType LineProbe::inputTime(const QStringList &arrayNames, bool isPointData) const
+{
+    // 网格几何与参与采样的数组任一变化都会使缓存失效
+    vtkMTimeType time = m_data->GetPoints() ? m_data->GetPoints()->GetMTime() : 0;
+    if (m_data->GetCells()) {
+        time = std::max(time, m_data->GetCells()->GetMTime());
+    }
+    for (const QString &name : arrayNames) {
+        if (vtkDataArray *array = findArray(m_data, name, isPointData)) {
+            time = std::max(time, array->GetMTime());
+        }
+    }
+    return time;
+}
+
+LineProbe::Result LineProbe::probe(const std::vector<Point> &polyline, const QStringList &arrayNames,
+                                   bool isPointData, int numberOfSamples)
+{
+    TRACE_SCOPE("LineProbe::probe", "compute");
+    Result result;
+    if (!m_data || !m_spatialIndex || polyline.size() < 2 || arrayNames.isEmpty() || numberOfSamples < 2) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 查找缓存（相机移动后重新探测不需要重新采样）
+    const vtkMTimeType dataTime = inputTime(arrayNames, isPointData);
+    for (int i = 0; i < m_cache.size(); ++i) {
+        const CacheEntry &entry = m_cache[i];
+        if (entry.isPointData == isPointData && entry.numberOfSamples == numberOfSamples &&
+            entry.dataTime == dataTime && entry.arrayNames == arrayNames && entry.polyline == polyline) {
+            m_cache.move(i, 0);
+            result = m_cache.first().result;
+            result.fromCache = true;
+            result.elapsedMs = timer.nsecsElapsed() / 1.0e6;
+            return result;
+        }
+    }
+
+    std::vector<vtkDataArray *> arrays;
+    for (const QString &name : arrayNames) {
+        vtkDataArray *array = findArray(m_data, name, isPointData);
+        if (!array) {
+            qDebug() << "LineProbe: 找不到数组" << name;
+            return result;
+        }
+        arrays.push_back(array);
+    }
+
+    FieldInterpolator interpolator;
+    if (!interpolator.initialize(m_data, m_spatialIndex->cellLocator(), arrays.front(), isPointData,
+                                 m_spatialIndex->topology())) {
+        return result;
+    }
+
+    // 折线累计弧长
+    std::vector<double> cumulative(polyline.size(), 0.0);
+    for (size_t i = 1; i < polyline.size(); ++i) {
+        const double dx = polyline[i][0] - polyline[i - 1][0];
+        const double dy = polyline[i][1] - polyline[i - 1][1];
+        const double dz = polyline[i][2] - polyline[i - 1][2];
+        cumulative[i] = cumulative[i - 1] + std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+    const double totalLength = cumulative.back();
+    if (totalLength <= 0.0) {
+        return result;
+    }
+
+    result.arrayNames = arrayNames;
+    result.distance.resize(numberOfSamples);
+    for (int i = 0; i < numberOfSamples; ++i) {
+        result.distance[i] = totalLength * i / (numberOfSamples - 1);
+    }
+    result.values.assign(arrays.size(), std::vector<double>(numberOfSamples, 0.0));
+
+    ProbeFunctor functor(interpolator, arrays, polyline, cumulative, result);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfSamples), functor);
+
+    result.elapsedMs = timer.nsecsElapsed() / 1.0e6;
+    qDebug() << "LineProbe: 采样" << numberOfSamples << "点 ×" << arrays.size() << "个数组，耗时(ms):" << result.elapsedMs;
+
+    CacheEntry entry;
+    entry.polyline = polyline;
+    entry.arrayNames = arrayNames;
+    entry.isPointData = isPointData;
+    entry.numberOfSamples = numberOfSamples;
+    entry.dataTime = dataTime;
+    entry.result = result;
+    m_cache.prepend(entry);
+    while (m_cache.size() > MAX_CACHE_ENTRIES) {
+        m_cache.removeLast();
+    }
+
+    return result;
+}
+
+QStringList LineProbe::timeSeriesArrays(vtkUnstructuredGrid *data, const QString &arrayName, bool isPointData)
+{
+    static const QRegularExpression stepPattern("^(.*)_t(\\d+)$");
+
+    QStringList series;
+    if (!data) {
+        return series;
+    }
+
+    QRegularExpressionMatch match = stepPattern.match(arrayName);
+    if (!match.hasMatch()) {
+        return series;
+    }
+    const QString baseName = match.captured(1);
+
+    vtkFieldData *fields = isPointData ? static_cast<vtkFieldData *>(data->GetPointData())
+                                       : static_cast<vtkFieldData *>(data->GetCellData());
+    QMap<int, QString> steps;
+    for (int i = 0; i < fields->GetNumberOfArrays(); ++i) {
+        const char *name = fields->GetArrayName(i);
+        if (!name) {
+            continue;
+        }
+        QRegularExpressionMatch stepMatch = stepPattern.match(QString::fromUtf8(name));
+        if (stepMatch.hasMatch() && stepMatch.captured(1) == baseName) {
+            steps.insert(stepMatch.captured(2).toInt(), stepMatch.captured(0));
+        }
+    }
+
+    return steps.values();
+}
@@ -0,0 +1,64 @@
+#ifndef LINEPROBE_H
+#define LINEPROBE_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+#include <array>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include "core/SpatialIndex.h"
+
+// 线探测：沿直线或折线等弧长采样活动数组（可同时采样多个时间步）
+// 采样基于共享单元定位器并行执行，相同的线与数组再次探测时直接命中缓存
+class LineProbe
+{
+public:
+    typedef std::array<double, 3> Point;
+
+    struct Result
+    {
+        std::vector<double> distance;             // 各采样点的弧长坐标
+        std::vector<std::vector<double>> values;  // 每个数组一条曲线，网格外为 NaN，矢量取模
+        QStringList arrayNames;
+        double elapsedMs = 0.0;
+        bool fromCache = false;
+
+        bool isEmpty() const { return distance.empty(); }
+    };
+
+    LineProbe();
+
+    void setData(vtkUnstructuredGrid *data, SpatialIndex *spatialIndex);
+
+    Result probe(const std::vector<Point> &polyline, const QStringList &arrayNames,
+                 bool isPointData, int numberOfSamples);
+
+    void clearCache();
+
+    // 查找与 arrayName 同属一个时间序列的数组（命名约定 <名称>_t<序号>），按序号排序
+    static QStringList timeSeriesArrays(vtkUnstructuredGrid *data, const QString &arrayName, bool isPointData);
+
+private:
+    struct CacheEntry
+    {
+        std::vector<Point> polyline;
+        QStringList arrayNames;
+        bool isPointData;
+        int numberOfSamples;
+        vtkMTimeType dataTime;
+        Result result;
+    };
+
+    vtkMTimeType inputTime(const QStringList &arrayNames, bool isPointData) const;
+
+    vtkSmartPointer<vtkUnstructuredGrid> m_data;
+    SpatialIndex *m_spatialIndex;
+    QList<CacheEntry> m_cache; // 最近使用的排在最前
+};
+
+#endif // LINEPROBE_H
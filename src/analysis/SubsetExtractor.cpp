@@ -0,0 +1,64 @@
+#include "SubsetExtractor.h"
+#include <vtkIdList.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkPointData.h>
+#include <vtkExtractCells.h>
+#include <algorithm>
+
+namespace
+{
+vtkSmartPointer<vtkIdList> toIdList(const std::vector<vtkIdType> &ids)
+{
+    vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
+    idList->SetNumberOfIds(static_cast<vtkIdType>(ids.size()));
+    std::copy(ids.begin(), ids.end(), idList->GetPointer(0));
+    return idList;
+}
+} // namespace
+
+vtkSmartPointer<vtkUnstructuredGrid> SubsetExtractor::extractCells(vtkUnstructuredGrid *data,
+                                                                   const std::vector<vtkIdType> &cellIds)
+{
+    vtkSmartPointer<vtkExtractCells> extractor = vtkSmartPointer<vtkExtractCells>::New();
+    extractor->SetInputData(data);
+    extractor->SetCellList(toIdList(cellIds));
+    extractor->Update();
+
+    vtkSmartPointer<vtkUnstructuredGrid> output = extractor->GetOutput();
+    return output;
+}
+
+vtkSmartPointer<vtkPolyData> SubsetExtractor::extractPoints(vtkUnstructuredGrid *data,
+                                                            const std::vector<vtkIdType> &pointIds,
+                                                            vtkDataArray *pointArray)
+{
+    const vtkIdType count = static_cast<vtkIdType>(pointIds.size());
+    vtkSmartPointer<vtkIdList> idList = toIdList(pointIds);
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetDataType(data->GetPoints()->GetDataType());
+    points->SetNumberOfPoints(count);
+    data->GetPoints()->GetPoints(idList, points);
+
+    vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+    verts->AllocateExact(count, count);
+    for (vtkIdType i = 0; i < count; ++i) {
+        verts->InsertNextCell(1, &i);
+    }
+
+    vtkSmartPointer<vtkPolyData> pointSet = vtkSmartPointer<vtkPolyData>::New();
+    pointSet->SetPoints(points);
+    pointSet->SetVerts(verts);
+
+    if (pointArray) {
+        vtkSmartPointer<vtkDataArray> values = vtkSmartPointer<vtkDataArray>::Take(pointArray->NewInstance());
+        values->SetName(pointArray->GetName());
+        values->SetNumberOfComponents(pointArray->GetNumberOfComponents());
+        values->SetNumberOfTuples(count);
+        pointArray->GetTuples(idList, values);
+        pointSet->GetPointData()->AddArray(values);
+    }
+
+    return pointSet;
+}
@@ -0,0 +1,25 @@
+#ifndef SUBSETEXTRACTOR_H
+#define SUBSETEXTRACTOR_H
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+#include <vtkDataArray.h>
+
+// 按ID列表提取网格子集，供区域选择、查询命中等高亮显示使用
+class SubsetExtractor
+{
+public:
+    // 提取指定单元（保留点/单元数据）
+    static vtkSmartPointer<vtkUnstructuredGrid> extractCells(vtkUnstructuredGrid *data,
+                                                             const std::vector<vtkIdType> &cellIds);
+
+    // 提取指定点为顶点集合，可附带一个点数据数组用于着色
+    static vtkSmartPointer<vtkPolyData> extractPoints(vtkUnstructuredGrid *data,
+                                                      const std::vector<vtkIdType> &pointIds,
+                                                      vtkDataArray *pointArray = nullptr);
+};
+
+#endif // SUBSETEXTRACTOR_H
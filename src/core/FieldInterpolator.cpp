@@ -0,0 +1,124 @@
+#include "FieldInterpolator.h"
+#include <vtkIdList.h>
+#include <algorithm>
+
+FieldInterpolator::Workspace::Workspace()
+    : cell(vtkSmartPointer<vtkGenericCell>::New())
+    , weights(VTK_CELL_SIZE, 0.0)
+    , lastCellId(-1)
+{
+}
+
+FieldInterpolator::FieldInterpolator()
+    : m_isPointData(true)
+    , m_numberOfComponents(0)
+{
+}
+
+bool FieldInterpolator::initialize(vtkUnstructuredGrid *data, vtkAbstractCellLocator *locator,
+                                   vtkDataArray *array, bool isPointData,
+                                   std::shared_ptr<const MeshTopology> topology)
+{
+    m_data = data;
+    m_locator = locator;
+    m_array = array;
+    // 拓扑表须与当前网格对应
+    m_topology = topology && data && topology->numberOfCells() == data->GetNumberOfCells() ? topology : nullptr;
+    m_isPointData = isPointData;
+    m_numberOfComponents = array ? array->GetNumberOfComponents() : 0;
+
+    if (!isValid()) {
+        return false;
+    }
+
+    // 先在主线程上调用一次 GetCell，保证后续多线程 GetCell(id, vtkGenericCell*) 的线程安全
+    if (m_data->GetNumberOfCells() > 0) {
+        vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+        m_data->GetCell(0, cell);
+    }
+    return true;
+}
+
+void FieldInterpolator::reset()
+{
+    m_data = nullptr;
+    m_locator = nullptr;
+    m_array = nullptr;
+    m_topology.reset();
+    m_numberOfComponents = 0;
+}
+
+bool FieldInterpolator::containsPoint(vtkIdType cellId, const double x[3], Workspace &ws) const
+{
+    int subId = 0;
+    double pcoords[3];
+    double closest[3];
+    double dist2 = 0.0;
+
+    m_data->GetCell(cellId, ws.cell);
+    if (ws.weights.size() < static_cast<size_t>(ws.cell->GetNumberOfPoints())) {
+        ws.weights.resize(ws.cell->GetNumberOfPoints());
+    }
+    return ws.cell->EvaluatePosition(x, closest, subId, pcoords, dist2, ws.weights.data()) == 1;
+}
+
+vtkIdType FieldInterpolator::locateCell(const double x[3], Workspace &ws) const
+{
+    int subId = 0;
+    double pcoords[3];
+
+    // 相邻两次查询通常落在同一单元内，先检查上次命中的单元；
+    // 沿流线前进时通常只跨过一个面，再检查其面邻居
+    if (ws.lastCellId >= 0) {
+        if (containsPoint(ws.lastCellId, x, ws)) {
+            return ws.lastCellId;
+        }
+        if (m_topology) {
+            vtkIdType count = 0;
+            const vtkIdType *neighbors = m_topology->faceNeighbors(ws.lastCellId, count);
+            for (vtkIdType k = 0; k < count; ++k) {
+                if (neighbors[k] >= 0 && containsPoint(neighbors[k], x, ws)) {
+                    ws.lastCellId = neighbors[k];
+                    return ws.lastCellId;
+                }
+            }
+        }
+    }
+
+    double point[3] = {x[0], x[1], x[2]};
+    vtkIdType cellId = m_locator->FindCell(point, 0.0, ws.cell, subId, pcoords, ws.weights.data());
+    ws.lastCellId = cellId;
+    return cellId;
+}
+
+vtkIdType FieldInterpolator::interpolate(const double x[3], double *value, Workspace &ws) const
+{
+    vtkIdType cellId = locateCell(x, ws);
+    if (cellId < 0) {
+        return -1;
+    }
+
+    interpolateInCell(m_array, cellId, ws, value);
+    return cellId;
+}
+
+void FieldInterpolator::interpolateInCell(vtkDataArray *array, vtkIdType cellId,
+                                          const Workspace &ws, double *value) const
+{
+    if (!m_isPointData) {
+        array->GetTuple(cellId, value);
+        return;
+    }
+
+    const int numberOfComponents = array->GetNumberOfComponents();
+    std::fill(value, value + numberOfComponents, 0.0);
+    vtkIdList *pointIds = ws.cell->GetPointIds();
+    const vtkIdType numPoints = pointIds->GetNumberOfIds();
+    for (vtkIdType i = 0; i < numPoints; ++i) {
+        const vtkIdType pointId = pointIds->GetId(i);
+        const double w = ws.weights[i];
+        for (int c = 0; c < numberOfComponents; ++c) {
+            value[c] += w * array->GetComponent(pointId, c);
+        }
+    }
+}
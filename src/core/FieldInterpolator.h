@@ -0,0 +1,63 @@
+#ifndef FIELDINTERPOLATOR_H
+#define FIELDINTERPOLATOR_H
+
+#include <memory>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkAbstractCellLocator.h>
+#include <vtkGenericCell.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataArray.h>
+
+#include "MeshTopology.h"
+
+// 场插值器：在任意位置对点/单元数据进行插值
+// 本身只读，可被多个线程同时使用；每个线程持有自己的 Workspace
+class FieldInterpolator
+{
+public:
+    // 线程私有工作区，缓存上一次命中的单元（单元游走缓存）
+    struct Workspace
+    {
+        Workspace();
+
+        vtkSmartPointer<vtkGenericCell> cell;
+        std::vector<double> weights;
+        vtkIdType lastCellId;
+    };
+
+    FieldInterpolator();
+
+    // topology 可选：提供时上次单元未命中后先检查其面邻居，再退回定位器
+    bool initialize(vtkUnstructuredGrid *data, vtkAbstractCellLocator *locator,
+                    vtkDataArray *array, bool isPointData,
+                    std::shared_ptr<const MeshTopology> topology = nullptr);
+    // 释放对网格、定位器与数组的引用，之后 isValid() 为 false
+    void reset();
+    bool isValid() const { return m_data && m_locator && m_array; }
+    int numberOfComponents() const { return m_numberOfComponents; }
+    vtkUnstructuredGrid *data() const { return m_data; }
+    vtkDataArray *array() const { return m_array; }
+
+    // 在位置x处插值，结果写入value（numberOfComponents个分量）
+    // 返回所在单元ID，位于网格外时返回-1
+    vtkIdType interpolate(const double x[3], double *value, Workspace &ws) const;
+
+    // 复用 interpolate 刚定位到的单元及权重，对同一网格上的另一数组插值（如其他时间步）
+    void interpolateInCell(vtkDataArray *array, vtkIdType cellId, const Workspace &ws, double *value) const;
+
+private:
+    vtkIdType locateCell(const double x[3], Workspace &ws) const;
+    bool containsPoint(vtkIdType cellId, const double x[3], Workspace &ws) const;
+
+    // 持有引用：空间索引重建或网格替换后，旧的定位器与数组在插值器重新初始化前仍然有效
+    vtkSmartPointer<vtkUnstructuredGrid> m_data;
+    vtkSmartPointer<vtkAbstractCellLocator> m_locator;
+    vtkSmartPointer<vtkDataArray> m_array;
+    std::shared_ptr<const MeshTopology> m_topology;
+    bool m_isPointData;
+    int m_numberOfComponents;
+};
+
+#endif // FIELDINTERPOLATOR_H
@@ -0,0 +1,216 @@
+#include "GeometryExporter.h"
+#include "SurfaceExtractor.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrent/QtConcurrent>
+#include <vtkCommand.h>
+#include <vtkErrorCode.h>
+#include <vtkPolyData.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataSetSurfaceFilter.h>
+#include <vtkTriangleFilter.h>
+#include <vtkXMLWriter.h>
+#include <vtkXMLUnstructuredGridWriter.h>
+#include <vtkXMLPolyDataWriter.h>
+#include <vtkWriter.h>
+#include <vtkSTLWriter.h>
+#include <vtkPLYWriter.h>
+#include <cmath>
+
+GeometryExporter::GeometryExporter(QObject *parent)
+    : QObject(parent)
+    , m_canceled(false)
+    , m_writeStarted(false)
+    , m_lastPercent(-1)
+    , m_stageStart(0.0)
+    , m_stageEnd(1.0)
+{
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, [this]() {
+        const QString error = m_watcher.result();
+        if (!error.isEmpty() && m_writeStarted) {
+            // 写出开始后失败或取消时不留下写了一半的文件
+            QFile::remove(m_fileName);
+        }
+        emit finished(m_fileName, error.isEmpty(), error);
+    });
+}
+
+GeometryExporter::~GeometryExporter()
+{
+    m_canceled = true;
+    m_watcher.waitForFinished();
+}
+
+bool GeometryExporter::isSupportedFile(const QString &fileName)
+{
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    return suffix == "vtu" || suffix == "vtp" || suffix == "stl" || suffix == "ply";
+}
+
+QString GeometryExporter::fileFilter(vtkDataObject *data)
+{
+    if (vtkPolyData::SafeDownCast(data)) {
+        return "VTK多边形数据 (*.vtp);;STL文件 (*.stl);;PLY文件 (*.ply)";
+    }
+    return "VTK非结构网格 (*.vtu);;STL表面 (*.stl);;PLY表面 (*.ply)";
+}
+
+bool GeometryExporter::start(vtkDataObject *data, const QString &fileName, int compressionLevel)
+{
+    if (!data || isRunning() || !isSupportedFile(fileName)) {
+        return false;
+    }
+
+    // 浅拷贝只增加数组引用计数，写出期间界面可以继续修改管线
+    vtkSmartPointer<vtkDataObject> snapshot = vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+    snapshot->ShallowCopy(data);
+
+    m_fileName = fileName;
+    m_canceled = false;
+    m_writeStarted = false;
+    m_lastPercent = -1;
+    m_watcher.setFuture(QtConcurrent::run([this, snapshot, fileName, compressionLevel]() {
+        return write(snapshot, fileName, compressionLevel);
+    }));
+    return true;
+}
+
+void GeometryExporter::cancel()
+{
+    m_canceled = true;
+}
+
+QString GeometryExporter::write(vtkSmartPointer<vtkDataObject> data, const QString &fileName, int compressionLevel)
+{
+    TRACE_SCOPE("GeometryExporter::write", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+    const std::string path = fileName.toStdString();
+
+    if (suffix == "vtu" || suffix == "vtp") {
+        vtkSmartPointer<vtkXMLWriter> writer;
+        if (vtkUnstructuredGrid::SafeDownCast(data) && suffix == "vtu") {
+            writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+        } else if (vtkPolyData::SafeDownCast(data) && suffix == "vtp") {
+            writer = vtkSmartPointer<vtkXMLPolyDataWriter>::New();
+        } else {
+            return QString("%1 数据不能保存为 .%2").arg(data->GetClassName()).arg(suffix);
+        }
+
+        writer->SetInputData(data);
+        writer->SetFileName(path.c_str());
+        // 追加的原始二进制，不做 base64 编码
+        writer->SetDataModeToAppended();
+        writer->EncodeAppendedDataOff();
+        if (compressionLevel > 0) {
+            writer->SetCompressorTypeToZLib();
+            writer->SetCompressionLevel(compressionLevel);
+        } else {
+            writer->SetCompressorTypeToNone();
+        }
+
+        m_writeStarted = true;
+        if (!runStage(writer, 0.0, 1.0)) {
+            return m_canceled ? QString("已取消") : QString("写入失败: %1").arg(vtkErrorCode::GetStringFromErrorCode(writer->GetErrorCode()));
+        }
+    } else {
+        // STL/PLY 只保存三角化的外表面；体网格先提取表面，结果远小于原数据
+        vtkSmartPointer<vtkPolyData> surface = vtkPolyData::SafeDownCast(data);
+        vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(data);
+        if (!surface && grid && SurfaceExtractor::select(grid) != SurfaceExtractor::Generic) {
+            // 纯四面体/六面体网格走专用的并行面哈希，不经过 vtkDataSetSurfaceFilter
+            surface = SurfaceExtractor::extract(grid);
+            if (m_canceled) {
+                return QString("已取消");
+            }
+            m_lastPercent = 30;
+            emit progressChanged(30);
+        }
+        if (!surface) {
+            vtkSmartPointer<vtkDataSetSurfaceFilter> surfaceFilter = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+            surfaceFilter->SetInputData(data);
+            if (!runStage(surfaceFilter, 0.0, 0.3)) {
+                return QString("已取消");
+            }
+            surface = surfaceFilter->GetOutput();
+        }
+
+        vtkSmartPointer<vtkTriangleFilter> triangleFilter = vtkSmartPointer<vtkTriangleFilter>::New();
+        triangleFilter->SetInputData(surface);
+        triangleFilter->PassVertsOff();
+        triangleFilter->PassLinesOff();
+        if (!runStage(triangleFilter, 0.3, 0.5)) {
+            return QString("已取消");
+        }
+        vtkSmartPointer<vtkPolyData> triangles = triangleFilter->GetOutput();
+        // 释放中间表面，只保留三角化结果
+        triangleFilter = nullptr;
+        surface = nullptr;
+
+        if (triangles->GetNumberOfPolys() == 0) {
+            return QString("没有可导出的面（流线等线数据请保存为 .vtp）");
+        }
+
+        vtkSmartPointer<vtkWriter> writer;
+        if (suffix == "stl") {
+            vtkSmartPointer<vtkSTLWriter> stlWriter = vtkSmartPointer<vtkSTLWriter>::New();
+            stlWriter->SetFileTypeToBinary();
+            writer = stlWriter;
+        } else {
+            vtkSmartPointer<vtkPLYWriter> plyWriter = vtkSmartPointer<vtkPLYWriter>::New();
+            plyWriter->SetFileTypeToBinary();
+            writer = plyWriter;
+        }
+        writer->SetInputData(triangles);
+        writer->SetFileName(path.c_str());
+
+        m_writeStarted = true;
+        if (!runStage(writer, 0.5, 1.0)) {
+            return m_canceled ? QString("已取消") : QString("写入失败: %1").arg(vtkErrorCode::GetStringFromErrorCode(writer->GetErrorCode()));
+        }
+    }
+
+    qDebug() << "GeometryExporter: 已导出" << fileName << "大小(MB):" << QFileInfo(fileName).size() / (1024.0 * 1024.0)
+             << "耗时(ms):" << timer.elapsed();
+    return QString();
+}
+
+bool GeometryExporter::runStage(vtkAlgorithm *algorithm, double progressStart, double progressEnd)
+{
+    m_stageStart = progressStart;
+    m_stageEnd = progressEnd;
+    unsigned long observer = algorithm->AddObserver(vtkCommand::ProgressEvent, this, &GeometryExporter::onProgress);
+
+    bool ok = true;
+    if (vtkXMLWriter *xmlWriter = vtkXMLWriter::SafeDownCast(algorithm)) {
+        ok = xmlWriter->Write() == 1 && xmlWriter->GetErrorCode() == vtkErrorCode::NoError;
+    } else if (vtkWriter *writer = vtkWriter::SafeDownCast(algorithm)) {
+        ok = writer->Write() == 1 && writer->GetErrorCode() == vtkErrorCode::NoError;
+    } else {
+        algorithm->Update();
+    }
+
+    algorithm->RemoveObserver(observer);
+    return ok && !m_canceled;
+}
+
+void GeometryExporter::onProgress(vtkObject *caller, unsigned long eventId, void *callData)
+{
+    Q_UNUSED(eventId);
+    if (m_canceled) {
+        // 写出器与过滤器在下一次检查时中止
+        vtkAlgorithm::SafeDownCast(caller)->SetAbortExecute(1);
+        return;
+    }
+
+    const double progress = callData ? *static_cast<double *>(callData) : 0.0;
+    const int percent = static_cast<int>(std::lround((m_stageStart + (m_stageEnd - m_stageStart) * progress) * 100.0));
+    if (m_lastPercent.exchange(percent) != percent) {
+        emit progressChanged(percent);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef GEOMETRYEXPORTER_H
+#define GEOMETRYEXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include <QFutureWatcher>
+
+#include <atomic>
+
+#include <vtkSmartPointer.h>
+#include <vtkDataObject.h>
+#include <vtkAlgorithm.h>
+
+// 派生几何导出：把剖切、等值面、变形图等过滤器的输出在后台线程写成
+// 二进制 VTU/VTP（可选压缩级别）、STL 或 PLY。
+// 输入只做浅拷贝（共享数组引用计数），写出器逐块读取数组直接写盘，不产生整份数据副本；
+// 导出期间管线重新执行会分配新的数组，不影响正在写出的数据
+class GeometryExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GeometryExporter(QObject *parent = nullptr);
+    ~GeometryExporter();
+
+    // 由文件扩展名确定格式：.vtu/.vtp（XML，按数据类型）、.stl、.ply
+    static bool isSupportedFile(const QString &fileName);
+    // 适合该数据类型的保存对话框过滤器，第一项为默认
+    static QString fileFilter(vtkDataObject *data);
+
+    // 开始后台导出；compressionLevel 为 0 时不压缩，1-9 为 zlib 压缩级别（仅 XML 格式）
+    bool start(vtkDataObject *data, const QString &fileName, int compressionLevel);
+    bool isRunning() const { return m_watcher.isRunning(); }
+
+public slots:
+    void cancel();
+
+signals:
+    void progressChanged(int percent);
+    void finished(const QString &fileName, bool ok, const QString &message);
+
+private:
+    QString write(vtkSmartPointer<vtkDataObject> data, const QString &fileName, int compressionLevel);
+    // 执行一个阶段（过滤器 Update 或写出器 Write），进度映射到 [progressStart, progressEnd]
+    bool runStage(vtkAlgorithm *algorithm, double progressStart, double progressEnd);
+    void onProgress(vtkObject *caller, unsigned long eventId, void *callData);
+
+    QFutureWatcher<QString> m_watcher;
+    QString m_fileName;
+    std::atomic<bool> m_canceled;
+    std::atomic<bool> m_writeStarted;   // 已开始写出目标文件；此前的失败不能删除用户原有的同名文件
+    std::atomic<int> m_lastPercent;
+    double m_stageStart;
+    double m_stageEnd;
+};
+
+#endif // GEOMETRYEXPORTER_H
@@ -0,0 +1,158 @@
+#include "MemoryManager.h"
+#include <QDebug>
+#include <vtkDataObject.h>
+#include <vtkInformation.h>
+#include <vtksys/SystemInformation.hxx>
+#include <algorithm>
+
+MemoryManager::MemoryManager()
+    : m_budget(defaultBudget())
+    , m_clock(0)
+{
+}
+
+void MemoryManager::addStage(const QString &name, std::function<size_t()> bytes,
+                             std::function<bool()> isActive, std::function<void()> release)
+{
+    Stage stage;
+    stage.name = name;
+    stage.bytes = std::move(bytes);
+    stage.isActive = std::move(isActive);
+    stage.release = std::move(release);
+    stage.lastUsed = ++m_clock;
+    m_stages.push_back(stage);
+}
+
+void MemoryManager::addPinnedStage(const QString &name, std::function<size_t()> bytes)
+{
+    addStage(name, std::move(bytes), [] { return true; }, [] {});
+    m_stages.back().pinned = true;
+}
+
+void MemoryManager::addAlgorithmStage(const QString &name, vtkAlgorithm *algorithm, std::function<bool()> isActive)
+{
+    vtkSmartPointer<vtkAlgorithm> filter = algorithm;
+
+    auto bytes = [filter]() -> size_t {
+        size_t total = 0;
+        for (int port = 0; port < filter->GetNumberOfOutputPorts(); ++port) {
+            vtkDataObject *output = existingOutput(filter, port);
+            if (output && !output->GetDataReleased()) {
+                total += static_cast<size_t>(output->GetActualMemorySize()) * 1024;
+            }
+        }
+        return total;
+    };
+
+    auto release = [filter]() {
+        for (int port = 0; port < filter->GetNumberOfOutputPorts(); ++port) {
+            if (vtkDataObject *output = existingOutput(filter, port)) {
+                output->ReleaseData();
+            }
+        }
+    };
+
+    addStage(name, bytes, std::move(isActive), release);
+}
+
+MemoryManager::Stage *MemoryManager::find(const QString &name)
+{
+    for (Stage &stage : m_stages) {
+        if (stage.name == name) {
+            return &stage;
+        }
+    }
+    return nullptr;
+}
+
+void MemoryManager::touch(const QString &name)
+{
+    if (Stage *stage = find(name)) {
+        stage->lastUsed = ++m_clock;
+    }
+}
+
+size_t MemoryManager::totalBytes() const
+{
+    size_t total = 0;
+    for (const Stage &stage : m_stages) {
+        total += stage.bytes();
+    }
+    return total;
+}
+
+QStringList MemoryManager::enforce()
+{
+    QStringList released;
+    size_t total = totalBytes();
+    if (total <= m_budget) {
+        return released;
+    }
+
+    // 候选：非固定、当前不活动且有占用的阶段，最久未使用的先释放
+    std::vector<Stage *> candidates;
+    for (Stage &stage : m_stages) {
+        if (!stage.pinned && !stage.isActive()) {
+            candidates.push_back(&stage);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Stage *a, const Stage *b) { return a->lastUsed < b->lastUsed; });
+
+    for (Stage *stage : candidates) {
+        if (total <= m_budget) {
+            break;
+        }
+        const size_t bytes = stage->bytes();
+        if (bytes == 0) {
+            continue;
+        }
+        stage->release();
+        total = totalBytes();
+        released << stage->name;
+        qDebug() << "MemoryManager: 释放阶段" << stage->name << "约" << formatBytes(bytes);
+    }
+
+    if (total > m_budget) {
+        qDebug() << "MemoryManager: 释放后仍超出预算，当前占用" << formatBytes(total)
+                 << "预算" << formatBytes(m_budget);
+    }
+    return released;
+}
+
+QString MemoryManager::report() const
+{
+    QStringList lines;
+    for (const Stage &stage : m_stages) {
+        QString state = stage.pinned ? "常驻" : (stage.isActive() ? "活动" : "非活动");
+        lines << QString("%1: %2 (%3)").arg(stage.name, formatBytes(stage.bytes()), state);
+    }
+    lines << QString("合计: %1 / 预算 %2").arg(formatBytes(totalBytes()), formatBytes(m_budget));
+    return lines.join("\n");
+}
+
+size_t MemoryManager::defaultBudget()
+{
+    vtksys::SystemInformation info;
+    info.RunMemoryCheck();
+    const size_t physicalMB = info.GetTotalPhysicalMemory();
+    if (physicalMB == 0) {
+        return static_cast<size_t>(4096) * 1024 * 1024; // 无法获取时按4GB
+    }
+    return physicalMB * 1024 * 1024 / 10 * 6;
+}
+
+QString MemoryManager::formatBytes(size_t bytes)
+{
+    const double mb = bytes / (1024.0 * 1024.0);
+    if (mb >= 1024.0) {
+        return QString("%1 GB").arg(mb / 1024.0, 0, 'f', 2);
+    }
+    return QString("%1 MB").arg(mb, 0, 'f', 1);
+}
+
+vtkDataObject *MemoryManager::existingOutput(vtkAlgorithm *algorithm, int port)
+{
+    vtkInformation *info = algorithm->GetOutputInformation(port);
+    return info ? info->Get(vtkDataObject::DATA_OBJECT()) : nullptr;
+}
@@ -0,0 +1,67 @@
+#ifndef MEMORYMANAGER_H
+#define MEMORYMANAGER_H
+
+#include <QString>
+#include <QStringList>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkAlgorithm.h>
+#include <vtkDataObject.h>
+
+// 内存预算管理：按管线阶段统计占用字节数，超出预算时按最近最少使用顺序
+// 释放非活动阶段的输出。被释放的过滤器输出标记为已释放，下次 Update 时自动重算
+class MemoryManager
+{
+public:
+    struct Stage
+    {
+        QString name;
+        std::function<size_t()> bytes;
+        std::function<bool()> isActive;   // 活动阶段（正在显示/使用）不会被释放
+        std::function<void()> release;
+        bool pinned = false;              // 仅统计、从不释放（如当前数据集本身）
+        unsigned long long lastUsed = 0;
+    };
+
+    MemoryManager();
+
+    // 登记通用阶段
+    void addStage(const QString &name, std::function<size_t()> bytes,
+                  std::function<bool()> isActive, std::function<void()> release);
+    // 登记只统计不释放的阶段
+    void addPinnedStage(const QString &name, std::function<size_t()> bytes);
+    // 登记VTK过滤器：统计其全部输出端口的数据，释放时调用 ReleaseData
+    void addAlgorithmStage(const QString &name, vtkAlgorithm *algorithm, std::function<bool()> isActive);
+
+    // 标记阶段刚被使用（LRU排序依据）
+    void touch(const QString &name);
+
+    void setBudget(size_t bytes) { m_budget = bytes; }
+    size_t budget() const { return m_budget; }
+    size_t totalBytes() const;
+
+    // 超出预算时按LRU释放非活动阶段，返回被释放的阶段名称
+    QStringList enforce();
+
+    // 各阶段占用情况（多行文本）
+    QString report() const;
+
+    // 默认预算：物理内存的60%
+    static size_t defaultBudget();
+    static QString formatBytes(size_t bytes);
+    // 过滤器输出端口上已有的数据对象，不触发管线创建或执行（PipelineMonitor 也用它统计输出）
+    static vtkDataObject *existingOutput(vtkAlgorithm *algorithm, int port);
+
+private:
+    Stage *find(const QString &name);
+
+    std::vector<Stage> m_stages;
+    size_t m_budget;
+    unsigned long long m_clock;
+};
+
+#endif // MEMORYMANAGER_H
@@ -0,0 +1,587 @@
+#include "MeshReorderer.h"
+#include "MeshTopology.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vtkSmartPointer.h>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkCellType.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetAttributes.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+const char *MeshReorderer::ORIGINAL_POINT_IDS = "OriginalPointIds";
+const char *MeshReorderer::ORIGINAL_CELL_IDS = "OriginalCellIds";
+
+bool MeshReorderer::isIdMapArray(const char *name)
+{
+    return name && (std::strcmp(name, ORIGINAL_POINT_IDS) == 0 || std::strcmp(name, ORIGINAL_CELL_IDS) == 0
+                    || std::strcmp(name, "vtkOriginalPointIds") == 0 || std::strcmp(name, "vtkOriginalCellIds") == 0);
+}
+
+namespace
+{
+const int KEY_BITS = 21;                        // 每轴量化位数，三轴交错后共 63 位
+const double KEY_MAX = (1u << KEY_BITS) - 1;
+const int PERIPHERAL_ITERATIONS = 4;            // 伪外围点搜索的最大迭代次数
+
+typedef std::pair<uint64_t, vtkIdType> KeyedId;
+
+// 把 21 位整数的各位之间插入两个 0 位
+inline uint64_t spreadBits(uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+inline uint64_t mortonKey(uint32_t x, uint32_t y, uint32_t z)
+{
+    return spreadBits(x) << 2 | spreadBits(y) << 1 | spreadBits(z);
+}
+
+// Skilling 转置法：先把坐标变换为 Hilbert 转置形式，按位交错后即为曲线上的序号
+inline uint64_t hilbertKey(uint32_t x, uint32_t y, uint32_t z)
+{
+    uint32_t X[3] = {x, y, z};
+    const uint32_t M = 1u << (KEY_BITS - 1);
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                const uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+    // 格雷码编码
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q) {
+            t ^= Q - 1;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        X[i] ^= t;
+    }
+    return mortonKey(X[0], X[1], X[2]);
+}
+
+// 坐标按包围盒最长边等比例量化，曲线单元保持立方体，细长模型也不会沿短边过度细分
+class CurveKey
+{
+public:
+    CurveKey(const double bounds[6], MeshReorderer::Method method)
+        : m_method(method)
+    {
+        double extent = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            m_origin[c] = bounds[2 * c];
+            extent = std::max(extent, bounds[2 * c + 1] - bounds[2 * c]);
+        }
+        m_scale = extent > 0.0 ? KEY_MAX / extent : 0.0;
+    }
+
+    uint64_t operator()(const double x[3]) const
+    {
+        uint32_t q[3];
+        for (int c = 0; c < 3; ++c) {
+            const double v = (x[c] - m_origin[c]) * m_scale;
+            q[c] = static_cast<uint32_t>(std::min(std::max(v, 0.0), KEY_MAX));
+        }
+        return m_method == MeshReorderer::Hilbert ? hilbertKey(q[0], q[1], q[2]) : mortonKey(q[0], q[1], q[2]);
+    }
+
+private:
+    MeshReorderer::Method m_method;
+    double m_origin[3];
+    double m_scale;
+};
+
+// 键相同时按原编号排序，结果与线程数无关
+std::vector<vtkIdType> sortedIds(std::vector<KeyedId> &keys)
+{
+    vtkSMPTools::Sort(keys.begin(), keys.end());
+    std::vector<vtkIdType> order(keys.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(keys.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            order[i] = keys[i].second;
+        }
+    });
+    return order;
+}
+
+std::vector<vtkIdType> curvePointOrder(vtkUnstructuredGrid *grid, const CurveKey &curveKey)
+{
+    vtkPoints *points = grid->GetPoints();
+    std::vector<KeyedId> keys(static_cast<size_t>(grid->GetNumberOfPoints()));
+    vtkSMPTools::For(0, grid->GetNumberOfPoints(), [&](vtkIdType first, vtkIdType last) {
+        double x[3];
+        for (vtkIdType i = first; i < last; ++i) {
+            points->GetPoint(i, x);
+            keys[i] = KeyedId(curveKey(x), i);
+        }
+    });
+    return sortedIds(keys);
+}
+
+// 反向 Cuthill-McKee：节点邻接图（同一单元内的点互相邻接）按 CSR 存储，
+// 每个连通分量从伪外围点（George-Liu 迭代）开始广度优先编号，邻点按度数升序入队，最后整体反转
+std::vector<vtkIdType> rcmPointOrder(vtkUnstructuredGrid *grid)
+{
+    const vtkIdType numPoints = grid->GetNumberOfPoints();
+    vtkCellArray *cells = grid->GetCells();
+    // 重排会改变连接，这里的点→单元表只在本次使用，不放进 SpatialIndex
+    std::shared_ptr<const MeshTopology> topology = MeshTopology::build(grid, false);
+
+    vtkSMPThreadLocal<std::vector<vtkIdType>> localNeighbors;
+    vtkSMPThreadLocalObject<vtkIdList> localIdLists;
+    auto gatherNeighbors = [&](vtkIdType pointId, std::vector<vtkIdType> &neighbors, vtkIdList *idList) {
+        neighbors.clear();
+        vtkIdType numCells = 0;
+        const vtkIdType *cellIds = topology->pointCells(pointId, numCells);
+        for (vtkIdType k = 0; k < numCells; ++k) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(cellIds[k], npts, pts, idList);
+            for (vtkIdType j = 0; j < npts; ++j) {
+                if (pts[j] != pointId) {
+                    neighbors.push_back(pts[j]);
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    };
+
+    // 第一遍统计度数，第二遍写入邻接表
+    std::vector<vtkIdType> adjacencyOffsets(static_cast<size_t>(numPoints) + 1, 0);
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+        std::vector<vtkIdType> &neighbors = localNeighbors.Local();
+        vtkIdList *idList = localIdLists.Local();
+        for (vtkIdType p = first; p < last; ++p) {
+            gatherNeighbors(p, neighbors, idList);
+            adjacencyOffsets[p + 1] = static_cast<vtkIdType>(neighbors.size());
+        }
+    });
+    for (vtkIdType p = 0; p < numPoints; ++p) {
+        adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+    }
+    std::vector<vtkIdType> adjacency(static_cast<size_t>(adjacencyOffsets[numPoints]));
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+        std::vector<vtkIdType> &neighbors = localNeighbors.Local();
+        vtkIdList *idList = localIdLists.Local();
+        for (vtkIdType p = first; p < last; ++p) {
+            gatherNeighbors(p, neighbors, idList);
+            std::copy(neighbors.begin(), neighbors.end(), adjacency.begin() + adjacencyOffsets[p]);
+        }
+    });
+
+    auto degree = [&adjacencyOffsets](vtkIdType p) { return adjacencyOffsets[p + 1] - adjacencyOffsets[p]; };
+    auto byDegree = [&degree](vtkIdType a, vtkIdType b) {
+        return degree(a) != degree(b) ? degree(a) < degree(b) : a < b;
+    };
+
+    // 各分量的起点候选：按度数升序遍历
+    std::vector<KeyedId> degreeKeys(static_cast<size_t>(numPoints));
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType p = first; p < last; ++p) {
+            degreeKeys[p] = KeyedId(static_cast<uint64_t>(degree(p)), p);
+        }
+    });
+    const std::vector<vtkIdType> candidates = sortedIds(degreeKeys);
+
+    // 层次结构：返回从 root 出发的最大层数，lastLevel 为最外层的点
+    std::vector<int> visitStamp(static_cast<size_t>(numPoints), 0);
+    int stamp = 0;
+    std::vector<vtkIdType> level;
+    std::vector<vtkIdType> nextLevel;
+    auto levelStructure = [&](vtkIdType root, std::vector<vtkIdType> &lastLevel) {
+        ++stamp;
+        level.assign(1, root);
+        visitStamp[root] = stamp;
+        int depth = 0;
+        for (;;) {
+            nextLevel.clear();
+            for (vtkIdType v : level) {
+                for (vtkIdType k = adjacencyOffsets[v]; k < adjacencyOffsets[v + 1]; ++k) {
+                    const vtkIdType u = adjacency[k];
+                    if (visitStamp[u] != stamp) {
+                        visitStamp[u] = stamp;
+                        nextLevel.push_back(u);
+                    }
+                }
+            }
+            if (nextLevel.empty()) {
+                break;
+            }
+            level.swap(nextLevel);
+            ++depth;
+        }
+        lastLevel = level;
+        return depth;
+    };
+
+    auto pseudoPeripheral = [&](vtkIdType start) {
+        std::vector<vtkIdType> lastLevel;
+        std::vector<vtkIdType> candidateLevel;
+        int depth = levelStructure(start, lastLevel);
+        for (int iteration = 0; iteration < PERIPHERAL_ITERATIONS; ++iteration) {
+            const vtkIdType candidate = *std::min_element(lastLevel.begin(), lastLevel.end(), byDegree);
+            const int candidateDepth = levelStructure(candidate, candidateLevel);
+            if (candidateDepth <= depth) {
+                break;
+            }
+            start = candidate;
+            depth = candidateDepth;
+            lastLevel.swap(candidateLevel);
+        }
+        return start;
+    };
+
+    std::vector<vtkIdType> order;
+    order.reserve(static_cast<size_t>(numPoints));
+    std::vector<unsigned char> numbered(static_cast<size_t>(numPoints), 0);
+    std::vector<vtkIdType> neighbors;
+    size_t cursor = 0;
+    for (vtkIdType seed : candidates) {
+        if (numbered[seed]) {
+            continue;
+        }
+        const vtkIdType root = pseudoPeripheral(seed);
+        numbered[root] = 1;
+        order.push_back(root);
+        while (cursor < order.size()) {
+            const vtkIdType v = order[cursor++];
+            neighbors.clear();
+            for (vtkIdType k = adjacencyOffsets[v]; k < adjacencyOffsets[v + 1]; ++k) {
+                const vtkIdType u = adjacency[k];
+                if (!numbered[u]) {
+                    numbered[u] = 1;
+                    neighbors.push_back(u);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), byDegree);
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// 单元排序键：曲线重排用形心的曲线键，RCM 用单元内最小的新点号
+std::vector<vtkIdType> sortCells(vtkUnstructuredGrid *grid, MeshReorderer::Method method, const CurveKey &curveKey,
+                                const std::vector<vtkIdType> &newPointId)
+{
+    vtkPoints *points = grid->GetPoints();
+    vtkCellArray *cells = grid->GetCells();
+    std::vector<KeyedId> keys(static_cast<size_t>(grid->GetNumberOfCells()));
+    vtkSMPThreadLocalObject<vtkIdList> localIdLists;
+    vtkSMPTools::For(0, grid->GetNumberOfCells(), [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *idList = localIdLists.Local();
+        double x[3];
+        for (vtkIdType c = first; c < last; ++c) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, idList);
+            uint64_t key = 0;
+            if (method == MeshReorderer::RCM) {
+                vtkIdType minId = grid->GetNumberOfPoints();
+                for (vtkIdType k = 0; k < npts; ++k) {
+                    minId = std::min(minId, newPointId[pts[k]]);
+                }
+                key = static_cast<uint64_t>(minId);
+            } else {
+                double centroid[3] = {0.0, 0.0, 0.0};
+                for (vtkIdType k = 0; k < npts; ++k) {
+                    points->GetPoint(pts[k], x);
+                    centroid[0] += x[0];
+                    centroid[1] += x[1];
+                    centroid[2] += x[2];
+                }
+                const double scale = npts > 0 ? 1.0 / npts : 0.0;
+                centroid[0] *= scale;
+                centroid[1] *= scale;
+                centroid[2] *= scale;
+                key = curveKey(centroid);
+            }
+            keys[c] = KeyedId(key, c);
+        }
+    });
+    return sortedIds(keys);
+}
+
+template <typename T>
+void gatherTuples(const T *source, T *target, int components, const std::vector<vtkIdType> &order)
+{
+    vtkSMPTools::For(0, static_cast<vtkIdType>(order.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            std::copy_n(source + order[i] * components, components, target + i * components);
+        }
+    });
+}
+
+// 逐个置换数组后整体替换，数组顺序与活动属性（标量、矢量等）保持不变
+void permuteAttributes(vtkDataSetAttributes *attributes, const std::vector<vtkIdType> &order)
+{
+    vtkSmartPointer<vtkDataSetAttributes> result = vtkSmartPointer<vtkDataSetAttributes>::Take(attributes->NewInstance());
+    MeshReorderer::gatherAttributes(attributes, order, result);
+    attributes->ShallowCopy(result);
+}
+
+// 已有原始编号数组（重复重排）时它已随其他数组一起置换，仍指向文件中的编号
+void addReverseMap(vtkDataSetAttributes *attributes, const char *name, const std::vector<vtkIdType> &order)
+{
+    if (attributes->GetAbstractArray(name)) {
+        return;
+    }
+    vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+    ids->SetName(name);
+    ids->SetNumberOfTuples(static_cast<vtkIdType>(order.size()));
+    std::copy(order.begin(), order.end(), ids->GetPointer(0));
+    attributes->AddArray(ids);
+}
+
+// pointOrder[新编号] = 旧编号，newPointId 为其逆映射；cellOrder 同理
+void applyOrder(vtkUnstructuredGrid *grid, const std::vector<vtkIdType> &pointOrder,
+                const std::vector<vtkIdType> &newPointId, const std::vector<vtkIdType> &cellOrder)
+{
+    const vtkIdType numCells = grid->GetNumberOfCells();
+
+    vtkSmartPointer<vtkAbstractArray> coordinates = MeshReorderer::gathered(grid->GetPoints()->GetData(), pointOrder);
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(vtkDataArray::SafeDownCast(coordinates));
+
+    // 偏移为前缀和需串行计算，连接数组按单元并行写入新点号
+    vtkCellArray *cells = grid->GetCells();
+    vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfTuples(numCells + 1);
+    vtkIdType *offsetValues = offsets->GetPointer(0);
+    offsetValues[0] = 0;
+    for (vtkIdType i = 0; i < numCells; ++i) {
+        offsetValues[i + 1] = offsetValues[i] + cells->GetCellSize(cellOrder[i]);
+    }
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfTuples(offsetValues[numCells]);
+    vtkIdType *connectivityValues = connectivity->GetPointer(0);
+    vtkSMPThreadLocalObject<vtkIdList> localIdLists;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *idList = localIdLists.Local();
+        for (vtkIdType i = first; i < last; ++i) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(cellOrder[i], npts, pts, idList);
+            vtkIdType *target = connectivityValues + offsetValues[i];
+            for (vtkIdType k = 0; k < npts; ++k) {
+                target[k] = newPointId[pts[k]];
+            }
+        }
+    });
+    vtkSmartPointer<vtkCellArray> newCells = vtkSmartPointer<vtkCellArray>::New();
+    newCells->SetData(offsets, connectivity);
+
+    vtkSmartPointer<vtkAbstractArray> types = MeshReorderer::gathered(grid->GetCellTypesArray(), cellOrder);
+
+    grid->SetPoints(points);
+    grid->SetCells(vtkUnsignedCharArray::SafeDownCast(types), newCells);
+    permuteAttributes(grid->GetPointData(), pointOrder);
+    permuteAttributes(grid->GetCellData(), cellOrder);
+    addReverseMap(grid->GetPointData(), MeshReorderer::ORIGINAL_POINT_IDS, pointOrder);
+    addReverseMap(grid->GetCellData(), MeshReorderer::ORIGINAL_CELL_IDS, cellOrder);
+    grid->Modified();
+}
+
+bool hasPolyhedra(vtkUnstructuredGrid *grid)
+{
+    vtkUnsignedCharArray *types = grid->GetCellTypesArray();
+    const unsigned char *begin = types->GetPointer(0);
+    return std::find(begin, begin + types->GetNumberOfValues(), static_cast<unsigned char>(VTK_POLYHEDRON))
+        != begin + types->GetNumberOfValues();
+}
+
+// 由 order 求逆映射，order 不是 0..n-1 的排列时返回 false
+bool invert(const std::vector<vtkIdType> &order, std::vector<vtkIdType> &inverse)
+{
+    const vtkIdType count = static_cast<vtkIdType>(order.size());
+    inverse.assign(order.size(), -1);
+    for (vtkIdType i = 0; i < count; ++i) {
+        const vtkIdType id = order[i];
+        if (id < 0 || id >= count || inverse[id] >= 0) {
+            return false;
+        }
+        inverse[id] = i;
+    }
+    return true;
+}
+
+std::vector<vtkIdType> idValues(vtkIdTypeArray *ids)
+{
+    return std::vector<vtkIdType>(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfTuples());
+}
+}
+
+QString MeshReorderer::methodName(Method method)
+{
+    switch (method) {
+    case Morton:
+        return "Morton";
+    case Hilbert:
+        return "Hilbert";
+    case RCM:
+        return "RCM";
+    default:
+        return "不重排";
+    }
+}
+
+bool MeshReorderer::reorder(vtkUnstructuredGrid *grid, Method method, QString *error)
+{
+    TRACE_SCOPE("MeshReorderer::reorder", "core");
+    if (method == None) {
+        return false;
+    }
+    if (!grid || !grid->GetPoints() || !grid->GetCells()
+        || grid->GetNumberOfPoints() == 0 || grid->GetNumberOfCells() == 0) {
+        if (error) {
+            *error = "网格为空";
+        }
+        return false;
+    }
+    if (hasPolyhedra(grid)) {
+        if (error) {
+            *error = "含多面体单元，不支持重排";
+        }
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    double bounds[6];
+    grid->GetPoints()->GetBounds(bounds);
+    const CurveKey curveKey(bounds, method);
+
+    const std::vector<vtkIdType> pointOrder = method == RCM ? rcmPointOrder(grid) : curvePointOrder(grid, curveKey);
+    std::vector<vtkIdType> newPointId(pointOrder.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(pointOrder.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            newPointId[pointOrder[i]] = i;
+        }
+    });
+    const std::vector<vtkIdType> cellOrder = sortCells(grid, method, curveKey, newPointId);
+    applyOrder(grid, pointOrder, newPointId, cellOrder);
+
+    qDebug() << "MeshReorderer:" << methodName(method) << "重排" << grid->GetNumberOfPoints() << "个点,"
+             << grid->GetNumberOfCells() << "个单元, 耗时(ms):" << timer.elapsed();
+    return true;
+}
+
+bool MeshReorderer::reorderLike(vtkUnstructuredGrid *grid, vtkUnstructuredGrid *reference)
+{
+    if (!grid || !reference || grid->GetPointData()->GetAbstractArray(ORIGINAL_POINT_IDS)) {
+        return false;
+    }
+    vtkIdTypeArray *pointIds = vtkIdTypeArray::SafeDownCast(reference->GetPointData()->GetAbstractArray(ORIGINAL_POINT_IDS));
+    vtkIdTypeArray *cellIds = vtkIdTypeArray::SafeDownCast(reference->GetCellData()->GetAbstractArray(ORIGINAL_CELL_IDS));
+    if (!pointIds || !cellIds) {
+        return false;
+    }
+    return permute(grid, idValues(pointIds), idValues(cellIds));
+}
+
+bool MeshReorderer::permute(vtkUnstructuredGrid *grid, const std::vector<vtkIdType> &pointOrder,
+                            const std::vector<vtkIdType> &cellOrder)
+{
+    if (!grid || !grid->GetPoints() || !grid->GetCells()
+        || static_cast<vtkIdType>(pointOrder.size()) != grid->GetNumberOfPoints()
+        || static_cast<vtkIdType>(cellOrder.size()) != grid->GetNumberOfCells()
+        || hasPolyhedra(grid)) {
+        return false;
+    }
+    std::vector<vtkIdType> newPointId;
+    std::vector<vtkIdType> newCellId;
+    if (!invert(pointOrder, newPointId) || !invert(cellOrder, newCellId)) {
+        return false;
+    }
+    applyOrder(grid, pointOrder, newPointId, cellOrder);
+    return true;
+}
+
+vtkSmartPointer<vtkAbstractArray> MeshReorderer::gathered(vtkAbstractArray *array, const std::vector<vtkIdType> &order)
+{
+    vtkSmartPointer<vtkAbstractArray> result = vtkSmartPointer<vtkAbstractArray>::Take(array->NewInstance());
+    result->SetName(array->GetName());
+    result->SetNumberOfComponents(array->GetNumberOfComponents());
+    result->CopyComponentNames(array);
+    result->SetNumberOfTuples(static_cast<vtkIdType>(order.size()));
+
+    bool done = false;
+    vtkDataArray *data = vtkDataArray::SafeDownCast(array);
+    if (data && data->HasStandardMemoryLayout() && result->HasStandardMemoryLayout() && !order.empty()) {
+        switch (data->GetDataType()) {
+            vtkTemplateMacro(
+                gatherTuples(static_cast<const VTK_TT *>(data->GetVoidPointer(0)),
+                             static_cast<VTK_TT *>(result->GetVoidPointer(0)),
+                             data->GetNumberOfComponents(), order);
+                done = true);
+        }
+    }
+    if (!done) {
+        // 字符串数组等其他布局走通用路径
+        vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+        ids->SetNumberOfIds(static_cast<vtkIdType>(order.size()));
+        std::copy(order.begin(), order.end(), ids->GetPointer(0));
+        array->GetTuples(ids, result);
+    }
+    return result;
+}
+
+void MeshReorderer::gatherAttributes(vtkDataSetAttributes *source, const std::vector<vtkIdType> &order,
+                                     vtkDataSetAttributes *target)
+{
+    target->Initialize();
+    for (int i = 0; i < source->GetNumberOfArrays(); ++i) {
+        target->AddArray(gathered(source->GetAbstractArray(i), order));
+    }
+    int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    source->GetAttributeIndices(indices);
+    for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute) {
+        if (indices[attribute] >= 0) {
+            target->SetActiveAttribute(indices[attribute], attribute);
+        }
+    }
+}
+
+vtkIdType MeshReorderer::originalPointId(vtkDataSet *data, vtkIdType pointId)
+{
+    vtkIdTypeArray *ids = data ? vtkIdTypeArray::SafeDownCast(data->GetPointData()->GetAbstractArray(ORIGINAL_POINT_IDS)) : nullptr;
+    return ids && pointId >= 0 && pointId < ids->GetNumberOfTuples() ? ids->GetValue(pointId) : pointId;
+}
+
+vtkIdType MeshReorderer::originalCellId(vtkDataSet *data, vtkIdType cellId)
+{
+    vtkIdTypeArray *ids = data ? vtkIdTypeArray::SafeDownCast(data->GetCellData()->GetAbstractArray(ORIGINAL_CELL_IDS)) : nullptr;
+    return ids && cellId >= 0 && cellId < ids->GetNumberOfTuples() ? ids->GetValue(cellId) : cellId;
+}
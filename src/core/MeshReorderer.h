@@ -0,0 +1,64 @@
+#ifndef MESHREORDERER_H
+#define MESHREORDERER_H
+
+#include <QString>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkAbstractArray.h>
+#include <vtkDataSetAttributes.h>
+
+// 加载时网格重排：求解器输出的节点/单元编号常常近乎随机，相邻单元在内存中相距很远，
+// 表面提取、剖切、等值面、插值与流线追踪的每一趟遍历都会因此频繁缓存未命中。
+// 按空间填充曲线（Morton / Hilbert，点坐标与单元形心各量化为每轴 21 位）或
+// RCM（反向 Cuthill-McKee，按节点邻接图做带宽缩减）重新编号点，单元再按形心曲线键
+// （RCM 时按最小新点号）排序；所有点/单元数组与连接一致地置换。
+//
+// 重排后新增 OriginalPointIds / OriginalCellIds 两个 vtkIdType 数组记录每个新编号对应的
+// 文件中编号，DataPicker 据此显示原始 ID；再次重排时两数组随之置换，始终指向文件编号
+class MeshReorderer
+{
+public:
+    enum Method
+    {
+        None,
+        Morton,
+        Hilbert,
+        RCM
+    };
+
+    static const char *ORIGINAL_POINT_IDS;
+    static const char *ORIGINAL_CELL_IDS;
+
+    // 编号映射数组（本类的原始编号与表面提取的 vtkOriginal*Ids），不是结果数据，不参与着色与派生场
+    static bool isIdMapArray(const char *name);
+
+    static QString methodName(Method method);
+
+    // 原地重排；method 为 None、网格为空或含多面体单元时不做修改并返回 false
+    static bool reorder(vtkUnstructuredGrid *grid, Method method, QString *error = nullptr);
+
+    // 按 reference 中记录的原始编号重排 grid（同一网格重新读取时沿用已有顺序），
+    // 点数、单元数不一致或 reference 未重排过时返回 false
+    static bool reorderLike(vtkUnstructuredGrid *grid, vtkUnstructuredGrid *reference);
+
+    // 按给定顺序置换：pointOrder[新编号] = 旧编号，cellOrder 同理；不是排列时返回 false
+    static bool permute(vtkUnstructuredGrid *grid, const std::vector<vtkIdType> &pointOrder,
+                        const std::vector<vtkIdType> &cellOrder);
+
+    // 当前编号对应的文件中编号，未重排时原样返回
+    static vtkIdType originalPointId(vtkDataSet *data, vtkIdType pointId);
+    static vtkIdType originalCellId(vtkDataSet *data, vtkIdType cellId);
+
+    // 新数组第 i 个元组取自 array 第 order[i] 个元组，order 可以只取部分编号（如表面提取时的表面点）；
+    // 不修改原数组，仍被其他对象引用时不受影响
+    static vtkSmartPointer<vtkAbstractArray> gathered(vtkAbstractArray *array, const std::vector<vtkIdType> &order);
+
+    // 对 source 的每个数组做 gathered 后放入 target（原有数组清空），数组顺序与活动属性保持不变
+    static void gatherAttributes(vtkDataSetAttributes *source, const std::vector<vtkIdType> &order,
+                                 vtkDataSetAttributes *target);
+};
+
+#endif // MESHREORDERER_H
@@ -0,0 +1,220 @@
+#include "MeshTopology.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkCellArray.h>
+#include <vtkCellTypes.h>
+#include <vtkGenericCell.h>
+#include <vtkIdList.h>
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+// 单元的"面"：三维单元取面，二维单元取边，其余没有面邻居
+int faceCount(vtkGenericCell *cell)
+{
+    switch (cell->GetCellDimension()) {
+    case 3:
+        return cell->GetNumberOfFaces();
+    case 2:
+        return cell->GetNumberOfEdges();
+    default:
+        return 0;
+    }
+}
+
+vtkCell *face(vtkGenericCell *cell, int faceId)
+{
+    return cell->GetCellDimension() == 3 ? cell->GetFace(faceId) : cell->GetEdge(faceId);
+}
+}
+
+std::shared_ptr<const MeshTopology> MeshTopology::build(vtkUnstructuredGrid *grid, bool withFaceNeighbors)
+{
+    TRACE_SCOPE("MeshTopology::build", "compute");
+    if (!grid || !grid->GetCells() || grid->GetNumberOfPoints() == 0 || grid->GetNumberOfCells() == 0) {
+        return nullptr;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const vtkIdType numPoints = grid->GetNumberOfPoints();
+    const vtkIdType numCells = grid->GetNumberOfCells();
+    vtkCellArray *cells = grid->GetCells();
+    std::shared_ptr<MeshTopology> topology(new MeshTopology());
+
+    // 点→单元：原子计数、前缀和、原子游标填充，最后把每个点的单元表排序，结果与线程数无关
+    std::vector<std::atomic<vtkIdType>> cursors(static_cast<size_t>(numPoints));
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType p = first; p < last; ++p) {
+            cursors[p].store(0, std::memory_order_relaxed);
+        }
+    });
+    vtkSMPThreadLocalObject<vtkIdList> localIdLists;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *idList = localIdLists.Local();
+        for (vtkIdType c = first; c < last; ++c) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, idList);
+            for (vtkIdType k = 0; k < npts; ++k) {
+                cursors[pts[k]].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    std::vector<vtkIdType> &pointOffsets = topology->m_pointCellOffsets;
+    pointOffsets.assign(static_cast<size_t>(numPoints) + 1, 0);
+    for (vtkIdType p = 0; p < numPoints; ++p) {
+        const vtkIdType count = cursors[p].load(std::memory_order_relaxed);
+        pointOffsets[p + 1] = pointOffsets[p] + count;
+        cursors[p].store(pointOffsets[p], std::memory_order_relaxed);
+    }
+
+    std::vector<vtkIdType> &pointCells = topology->m_pointCells;
+    pointCells.resize(static_cast<size_t>(pointOffsets[numPoints]));
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *idList = localIdLists.Local();
+        for (vtkIdType c = first; c < last; ++c) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, idList);
+            for (vtkIdType k = 0; k < npts; ++k) {
+                pointCells[cursors[pts[k]].fetch_add(1, std::memory_order_relaxed)] = c;
+            }
+        }
+    });
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType p = first; p < last; ++p) {
+            std::sort(pointCells.begin() + pointOffsets[p], pointCells.begin() + pointOffsets[p + 1]);
+        }
+    });
+
+    std::vector<vtkIdType> &faceOffsets = topology->m_faceOffsets;
+    faceOffsets.assign(static_cast<size_t>(numCells) + 1, 0);
+    if (!withFaceNeighbors) {
+        return topology;
+    }
+
+    // 单元→单元：先统计各单元的面数，再逐面在其点中单元最少的那个点的单元表里找包含全部面点的同维单元。
+    // 先在当前线程调用一次 GetCell，保证后续多线程 GetCell(id, vtkGenericCell*) 的线程安全
+    {
+        vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+        grid->GetCell(0, cell);
+    }
+    vtkSMPThreadLocalObject<vtkGenericCell> localCells;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkGenericCell *cell = localCells.Local();
+        for (vtkIdType c = first; c < last; ++c) {
+            grid->GetCell(c, cell);
+            faceOffsets[c + 1] = faceCount(cell);
+        }
+    });
+    for (vtkIdType c = 0; c < numCells; ++c) {
+        faceOffsets[c + 1] += faceOffsets[c];
+    }
+
+    std::vector<vtkIdType> &faceNeighbors = topology->m_faceNeighbors;
+    faceNeighbors.assign(static_cast<size_t>(faceOffsets[numCells]), -1);
+    std::atomic<vtkIdType> boundaryFaces(0);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkGenericCell *cell = localCells.Local();
+        vtkIdList *idList = localIdLists.Local();
+        vtkIdType boundary = 0;
+        for (vtkIdType c = first; c < last; ++c) {
+            grid->GetCell(c, cell);
+            const int dimension = cell->GetCellDimension();
+            const vtkIdType numFaces = faceOffsets[c + 1] - faceOffsets[c];
+            for (vtkIdType f = 0; f < numFaces; ++f) {
+                vtkIdList *faceIds = face(cell, static_cast<int>(f))->GetPointIds();
+                const vtkIdType faceSize = faceIds->GetNumberOfIds();
+                if (faceSize == 0) {
+                    ++boundary;
+                    continue;
+                }
+
+                vtkIdType pivot = faceIds->GetId(0);
+                for (vtkIdType k = 1; k < faceSize; ++k) {
+                    const vtkIdType id = faceIds->GetId(k);
+                    if (pointOffsets[id + 1] - pointOffsets[id] < pointOffsets[pivot + 1] - pointOffsets[pivot]) {
+                        pivot = id;
+                    }
+                }
+
+                vtkIdType neighbor = -1;
+                for (vtkIdType j = pointOffsets[pivot]; j < pointOffsets[pivot + 1] && neighbor < 0; ++j) {
+                    const vtkIdType candidate = pointCells[j];
+                    if (candidate == c || vtkCellTypes::GetDimension(static_cast<unsigned char>(grid->GetCellType(candidate))) != dimension) {
+                        continue;
+                    }
+                    vtkIdType npts = 0;
+                    const vtkIdType *pts = nullptr;
+                    cells->GetCellAtId(candidate, npts, pts, idList);
+                    bool containsFace = true;
+                    for (vtkIdType k = 0; k < faceSize && containsFace; ++k) {
+                        containsFace = std::find(pts, pts + npts, faceIds->GetId(k)) != pts + npts;
+                    }
+                    if (containsFace) {
+                        neighbor = candidate;
+                    }
+                }
+                faceNeighbors[faceOffsets[c] + f] = neighbor;
+                if (neighbor < 0) {
+                    ++boundary;
+                }
+            }
+        }
+        boundaryFaces.fetch_add(boundary, std::memory_order_relaxed);
+    });
+    topology->m_boundaryFaces = boundaryFaces.load();
+
+    qDebug() << "MeshTopology: 拓扑表构建完成，点数:" << numPoints << "单元数:" << numCells
+             << "边界面:" << topology->m_boundaryFaces << "内存(KB):" << topology->memorySize() / 1024
+             << "耗时(ms):" << timer.elapsed();
+    return topology;
+}
+
+size_t MeshTopology::memorySize() const
+{
+    return (m_pointCellOffsets.size() + m_pointCells.size() + m_faceOffsets.size() + m_faceNeighbors.size())
+        * sizeof(vtkIdType);
+}
+
+vtkSmartPointer<vtkDoubleArray> MeshTopology::cellToPoint(vtkDataArray *cellArray) const
+{
+    TRACE_SCOPE("MeshTopology::cellToPoint", "compute");
+    const vtkIdType numPoints = numberOfPoints();
+    const int components = cellArray->GetNumberOfComponents();
+
+    vtkSmartPointer<vtkDoubleArray> output = vtkSmartPointer<vtkDoubleArray>::New();
+    output->SetNumberOfComponents(components);
+    output->SetNumberOfTuples(numPoints);
+    output->CopyComponentNames(cellArray);
+    double *values = output->GetPointer(0);
+
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+        std::vector<double> tuple(static_cast<size_t>(components));
+        for (vtkIdType p = first; p < last; ++p) {
+            double *sum = values + p * components;
+            std::fill(sum, sum + components, 0.0);
+            vtkIdType count = 0;
+            const vtkIdType *cellIds = pointCells(p, count);
+            for (vtkIdType k = 0; k < count; ++k) {
+                cellArray->GetTuple(cellIds[k], tuple.data());
+                for (int c = 0; c < components; ++c) {
+                    sum[c] += tuple[c];
+                }
+            }
+            if (count > 0) {
+                for (int c = 0; c < components; ++c) {
+                    sum[c] /= count;
+                }
+            }
+        }
+    });
+    return output;
+}
@@ -0,0 +1,54 @@
+#ifndef MESHTOPOLOGY_H
+#define MESHTOPOLOGY_H
+
+#include <memory>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
+
+// 网格拓扑表：点→单元与单元→单元（面邻居）两张 CSR 表，在 vtkSMPTools 线程池上一次构建，
+// 由 SpatialIndex 持有并在网格拓扑变化时丢弃，流线/粒子的单元游走、单元值节点平均等模块共享，
+// 不再各自通过 BuildLinks 或面哈希重建。构建完成后只读，可被多个线程同时使用
+class MeshTopology
+{
+public:
+    // 网格为空时返回空；withFaceNeighbors 为 false 时只建点→单元表，各单元的面邻居个数为 0
+    static std::shared_ptr<const MeshTopology> build(vtkUnstructuredGrid *grid, bool withFaceNeighbors = true);
+
+    vtkIdType numberOfPoints() const { return static_cast<vtkIdType>(m_pointCellOffsets.size()) - 1; }
+    vtkIdType numberOfCells() const { return static_cast<vtkIdType>(m_faceOffsets.size()) - 1; }
+
+    // 使用该点的单元（升序），count 返回个数
+    const vtkIdType *pointCells(vtkIdType pointId, vtkIdType &count) const
+    {
+        count = m_pointCellOffsets[pointId + 1] - m_pointCellOffsets[pointId];
+        return m_pointCells.data() + m_pointCellOffsets[pointId];
+    }
+
+    // 各面（二维单元为各边）对面的同维单元，顺序与 vtkCell::GetFace / GetEdge 一致，边界为 -1
+    const vtkIdType *faceNeighbors(vtkIdType cellId, vtkIdType &count) const
+    {
+        count = m_faceOffsets[cellId + 1] - m_faceOffsets[cellId];
+        return m_faceNeighbors.data() + m_faceOffsets[cellId];
+    }
+
+    vtkIdType numberOfBoundaryFaces() const { return m_boundaryFaces; }
+    size_t memorySize() const;
+
+    // 单元数组按共享该点的单元取平均，得到同分量数的双精度点数组；不属于任何单元的点为 0
+    vtkSmartPointer<vtkDoubleArray> cellToPoint(vtkDataArray *cellArray) const;
+
+private:
+    MeshTopology() = default;
+
+    std::vector<vtkIdType> m_pointCellOffsets;
+    std::vector<vtkIdType> m_pointCells;
+    std::vector<vtkIdType> m_faceOffsets;
+    std::vector<vtkIdType> m_faceNeighbors;
+    vtkIdType m_boundaryFaces = 0;
+};
+
+#endif // MESHTOPOLOGY_H
@@ -0,0 +1,221 @@
+#include "PipelineMonitor.h"
+#include "MemoryManager.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QFile>
+#include <vtkCommand.h>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace
+{
+size_t outputBytes(vtkAlgorithm *algorithm)
+{
+    size_t total = 0;
+    for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port) {
+        vtkDataObject *output = MemoryManager::existingOutput(algorithm, port);
+        if (output && !output->GetDataReleased()) {
+            total += static_cast<size_t>(output->GetActualMemorySize()) * 1024;
+        }
+    }
+    return total;
+}
+
+#ifndef _WIN32
+// Linux: 从 /proc/self/status 读取 VmRSS / VmHWM（单位kB）
+size_t readProcStatus(const char *key)
+{
+    QFile file("/proc/self/status");
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+    const QByteArray prefix(key);
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        if (line.startsWith(prefix)) {
+            QList<QByteArray> parts = line.mid(prefix.size()).simplified().split(' ');
+            return parts.isEmpty() ? 0 : parts.first().toULongLong() * 1024;
+        }
+    }
+    return 0;
+}
+#endif
+}
+
+PipelineMonitor::PipelineMonitor(QObject *parent)
+    : QObject(parent)
+{
+}
+
+PipelineMonitor::~PipelineMonitor()
+{
+    for (Watched &watched : m_watched) {
+        watched.object->RemoveObserver(watched.startObserver);
+        watched.object->RemoveObserver(watched.endObserver);
+    }
+}
+
+int PipelineMonitor::stageIndex(const QString &name)
+{
+    for (size_t i = 0; i < m_stages.size(); ++i) {
+        if (m_stages[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    StageStats stats;
+    stats.name = name;
+    m_stages.push_back(stats);
+    return static_cast<int>(m_stages.size()) - 1;
+}
+
+void PipelineMonitor::addWatched(const QString &name, vtkObject *object)
+{
+    if (!object) {
+        return;
+    }
+
+    Watched watched;
+    watched.object = object;
+    watched.stageIndex = stageIndex(name);
+    watched.startObserver = object->AddObserver(vtkCommand::StartEvent, this, &PipelineMonitor::onStart);
+    watched.endObserver = object->AddObserver(vtkCommand::EndEvent, this, &PipelineMonitor::onEnd);
+    m_watched.push_back(watched);
+}
+
+void PipelineMonitor::watch(const QString &name, vtkAlgorithm *algorithm)
+{
+    addWatched(name, algorithm);
+}
+
+void PipelineMonitor::watchRenderer(const QString &name, vtkRenderer *renderer)
+{
+    addWatched(name, renderer);
+}
+
+void PipelineMonitor::unwatch(vtkObject *object)
+{
+    for (auto it = m_watched.begin(); it != m_watched.end(); ++it) {
+        if (it->object == object) {
+            object->RemoveObserver(it->startObserver);
+            object->RemoveObserver(it->endObserver);
+            m_watched.erase(it);
+            return;
+        }
+    }
+}
+
+void PipelineMonitor::onStart(vtkObject *caller, unsigned long, void *)
+{
+    for (Watched &watched : m_watched) {
+        if (watched.object == caller) {
+            watched.timer.start();
+            watched.traceStartUs = TraceRecorder::isEnabled() ? TraceRecorder::instance().nowMicroseconds() : -1;
+            return;
+        }
+    }
+}
+
+void PipelineMonitor::onEnd(vtkObject *caller, unsigned long, void *)
+{
+    for (Watched &watched : m_watched) {
+        if (watched.object != caller || !watched.timer.isValid()) {
+            continue;
+        }
+        const double elapsedMs = watched.timer.nsecsElapsed() / 1.0e6;
+        watched.timer.invalidate();
+
+        // 同时写入性能追踪（过滤器执行与渲染）
+        if (TraceRecorder::isEnabled() && watched.traceStartUs >= 0) {
+            TraceRecorder &recorder = TraceRecorder::instance();
+            recorder.addComplete(m_stages[watched.stageIndex].name.toStdString(), "pipeline",
+                                 watched.traceStartUs, recorder.nowMicroseconds() - watched.traceStartUs);
+        }
+
+        vtkAlgorithm *algorithm = vtkAlgorithm::SafeDownCast(caller);
+        finish(watched.stageIndex, elapsedMs, algorithm ? outputBytes(algorithm) : 0);
+        return;
+    }
+}
+
+void PipelineMonitor::record(const QString &name, double elapsedMs, size_t outputBytes)
+{
+    finish(stageIndex(name), elapsedMs, outputBytes);
+}
+
+void PipelineMonitor::finish(int index, double elapsedMs, size_t outputBytes)
+{
+    StageStats &stats = m_stages[index];
+    stats.calls++;
+    stats.lastMs = elapsedMs;
+    stats.totalMs += elapsedMs;
+    stats.maxMs = std::max(stats.maxMs, elapsedMs);
+    if (outputBytes > 0 || stats.outputBytes > 0) {
+        stats.outputBytes = outputBytes;
+    }
+    emit statsChanged();
+}
+
+void PipelineMonitor::resetStatistics()
+{
+    for (StageStats &stats : m_stages) {
+        const QString name = stats.name;
+        const size_t bytes = stats.outputBytes;
+        stats = StageStats();
+        stats.name = name;
+        stats.outputBytes = bytes;
+    }
+    emit statsChanged();
+}
+
+std::vector<std::pair<QString, vtkDataObject *>> PipelineMonitor::watchedOutputs() const
+{
+    std::vector<std::pair<QString, vtkDataObject *>> outputs;
+    for (const Watched &watched : m_watched) {
+        vtkAlgorithm *algorithm = vtkAlgorithm::SafeDownCast(watched.object);
+        if (!algorithm) {
+            continue;
+        }
+        for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port) {
+            vtkDataObject *output = MemoryManager::existingOutput(algorithm, port);
+            if (output && !output->GetDataReleased()) {
+                QString name = m_stages[watched.stageIndex].name;
+                if (algorithm->GetNumberOfOutputPorts() > 1) {
+                    name += QString(" [端口%1]").arg(port);
+                }
+                outputs.emplace_back(name, output);
+            }
+        }
+    }
+    return outputs;
+}
+
+size_t PipelineMonitor::currentRss()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.WorkingSetSize);
+    }
+    return 0;
+#else
+    return readProcStatus("VmRSS:");
+#endif
+}
+
+size_t PipelineMonitor::peakRss()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<size_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    return readProcStatus("VmHWM:");
+#endif
+}
@@ -0,0 +1,80 @@
+#ifndef PIPELINEMONITOR_H
+#define PIPELINEMONITOR_H
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkAlgorithm.h>
+#include <vtkRenderer.h>
+#include <vtkDataObject.h>
+
+// 管线监视：通过 StartEvent/EndEvent 观察者记录各过滤器与渲染的执行耗时、
+// 调用次数和输出大小，并提供进程常驻内存（RSS）及峰值
+class PipelineMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct StageStats
+    {
+        QString name;
+        int calls = 0;
+        double lastMs = 0.0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        size_t outputBytes = 0;
+    };
+
+    explicit PipelineMonitor(QObject *parent = nullptr);
+    ~PipelineMonitor();
+
+    // 观察过滤器的执行（管线中每次 RequestData）
+    void watch(const QString &name, vtkAlgorithm *algorithm);
+    // 观察渲染器的每次 Render
+    void watchRenderer(const QString &name, vtkRenderer *renderer);
+    // 停止观察（统计保留），用于读取器等临时对象
+    void unwatch(vtkObject *object);
+    // 手动记录不经过观察者的阶段（如读取文件）
+    void record(const QString &name, double elapsedMs, size_t outputBytes);
+
+    const std::vector<StageStats> &stages() const { return m_stages; }
+    void resetStatistics();
+
+    // 被观察过滤器当前的输出（未执行或已释放时为空）
+    std::vector<std::pair<QString, vtkDataObject *>> watchedOutputs() const;
+
+    // 进程内存（字节）
+    static size_t currentRss();
+    static size_t peakRss();
+
+signals:
+    void statsChanged();
+
+private:
+    struct Watched
+    {
+        vtkSmartPointer<vtkObject> object;
+        int stageIndex;
+        unsigned long startObserver;
+        unsigned long endObserver;
+        QElapsedTimer timer;
+        int64_t traceStartUs = 0;
+    };
+
+    int stageIndex(const QString &name);
+    void addWatched(const QString &name, vtkObject *object);
+    void onStart(vtkObject *caller, unsigned long eventId, void *callData);
+    void onEnd(vtkObject *caller, unsigned long eventId, void *callData);
+    void finish(int index, double elapsedMs, size_t outputBytes);
+
+    std::vector<StageStats> m_stages;
+    std::vector<Watched> m_watched;
+};
+
+#endif // PIPELINEMONITOR_H
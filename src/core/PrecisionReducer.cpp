@@ -0,0 +1,268 @@
+#include "PrecisionReducer.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkInformation.h>
+#include <vtkInformationDoubleKey.h>
+#include <vtkPoints.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkFieldData.h>
+#include <vtkUnsignedShortArray.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+vtkInformationKeyMacro(PrecisionReducer, QUANTIZATION_OFFSET, Double);
+vtkInformationKeyMacro(PrecisionReducer, QUANTIZATION_SCALE, Double);
+
+namespace
+{
+const char *POINT_PREFIX = "Q16:P:";
+const char *CELL_PREFIX = "Q16:C:";
+const double QUANTIZATION_LEVELS = 65535.0;
+
+bool isFloating(vtkDataArray *array)
+{
+    return array && (array->GetDataType() == VTK_DOUBLE || array->GetDataType() == VTK_FLOAT);
+}
+
+vtkSmartPointer<vtkFloatArray> toFloat(vtkDataArray *array)
+{
+    vtkSmartPointer<vtkFloatArray> result = vtkSmartPointer<vtkFloatArray>::New();
+    result->SetName(array->GetName());
+    result->SetNumberOfComponents(array->GetNumberOfComponents());
+    result->CopyComponentNames(array);
+    result->SetNumberOfTuples(array->GetNumberOfTuples());
+    float *target = result->GetPointer(0);
+    const vtkIdType numValues = array->GetNumberOfValues();
+    const int components = array->GetNumberOfComponents();
+
+    if (array->GetDataType() == VTK_DOUBLE && array->HasStandardMemoryLayout()) {
+        const double *source = static_cast<const double *>(array->GetVoidPointer(0));
+        vtkSMPTools::For(0, numValues, [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType i = first; i < last; ++i) {
+                target[i] = static_cast<float>(source[i]);
+            }
+        });
+    } else {
+        vtkSMPTools::For(0, numValues, [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType i = first; i < last; ++i) {
+                target[i] = static_cast<float>(array->GetComponent(i / components, static_cast<int>(i % components)));
+            }
+        });
+    }
+    return result;
+}
+
+// 有限值的最小/最大值，各线程分别统计后合并；没有有限值时返回 false
+bool finiteRange(vtkDataArray *array, double range[2])
+{
+    struct Extent
+    {
+        double low = std::numeric_limits<double>::max();
+        double high = std::numeric_limits<double>::lowest();
+    };
+    vtkSMPThreadLocal<Extent> localExtents;
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), [&](vtkIdType first, vtkIdType last) {
+        Extent &extent = localExtents.Local();
+        for (vtkIdType i = first; i < last; ++i) {
+            const double value = array->GetComponent(i, 0);
+            if (std::isfinite(value)) {
+                extent.low = std::min(extent.low, value);
+                extent.high = std::max(extent.high, value);
+            }
+        }
+    });
+
+    range[0] = std::numeric_limits<double>::max();
+    range[1] = std::numeric_limits<double>::lowest();
+    for (const Extent &extent : localExtents) {
+        range[0] = std::min(range[0], extent.low);
+        range[1] = std::max(range[1], extent.high);
+    }
+    return range[0] <= range[1];
+}
+
+// 单分量数组按 [最小值, 最大值] 均匀量化为 0..65535，非有限值存为 0（即最小值）
+vtkSmartPointer<vtkUnsignedShortArray> quantize(vtkDataArray *array, const QString &storedName)
+{
+    double range[2] = {0.0, 0.0};
+    if (!finiteRange(array, range)) {
+        range[0] = range[1] = 0.0;
+    }
+    const double offset = range[0];
+    const double scale = (range[1] - range[0]) / QUANTIZATION_LEVELS;
+    const double inverse = scale > 0.0 ? 1.0 / scale : 0.0;
+
+    vtkSmartPointer<vtkUnsignedShortArray> result = vtkSmartPointer<vtkUnsignedShortArray>::New();
+    result->SetName(storedName.toUtf8().constData());
+    result->SetNumberOfTuples(array->GetNumberOfTuples());
+    unsigned short *target = result->GetPointer(0);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            const double value = array->GetComponent(i, 0);
+            const double level = std::isfinite(value) ? std::round((value - offset) * inverse) : 0.0;
+            target[i] = static_cast<unsigned short>(std::min(std::max(level, 0.0), QUANTIZATION_LEVELS));
+        }
+    });
+    result->GetInformation()->Set(PrecisionReducer::QUANTIZATION_OFFSET(), offset);
+    result->GetInformation()->Set(PrecisionReducer::QUANTIZATION_SCALE(), scale);
+    return result;
+}
+
+// 返回转换前后的字节数差
+size_t reduceAttributes(vtkDataSetAttributes *attributes, vtkFieldData *quantizedTarget, bool isPointData,
+                        PrecisionReducer::Mode mode, const QStringList &fullPrecisionArrays)
+{
+    size_t saved = 0;
+    for (int i = attributes->GetNumberOfArrays() - 1; i >= 0; --i) {
+        vtkDataArray *array = attributes->GetArray(i);
+        if (!isFloating(array) || !array->GetName()) {
+            continue;
+        }
+
+        const size_t before = static_cast<size_t>(array->GetActualMemorySize()) * 1024;
+        const QString name = QString::fromUtf8(array->GetName());
+        QString baseName;
+        const bool timeStep = PrecisionReducer::isTimeStepName(name, &baseName);
+        if (fullPrecisionArrays.contains(name) || (timeStep && fullPrecisionArrays.contains(baseName))) {
+            continue;
+        }
+        if (mode == PrecisionReducer::Quantized16 && array->GetNumberOfComponents() == 1 && !timeStep) {
+            vtkSmartPointer<vtkUnsignedShortArray> quantized =
+                quantize(array, PrecisionReducer::quantizedName(name, isPointData));
+            saved += before - std::min(before, static_cast<size_t>(quantized->GetActualMemorySize()) * 1024);
+            quantizedTarget->AddArray(quantized);
+            attributes->RemoveArray(i);
+        } else if (array->GetDataType() == VTK_DOUBLE) {
+            // 替换同名数组时 vtkDataSetAttributes 保留其活动属性（标量、矢量等）
+            vtkSmartPointer<vtkFloatArray> converted = toFloat(array);
+            saved += before - std::min(before, static_cast<size_t>(converted->GetActualMemorySize()) * 1024);
+            attributes->AddArray(converted);
+        }
+    }
+    return saved;
+}
+}
+
+QString PrecisionReducer::modeName(Mode mode)
+{
+    switch (mode) {
+    case Float32:
+        return "float32";
+    case Quantized16:
+        return "float32 + 16位量化标量";
+    case Full:
+    default:
+        return "完整精度";
+    }
+}
+
+bool PrecisionReducer::isTimeStepName(const QString &name, QString *baseName)
+{
+    static const QRegularExpression timeStepName("^(.*)_t\\d+$");
+    const QRegularExpressionMatch match = timeStepName.match(name);
+    if (match.hasMatch() && baseName) {
+        *baseName = match.captured(1);
+    }
+    return match.hasMatch();
+}
+
+bool PrecisionReducer::reduce(vtkUnstructuredGrid *grid, Mode mode, const QStringList &fullPrecisionArrays,
+                              QString *error)
+{
+    TRACE_SCOPE("PrecisionReducer::reduce", "compute");
+    if (mode == Full) {
+        return false;
+    }
+    if (!grid || !grid->GetPoints() || grid->GetNumberOfPoints() == 0) {
+        if (error) {
+            *error = "网格为空";
+        }
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    size_t saved = 0;
+
+    vtkDataArray *coordinates = grid->GetPoints()->GetData();
+    if (coordinates->GetDataType() == VTK_DOUBLE) {
+        // 换用新的 vtkPoints，不修改可能仍被其他对象引用的旧坐标
+        vtkSmartPointer<vtkFloatArray> converted = toFloat(coordinates);
+        saved += static_cast<size_t>(coordinates->GetActualMemorySize() - converted->GetActualMemorySize()) * 1024;
+        vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+        points->SetData(converted);
+        grid->SetPoints(points);
+    }
+    saved += reduceAttributes(grid->GetPointData(), grid->GetFieldData(), true, mode, fullPrecisionArrays);
+    saved += reduceAttributes(grid->GetCellData(), grid->GetFieldData(), false, mode, fullPrecisionArrays);
+    grid->Modified();
+
+    qDebug() << "PrecisionReducer: 转换为" << modeName(mode) << "节省(MB):" << saved / (1024.0 * 1024.0)
+             << "耗时(ms):" << timer.elapsed();
+    return true;
+}
+
+QString PrecisionReducer::quantizedName(const QString &name, bool isPointData)
+{
+    return QString::fromUtf8(isPointData ? POINT_PREFIX : CELL_PREFIX) + name;
+}
+
+QStringList PrecisionReducer::quantizedNames(vtkDataSet *data, bool isPointData)
+{
+    QStringList names;
+    if (!data) {
+        return names;
+    }
+    const QString prefix = QString::fromUtf8(isPointData ? POINT_PREFIX : CELL_PREFIX);
+    vtkFieldData *fieldData = data->GetFieldData();
+    for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i) {
+        vtkDataArray *array = fieldData->GetArray(i);
+        if (!vtkUnsignedShortArray::SafeDownCast(array) || !array->GetName()) {
+            continue;
+        }
+        const QString name = QString::fromUtf8(array->GetName());
+        if (name.startsWith(prefix)) {
+            names << name.mid(prefix.size());
+        }
+    }
+    return names;
+}
+
+vtkDataArray *PrecisionReducer::quantizedArray(vtkDataSet *data, const QString &name, bool isPointData)
+{
+    if (!data) {
+        return nullptr;
+    }
+    return vtkUnsignedShortArray::SafeDownCast(
+        data->GetFieldData()->GetArray(quantizedName(name, isPointData).toUtf8().constData()));
+}
+
+vtkSmartPointer<vtkFloatArray> PrecisionReducer::dequantize(vtkDataSet *data, const QString &name, bool isPointData)
+{
+    TRACE_SCOPE("PrecisionReducer::dequantize", "compute");
+    vtkUnsignedShortArray *quantized = vtkUnsignedShortArray::SafeDownCast(quantizedArray(data, name, isPointData));
+    if (!quantized) {
+        return nullptr;
+    }
+
+    const double offset = quantized->GetInformation()->Get(QUANTIZATION_OFFSET());
+    const double scale = quantized->GetInformation()->Get(QUANTIZATION_SCALE());
+    vtkSmartPointer<vtkFloatArray> result = vtkSmartPointer<vtkFloatArray>::New();
+    result->SetName(name.toUtf8().constData());
+    result->SetNumberOfTuples(quantized->GetNumberOfTuples());
+    const unsigned short *source = quantized->GetPointer(0);
+    float *target = result->GetPointer(0);
+    vtkSMPTools::For(0, quantized->GetNumberOfTuples(), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            target[i] = static_cast<float>(offset + scale * source[i]);
+        }
+    });
+    return result;
+}
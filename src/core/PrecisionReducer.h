@@ -0,0 +1,58 @@
+#ifndef PRECISIONREDUCER_H
+#define PRECISIONREDUCER_H
+
+#include <QString>
+#include <QStringList>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataArray.h>
+#include <vtkFloatArray.h>
+
+class vtkInformationDoubleKey;
+
+// 降精度内存模式：求解器结果多为 float64，每个过滤器与 GPU 上传都要搬运双倍数据，而显示用不到这么高的精度。
+// Float32：点坐标与浮点数组转为 float32；
+// Quantized16：点坐标与多分量数组（矢量、张量，供派生场、流线、变形使用）转为 float32，
+// 只用于着色的单分量浮点数组按各自的最小值（偏移）与步长（缩放）量化为 16 位无符号整数。
+// 时间步数组（<名称>_t<步号>，线探测的时间序列直接对其插值）只转为 float32，不量化；
+// 用户指定的数组（工具 → 加载精度 → 保持完整精度的数组）保持原样。
+//
+// 量化数组移到网格的 FieldData 中（名称为 quantizedName），不再出现在点/单元数据里，
+// 由 DerivedFieldRegistry 在被选中时解码为 float32 加入数据集；精确值由 ExactValueSource 从原文件读取
+class PrecisionReducer
+{
+public:
+    enum Mode
+    {
+        Full,
+        Float32,
+        Quantized16
+    };
+
+    static QString modeName(Mode mode);
+
+    // 量化数组上记录的偏移与缩放：值 = 偏移 + 缩放 * 量化值
+    static vtkInformationDoubleKey *QUANTIZATION_OFFSET();
+    static vtkInformationDoubleKey *QUANTIZATION_SCALE();
+
+    // 原地转换：逐个数组依次进行，每个数组内部的元素转换并行；mode 为 Full 或网格为空时不做修改并返回 false。
+    // fullPrecisionArrays 中的数组（按名称或去掉 _t<步号> 后的名称匹配）不转换。
+    // 转换是确定的：同一份数据两次转换结果逐字节相同，结果文件监视据此比较数组是否变化
+    static bool reduce(vtkUnstructuredGrid *grid, Mode mode, const QStringList &fullPrecisionArrays = QStringList(),
+                       QString *error = nullptr);
+
+    // 线探测时间序列使用的数组名（<名称>_t<步号>），baseName 可为空
+    static bool isTimeStepName(const QString &name, QString *baseName = nullptr);
+
+    // 量化数组在 FieldData 中的名称，点/单元数组分别加前缀以免重名
+    static QString quantizedName(const QString &name, bool isPointData);
+    // FieldData 中某一位置的量化数组对应的原数组名
+    static QStringList quantizedNames(vtkDataSet *data, bool isPointData);
+    static vtkDataArray *quantizedArray(vtkDataSet *data, const QString &name, bool isPointData);
+
+    // 解码为名为 name 的 float32 数组；不存在时返回空
+    static vtkSmartPointer<vtkFloatArray> dequantize(vtkDataSet *data, const QString &name, bool isPointData);
+};
+
+#endif // PRECISIONREDUCER_H
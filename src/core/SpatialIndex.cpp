@@ -0,0 +1,254 @@
+#include "SpatialIndex.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
+#include <vtkCellArray.h>
+#include <vtkPoints.h>
+#include <algorithm>
+#include <cmath>
+
+SpatialIndex::SpatialIndex(QObject *parent)
+    : QObject(parent)
+    , m_data(nullptr)
+    , m_cellLocator(nullptr)
+    , m_cellLocatorBuildTime(0)
+    , m_pointLocator(nullptr)
+    , m_pointLocatorBuildTime(0)
+    , m_topologyBuildTime(0)
+    , m_buildTarget(nullptr)
+    , m_rebuildPending(false)
+{
+    connect(&m_buildWatcher, &QFutureWatcher<void>::finished, this, &SpatialIndex::onBuildFinished);
+}
+
+SpatialIndex::~SpatialIndex()
+{
+    m_buildWatcher.waitForFinished();
+}
+
+void SpatialIndex::setData(vtkUnstructuredGrid *data)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_data == data) {
+        return;
+    }
+
+    m_data = data;
+    m_cellLocator = nullptr;
+    m_cellLocatorBuildTime = 0;
+    m_pointLocator = nullptr;
+    m_pointLocatorBuildTime = 0;
+    m_topology.reset();
+    m_topologyBuildTime = 0;
+}
+
+vtkMTimeType SpatialIndex::geometryTime() const
+{
+    // 只关心几何与拓扑的修改时间，切换活动标量不应触发重建
+    vtkMTimeType time = 0;
+    if (m_data->GetPoints()) {
+        time = std::max(time, m_data->GetPoints()->GetMTime());
+    }
+    if (m_data->GetCells()) {
+        time = std::max(time, m_data->GetCells()->GetMTime());
+    }
+    return time;
+}
+
+bool SpatialIndex::isCellLocatorStale() const
+{
+    return !m_cellLocator || geometryTime() > m_cellLocatorBuildTime;
+}
+
+bool SpatialIndex::isPointLocatorStale() const
+{
+    return !m_pointLocator || geometryTime() > m_pointLocatorBuildTime;
+}
+
+bool SpatialIndex::isTopologyStale() const
+{
+    // 拓扑表只依赖单元连接，点坐标变化（变形、重新加载的位移）不触发重建
+    return !m_topology || !m_data->GetCells() || m_data->GetCells()->GetMTime() > m_topologyBuildTime;
+}
+
+vtkSmartPointer<vtkStaticCellLocator> SpatialIndex::cellLocator()
+{
+    // 构建时不持有 m_mutex，isReady 与 ready*Locator 不会被长时间的构建阻塞
+    std::lock_guard<std::mutex> build(m_buildMutex);
+    vtkSmartPointer<vtkUnstructuredGrid> data;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_data || m_data->GetNumberOfCells() == 0) {
+            return nullptr;
+        }
+        if (!isCellLocatorStale()) {
+            return m_cellLocator;
+        }
+        data = m_data;
+    }
+
+    TRACE_SCOPE("SpatialIndex::buildCellLocator", "compute");
+    QElapsedTimer timer;
+    timer.start();
+
+    vtkSmartPointer<vtkStaticCellLocator> locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+    locator->SetDataSet(data);
+    locator->BuildLocator();
+
+    qDebug() << "SpatialIndex: 单元定位器构建完成，单元数:" << data->GetNumberOfCells()
+             << "耗时(ms):" << timer.elapsed();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_data == data) {
+        // 构建期间换了网格时不保存，调用方仍可使用旧网格的定位器
+        m_cellLocator = locator;
+        m_cellLocatorBuildTime = locator->GetMTime();
+    }
+    return locator;
+}
+
+vtkSmartPointer<vtkStaticPointLocator> SpatialIndex::pointLocator()
+{
+    std::lock_guard<std::mutex> build(m_buildMutex);
+    vtkSmartPointer<vtkUnstructuredGrid> data;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_data || m_data->GetNumberOfPoints() == 0) {
+            return nullptr;
+        }
+        if (!isPointLocatorStale()) {
+            return m_pointLocator;
+        }
+        data = m_data;
+    }
+
+    TRACE_SCOPE("SpatialIndex::buildPointLocator", "compute");
+    QElapsedTimer timer;
+    timer.start();
+
+    vtkSmartPointer<vtkStaticPointLocator> locator = vtkSmartPointer<vtkStaticPointLocator>::New();
+    locator->SetDataSet(data);
+    locator->BuildLocator();
+
+    qDebug() << "SpatialIndex: 点定位器构建完成，点数:" << data->GetNumberOfPoints()
+             << "耗时(ms):" << timer.elapsed();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_data == data) {
+        m_pointLocator = locator;
+        m_pointLocatorBuildTime = locator->GetMTime();
+    }
+    return locator;
+}
+
+vtkSmartPointer<vtkStaticCellLocator> SpatialIndex::readyCellLocator()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_data && !isCellLocatorStale() ? m_cellLocator : nullptr;
+}
+
+vtkSmartPointer<vtkStaticPointLocator> SpatialIndex::readyPointLocator()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_data && !isPointLocatorStale() ? m_pointLocator : nullptr;
+}
+
+std::shared_ptr<const MeshTopology> SpatialIndex::topology()
+{
+    std::lock_guard<std::mutex> build(m_buildMutex);
+    vtkSmartPointer<vtkUnstructuredGrid> data;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_data || m_data->GetNumberOfCells() == 0) {
+            return nullptr;
+        }
+        if (!isTopologyStale()) {
+            return m_topology;
+        }
+        data = m_data;
+    }
+
+    std::shared_ptr<const MeshTopology> topology = MeshTopology::build(data);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_data == data) {
+        m_topology = topology;
+        m_topologyBuildTime = data->GetCells() ? data->GetCells()->GetMTime() : 0;
+    }
+    return topology;
+}
+
+size_t SpatialIndex::topologyBytes()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_topology ? m_topology->memorySize() : 0;
+}
+
+void SpatialIndex::releaseTopology()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_topology.reset();
+    m_topologyBuildTime = 0;
+}
+
+void SpatialIndex::buildAsync()
+{
+    if (m_buildWatcher.isRunning()) {
+        // 正在构建的可能是之前的网格或几何，结束后再构建一次（已是最新的部分不会重复构建）
+        m_rebuildPending = true;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_data) {
+            return;
+        }
+        m_buildTarget = m_data;
+    }
+
+    m_rebuildPending = false;
+    m_buildWatcher.setFuture(QtConcurrent::run([this]() {
+        cellLocator();
+        pointLocator();
+        topology();
+    }));
+}
+
+void SpatialIndex::onBuildFinished()
+{
+    // 构建期间通过 setData 换了网格时，刚建好的是旧网格的索引，须为新网格再构建
+    bool dataChanged = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dataChanged = m_data && m_data != m_buildTarget;
+        m_buildTarget = nullptr;
+    }
+    if (m_rebuildPending || dataChanged) {
+        m_rebuildPending = false;
+        buildAsync();
+        return;
+    }
+    emit indexReady();
+}
+
+bool SpatialIndex::isReady()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_data) {
+        return false;
+    }
+    return !isCellLocatorStale() && !isPointLocatorStale();
+}
+
+double SpatialIndex::characteristicCellLength()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_data || m_data->GetNumberOfCells() == 0) {
+        return 0.0;
+    }
+
+    double diagonal = m_data->GetLength();
+    return diagonal / std::cbrt(static_cast<double>(m_data->GetNumberOfCells()));
+}
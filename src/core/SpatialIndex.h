@@ -0,0 +1,79 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QObject>
+#include <QFutureWatcher>
+
+#include <memory>
+#include <mutex>
+
+#include <vtkSmartPointer.h>
+#include <vtkStaticCellLocator.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkUnstructuredGrid.h>
+
+#include "MeshTopology.h"
+
+// 网格空间索引
+// 每个数据集只构建一次单元/点定位器与拓扑表，由流线、粒子、拾取、派生场等模块共享
+class SpatialIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SpatialIndex(QObject *parent = nullptr);
+    ~SpatialIndex();
+
+    void setData(vtkUnstructuredGrid *data);
+    vtkUnstructuredGrid *data() const { return m_data; }
+
+    // 按需构建单元定位器（线程安全），网格几何或拓扑变化后自动重建；需要构建或后台正在构建时等待其完成，
+    // 不能在交互热路径中调用。返回引用计数指针，重建或切换网格期间调用方手中的旧定位器仍然有效
+    vtkSmartPointer<vtkStaticCellLocator> cellLocator();
+    vtkSmartPointer<vtkStaticPointLocator> pointLocator();
+    // 已构建且未过期的定位器，否则返回空；不触发构建也不等待（悬停、拾取使用）
+    vtkSmartPointer<vtkStaticCellLocator> readyCellLocator();
+    vtkSmartPointer<vtkStaticPointLocator> readyPointLocator();
+
+    // 按需构建拓扑表（线程安全），网格拓扑变化后自动重建；
+    // 返回共享指针，释放或重建期间正在使用的旧表仍然有效
+    std::shared_ptr<const MeshTopology> topology();
+    size_t topologyBytes();
+    void releaseTopology();
+
+    // 在后台线程预先构建全部定位器与拓扑表，完成后发出 indexReady；
+    // 构建期间设置了新网格时，当前构建结束后自动再为新网格构建一次
+    void buildAsync();
+    // 定位器均已构建且未过期（不会触发构建，可在交互热路径中调用）
+    bool isReady();
+
+    // 网格特征单元尺寸（包围盒对角线 / 单元数的立方根）
+    double characteristicCellLength();
+
+signals:
+    void indexReady();
+
+private slots:
+    void onBuildFinished();
+
+private:
+    vtkMTimeType geometryTime() const;
+    bool isCellLocatorStale() const;
+    bool isPointLocatorStale() const;
+    bool isTopologyStale() const;
+
+    std::mutex m_mutex;                     // 保护网格与已构建的索引，只短暂持有
+    std::mutex m_buildMutex;                // 同一时间只构建一项，其余调用等待后直接取用结果
+    vtkSmartPointer<vtkUnstructuredGrid> m_data;
+    vtkSmartPointer<vtkStaticCellLocator> m_cellLocator;
+    vtkMTimeType m_cellLocatorBuildTime;
+    vtkSmartPointer<vtkStaticPointLocator> m_pointLocator;
+    vtkMTimeType m_pointLocatorBuildTime;
+    std::shared_ptr<const MeshTopology> m_topology;
+    vtkMTimeType m_topologyBuildTime;
+    QFutureWatcher<void> m_buildWatcher;
+    vtkUnstructuredGrid *m_buildTarget;   // 后台构建开始时的网格，仅用于比较
+    bool m_rebuildPending;
+};
+
+#endif // SPATIALINDEX_H
@@ -0,0 +1,459 @@
+#include "SurfaceExtractor.h"
+#include "MeshReorderer.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkCellType.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkDataSetSurfaceFilter.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+const char *ORIGINAL_POINT_IDS = "vtkOriginalPointIds";
+const char *ORIGINAL_CELL_IDS = "vtkOriginalCellIds";
+
+// 面按键哈希分到的桶数（2 的幂）；各桶独立排序配对，桶间互不依赖
+const int SHARD_COUNT = 1024;
+
+// 各单元类型的面表：CORNERS 为用于配对的角点（局部编号，顺序使面法向朝外），
+// POLYS 为每个面输出的多边形；与 vtkTetra / vtkQuadraticTetra / vtkHexahedron 的面定义一致
+template <int CellType>
+struct CellFaces;
+
+template <>
+struct CellFaces<VTK_TETRA>
+{
+    static constexpr int NUM_POINTS = 4;
+    static constexpr int NUM_FACES = 4;
+    static constexpr int NUM_CORNERS = 3;
+    static constexpr int POLYS_PER_FACE = 1;
+    static constexpr int POLY_SIZE = 3;
+    static constexpr int CORNERS[NUM_FACES][NUM_CORNERS] = {{0, 1, 3}, {1, 2, 3}, {2, 0, 3}, {0, 2, 1}};
+    static constexpr int POLYS[NUM_FACES][POLYS_PER_FACE][POLY_SIZE] = {
+        {{0, 1, 3}}, {{1, 2, 3}}, {{2, 0, 3}}, {{0, 2, 1}}};
+};
+
+// 二次四面体：角点 0-3，棱中点 4(0-1) 5(1-2) 6(2-0) 7(0-3) 8(1-3) 9(2-3)；
+// 每个面 (a,b,c) 按中点剖成 (a,ab,ca) (ab,b,bc) (ca,bc,c) (ab,bc,ca) 四个三角形
+template <>
+struct CellFaces<VTK_QUADRATIC_TETRA>
+{
+    static constexpr int NUM_POINTS = 10;
+    static constexpr int NUM_FACES = 4;
+    static constexpr int NUM_CORNERS = 3;
+    static constexpr int POLYS_PER_FACE = 4;
+    static constexpr int POLY_SIZE = 3;
+    static constexpr int CORNERS[NUM_FACES][NUM_CORNERS] = {{0, 1, 3}, {1, 2, 3}, {2, 0, 3}, {0, 2, 1}};
+    static constexpr int POLYS[NUM_FACES][POLYS_PER_FACE][POLY_SIZE] = {
+        {{0, 4, 7}, {4, 1, 8}, {7, 8, 3}, {4, 8, 7}},
+        {{1, 5, 8}, {5, 2, 9}, {8, 9, 3}, {5, 9, 8}},
+        {{2, 6, 9}, {6, 0, 7}, {9, 7, 3}, {6, 7, 9}},
+        {{0, 6, 4}, {6, 2, 5}, {4, 5, 1}, {6, 5, 4}}};
+};
+
+template <>
+struct CellFaces<VTK_HEXAHEDRON>
+{
+    static constexpr int NUM_POINTS = 8;
+    static constexpr int NUM_FACES = 6;
+    static constexpr int NUM_CORNERS = 4;
+    static constexpr int POLYS_PER_FACE = 1;
+    static constexpr int POLY_SIZE = 4;
+    static constexpr int CORNERS[NUM_FACES][NUM_CORNERS] = {
+        {0, 4, 7, 3}, {1, 2, 6, 5}, {0, 1, 5, 4}, {3, 7, 6, 2}, {0, 3, 2, 1}, {4, 5, 6, 7}};
+    static constexpr int POLYS[NUM_FACES][POLYS_PER_FACE][POLY_SIZE] = {
+        {{0, 4, 7, 3}}, {{1, 2, 6, 5}}, {{0, 1, 5, 4}}, {{3, 7, 6, 2}}, {{0, 3, 2, 1}}, {{4, 5, 6, 7}}};
+};
+
+template <typename Faces>
+struct FaceRecord
+{
+    std::array<vtkIdType, Faces::NUM_CORNERS> key;   // 排序后的角点号，同一个面在两侧单元中相同
+    vtkIdType face;                                  // 单元号 * NUM_FACES + 局部面号
+
+    bool operator<(const FaceRecord &other) const
+    {
+        return key < other.key || (key == other.key && face < other.face);
+    }
+};
+
+template <typename Faces>
+std::array<vtkIdType, Faces::NUM_CORNERS> faceKey(const vtkIdType *pts, int f)
+{
+    std::array<vtkIdType, Faces::NUM_CORNERS> key;
+    for (int k = 0; k < Faces::NUM_CORNERS; ++k) {
+        key[k] = pts[Faces::CORNERS[f][k]];
+    }
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+template <size_t N>
+int shardOf(const std::array<vtkIdType, N> &key)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (vtkIdType id : key) {
+        hash ^= static_cast<uint64_t>(id) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return static_cast<int>(hash & (SHARD_COUNT - 1));
+}
+
+// 并行面哈希：两趟按单元遍历（先计各桶面数，再按块预留位置写入），各桶内排序后
+// 键只出现一次的面即外表面。返回外表面的面号（单元号 * NUM_FACES + 局部面号），升序，与线程数无关
+template <typename Faces>
+std::vector<vtkIdType> boundaryFaces(vtkUnstructuredGrid *grid)
+{
+    const vtkIdType numCells = grid->GetNumberOfCells();
+    vtkCellArray *cells = grid->GetCells();
+    vtkSMPThreadLocalObject<vtkIdList> localIdLists;
+
+    std::vector<std::atomic<vtkIdType>> cursors(SHARD_COUNT);
+    for (std::atomic<vtkIdType> &cursor : cursors) {
+        cursor.store(0, std::memory_order_relaxed);
+    }
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *idList = localIdLists.Local();
+        std::vector<vtkIdType> counts(SHARD_COUNT, 0);
+        for (vtkIdType c = first; c < last; ++c) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, idList);
+            for (int f = 0; f < Faces::NUM_FACES; ++f) {
+                ++counts[shardOf(faceKey<Faces>(pts, f))];
+            }
+        }
+        for (int s = 0; s < SHARD_COUNT; ++s) {
+            if (counts[s] > 0) {
+                cursors[s].fetch_add(counts[s], std::memory_order_relaxed);
+            }
+        }
+    });
+
+    std::vector<vtkIdType> shardOffsets(SHARD_COUNT + 1, 0);
+    for (int s = 0; s < SHARD_COUNT; ++s) {
+        shardOffsets[s + 1] = shardOffsets[s] + cursors[s].load(std::memory_order_relaxed);
+        cursors[s].store(shardOffsets[s], std::memory_order_relaxed);
+    }
+
+    std::vector<FaceRecord<Faces>> records(static_cast<size_t>(shardOffsets[SHARD_COUNT]));
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *idList = localIdLists.Local();
+        std::vector<vtkIdType> positions(SHARD_COUNT, 0);
+        for (vtkIdType c = first; c < last; ++c) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, idList);
+            for (int f = 0; f < Faces::NUM_FACES; ++f) {
+                ++positions[shardOf(faceKey<Faces>(pts, f))];
+            }
+        }
+        // 每块每桶只做一次原子操作预留连续位置
+        for (int s = 0; s < SHARD_COUNT; ++s) {
+            if (positions[s] > 0) {
+                positions[s] = cursors[s].fetch_add(positions[s], std::memory_order_relaxed);
+            }
+        }
+        for (vtkIdType c = first; c < last; ++c) {
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, idList);
+            for (int f = 0; f < Faces::NUM_FACES; ++f) {
+                FaceRecord<Faces> record;
+                record.key = faceKey<Faces>(pts, f);
+                record.face = c * Faces::NUM_FACES + f;
+                records[positions[shardOf(record.key)]++] = record;
+            }
+        }
+    });
+
+    std::vector<unsigned char> isBoundary(static_cast<size_t>(numCells) * Faces::NUM_FACES, 0);
+    vtkSMPTools::For(0, SHARD_COUNT, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType s = first; s < last; ++s) {
+            auto begin = records.begin() + shardOffsets[s];
+            auto end = records.begin() + shardOffsets[s + 1];
+            std::sort(begin, end);
+            for (auto run = begin; run != end;) {
+                auto next = run + 1;
+                while (next != end && next->key == run->key) {
+                    ++next;
+                }
+                if (next - run == 1) {
+                    isBoundary[run->face] = 1;
+                }
+                run = next;
+            }
+        }
+    });
+
+    std::vector<vtkIdType> faces;
+    for (vtkIdType face = 0; face < static_cast<vtkIdType>(isBoundary.size()); ++face) {
+        if (isBoundary[face]) {
+            faces.push_back(face);
+        }
+    }
+    return faces;
+}
+
+vtkSmartPointer<vtkIdTypeArray> idArray(const char *name, const std::vector<vtkIdType> &ids)
+{
+    vtkSmartPointer<vtkIdTypeArray> array = vtkSmartPointer<vtkIdTypeArray>::New();
+    array->SetName(name);
+    array->SetNumberOfTuples(static_cast<vtkIdType>(ids.size()));
+    std::copy(ids.begin(), ids.end(), array->GetPointer(0));
+    return array;
+}
+
+std::vector<vtkIdType> idValues(vtkDataSetAttributes *attributes, const char *name)
+{
+    vtkIdTypeArray *array = vtkIdTypeArray::SafeDownCast(attributes->GetAbstractArray(name));
+    if (!array) {
+        return std::vector<vtkIdType>();
+    }
+    const vtkIdType *values = array->GetPointer(0);
+    return std::vector<vtkIdType>(values, values + array->GetNumberOfTuples());
+}
+
+// 按原始编号从网格取点坐标与点/单元数组，并写回原始编号数组
+void gatherFromGrid(vtkPolyData *surface, vtkUnstructuredGrid *grid, const std::vector<vtkIdType> &pointIds,
+                    const std::vector<vtkIdType> &cellIds)
+{
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(vtkDataArray::SafeDownCast(MeshReorderer::gathered(grid->GetPoints()->GetData(), pointIds)));
+    surface->SetPoints(points);
+    MeshReorderer::gatherAttributes(grid->GetPointData(), pointIds, surface->GetPointData());
+    MeshReorderer::gatherAttributes(grid->GetCellData(), cellIds, surface->GetCellData());
+    surface->GetPointData()->AddArray(idArray(ORIGINAL_POINT_IDS, pointIds));
+    surface->GetCellData()->AddArray(idArray(ORIGINAL_CELL_IDS, cellIds));
+}
+
+template <typename Faces>
+vtkSmartPointer<vtkPolyData> extractSpecialized(vtkUnstructuredGrid *grid)
+{
+    const vtkIdType numPoints = grid->GetNumberOfPoints();
+    const std::vector<vtkIdType> faces = boundaryFaces<Faces>(grid);
+    const vtkIdType numFaces = static_cast<vtkIdType>(faces.size());
+    vtkCellArray *cells = grid->GetCells();
+    vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
+
+    // 表面点按网格点号升序压缩编号，保持原有的内存局部性
+    std::vector<unsigned char> used(static_cast<size_t>(numPoints), 0);
+    for (vtkIdType i = 0; i < numFaces; ++i) {
+        const vtkIdType c = faces[i] / Faces::NUM_FACES;
+        const int f = static_cast<int>(faces[i] % Faces::NUM_FACES);
+        vtkIdType npts = 0;
+        const vtkIdType *pts = nullptr;
+        cells->GetCellAtId(c, npts, pts, idList);
+        for (int k = 0; k < Faces::POLYS_PER_FACE; ++k) {
+            for (int j = 0; j < Faces::POLY_SIZE; ++j) {
+                used[pts[Faces::POLYS[f][k][j]]] = 1;
+            }
+        }
+    }
+    std::vector<vtkIdType> pointIds;
+    std::vector<vtkIdType> newPointId(static_cast<size_t>(numPoints), -1);
+    for (vtkIdType p = 0; p < numPoints; ++p) {
+        if (used[p]) {
+            newPointId[p] = static_cast<vtkIdType>(pointIds.size());
+            pointIds.push_back(p);
+        }
+    }
+
+    const vtkIdType numPolys = numFaces * Faces::POLYS_PER_FACE;
+    std::vector<vtkIdType> cellIds(static_cast<size_t>(numPolys));
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfTuples(numPolys * Faces::POLY_SIZE);
+    vtkIdType *connectivityValues = connectivity->GetPointer(0);
+    vtkSMPThreadLocalObject<vtkIdList> localIdLists;
+    vtkSMPTools::For(0, numFaces, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *localIdList = localIdLists.Local();
+        for (vtkIdType i = first; i < last; ++i) {
+            const vtkIdType c = faces[i] / Faces::NUM_FACES;
+            const int f = static_cast<int>(faces[i] % Faces::NUM_FACES);
+            vtkIdType npts = 0;
+            const vtkIdType *pts = nullptr;
+            cells->GetCellAtId(c, npts, pts, localIdList);
+            for (int k = 0; k < Faces::POLYS_PER_FACE; ++k) {
+                const vtkIdType poly = i * Faces::POLYS_PER_FACE + k;
+                cellIds[poly] = c;
+                for (int j = 0; j < Faces::POLY_SIZE; ++j) {
+                    connectivityValues[poly * Faces::POLY_SIZE + j] = newPointId[pts[Faces::POLYS[f][k][j]]];
+                }
+            }
+        }
+    });
+
+    vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetData(Faces::POLY_SIZE, connectivity);
+
+    vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+    surface->SetPolys(polys);
+    gatherFromGrid(surface, grid, pointIds, cellIds);
+    return surface;
+}
+
+vtkSmartPointer<vtkPolyData> extractGeneric(vtkUnstructuredGrid *grid)
+{
+    vtkSmartPointer<vtkDataSetSurfaceFilter> filter = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+    filter->PassThroughCellIdsOn();
+    filter->PassThroughPointIdsOn();
+    filter->SetInputData(grid);
+    filter->Update();
+
+    vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+    surface->ShallowCopy(filter->GetOutput());
+    return surface;
+}
+
+template <typename Faces>
+bool hasUniformSize(vtkUnstructuredGrid *grid)
+{
+    return grid->GetCells()->GetNumberOfConnectivityIds() == grid->GetNumberOfCells() * Faces::NUM_POINTS;
+}
+}
+
+QString SurfaceExtractor::pathName(Path path)
+{
+    switch (path) {
+    case Tetra:
+        return "四面体";
+    case QuadraticTetra:
+        return "二次四面体";
+    case Hexahedron:
+        return "六面体";
+    case Generic:
+    default:
+        return "通用";
+    }
+}
+
+SurfaceExtractor::Path SurfaceExtractor::select(vtkUnstructuredGrid *grid)
+{
+    if (!grid || !grid->GetCells() || grid->GetNumberOfCells() == 0 || grid->GetNumberOfPoints() == 0) {
+        return Generic;
+    }
+
+    // 逐字节扫描单元类型数组，比 vtkUnstructuredGrid::IsHomogeneous 构建类型表更省
+    vtkUnsignedCharArray *types = grid->GetCellTypesArray();
+    const unsigned char *begin = types->GetPointer(0);
+    const unsigned char *end = begin + types->GetNumberOfValues();
+    const unsigned char type = *begin;
+    if (std::find_if(begin, end, [type](unsigned char t) { return t != type; }) != end) {
+        return Generic;
+    }
+
+    switch (type) {
+    case VTK_TETRA:
+        return hasUniformSize<CellFaces<VTK_TETRA>>(grid) ? Tetra : Generic;
+    case VTK_QUADRATIC_TETRA:
+        return hasUniformSize<CellFaces<VTK_QUADRATIC_TETRA>>(grid) ? QuadraticTetra : Generic;
+    case VTK_HEXAHEDRON:
+        return hasUniformSize<CellFaces<VTK_HEXAHEDRON>>(grid) ? Hexahedron : Generic;
+    default:
+        return Generic;
+    }
+}
+
+vtkSmartPointer<vtkPolyData> SurfaceExtractor::extract(vtkUnstructuredGrid *grid, Path *used)
+{
+    TRACE_SCOPE("SurfaceExtractor::extract", "compute");
+    QElapsedTimer timer;
+    timer.start();
+
+    const Path path = select(grid);
+    vtkSmartPointer<vtkPolyData> surface;
+    switch (path) {
+    case Tetra:
+        surface = extractSpecialized<CellFaces<VTK_TETRA>>(grid);
+        break;
+    case QuadraticTetra:
+        surface = extractSpecialized<CellFaces<VTK_QUADRATIC_TETRA>>(grid);
+        break;
+    case Hexahedron:
+        surface = extractSpecialized<CellFaces<VTK_HEXAHEDRON>>(grid);
+        break;
+    case Generic:
+    default:
+        surface = extractGeneric(grid);
+        break;
+    }
+    if (used) {
+        *used = path;
+    }
+
+    qDebug() << "SurfaceExtractor: 表面提取完成，路径:" << pathName(path)
+             << "表面点数:" << surface->GetNumberOfPoints() << "表面单元数:" << surface->GetNumberOfCells()
+             << "耗时(ms):" << timer.elapsed();
+    return surface;
+}
+
+void SurfaceExtractor::setData(vtkUnstructuredGrid *grid)
+{
+    if (grid != m_grid) {
+        m_grid = grid;
+        release();
+    }
+}
+
+vtkPolyData *SurfaceExtractor::surface()
+{
+    if (!m_grid) {
+        return nullptr;
+    }
+
+    const vtkMTimeType cellsTime = m_grid->GetCells() ? m_grid->GetCells()->GetMTime() : 0;
+    if (!m_surface || cellsTime > m_topologyTime) {
+        m_surface = extract(m_grid, &m_path);
+        m_topologyTime = cellsTime;
+        m_syncTime = m_grid->GetMTime();
+        return m_surface;
+    }
+    if (m_grid->GetMTime() <= m_syncTime) {
+        return m_surface;
+    }
+
+    if (m_path == Generic) {
+        // 通用路径细分二次单元时会插入新点，无法按原始编号取值，整体重新提取
+        m_surface = extract(m_grid, &m_path);
+    } else {
+        // 拓扑未变（新的时间步、切换数组、变形后的点坐标）：沿用已配对的表面，只重新取值
+        TRACE_SCOPE("SurfaceExtractor::sync", "compute");
+        const std::vector<vtkIdType> pointIds = idValues(m_surface->GetPointData(), ORIGINAL_POINT_IDS);
+        const std::vector<vtkIdType> cellIds = idValues(m_surface->GetCellData(), ORIGINAL_CELL_IDS);
+        // 换用新的 vtkPolyData，映射器与选择面板仍持有的旧表面不受影响
+        vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+        surface->SetPolys(m_surface->GetPolys());
+        gatherFromGrid(surface, m_grid, pointIds, cellIds);
+        m_surface = surface;
+    }
+    m_syncTime = m_grid->GetMTime();
+    return m_surface;
+}
+
+size_t SurfaceExtractor::memorySize() const
+{
+    return m_surface ? static_cast<size_t>(m_surface->GetActualMemorySize()) * 1024 : 0;
+}
+
+void SurfaceExtractor::release()
+{
+    m_surface = nullptr;
+    m_path = Generic;
+    m_topologyTime = 0;
+    m_syncTime = 0;
+}
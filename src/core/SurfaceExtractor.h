@@ -0,0 +1,52 @@
+#ifndef SURFACEEXTRACTOR_H
+#define SURFACEEXTRACTOR_H
+
+#include <QString>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+
+// 体网格外表面提取：求解器输出大多是纯线性/二次四面体或纯六面体网格，
+// 而 vtkDataSetMapper 内部的 vtkDataSetSurfaceFilter 逐单元走虚函数取面。
+// 单元类型单一且受支持时，按编译期的单元面表（模板特化）并行生成所有面，
+// 以角点排序后的键哈希分桶、桶内配对，只出现一次的面即外表面；其余网格（混合单元、壳、多面体等）
+// 回退到 vtkDataSetSurfaceFilter。
+//
+// 输出携带 vtkOriginalPointIds / vtkOriginalCellIds（与 vtkDataSetSurfaceFilter 的 PassThrough 一致），
+// 点/单元数组按原始编号取值。二次四面体的每个面按中点剖成 4 个三角形，与默认一级非线性细分的显示一致
+class SurfaceExtractor
+{
+public:
+    enum Path
+    {
+        Generic,
+        Tetra,
+        QuadraticTetra,
+        Hexahedron
+    };
+
+    static QString pathName(Path path);
+
+    // 检查单元类型：全部为同一种受支持的三维单元时返回对应专用路径，否则返回 Generic
+    static Path select(vtkUnstructuredGrid *grid);
+
+    // 按 select 的结果提取外表面，used 返回实际使用的路径
+    static vtkSmartPointer<vtkPolyData> extract(vtkUnstructuredGrid *grid, Path *used = nullptr);
+
+    // 显示用缓存：拓扑不变时只在点坐标或点/单元数组变化后按原始编号重新取值，不再重新配对面
+    void setData(vtkUnstructuredGrid *grid);
+    vtkPolyData *surface();
+    Path path() const { return m_path; }
+    size_t memorySize() const;
+    void release();
+
+private:
+    vtkSmartPointer<vtkUnstructuredGrid> m_grid;
+    vtkSmartPointer<vtkPolyData> m_surface;
+    Path m_path = Generic;
+    vtkMTimeType m_topologyTime = 0;    // 提取时网格单元数组的修改时间
+    vtkMTimeType m_syncTime = 0;        // 上次提取或同步时网格的修改时间
+};
+
+#endif // SURFACEEXTRACTOR_H
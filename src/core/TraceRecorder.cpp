@@ -0,0 +1,139 @@
+#include "TraceRecorder.h"
+#include <QDebug>
+#include <QFile>
+#include <QCoreApplication>
+#include <QThread>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <chrono>
+
+namespace
+{
+// 单次追踪最多保留的事件数，防止长时间开启时无限增长
+const size_t MAX_EVENTS = 2000000;
+
+int64_t steadyNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+
+TraceRecorder::TraceRecorder()
+    : m_epochNs(steadyNanoseconds())
+{
+}
+
+TraceRecorder &TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+int TraceRecorder::currentThreadId()
+{
+    static std::atomic<int> nextId(1);
+    thread_local int id = nextId.fetch_add(1);
+    return id;
+}
+
+void TraceRecorder::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.clear();
+        m_threadNames.clear();
+        m_epochNs = steadyNanoseconds();
+    }
+    s_enabled.store(true, std::memory_order_relaxed);
+    qDebug() << "TraceRecorder: 开始记录";
+}
+
+void TraceRecorder::stop()
+{
+    s_enabled.store(false, std::memory_order_relaxed);
+    qDebug() << "TraceRecorder: 停止记录，事件数:" << eventCount();
+}
+
+int64_t TraceRecorder::nowMicroseconds() const
+{
+    return (steadyNanoseconds() - m_epochNs.load(std::memory_order_relaxed)) / 1000;
+}
+
+void TraceRecorder::addComplete(const std::string &name, const char *category, int64_t startUs, int64_t durationUs)
+{
+    const int threadId = currentThreadId();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_events.size() >= MAX_EVENTS) {
+        return;
+    }
+
+    bool known = false;
+    for (const auto &thread : m_threadNames) {
+        if (thread.first == threadId) {
+            known = true;
+            break;
+        }
+    }
+    if (!known) {
+        const bool isMainThread = QCoreApplication::instance() &&
+                                  QThread::currentThread() == QCoreApplication::instance()->thread();
+        m_threadNames.emplace_back(threadId, isMainThread ? std::string("主线程")
+                                                          : "工作线程 " + std::to_string(threadId));
+    }
+
+    m_events.push_back(Event{name, category, startUs, durationUs, threadId});
+}
+
+size_t TraceRecorder::eventCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events.size();
+}
+
+bool TraceRecorder::writeJson(const QString &fileName, QString *error) const
+{
+    QJsonArray traceEvents;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto &thread : m_threadNames) {
+            QJsonObject metadata;
+            metadata["name"] = "thread_name";
+            metadata["ph"] = "M";
+            metadata["pid"] = 1;
+            metadata["tid"] = thread.first;
+            metadata["args"] = QJsonObject{{"name", QString::fromStdString(thread.second)}};
+            traceEvents.append(metadata);
+        }
+
+        for (const Event &event : m_events) {
+            QJsonObject object;
+            object["name"] = QString::fromStdString(event.name);
+            object["cat"] = event.category;
+            object["ph"] = "X";
+            object["ts"] = static_cast<qint64>(event.startUs);
+            object["dur"] = static_cast<qint64>(event.durationUs);
+            object["pid"] = 1;
+            object["tid"] = event.threadId;
+            traceEvents.append(object);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    qDebug() << "TraceRecorder: 已写出" << traceEvents.size() << "个事件到" << fileName;
+    return true;
+}
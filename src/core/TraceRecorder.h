@@ -0,0 +1,88 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 性能追踪：记录文件读取、过滤器执行、渲染与界面槽函数的时间段（含线程ID），
+// 导出为 Chrome trace-event JSON，可直接在 Perfetto / chrome://tracing 中打开。
+// 未开启时每个追踪点只有一次原子读取
+class TraceRecorder
+{
+public:
+    static TraceRecorder &instance();
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // 开始记录（清空已有事件）/ 停止记录
+    void start();
+    void stop();
+
+    // 自记录开始以来的微秒数
+    int64_t nowMicroseconds() const;
+
+    // 追加一个完整时间段（ph = "X"）
+    void addComplete(const std::string &name, const char *category, int64_t startUs, int64_t durationUs);
+
+    size_t eventCount() const;
+    bool writeJson(const QString &fileName, QString *error = nullptr) const;
+
+private:
+    struct Event
+    {
+        std::string name;
+        const char *category;
+        int64_t startUs;
+        int64_t durationUs;
+        int threadId;
+    };
+
+    TraceRecorder();
+    static int currentThreadId();
+
+    static std::atomic<bool> s_enabled;
+
+    mutable std::mutex m_mutex;
+    std::vector<Event> m_events;
+    std::vector<std::pair<int, std::string>> m_threadNames;
+    std::atomic<int64_t> m_epochNs;
+};
+
+// 作用域追踪：构造时记录开始时间，析构时写入一个时间段
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name, const char *category = "ui")
+        : m_name(TraceRecorder::isEnabled() ? name : nullptr)
+        , m_category(category)
+        , m_startUs(m_name ? TraceRecorder::instance().nowMicroseconds() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_name) {
+            TraceRecorder &recorder = TraceRecorder::instance();
+            recorder.addComplete(m_name, m_category, m_startUs, recorder.nowMicroseconds() - m_startUs);
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *m_name;
+    const char *m_category;
+    int64_t m_startUs;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, category)
+
+#endif // TRACERECORDER_H
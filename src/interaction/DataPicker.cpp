@@ -1,20 +1,64 @@
 #include "DataPicker.h"
+#include "core/MeshReorderer.h"
+#include "core/TraceRecorder.h"
 #include <QDebug>
 #include <vtkRenderWindow.h>
+#include <vtkCommand.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// 射线拾取命中的是主演员绘制的外表面（SurfaceExtractor 输出），按其原始ID数组换算回网格编号
+vtkIdType toGridId(vtkDataSet *picked, vtkDataSet *grid, vtkIdType id, bool isPoint)
+{
+    if (!picked || picked == grid || id < 0) {
+        return id;
+    }
+    vtkIdTypeArray *originalIds = vtkIdTypeArray::SafeDownCast(isPoint
+        ? picked->GetPointData()->GetArray("vtkOriginalPointIds")
+        : picked->GetCellData()->GetArray("vtkOriginalCellIds"));
+    if (!originalIds || id >= originalIds->GetNumberOfTuples()) {
+        return -1;
+    }
+    return originalIds->GetValue(id);
+}
+}
 
 DataPicker::DataPicker(QObject *parent)
     : QObject(parent)
     , m_renderer(nullptr)
     , m_interactor(nullptr)
     , m_data(nullptr)
+    , m_spatialIndex(nullptr)
+    , m_exactValues(nullptr)
+    , m_pressObserver(0)
+    , m_releaseObserver(0)
+    , m_moveObserver(0)
+    , m_buttonDown(false)
     , m_isPointData(true)
     , m_pickingEnabled(false)
+    , m_hoverEnabled(false)
 {
+    m_pressPosition[0] = m_pressPosition[1] = 0;
+    m_hoverPosition[0] = m_hoverPosition[1] = 0;
+    m_lastPick.valid = false;
+
+    // 悬停探测按约60Hz节流
+    m_hoverTimer = new QTimer(this);
+    m_hoverTimer->setSingleShot(true);
+    m_hoverTimer->setInterval(16);
+    connect(m_hoverTimer, &QTimer::timeout, this, &DataPicker::onHoverTimeout);
+
     setupPickers();
 }
 
 DataPicker::~DataPicker()
 {
+    removeInteractorObservers();
 }
 
 void DataPicker::setupPickers()
@@ -22,10 +66,12 @@ void DataPicker::setupPickers()
     // 创建单元拾取器
     m_cellPicker = vtkSmartPointer<vtkCellPicker>::New();
     m_cellPicker->SetTolerance(0.005); // 设置拾取容差
-    
+
     // 创建点拾取器
     m_pointPicker = vtkSmartPointer<vtkPointPicker>::New();
     m_pointPicker->SetTolerance(0.005);
+
+    m_genericCell = vtkSmartPointer<vtkGenericCell>::New();
 }
 
 void DataPicker::setRenderer(vtkRenderer *renderer)
@@ -35,7 +81,32 @@ void DataPicker::setRenderer(vtkRenderer *renderer)
 
 void DataPicker::setInteractor(vtkRenderWindowInteractor *interactor)
 {
+    if (m_interactor == interactor) {
+        return;
+    }
+
+    removeInteractorObservers();
     m_interactor = interactor;
+
+    // 直接监听交互器事件：点击（按下与释放位置接近）触发拾取，移动触发悬停探测
+    if (m_interactor) {
+        m_pressObserver = m_interactor->AddObserver(vtkCommand::LeftButtonPressEvent,
+                                                    this, &DataPicker::onInteractorEvent);
+        m_releaseObserver = m_interactor->AddObserver(vtkCommand::LeftButtonReleaseEvent,
+                                                      this, &DataPicker::onInteractorEvent);
+        m_moveObserver = m_interactor->AddObserver(vtkCommand::MouseMoveEvent,
+                                                   this, &DataPicker::onInteractorEvent);
+    }
+}
+
+void DataPicker::removeInteractorObservers()
+{
+    if (m_interactor) {
+        m_interactor->RemoveObserver(m_pressObserver);
+        m_interactor->RemoveObserver(m_releaseObserver);
+        m_interactor->RemoveObserver(m_moveObserver);
+    }
+    m_pressObserver = m_releaseObserver = m_moveObserver = 0;
 }
 
 void DataPicker::setData(vtkUnstructuredGrid *data)
@@ -43,17 +114,115 @@ void DataPicker::setData(vtkUnstructuredGrid *data)
     m_data = data;
 }
 
+void DataPicker::setSpatialIndex(SpatialIndex *spatialIndex)
+{
+    m_spatialIndex = spatialIndex;
+}
+
 void DataPicker::setActiveScalarArray(const QString &arrayName, bool isPointData)
 {
     m_activeArrayName = arrayName;
     m_isPointData = isPointData;
 }
 
+void DataPicker::setExactValueSource(ExactValueSource *source)
+{
+    if (m_exactValues) {
+        disconnect(m_exactValues, nullptr, this, nullptr);
+    }
+    m_exactValues = source;
+    if (m_exactValues) {
+        connect(m_exactValues, &ExactValueSource::arrayReady, this, &DataPicker::onExactArrayReady);
+    }
+}
+
+void DataPicker::onExactArrayReady(const QString &arrayName, bool isPointData)
+{
+    // 等待中的点击拾取补报精确值
+    if (m_lastPick.valid && arrayName == m_activeArrayName && isPointData == m_isPointData) {
+        emit pointPicked(formatPickInfo(m_lastPick.position, m_lastPick.value, m_lastPick.cellId, m_lastPick.pointId)
+                         + formatExactValue(m_lastPick));
+    }
+}
+
 void DataPicker::enablePicking(bool enabled)
 {
     m_pickingEnabled = enabled;
 }
 
+void DataPicker::enableHover(bool enabled)
+{
+    m_hoverEnabled = enabled;
+    if (!enabled) {
+        m_hoverTimer->stop();
+    }
+}
+
+void DataPicker::onInteractorEvent(vtkObject *caller, unsigned long eventId, void *callData)
+{
+    Q_UNUSED(caller);
+    Q_UNUSED(callData);
+
+    const int *position = m_interactor->GetEventPosition();
+
+    switch (eventId) {
+    case vtkCommand::LeftButtonPressEvent:
+        m_buttonDown = true;
+        m_pressPosition[0] = position[0];
+        m_pressPosition[1] = position[1];
+        break;
+
+    case vtkCommand::LeftButtonReleaseEvent:
+        m_buttonDown = false;
+        // 拖动旋转不算点击
+        if (m_pickingEnabled &&
+            std::abs(position[0] - m_pressPosition[0]) + std::abs(position[1] - m_pressPosition[1]) <= 3) {
+            pickAndReport(position[0], position[1]);
+        }
+        break;
+
+    case vtkCommand::MouseMoveEvent:
+        if (!m_hoverEnabled || m_buttonDown) {
+            return;
+        }
+        m_hoverPosition[0] = position[0];
+        m_hoverPosition[1] = position[1];
+        if (!m_hoverClock.isValid() || m_hoverClock.elapsed() >= m_hoverTimer->interval()) {
+            m_hoverTimer->stop();
+            onHoverTimeout();
+        } else if (!m_hoverTimer->isActive()) {
+            m_hoverTimer->start();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void DataPicker::onHoverTimeout()
+{
+    TRACE_SCOPE("DataPicker::onHoverTimeout", "ui");
+    m_hoverClock.restart();
+
+    if (!m_hoverEnabled || !m_renderer || !m_data) {
+        return;
+    }
+
+    // 悬停只走定位器快速路径，索引未就绪时不退回到逐单元射线拾取
+    if (!m_spatialIndex || !m_spatialIndex->isReady()) {
+        emit hoverProbed("空间索引构建中...");
+        return;
+    }
+
+    PickResult result = pickAt(m_hoverPosition[0], m_hoverPosition[1], false);
+    if (result.valid) {
+        emit hoverProbed(formatPickInfo(result.position, result.value, result.cellId, result.pointId));
+    } else {
+        emit hoverProbed(QString());
+    }
+}
+
 void DataPicker::onMouseClick(int x, int y)
 {
     if (!m_pickingEnabled || !m_renderer || !m_data) {
@@ -62,75 +231,187 @@ void DataPicker::onMouseClick(int x, int y)
 
     // 获取渲染窗口尺寸
     int *size = m_renderer->GetRenderWindow()->GetSize();
-    
+
     // VTK使用左下角为原点，Qt使用左上角，需要转换Y坐标
     int vtkY = size[1] - y - 1;
-    
-    bool pickSuccessful = false;
-    double position[3] = {0, 0, 0};
-    double value = 0.0;
-    vtkIdType cellId = -1;
-    vtkIdType pointId = -1;
 
-    if (m_isPointData) {
-        // 使用点拾取器
-        if (m_pointPicker->Pick(x, vtkY, 0, m_renderer)) {
-            pickSuccessful = true;
-            m_pointPicker->GetPickPosition(position);
-            pointId = m_pointPicker->GetPointId();
-            
-            // 获取点数据值
-            if (pointId >= 0 && !m_activeArrayName.isEmpty()) {
-                vtkDataArray *array = m_data->GetPointData()->GetArray(m_activeArrayName.toStdString().c_str());
-                if (array) {
-                    value = array->GetTuple1(pointId);
-                }
+    pickAndReport(x, vtkY);
+}
+
+void DataPicker::pickAndReport(int displayX, int displayY)
+{
+    TRACE_SCOPE("DataPicker::pickAndReport", "ui");
+    if (!m_renderer || !m_data) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    PickResult result = pickAt(displayX, displayY, true);
+    qDebug() << "DataPicker: 拾取耗时(us):" << timer.nsecsElapsed() / 1000;
+
+    m_lastPick = result;
+    if (result.valid) {
+        QString info = formatPickInfo(result.position, result.value, result.cellId, result.pointId);
+        emit pointPicked(info + formatExactValue(result));
+    } else {
+        emit pointPicked("未拾取到数据点");
+    }
+}
+
+bool DataPicker::displayToSurface(int displayX, int displayY, double world[3])
+{
+    // 从深度缓冲读取该像素的可见表面深度，背景处深度为1
+    double z = m_renderer->GetZ(displayX, displayY);
+    if (z >= 1.0) {
+        return false;
+    }
+
+    m_renderer->SetDisplayPoint(displayX, displayY, z);
+    m_renderer->DisplayToWorld();
+    double worldPoint[4];
+    m_renderer->GetWorldPoint(worldPoint);
+    if (worldPoint[3] == 0.0) {
+        return false;
+    }
+
+    world[0] = worldPoint[0] / worldPoint[3];
+    world[1] = worldPoint[1] / worldPoint[3];
+    world[2] = worldPoint[2] / worldPoint[3];
+    return true;
+}
+
+DataPicker::PickResult DataPicker::pickAt(int displayX, int displayY, bool allowFallback)
+{
+    PickResult result;
+    result.valid = false;
+    result.position[0] = result.position[1] = result.position[2] = 0.0;
+    result.value = 0.0;
+    result.cellId = -1;
+    result.pointId = -1;
+
+    bool indexReady = m_spatialIndex && m_spatialIndex->data() == m_data && m_spatialIndex->isReady();
+
+    if (indexReady) {
+        // 快速路径：深度缓冲得到表面位置，再用静态定位器查找最近的点/单元
+        double world[3];
+        if (!displayToSurface(displayX, displayY, world)) {
+            return result;
+        }
+
+        if (m_isPointData) {
+            vtkSmartPointer<vtkStaticPointLocator> locator = m_spatialIndex->readyPointLocator();
+            result.pointId = locator ? locator->FindClosestPoint(world) : -1;
+            if (result.pointId >= 0) {
+                m_data->GetPoint(result.pointId, result.position);
+                result.valid = true;
             }
+        } else if (vtkSmartPointer<vtkStaticCellLocator> locator = m_spatialIndex->readyCellLocator()) {
+            int subId = 0;
+            double dist2 = 0.0;
+            locator->FindClosestPoint(world, result.position, m_genericCell, result.cellId, subId, dist2);
+            result.valid = result.cellId >= 0;
         }
-    } else {
-        // 使用单元拾取器
-        if (m_cellPicker->Pick(x, vtkY, 0, m_renderer)) {
-            pickSuccessful = true;
-            m_cellPicker->GetPickPosition(position);
-            cellId = m_cellPicker->GetCellId();
-            
-            // 获取单元数据值
-            if (cellId >= 0 && !m_activeArrayName.isEmpty()) {
-                vtkDataArray *array = m_data->GetCellData()->GetArray(m_activeArrayName.toStdString().c_str());
-                if (array) {
-                    value = array->GetTuple1(cellId);
-                }
+    } else if (allowFallback) {
+        // 索引尚在后台构建时退回到射线拾取
+        if (m_isPointData) {
+            if (m_pointPicker->Pick(displayX, displayY, 0, m_renderer)) {
+                m_pointPicker->GetPickPosition(result.position);
+                result.pointId = toGridId(m_pointPicker->GetDataSet(), m_data, m_pointPicker->GetPointId(), true);
+                result.valid = result.pointId >= 0;
+            }
+        } else {
+            if (m_cellPicker->Pick(displayX, displayY, 0, m_renderer)) {
+                m_cellPicker->GetPickPosition(result.position);
+                result.cellId = toGridId(m_cellPicker->GetDataSet(), m_data, m_cellPicker->GetCellId(), false);
+                result.valid = result.cellId >= 0;
             }
         }
     }
 
-    if (pickSuccessful) {
-        QString info = formatPickInfo(position, value, cellId, pointId);
-        emit pointPicked(info);
+    if (!result.valid || m_activeArrayName.isEmpty()) {
+        return result;
+    }
+
+    // 获取数据值，矢量取模
+    vtkDataArray *array = nullptr;
+    vtkIdType tupleId = -1;
+    if (m_isPointData) {
+        array = m_data->GetPointData()->GetArray(m_activeArrayName.toStdString().c_str());
+        tupleId = result.pointId;
     } else {
-        emit pointPicked("未拾取到数据点");
+        array = m_data->GetCellData()->GetArray(m_activeArrayName.toStdString().c_str());
+        tupleId = result.cellId;
+    }
+
+    if (array && tupleId >= 0 && tupleId < array->GetNumberOfTuples()) {
+        if (array->GetNumberOfComponents() == 1) {
+            result.value = array->GetTuple1(tupleId);
+        } else {
+            double sum = 0.0;
+            for (int c = 0; c < array->GetNumberOfComponents(); ++c) {
+                double component = array->GetComponent(tupleId, c);
+                sum += component * component;
+            }
+            result.value = std::sqrt(sum);
+        }
     }
+
+    return result;
 }
 
 QString DataPicker::formatPickInfo(double position[3], double value, vtkIdType cellId, vtkIdType pointId)
 {
     QString info;
-    
+
     // 坐标信息
-    info += QString("坐标: (%.3f, %.3f, %.3f)").arg(position[0]).arg(position[1]).arg(position[2]);
-    
+    info += QString("坐标: (%1, %2, %3)")
+                .arg(position[0], 0, 'f', 3)
+                .arg(position[1], 0, 'f', 3)
+                .arg(position[2], 0, 'f', 3);
+
     // 数据值信息
     if (!m_activeArrayName.isEmpty()) {
-        info += QString(" | %1: %.6f").arg(m_activeArrayName).arg(value);
+        info += QString(" | %1: %2").arg(m_activeArrayName).arg(value, 0, 'g', 6);
     }
-    
-    // ID信息
+
+    // ID信息：加载时重排过的网格换算回文件中的编号
     if (m_isPointData && pointId >= 0) {
-        info += QString(" | 点ID: %1").arg(pointId);
+        info += QString(" | 点ID: %1").arg(MeshReorderer::originalPointId(m_data, pointId));
     } else if (!m_isPointData && cellId >= 0) {
-        info += QString(" | 单元ID: %1").arg(cellId);
+        info += QString(" | 单元ID: %1").arg(MeshReorderer::originalCellId(m_data, cellId));
     }
-    
+
     return info;
 }
 
+QString DataPicker::formatExactValue(const PickResult &result)
+{
+    if (!m_exactValues || !m_exactValues->isEnabled() || m_activeArrayName.isEmpty()) {
+        return QString();
+    }
+
+    // 原文件按文件中的编号索引
+    const vtkIdType fileId = m_isPointData ? MeshReorderer::originalPointId(m_data, result.pointId)
+                                           : MeshReorderer::originalCellId(m_data, result.cellId);
+    std::vector<double> tuple;
+    switch (m_exactValues->tuple(m_activeArrayName, m_isPointData, fileId, tuple)) {
+    case ExactValueSource::Ready: {
+        // 与显示值一致：矢量取模
+        double value = tuple.empty() ? 0.0 : tuple[0];
+        if (tuple.size() > 1) {
+            double sum = 0.0;
+            for (double component : tuple) {
+                sum += component * component;
+            }
+            value = std::sqrt(sum);
+        }
+        return QString(" | 文件值: %1").arg(value, 0, 'g', 15);
+    }
+    case ExactValueSource::Loading:
+        return QString(" | 文件值: 读取中...");
+    case ExactValueSource::Unavailable:
+    default:
+        return QString();
+    }
+}
@@ -3,10 +3,13 @@
 
 #include <QObject>
 #include <QString>
+#include <QElapsedTimer>
+#include <QTimer>
 
 #include <vtkSmartPointer.h>
 #include <vtkCellPicker.h>
 #include <vtkPointPicker.h>
+#include <vtkGenericCell.h>
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
@@ -15,6 +18,9 @@
 #include <vtkPointData.h>
 #include <vtkCellData.h>
 
+#include "core/SpatialIndex.h"
+#include "io/ExactValueSource.h"
+
 class DataPicker : public QObject
 {
     Q_OBJECT
@@ -26,32 +32,76 @@ public:
     void setRenderer(vtkRenderer *renderer);
     void setInteractor(vtkRenderWindowInteractor *interactor);
     void setData(vtkUnstructuredGrid *data);
+    void setSpatialIndex(SpatialIndex *spatialIndex);
     void setActiveScalarArray(const QString &arrayName, bool isPointData);
+    // 降精度加载时点击拾取附带原文件中的精确值（悬停不触发读取）
+    void setExactValueSource(ExactValueSource *source);
 
     void enablePicking(bool enabled);
     bool isPickingEnabled() const { return m_pickingEnabled; }
 
+    void enableHover(bool enabled);
+    bool isHoverEnabled() const { return m_hoverEnabled; }
+
 signals:
     void pointPicked(const QString &info);
+    void hoverProbed(const QString &info);
 
 public slots:
     void onMouseClick(int x, int y);
 
+private slots:
+    void onHoverTimeout();
+    void onExactArrayReady(const QString &arrayName, bool isPointData);
+
 private:
+    // 拾取结果
+    struct PickResult
+    {
+        bool valid;
+        double position[3];
+        double value;
+        vtkIdType cellId;
+        vtkIdType pointId;
+    };
+
     void setupPickers();
+    void onInteractorEvent(vtkObject *caller, unsigned long eventId, void *callData);
+    void removeInteractorObservers();
+    bool displayToSurface(int displayX, int displayY, double world[3]);
+    PickResult pickAt(int displayX, int displayY, bool allowFallback);
+    void pickAndReport(int displayX, int displayY);
     QString formatPickInfo(double position[3], double value, vtkIdType cellId, vtkIdType pointId);
+    QString formatExactValue(const PickResult &result);
 
     // VTK组件
     vtkSmartPointer<vtkCellPicker> m_cellPicker;
     vtkSmartPointer<vtkPointPicker> m_pointPicker;
+    vtkSmartPointer<vtkGenericCell> m_genericCell;
     vtkSmartPointer<vtkRenderer> m_renderer;
     vtkSmartPointer<vtkRenderWindowInteractor> m_interactor;
     vtkSmartPointer<vtkUnstructuredGrid> m_data;
+    SpatialIndex *m_spatialIndex;
+    ExactValueSource *m_exactValues;
+    PickResult m_lastPick;      // 最近一次点击拾取，精确值读入后据此重新报告
+
+    // 交互器观察者
+    unsigned long m_pressObserver;
+    unsigned long m_releaseObserver;
+    unsigned long m_moveObserver;
+    int m_pressPosition[2];
+    bool m_buttonDown;
+
+    // 悬停探测：按帧率节流，末次移动由定时器补发
+    QElapsedTimer m_hoverClock;
+    QTimer *m_hoverTimer;
+    int m_hoverPosition[2];
 
     // 数据信息
     QString m_activeArrayName;
     bool m_isPointData;
     bool m_pickingEnabled;
+    bool m_hoverEnabled;
 };
 
-#endif // DATAPICKER_H
\ No newline at end of file
+#endif // DATAPICKER_H
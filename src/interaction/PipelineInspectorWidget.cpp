@@ -0,0 +1,203 @@
+#include "PipelineInspectorWidget.h"
+#include "core/MemoryManager.h"
+#include <QDebug>
+#include <QHeaderView>
+#include <vtkDataSet.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+
+namespace
+{
+const int REFRESH_INTERVAL_MS = 1000;
+
+// GetActualMemorySize 单位为kB
+size_t dataObjectBytes(vtkDataObject *data)
+{
+    return data ? static_cast<size_t>(data->GetActualMemorySize()) * 1024 : 0;
+}
+}
+
+PipelineInspectorWidget::PipelineInspectorWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_inputData(nullptr)
+    , m_monitor(nullptr)
+    , m_dirty(true)
+{
+    setupUI();
+
+    m_refreshTimer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &PipelineInspectorWidget::refresh);
+}
+
+void PipelineInspectorWidget::setupUI()
+{
+    setWindowTitle("性能监视");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // 进程内存
+    QHBoxLayout *memoryLayout = new QHBoxLayout();
+    m_rssLabel = new QLabel("进程内存: -", this);
+    m_peakLabel = new QLabel("峰值: -", this);
+    memoryLayout->addWidget(m_rssLabel);
+    memoryLayout->addWidget(m_peakLabel);
+    mainLayout->addLayout(memoryLayout);
+
+    // 数据集与数组
+    mainLayout->addWidget(new QLabel("数据集与数组:", this));
+    m_datasetTree = new QTreeWidget(this);
+    m_datasetTree->setColumnCount(3);
+    m_datasetTree->setHeaderLabels(QStringList() << "名称" << "类型" << "大小");
+    m_datasetTree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    mainLayout->addWidget(m_datasetTree, 1);
+
+    // 管线阶段
+    mainLayout->addWidget(new QLabel("管线阶段:", this));
+    m_stageTable = new QTableWidget(0, 6, this);
+    m_stageTable->setHorizontalHeaderLabels(QStringList() << "阶段" << "调用次数" << "上次(ms)"
+                                                          << "平均(ms)" << "最长(ms)" << "输出大小");
+    m_stageTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_stageTable->verticalHeader()->setVisible(false);
+    m_stageTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_stageTable->setSelectionMode(QAbstractItemView::NoSelection);
+    mainLayout->addWidget(m_stageTable, 1);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    m_refreshButton = new QPushButton("刷新", this);
+    m_resetButton = new QPushButton("重置计时", this);
+    connect(m_refreshButton, &QPushButton::clicked, this, [this]() {
+        m_dirty = true;
+        refresh();
+    });
+    connect(m_resetButton, &QPushButton::clicked, this, &PipelineInspectorWidget::onResetTimings);
+    buttonLayout->addWidget(m_refreshButton);
+    buttonLayout->addWidget(m_resetButton);
+    mainLayout->addLayout(buttonLayout);
+}
+
+void PipelineInspectorWidget::setData(vtkUnstructuredGrid *data)
+{
+    m_inputData = data;
+    m_dirty = true;
+}
+
+void PipelineInspectorWidget::setMonitor(PipelineMonitor *monitor)
+{
+    if (m_monitor) {
+        disconnect(m_monitor, nullptr, this, nullptr);
+    }
+    m_monitor = monitor;
+    if (m_monitor) {
+        // 只做标记，由定时器统一刷新，避免每帧渲染都重建表格
+        connect(m_monitor, &PipelineMonitor::statsChanged, this, [this]() { m_dirty = true; });
+    }
+    m_dirty = true;
+}
+
+void PipelineInspectorWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    m_dirty = true;
+    refresh();
+    m_refreshTimer.start();
+}
+
+void PipelineInspectorWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    m_refreshTimer.stop();
+}
+
+void PipelineInspectorWidget::refresh()
+{
+    refreshProcessMemory();
+    if (m_dirty) {
+        refreshStages();
+        refreshDatasets();
+        m_dirty = false;
+    }
+}
+
+void PipelineInspectorWidget::onResetTimings()
+{
+    if (m_monitor) {
+        m_monitor->resetStatistics();
+    }
+    m_dirty = true;
+    refresh();
+}
+
+void PipelineInspectorWidget::refreshProcessMemory()
+{
+    m_rssLabel->setText(QString("进程内存: %1").arg(MemoryManager::formatBytes(PipelineMonitor::currentRss())));
+    m_peakLabel->setText(QString("峰值: %1").arg(MemoryManager::formatBytes(PipelineMonitor::peakRss())));
+}
+
+QTreeWidgetItem *PipelineInspectorWidget::addDatasetItem(const QString &name, vtkDataObject *data)
+{
+    QTreeWidgetItem *datasetItem = new QTreeWidgetItem(m_datasetTree);
+    datasetItem->setText(0, name);
+    datasetItem->setText(1, data->GetClassName());
+    datasetItem->setText(2, MemoryManager::formatBytes(dataObjectBytes(data)));
+
+    vtkDataSet *dataSet = vtkDataSet::SafeDownCast(data);
+    if (!dataSet) {
+        return datasetItem;
+    }
+
+    QTreeWidgetItem *geometryItem = new QTreeWidgetItem(datasetItem);
+    geometryItem->setText(0, QString("点 %1 / 单元 %2").arg(dataSet->GetNumberOfPoints()).arg(dataSet->GetNumberOfCells()));
+    geometryItem->setText(1, "几何与拓扑");
+
+    auto addArrays = [datasetItem](vtkFieldData *fields, const QString &location) {
+        for (int i = 0; i < fields->GetNumberOfArrays(); ++i) {
+            vtkDataArray *array = fields->GetArray(i);
+            if (!array) {
+                continue;
+            }
+            QTreeWidgetItem *arrayItem = new QTreeWidgetItem(datasetItem);
+            arrayItem->setText(0, QString("%1: %2").arg(location, QString::fromUtf8(array->GetName() ? array->GetName() : "(未命名)")));
+            arrayItem->setText(1, QString("%1 × %2分量").arg(array->GetDataTypeAsString()).arg(array->GetNumberOfComponents()));
+            arrayItem->setText(2, MemoryManager::formatBytes(static_cast<size_t>(array->GetActualMemorySize()) * 1024));
+        }
+    };
+    addArrays(dataSet->GetPointData(), "点数据");
+    addArrays(dataSet->GetCellData(), "单元数据");
+    return datasetItem;
+}
+
+void PipelineInspectorWidget::refreshDatasets()
+{
+    m_datasetTree->clear();
+
+    if (m_inputData) {
+        addDatasetItem("当前数据集", m_inputData)->setExpanded(true);
+    }
+    if (m_monitor) {
+        for (const auto &output : m_monitor->watchedOutputs()) {
+            addDatasetItem(output.first, output.second);
+        }
+    }
+}
+
+void PipelineInspectorWidget::refreshStages()
+{
+    if (!m_monitor) {
+        m_stageTable->setRowCount(0);
+        return;
+    }
+
+    const std::vector<PipelineMonitor::StageStats> &stages = m_monitor->stages();
+    m_stageTable->setRowCount(static_cast<int>(stages.size()));
+    for (int row = 0; row < static_cast<int>(stages.size()); ++row) {
+        const PipelineMonitor::StageStats &stats = stages[row];
+        const double average = stats.calls > 0 ? stats.totalMs / stats.calls : 0.0;
+        m_stageTable->setItem(row, 0, new QTableWidgetItem(stats.name));
+        m_stageTable->setItem(row, 1, new QTableWidgetItem(QString::number(stats.calls)));
+        m_stageTable->setItem(row, 2, new QTableWidgetItem(QString::number(stats.lastMs, 'f', 2)));
+        m_stageTable->setItem(row, 3, new QTableWidgetItem(QString::number(average, 'f', 2)));
+        m_stageTable->setItem(row, 4, new QTableWidgetItem(QString::number(stats.maxMs, 'f', 2)));
+        m_stageTable->setItem(row, 5, new QTableWidgetItem(stats.outputBytes > 0 ? MemoryManager::formatBytes(stats.outputBytes) : "-"));
+    }
+}
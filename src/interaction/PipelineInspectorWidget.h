@@ -0,0 +1,59 @@
+#ifndef PIPELINEINSPECTORWIDGET_H
+#define PIPELINEINSPECTORWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QTableWidget>
+#include <QTimer>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataObject.h>
+
+#include "core/PipelineMonitor.h"
+
+// 性能监视面板：列出各数据集及其数组的内存占用、各管线阶段的耗时与调用次数，
+// 以及进程常驻内存和峰值；面板可见时每秒刷新
+class PipelineInspectorWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PipelineInspectorWidget(QWidget *parent = nullptr);
+
+    void setData(vtkUnstructuredGrid *data);
+    void setMonitor(PipelineMonitor *monitor);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refresh();
+    void onResetTimings();
+
+private:
+    void setupUI();
+    void refreshDatasets();
+    void refreshStages();
+    void refreshProcessMemory();
+    QTreeWidgetItem *addDatasetItem(const QString &name, vtkDataObject *data);
+
+    QLabel *m_rssLabel;
+    QLabel *m_peakLabel;
+    QTreeWidget *m_datasetTree;
+    QTableWidget *m_stageTable;
+    QPushButton *m_refreshButton;
+    QPushButton *m_resetButton;
+    QTimer m_refreshTimer;
+
+    vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
+    PipelineMonitor *m_monitor;
+    bool m_dirty;
+};
+
+#endif // PIPELINEINSPECTORWIDGET_H
@@ -0,0 +1,308 @@
+#include "QueryWidget.h"
+#include "analysis/SubsetExtractor.h"
+#include <QDebug>
+#include <QHeaderView>
+#include <vtkCamera.h>
+#include <vtkCell.h>
+#include <vtkProperty.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkMath.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const int MAX_TABLE_ROWS = 1000; // 结果表只列出前若干个命中，高亮显示全部
+}
+
+QueryWidget::QueryWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_inputData(nullptr)
+    , m_isPointData(true)
+{
+    setupUI();
+    setupVTK();
+}
+
+void QueryWidget::setupUI()
+{
+    setWindowTitle("数值查询");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    m_arrayLabel = new QLabel("当前数组: -", this);
+    mainLayout->addWidget(m_arrayLabel);
+
+    QFormLayout *formLayout = new QFormLayout();
+
+    m_queryTypeComboBox = new QComboBox(this);
+    m_queryTypeComboBox->addItem("最大的K个");
+    m_queryTypeComboBox->addItem("最小的K个");
+    m_queryTypeComboBox->addItem("数值范围/阈值");
+    connect(m_queryTypeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &QueryWidget::onQueryTypeChanged);
+    formLayout->addRow("查询类型:", m_queryTypeComboBox);
+
+    m_topKSpinBox = new QSpinBox(this);
+    m_topKSpinBox->setRange(1, 1000000);
+    m_topKSpinBox->setValue(100);
+    formLayout->addRow("K:", m_topKSpinBox);
+
+    m_lowerSpinBox = new QDoubleSpinBox(this);
+    m_lowerSpinBox->setDecimals(6);
+    m_lowerSpinBox->setRange(-1e12, 1e12);
+    m_lowerSpinBox->setEnabled(false);
+    formLayout->addRow("下限:", m_lowerSpinBox);
+
+    m_upperSpinBox = new QDoubleSpinBox(this);
+    m_upperSpinBox->setDecimals(6);
+    m_upperSpinBox->setRange(-1e12, 1e12);
+    m_upperSpinBox->setEnabled(false);
+    formLayout->addRow("上限:", m_upperSpinBox);
+
+    mainLayout->addLayout(formLayout);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    m_runButton = new QPushButton("执行查询", this);
+    connect(m_runButton, &QPushButton::clicked, this, &QueryWidget::onRunQuery);
+    buttonLayout->addWidget(m_runButton);
+
+    m_clearButton = new QPushButton("清除结果", this);
+    m_clearButton->setEnabled(false);
+    connect(m_clearButton, &QPushButton::clicked, this, &QueryWidget::onClearQuery);
+    buttonLayout->addWidget(m_clearButton);
+    mainLayout->addLayout(buttonLayout);
+
+    m_highlightCheckBox = new QCheckBox("高亮命中", this);
+    m_highlightCheckBox->setChecked(true);
+    connect(m_highlightCheckBox, &QCheckBox::toggled, this, &QueryWidget::onHighlightToggled);
+    mainLayout->addWidget(m_highlightCheckBox);
+
+    m_resultLabel = new QLabel("尚未查询", this);
+    m_resultLabel->setWordWrap(true);
+    mainLayout->addWidget(m_resultLabel);
+
+    // 命中列表，双击跳转相机
+    m_hitTable = new QTableWidget(0, 3, this);
+    m_hitTable->setHorizontalHeaderLabels(QStringList() << "序号" << "ID" << "数值");
+    m_hitTable->horizontalHeader()->setStretchLastSection(true);
+    m_hitTable->verticalHeader()->setVisible(false);
+    m_hitTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_hitTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_hitTable->setToolTip("双击跳转到该位置");
+    connect(m_hitTable, &QTableWidget::cellDoubleClicked, this, &QueryWidget::onHitActivated);
+    mainLayout->addWidget(m_hitTable, 1);
+
+    setProperty("hasHits", false);
+}
+
+void QueryWidget::setupVTK()
+{
+    m_highlightMapper = vtkSmartPointer<vtkDataSetMapper>::New();
+    m_highlightMapper->ScalarVisibilityOff();
+    m_highlightMapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(-1.0, -1.0);
+
+    m_highlightActor = vtkSmartPointer<vtkActor>::New();
+    m_highlightActor->SetMapper(m_highlightMapper);
+    m_highlightActor->GetProperty()->SetColor(1.0, 0.0, 1.0); // 品红色
+    m_highlightActor->GetProperty()->SetPointSize(8.0);
+    m_highlightActor->GetProperty()->RenderPointsAsSpheresOn();
+}
+
+void QueryWidget::setData(vtkUnstructuredGrid *data)
+{
+    if (m_inputData == data) {
+        return;
+    }
+
+    m_inputData = data;
+    m_engine.clear();
+    onClearQuery();
+}
+
+void QueryWidget::setRenderer(vtkRenderer *renderer)
+{
+    m_renderer = renderer;
+}
+
+void QueryWidget::setActiveScalarArray(const QString &arrayName, bool isPointData)
+{
+    if (m_activeArrayName == arrayName && m_isPointData == isPointData) {
+        return;
+    }
+
+    m_activeArrayName = arrayName;
+    m_isPointData = isPointData;
+    m_arrayLabel->setText(QString("当前数组: %1 (%2)").arg(arrayName).arg(isPointData ? "点数据" : "单元数据"));
+
+    // 结果属于旧数组，清除后更新范围默认值
+    onClearQuery();
+    updateRangeDefaults();
+}
+
+vtkDataArray *QueryWidget::activeArray() const
+{
+    if (!m_inputData || m_activeArrayName.isEmpty()) {
+        return nullptr;
+    }
+
+    QByteArray name = m_activeArrayName.toUtf8();
+    if (m_isPointData) {
+        return m_inputData->GetPointData()->GetArray(name.constData());
+    }
+    return m_inputData->GetCellData()->GetArray(name.constData());
+}
+
+void QueryWidget::updateRangeDefaults()
+{
+    vtkDataArray *array = activeArray();
+    if (!array) {
+        return;
+    }
+
+    // 标量直接取范围；矢量取模的范围（-1分量）
+    double range[2];
+    array->GetRange(range, array->GetNumberOfComponents() == 1 ? 0 : -1);
+
+    // 默认阈值取上部10%
+    m_lowerSpinBox->setValue(range[0] + 0.9 * (range[1] - range[0]));
+    m_upperSpinBox->setValue(range[1]);
+}
+
+void QueryWidget::onQueryTypeChanged(int index)
+{
+    const bool isRange = index == QUERY_RANGE;
+    m_topKSpinBox->setEnabled(!isRange);
+    m_lowerSpinBox->setEnabled(isRange);
+    m_upperSpinBox->setEnabled(isRange);
+}
+
+void QueryWidget::onRunQuery()
+{
+    vtkDataArray *array = activeArray();
+    if (!array) {
+        m_resultLabel->setText("没有可查询的数组");
+        return;
+    }
+
+    switch (m_queryTypeComboBox->currentIndex()) {
+    case QUERY_TOP_LARGEST:
+        m_result = m_engine.topK(array, m_isPointData, m_topKSpinBox->value(), true);
+        break;
+    case QUERY_TOP_SMALLEST:
+        m_result = m_engine.topK(array, m_isPointData, m_topKSpinBox->value(), false);
+        break;
+    default:
+        m_result = m_engine.range(array, m_isPointData, m_lowerSpinBox->value(), m_upperSpinBox->value());
+        break;
+    }
+
+    qDebug() << "QueryWidget: 命中" << m_result.ids.size() << "耗时(ms):" << m_result.elapsedMs
+             << (m_result.indexBuilt ? "（新建索引）" : "（复用索引）");
+
+    m_resultLabel->setText(QString("命中 %1 个%2，耗时 %3 ms%4")
+                               .arg(m_result.ids.size())
+                               .arg(m_isPointData ? "点" : "单元")
+                               .arg(m_result.elapsedMs, 0, 'f', 2)
+                               .arg(m_result.indexBuilt ? "（含索引构建）" : "（复用索引）"));
+
+    populateTable();
+    updateHighlight();
+
+    const bool hasHits = !m_result.ids.empty();
+    setProperty("hasHits", hasHits && m_highlightCheckBox->isChecked());
+    m_clearButton->setEnabled(hasHits);
+    emit queryResultChanged();
+}
+
+void QueryWidget::onClearQuery()
+{
+    m_result = ArrayQueryEngine::Result();
+    m_hitTable->setRowCount(0);
+    m_resultLabel->setText("尚未查询");
+    m_clearButton->setEnabled(false);
+    setProperty("hasHits", false);
+    emit queryResultChanged();
+}
+
+void QueryWidget::onHighlightToggled(bool enabled)
+{
+    setProperty("hasHits", enabled && !m_result.ids.empty());
+    emit queryResultChanged();
+}
+
+void QueryWidget::populateTable()
+{
+    const int rows = static_cast<int>(std::min<size_t>(m_result.ids.size(), MAX_TABLE_ROWS));
+    m_hitTable->setUpdatesEnabled(false);
+    m_hitTable->setRowCount(rows);
+    for (int row = 0; row < rows; ++row) {
+        m_hitTable->setItem(row, 0, new QTableWidgetItem(QString::number(row + 1)));
+        m_hitTable->setItem(row, 1, new QTableWidgetItem(QString::number(m_result.ids[row])));
+        m_hitTable->setItem(row, 2, new QTableWidgetItem(QString::number(m_result.values[row], 'g', 6)));
+    }
+    m_hitTable->setUpdatesEnabled(true);
+
+    if (m_result.ids.size() > static_cast<size_t>(MAX_TABLE_ROWS)) {
+        m_resultLabel->setText(m_resultLabel->text() + QString("，列表仅显示前 %1 个").arg(MAX_TABLE_ROWS));
+    }
+}
+
+void QueryWidget::updateHighlight()
+{
+    if (m_result.ids.empty() || !m_inputData) {
+        return;
+    }
+
+    if (m_isPointData) {
+        m_highlightMapper->SetInputData(SubsetExtractor::extractPoints(m_inputData, m_result.ids));
+    } else {
+        m_highlightMapper->SetInputData(SubsetExtractor::extractCells(m_inputData, m_result.ids));
+    }
+}
+
+void QueryWidget::hitPosition(vtkIdType id, double position[3])
+{
+    if (m_isPointData) {
+        m_inputData->GetPoint(id, position);
+        return;
+    }
+
+    // 单元取包围盒中心
+    double bounds[6];
+    m_inputData->GetCellBounds(id, bounds);
+    position[0] = 0.5 * (bounds[0] + bounds[1]);
+    position[1] = 0.5 * (bounds[2] + bounds[3]);
+    position[2] = 0.5 * (bounds[4] + bounds[5]);
+}
+
+void QueryWidget::onHitActivated(int row, int column)
+{
+    Q_UNUSED(column);
+
+    if (!m_renderer || !m_inputData || row < 0 || row >= static_cast<int>(m_result.ids.size())) {
+        return;
+    }
+
+    double focal[3];
+    hitPosition(m_result.ids[row], focal);
+
+    // 保持视线方向，拉近到命中位置附近
+    vtkCamera *camera = m_renderer->GetActiveCamera();
+    double direction[3];
+    camera->GetDirectionOfProjection(direction);
+
+    const double cellLength = m_inputData->GetLength() /
+                              std::cbrt(static_cast<double>(std::max<vtkIdType>(1, m_inputData->GetNumberOfCells())));
+    const double distance = std::max(20.0 * cellLength, 0.05 * m_inputData->GetLength());
+
+    camera->SetFocalPoint(focal);
+    camera->SetPosition(focal[0] - direction[0] * distance,
+                        focal[1] - direction[1] * distance,
+                        focal[2] - direction[2] * distance);
+    m_renderer->ResetCameraClippingRange();
+
+    qDebug() << "QueryWidget: 跳转到" << (m_isPointData ? "点" : "单元") << m_result.ids[row];
+    emit queryResultChanged();
+}
@@ -0,0 +1,93 @@
+#ifndef QUERYWIDGET_H
+#define QUERYWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QTableWidget>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkRenderer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkDataSetMapper.h>
+#include <vtkActor.h>
+#include <vtkDataArray.h>
+
+#include "analysis/ArrayQueryEngine.h"
+
+// 查询面板：对当前数组做 Top-K 与阈值/范围查询，高亮命中并可跳转相机到命中位置
+class QueryWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit QueryWidget(QWidget *parent = nullptr);
+
+    void setData(vtkUnstructuredGrid *data);
+    void setRenderer(vtkRenderer *renderer);
+    void setActiveScalarArray(const QString &arrayName, bool isPointData);
+    vtkActor *getHighlightActor() const { return m_highlightActor; }
+    // 查询用有序索引占用的内存；释放后在下次查询时重建
+    size_t indexMemorySize() const { return m_engine.memorySize(); }
+    void releaseIndices() { m_engine.clear(); }
+
+signals:
+    void queryResultChanged();
+
+private slots:
+    void onQueryTypeChanged(int index);
+    void onRunQuery();
+    void onClearQuery();
+    void onHighlightToggled(bool enabled);
+    void onHitActivated(int row, int column);
+
+private:
+    enum QueryType {
+        QUERY_TOP_LARGEST,
+        QUERY_TOP_SMALLEST,
+        QUERY_RANGE
+    };
+
+    void setupUI();
+    void setupVTK();
+    vtkDataArray *activeArray() const;
+    void updateRangeDefaults();
+    void updateHighlight();
+    void populateTable();
+    void hitPosition(vtkIdType id, double position[3]);
+
+    // UI组件
+    QLabel *m_arrayLabel;
+    QComboBox *m_queryTypeComboBox;
+    QSpinBox *m_topKSpinBox;
+    QDoubleSpinBox *m_lowerSpinBox;
+    QDoubleSpinBox *m_upperSpinBox;
+    QPushButton *m_runButton;
+    QPushButton *m_clearButton;
+    QCheckBox *m_highlightCheckBox;
+    QLabel *m_resultLabel;
+    QTableWidget *m_hitTable;
+
+    // VTK组件
+    vtkSmartPointer<vtkRenderer> m_renderer;
+    vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
+    vtkSmartPointer<vtkDataSetMapper> m_highlightMapper;
+    vtkSmartPointer<vtkActor> m_highlightActor;
+
+    // 查询
+    ArrayQueryEngine m_engine;
+    ArrayQueryEngine::Result m_result;
+    QString m_activeArrayName;
+    bool m_isPointData;
+};
+
+#endif // QUERYWIDGET_H
@@ -0,0 +1,610 @@
+#include "SelectionWidget.h"
+#include "core/TraceRecorder.h"
+#include "analysis/SubsetExtractor.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vtkCommand.h>
+#include <vtkHardwareSelector.h>
+#include <vtkSelectionNode.h>
+#include <vtkInformation.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIdList.h>
+#include <vtkProperty.h>
+#include <vtkProperty2D.h>
+#include <vtkProp.h>
+#include <vtkDataArray.h>
+#include <vtkDataObject.h>
+#include <algorithm>
+#include <cstdlib>
+
+SelectionWidget::SelectionWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_inputData(nullptr)
+    , m_pressObserver(0)
+    , m_releaseObserver(0)
+    , m_moveObserver(0)
+    , m_dragging(false)
+    , m_selectionIsCells(true)
+    , m_isPointData(true)
+{
+    m_startPosition[0] = m_startPosition[1] = 0;
+    setupUI();
+    setupVTK();
+}
+
+SelectionWidget::~SelectionWidget()
+{
+    removeInteractorObservers();
+}
+
+void SelectionWidget::setupUI()
+{
+    setWindowTitle("区域选择与统计");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // 选择模式开关
+    m_enableSelectionCheckBox = new QCheckBox("启用区域选择（拖动鼠标框选）", this);
+    connect(m_enableSelectionCheckBox, &QCheckBox::toggled,
+            this, &SelectionWidget::onSelectionModeToggled);
+    mainLayout->addWidget(m_enableSelectionCheckBox);
+
+    QGroupBox *modeGroup = new QGroupBox("选择方式", this);
+    QFormLayout *modeLayout = new QFormLayout(modeGroup);
+
+    m_shapeComboBox = new QComboBox(this);
+    m_shapeComboBox->addItem("矩形");
+    m_shapeComboBox->addItem("套索");
+    modeLayout->addRow("形状:", m_shapeComboBox);
+
+    m_targetComboBox = new QComboBox(this);
+    m_targetComboBox->addItem("可见单元");
+    m_targetComboBox->addItem("可见点");
+    modeLayout->addRow("选择对象:", m_targetComboBox);
+
+    mainLayout->addWidget(modeGroup);
+
+    // 统计结果
+    QGroupBox *statsGroup = new QGroupBox("选区统计", this);
+    QFormLayout *statsLayout = new QFormLayout(statsGroup);
+
+    m_countLabel = new QLabel("-", this);
+    m_minLabel = new QLabel("-", this);
+    m_maxLabel = new QLabel("-", this);
+    m_meanLabel = new QLabel("-", this);
+    m_integralLabel = new QLabel("-", this);
+    m_measureLabel = new QLabel("-", this);
+    m_timingLabel = new QLabel("-", this);
+
+    statsLayout->addRow("数量:", m_countLabel);
+    statsLayout->addRow("最小值:", m_minLabel);
+    statsLayout->addRow("最大值:", m_maxLabel);
+    statsLayout->addRow("平均值:", m_meanLabel);
+    statsLayout->addRow("积分:", m_integralLabel);
+    statsLayout->addRow("总体积/面积:", m_measureLabel);
+    statsLayout->addRow("耗时:", m_timingLabel);
+
+    mainLayout->addWidget(statsGroup);
+
+    // 操作按钮
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+
+    m_extractButton = new QPushButton("提取为独立对象", this);
+    m_extractButton->setEnabled(false);
+    connect(m_extractButton, &QPushButton::clicked, this, &SelectionWidget::onExtractSelection);
+    buttonLayout->addWidget(m_extractButton);
+
+    m_clearButton = new QPushButton("清除选择", this);
+    m_clearButton->setEnabled(false);
+    connect(m_clearButton, &QPushButton::clicked, this, &SelectionWidget::onClearSelection);
+    buttonLayout->addWidget(m_clearButton);
+
+    mainLayout->addLayout(buttonLayout);
+
+    m_clearExtractedButton = new QPushButton("清除已提取对象", this);
+    m_clearExtractedButton->setEnabled(false);
+    connect(m_clearExtractedButton, &QPushButton::clicked, this, &SelectionWidget::onClearExtracted);
+    mainLayout->addWidget(m_clearExtractedButton);
+
+    mainLayout->addStretch();
+
+    setProperty("selectionModeEnabled", false);
+    setProperty("hasSelection", false);
+}
+
+void SelectionWidget::setupVTK()
+{
+    // 橡皮筋轮廓（显示坐标）
+    m_rubberBandPoints = vtkSmartPointer<vtkPoints>::New();
+    m_rubberBandData = vtkSmartPointer<vtkPolyData>::New();
+    m_rubberBandData->SetPoints(m_rubberBandPoints);
+    m_rubberBandData->SetLines(vtkSmartPointer<vtkCellArray>::New());
+
+    m_rubberBandMapper = vtkSmartPointer<vtkPolyDataMapper2D>::New();
+    m_rubberBandMapper->SetInputData(m_rubberBandData);
+
+    m_rubberBandActor = vtkSmartPointer<vtkActor2D>::New();
+    m_rubberBandActor->SetMapper(m_rubberBandMapper);
+    m_rubberBandActor->GetProperty()->SetColor(1.0, 1.0, 0.0);
+    m_rubberBandActor->GetProperty()->SetLineWidth(2.0);
+
+    // 选区高亮，偏移深度避免与主模型表面闪烁
+    m_highlightMapper = vtkSmartPointer<vtkDataSetMapper>::New();
+    m_highlightMapper->ScalarVisibilityOff();
+    m_highlightMapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(-1.0, -1.0);
+
+    m_highlightActor = vtkSmartPointer<vtkActor>::New();
+    m_highlightActor->SetMapper(m_highlightMapper);
+    m_highlightActor->GetProperty()->SetColor(1.0, 0.5, 0.0);
+    m_highlightActor->GetProperty()->SetPointSize(5.0);
+    m_highlightActor->GetProperty()->SetOpacity(0.6);
+}
+
+void SelectionWidget::setData(vtkUnstructuredGrid *data)
+{
+    if (m_inputData == data) {
+        return;
+    }
+
+    m_inputData = data;
+    clearSelectionState();
+
+    // 已提取的对象属于旧网格，一并清除
+    if (m_renderer) {
+        for (const vtkSmartPointer<vtkActor> &actor : m_extractedActors) {
+            m_renderer->RemoveActor(actor);
+        }
+    }
+    m_extractedActors.clear();
+    m_clearExtractedButton->setEnabled(false);
+}
+
+void SelectionWidget::setRenderer(vtkRenderer *renderer)
+{
+    m_renderer = renderer;
+}
+
+void SelectionWidget::setInteractor(vtkRenderWindowInteractor *interactor)
+{
+    if (m_interactor == interactor) {
+        return;
+    }
+
+    // 切换交互器前先退出选择模式，恢复原交互样式
+    if (m_enableSelectionCheckBox->isChecked()) {
+        m_enableSelectionCheckBox->setChecked(false);
+    }
+    m_interactor = interactor;
+}
+
+void SelectionWidget::setMainActor(vtkActor *actor)
+{
+    m_mainActor = actor;
+}
+
+void SelectionWidget::setActiveScalarArray(const QString &arrayName, bool isPointData)
+{
+    if (m_activeArrayName == arrayName && m_isPointData == isPointData) {
+        return;
+    }
+
+    m_activeArrayName = arrayName;
+    m_isPointData = isPointData;
+
+    // 选区不变，仅针对新数组重新统计
+    if (!m_selectedIds.empty()) {
+        updateStatistics();
+    }
+}
+
+vtkDataArray *SelectionWidget::activeArray() const
+{
+    if (!m_inputData || m_activeArrayName.isEmpty()) {
+        return nullptr;
+    }
+
+    QByteArray name = m_activeArrayName.toUtf8();
+    if (m_isPointData) {
+        return m_inputData->GetPointData()->GetArray(name.constData());
+    }
+    return m_inputData->GetCellData()->GetArray(name.constData());
+}
+
+void SelectionWidget::onSelectionModeToggled(bool enabled)
+{
+    setProperty("selectionModeEnabled", enabled);
+
+    if (!m_interactor) {
+        return;
+    }
+
+    if (enabled) {
+        // 暂时卸下相机交互样式，左键拖动改为画选择区域
+        m_savedStyle = m_interactor->GetInteractorStyle();
+        m_interactor->SetInteractorStyle(nullptr);
+
+        m_pressObserver = m_interactor->AddObserver(vtkCommand::LeftButtonPressEvent,
+                                                    this, &SelectionWidget::onInteractorEvent);
+        m_releaseObserver = m_interactor->AddObserver(vtkCommand::LeftButtonReleaseEvent,
+                                                      this, &SelectionWidget::onInteractorEvent);
+        m_moveObserver = m_interactor->AddObserver(vtkCommand::MouseMoveEvent,
+                                                   this, &SelectionWidget::onInteractorEvent);
+    } else {
+        removeInteractorObservers();
+        if (m_dragging) {
+            endRubberBand();
+        }
+        if (m_savedStyle) {
+            m_interactor->SetInteractorStyle(m_savedStyle);
+            m_savedStyle = nullptr;
+        }
+    }
+}
+
+void SelectionWidget::removeInteractorObservers()
+{
+    if (m_interactor) {
+        m_interactor->RemoveObserver(m_pressObserver);
+        m_interactor->RemoveObserver(m_releaseObserver);
+        m_interactor->RemoveObserver(m_moveObserver);
+    }
+    m_pressObserver = m_releaseObserver = m_moveObserver = 0;
+}
+
+void SelectionWidget::onInteractorEvent(vtkObject *caller, unsigned long eventId, void *callData)
+{
+    Q_UNUSED(caller);
+    Q_UNUSED(callData);
+
+    const int *position = m_interactor->GetEventPosition();
+
+    switch (eventId) {
+    case vtkCommand::LeftButtonPressEvent:
+        beginRubberBand(position[0], position[1]);
+        break;
+
+    case vtkCommand::MouseMoveEvent:
+        if (m_dragging) {
+            updateRubberBand(position[0], position[1]);
+        }
+        break;
+
+    case vtkCommand::LeftButtonReleaseEvent:
+        if (m_dragging) {
+            updateRubberBand(position[0], position[1]);
+            endRubberBand();
+            performSelection();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void SelectionWidget::beginRubberBand(int x, int y)
+{
+    if (!m_renderer || !m_inputData) {
+        return;
+    }
+
+    m_dragging = true;
+    m_startPosition[0] = x;
+    m_startPosition[1] = y;
+    m_lassoPolygon.clear();
+    m_lassoPolygon.push_back(x);
+    m_lassoPolygon.push_back(y);
+
+    m_rubberBandPoints->Reset();
+    m_rubberBandData->GetLines()->Reset();
+    m_rubberBandData->Modified();
+    m_renderer->AddActor2D(m_rubberBandActor);
+}
+
+void SelectionWidget::updateRubberBand(int x, int y)
+{
+    m_rubberBandPoints->Reset();
+
+    if (m_shapeComboBox->currentIndex() == SHAPE_RECTANGLE) {
+        m_rubberBandPoints->InsertNextPoint(m_startPosition[0], m_startPosition[1], 0.0);
+        m_rubberBandPoints->InsertNextPoint(x, m_startPosition[1], 0.0);
+        m_rubberBandPoints->InsertNextPoint(x, y, 0.0);
+        m_rubberBandPoints->InsertNextPoint(m_startPosition[0], y, 0.0);
+    } else {
+        // 套索：移动超过2像素才记录新顶点，避免多边形过密
+        const size_t n = m_lassoPolygon.size();
+        if (std::abs(x - m_lassoPolygon[n - 2]) + std::abs(y - m_lassoPolygon[n - 1]) > 2) {
+            m_lassoPolygon.push_back(x);
+            m_lassoPolygon.push_back(y);
+        }
+        for (size_t i = 0; i < m_lassoPolygon.size(); i += 2) {
+            m_rubberBandPoints->InsertNextPoint(m_lassoPolygon[i], m_lassoPolygon[i + 1], 0.0);
+        }
+    }
+
+    // 闭合折线
+    const vtkIdType numPoints = m_rubberBandPoints->GetNumberOfPoints();
+    vtkCellArray *lines = m_rubberBandData->GetLines();
+    lines->Reset();
+    lines->InsertNextCell(numPoints + 1);
+    for (vtkIdType i = 0; i < numPoints; ++i) {
+        lines->InsertCellPoint(i);
+    }
+    lines->InsertCellPoint(0);
+
+    m_rubberBandPoints->Modified();
+    m_rubberBandData->Modified();
+    m_renderer->GetRenderWindow()->Render();
+}
+
+void SelectionWidget::endRubberBand()
+{
+    m_dragging = false;
+    if (m_renderer) {
+        m_renderer->RemoveActor2D(m_rubberBandActor);
+    }
+}
+
+vtkPolyData *SelectionWidget::surfaceForMapping()
+{
+    // 主演员绘制的是 SurfaceExtractor 提取的表面，硬件选择返回的就是该表面的ID，无需再提取一次
+    if (!m_mainActor || !m_mainActor->GetMapper()) {
+        return nullptr;
+    }
+    return vtkPolyData::SafeDownCast(m_mainActor->GetMapper()->GetInput());
+}
+
+std::vector<vtkIdType> SelectionWidget::collectSelectedIds(vtkSelection *selection, bool selectCells)
+{
+    std::vector<vtkIdType> result;
+
+    vtkPolyData *surface = surfaceForMapping();
+    if (!surface) {
+        return result;
+    }
+    vtkIdTypeArray *originalIds = vtkIdTypeArray::SafeDownCast(selectCells
+        ? surface->GetCellData()->GetArray("vtkOriginalCellIds")
+        : surface->GetPointData()->GetArray("vtkOriginalPointIds"));
+    if (!originalIds) {
+        qDebug() << "SelectionWidget: 表面缺少原始ID数组";
+        return result;
+    }
+
+    // 一个体单元可能有多个可见面，用标记数组去重
+    const vtkIdType numTargets = selectCells ? m_inputData->GetNumberOfCells()
+                                             : m_inputData->GetNumberOfPoints();
+    const vtkIdType numSurfaceIds = originalIds->GetNumberOfTuples();
+    std::vector<unsigned char> mask(numTargets, 0);
+    vtkIdType selectedCount = 0;
+
+    for (unsigned int n = 0; n < selection->GetNumberOfNodes(); ++n) {
+        vtkSelectionNode *node = selection->GetNode(n);
+        // 只统计主模型，忽略剖切、等值面、流线等辅助对象
+        vtkProp *prop = vtkProp::SafeDownCast(node->GetProperties()->Get(vtkSelectionNode::PROP()));
+        if (!prop || prop != m_mainActor.GetPointer()) {
+            continue;
+        }
+
+        vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(node->GetSelectionList());
+        if (!ids) {
+            continue;
+        }
+
+        const vtkIdType count = ids->GetNumberOfTuples();
+        for (vtkIdType i = 0; i < count; ++i) {
+            const vtkIdType surfaceId = ids->GetValue(i);
+            if (surfaceId < 0 || surfaceId >= numSurfaceIds) {
+                continue;
+            }
+            const vtkIdType originalId = originalIds->GetValue(surfaceId);
+            if (originalId >= 0 && originalId < numTargets && !mask[originalId]) {
+                mask[originalId] = 1;
+                ++selectedCount;
+            }
+        }
+    }
+
+    result.reserve(selectedCount);
+    for (vtkIdType id = 0; id < numTargets; ++id) {
+        if (mask[id]) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+void SelectionWidget::performSelection()
+{
+    TRACE_SCOPE("SelectionWidget::performSelection", "ui");
+    if (!m_renderer || !m_inputData || !m_mainActor) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool selectCells = m_targetComboBox->currentIndex() == 0;
+    const int *size = m_renderer->GetRenderWindow()->GetSize();
+    auto clampX = [size](int x) { return std::max(0, std::min(x, size[0] - 1)); };
+    auto clampY = [size](int y) { return std::max(0, std::min(y, size[1] - 1)); };
+
+    vtkSmartPointer<vtkHardwareSelector> selector = vtkSmartPointer<vtkHardwareSelector>::New();
+    selector->SetRenderer(m_renderer);
+    selector->SetFieldAssociation(selectCells ? vtkDataObject::FIELD_ASSOCIATION_CELLS
+                                              : vtkDataObject::FIELD_ASSOCIATION_POINTS);
+
+    vtkSmartPointer<vtkSelection> selection;
+
+    if (m_shapeComboBox->currentIndex() == SHAPE_LASSO && m_lassoPolygon.size() >= 6) {
+        // 套索：按包围盒捕获ID缓冲，再逐像素做多边形内测试
+        int xmin = m_lassoPolygon[0], xmax = m_lassoPolygon[0];
+        int ymin = m_lassoPolygon[1], ymax = m_lassoPolygon[1];
+        for (size_t i = 0; i < m_lassoPolygon.size(); i += 2) {
+            xmin = std::min(xmin, m_lassoPolygon[i]);
+            xmax = std::max(xmax, m_lassoPolygon[i]);
+            ymin = std::min(ymin, m_lassoPolygon[i + 1]);
+            ymax = std::max(ymax, m_lassoPolygon[i + 1]);
+        }
+        selector->SetArea(clampX(xmin), clampY(ymin), clampX(xmax), clampY(ymax));
+        if (selector->CaptureBuffers()) {
+            selection = vtkSmartPointer<vtkSelection>::Take(
+                selector->GeneratePolygonSelection(m_lassoPolygon.data(),
+                                                   static_cast<vtkIdType>(m_lassoPolygon.size())));
+            selector->ClearBuffers();
+        }
+    } else {
+        const int *end = m_interactor->GetEventPosition();
+        selector->SetArea(clampX(std::min(m_startPosition[0], end[0])),
+                          clampY(std::min(m_startPosition[1], end[1])),
+                          clampX(std::max(m_startPosition[0], end[0])),
+                          clampY(std::max(m_startPosition[1], end[1])));
+        selection = vtkSmartPointer<vtkSelection>::Take(selector->Select());
+    }
+
+    const qint64 bufferMs = timer.elapsed();
+
+    m_selectionIsCells = selectCells;
+    m_selectedIds = selection ? collectSelectedIds(selection, selectCells) : std::vector<vtkIdType>();
+
+    qDebug() << "SelectionWidget: 选中" << (selectCells ? "单元" : "点") << m_selectedIds.size()
+             << "ID缓冲耗时(ms):" << bufferMs << "总耗时(ms):" << timer.elapsed();
+
+    updateHighlight();
+    updateStatistics();
+
+    const bool hasSelection = !m_selectedIds.empty();
+    setProperty("hasSelection", hasSelection);
+    m_extractButton->setEnabled(hasSelection);
+    m_clearButton->setEnabled(hasSelection);
+
+    emit selectionChanged();
+}
+
+void SelectionWidget::updateHighlight()
+{
+    if (m_selectedIds.empty()) {
+        m_selectionData = nullptr;
+        return;
+    }
+
+    if (m_selectionIsCells) {
+        m_selectionData = SubsetExtractor::extractCells(m_inputData, m_selectedIds);
+    } else {
+        // 点选区用顶点表示，并带上当前数组以便提取后着色
+        m_selectionData = SubsetExtractor::extractPoints(m_inputData, m_selectedIds,
+                                                         m_isPointData ? activeArray() : nullptr);
+    }
+
+    m_highlightMapper->SetInputData(m_selectionData);
+}
+
+void SelectionWidget::updateStatistics()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    vtkDataArray *array = activeArray();
+    if (!array || m_selectedIds.empty()) {
+        m_statistics = FieldStatistics();
+    } else if (m_selectionIsCells) {
+        m_statistics = FieldStatistics::computeOverCells(m_inputData, array, m_isPointData, m_selectedIds);
+    } else if (m_isPointData) {
+        m_statistics = FieldStatistics::computeOverPoints(array, m_selectedIds);
+    } else {
+        // 选点时单元数据无法直接对应，仅给出数量
+        m_statistics = FieldStatistics();
+        m_statistics.count = static_cast<vtkIdType>(m_selectedIds.size());
+    }
+
+    const qint64 statsMs = timer.elapsed();
+    const bool hasValues = array && m_statistics.count > 0 && (m_selectionIsCells || m_isPointData);
+
+    m_countLabel->setText(QString("%1 个%2").arg(m_selectedIds.size()).arg(m_selectionIsCells ? "单元" : "点"));
+    m_minLabel->setText(hasValues ? QString::number(m_statistics.minimum, 'g', 6) : "-");
+    m_maxLabel->setText(hasValues ? QString::number(m_statistics.maximum, 'g', 6) : "-");
+    m_meanLabel->setText(hasValues ? QString::number(m_statistics.mean, 'g', 6) : "-");
+    m_integralLabel->setText(hasValues && m_statistics.hasIntegral
+                                 ? QString::number(m_statistics.integral, 'g', 6) : "-");
+    m_measureLabel->setText(m_statistics.hasIntegral ? QString::number(m_statistics.measure, 'g', 6) : "-");
+    m_timingLabel->setText(QString("统计 %1 ms").arg(statsMs));
+}
+
+void SelectionWidget::onExtractSelection()
+{
+    TRACE_SCOPE("SelectionWidget::onExtractSelection", "ui");
+    if (!m_selectionData || !m_mainActor) {
+        return;
+    }
+
+    // 深拷贝当前选区，沿用主模型的颜色映射
+    vtkSmartPointer<vtkDataSet> copy = vtkSmartPointer<vtkDataSet>::Take(m_selectionData->NewInstance());
+    copy->DeepCopy(m_selectionData);
+
+    vtkSmartPointer<vtkDataSetMapper> mapper = vtkSmartPointer<vtkDataSetMapper>::New();
+    mapper->SetInputData(copy);
+    mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(-1.0, -1.0);
+
+    vtkMapper *mainMapper = m_mainActor->GetMapper();
+    if (mainMapper && !m_activeArrayName.isEmpty()) {
+        QByteArray name = m_activeArrayName.toUtf8();
+        mapper->SetLookupTable(mainMapper->GetLookupTable());
+        mapper->SetScalarRange(mainMapper->GetScalarRange());
+        mapper->SetScalarMode(m_isPointData ? VTK_SCALAR_MODE_USE_POINT_FIELD_DATA
+                                            : VTK_SCALAR_MODE_USE_CELL_FIELD_DATA);
+        mapper->SelectColorArray(name.constData());
+        mapper->ScalarVisibilityOn();
+    } else {
+        mapper->ScalarVisibilityOff();
+    }
+
+    vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+    actor->GetProperty()->SetPointSize(5.0);
+    m_extractedActors.append(actor);
+
+    qDebug() << "SelectionWidget: 已提取选区为独立对象，共" << m_extractedActors.size() << "个";
+
+    m_clearExtractedButton->setEnabled(true);
+    onClearSelection();
+}
+
+void SelectionWidget::onClearSelection()
+{
+    clearSelectionState();
+    emit selectionChanged();
+}
+
+void SelectionWidget::onClearExtracted()
+{
+    if (m_renderer) {
+        for (const vtkSmartPointer<vtkActor> &actor : m_extractedActors) {
+            m_renderer->RemoveActor(actor);
+        }
+    }
+    m_extractedActors.clear();
+    m_clearExtractedButton->setEnabled(false);
+    emit selectionChanged();
+}
+
+void SelectionWidget::clearSelectionState()
+{
+    m_selectedIds.clear();
+    m_selectionData = nullptr;
+    m_statistics = FieldStatistics();
+
+    if (m_renderer) {
+        m_renderer->RemoveActor(m_highlightActor);
+    }
+
+    setProperty("hasSelection", false);
+    m_extractButton->setEnabled(false);
+    m_clearButton->setEnabled(false);
+
+    m_countLabel->setText("-");
+    m_minLabel->setText("-");
+    m_maxLabel->setText("-");
+    m_meanLabel->setText("-");
+    m_integralLabel->setText("-");
+    m_measureLabel->setText("-");
+    m_timingLabel->setText("-");
+}
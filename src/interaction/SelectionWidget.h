@@ -0,0 +1,137 @@
+#ifndef SELECTIONWIDGET_H
+#define SELECTIONWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+#include <QComboBox>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QGroupBox>
+#include <QList>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkInteractorObserver.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkDataSetMapper.h>
+#include <vtkPolyDataMapper2D.h>
+#include <vtkActor.h>
+#include <vtkActor2D.h>
+#include <vtkSelection.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+
+#include "analysis/FieldStatistics.h"
+
+// 区域选择：在视图中拖出矩形或套索，通过硬件ID缓冲选取可见单元/点，
+// 并对选区做并行统计（最小/最大/平均/积分），可将选区提取为独立对象
+class SelectionWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SelectionWidget(QWidget *parent = nullptr);
+    ~SelectionWidget();
+
+    void setData(vtkUnstructuredGrid *data);
+    void setRenderer(vtkRenderer *renderer);
+    void setInteractor(vtkRenderWindowInteractor *interactor);
+    void setMainActor(vtkActor *actor);
+    void setActiveScalarArray(const QString &arrayName, bool isPointData);
+
+    vtkActor *getHighlightActor() const { return m_highlightActor; }
+    const QList<vtkSmartPointer<vtkActor>> &getExtractedActors() const { return m_extractedActors; }
+
+signals:
+    void selectionChanged();
+
+private slots:
+    void onSelectionModeToggled(bool enabled);
+    void onExtractSelection();
+    void onClearSelection();
+    void onClearExtracted();
+
+private:
+    enum SelectionShape {
+        SHAPE_RECTANGLE,
+        SHAPE_LASSO
+    };
+
+    void setupUI();
+    void setupVTK();
+    void onInteractorEvent(vtkObject *caller, unsigned long eventId, void *callData);
+    void removeInteractorObservers();
+
+    // 橡皮筋轮廓
+    void beginRubberBand(int x, int y);
+    void updateRubberBand(int x, int y);
+    void endRubberBand();
+
+    // 执行硬件选择并统计
+    void performSelection();
+    vtkPolyData *surfaceForMapping();
+    std::vector<vtkIdType> collectSelectedIds(vtkSelection *selection, bool selectCells);
+    void updateHighlight();
+    void updateStatistics();
+    vtkDataArray *activeArray() const;
+    void clearSelectionState();
+
+    // UI组件
+    QCheckBox *m_enableSelectionCheckBox;
+    QComboBox *m_shapeComboBox;
+    QComboBox *m_targetComboBox;
+    QLabel *m_countLabel;
+    QLabel *m_minLabel;
+    QLabel *m_maxLabel;
+    QLabel *m_meanLabel;
+    QLabel *m_integralLabel;
+    QLabel *m_measureLabel;
+    QLabel *m_timingLabel;
+    QPushButton *m_extractButton;
+    QPushButton *m_clearButton;
+    QPushButton *m_clearExtractedButton;
+
+    // VTK组件
+    vtkSmartPointer<vtkRenderer> m_renderer;
+    vtkSmartPointer<vtkRenderWindowInteractor> m_interactor;
+    vtkSmartPointer<vtkInteractorObserver> m_savedStyle;
+    vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
+    vtkSmartPointer<vtkActor> m_mainActor;
+
+    vtkSmartPointer<vtkPoints> m_rubberBandPoints;
+    vtkSmartPointer<vtkPolyData> m_rubberBandData;
+    vtkSmartPointer<vtkPolyDataMapper2D> m_rubberBandMapper;
+    vtkSmartPointer<vtkActor2D> m_rubberBandActor;
+
+    vtkSmartPointer<vtkDataSet> m_selectionData;
+    vtkSmartPointer<vtkDataSetMapper> m_highlightMapper;
+    vtkSmartPointer<vtkActor> m_highlightActor;
+    QList<vtkSmartPointer<vtkActor>> m_extractedActors;
+
+    // 交互器观察者
+    unsigned long m_pressObserver;
+    unsigned long m_releaseObserver;
+    unsigned long m_moveObserver;
+    bool m_dragging;
+    int m_startPosition[2];
+    std::vector<int> m_lassoPolygon;
+
+    // 选区
+    std::vector<vtkIdType> m_selectedIds;
+    bool m_selectionIsCells;
+    FieldStatistics m_statistics;
+    QString m_activeArrayName;
+    bool m_isPointData;
+};
+
+#endif // SELECTIONWIDGET_H
@@ -0,0 +1,249 @@
+#include "AbaqusInpReader.h"
+#include "MeshBuilder.h"
+#include "TextParsing.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QSet>
+#include <vtkCellType.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <cstring>
+#include <vector>
+
+using namespace TextParsing;
+
+namespace
+{
+// 不同 *PART 的节点号加上该间隔以互不冲突，NodeID 数组中再去掉
+const vtkIdType PART_ID_STRIDE = vtkIdType(1) << 40;
+
+struct ElementType
+{
+    int cellType;
+    int nodes;
+};
+
+// 由单元类型名得到 VTK 单元类型：前缀确定单元族，其后的数字为节点数
+ElementType elementType(const QByteArray &name)
+{
+    const QByteArray type = name.trimmed().toUpper();
+
+    static const struct
+    {
+        const char *prefix;
+        ElementType type;
+    } lineTypes[] = {
+        {"B21", {VTK_LINE, 2}}, {"B22", {VTK_QUADRATIC_EDGE, 3}}, {"B31", {VTK_LINE, 2}},
+        {"B32", {VTK_QUADRATIC_EDGE, 3}}, {"B33", {VTK_LINE, 2}}, {"T2D2", {VTK_LINE, 2}},
+        {"T2D3", {VTK_QUADRATIC_EDGE, 3}}, {"T3D2", {VTK_LINE, 2}}, {"T3D3", {VTK_QUADRATIC_EDGE, 3}},
+        {"STRI3", {VTK_TRIANGLE, 3}}};
+    for (const auto &entry : lineTypes) {
+        if (type.startsWith(entry.prefix)) {
+            return entry.type;
+        }
+    }
+
+    // 前缀按长度从长到短，避免 "S" 先于 "SC"、"SFM3D" 匹配
+    static const char *solidPrefixes[] = {"DC3D", "C3D", "SC"};
+    static const char *surfacePrefixes[] = {"SFM3D", "CGAX", "DC2D", "DCAX", "CPS", "CPE", "CAX", "M3D", "R3D", "S"};
+
+    auto nodeCount = [&type](const char *prefix) {
+        int count = 0;
+        for (int i = static_cast<int>(std::strlen(prefix)); i < type.size() && type[i] >= '0' && type[i] <= '9'; ++i) {
+            count = count * 10 + (type[i] - '0');
+        }
+        return count;
+    };
+
+    for (const char *prefix : solidPrefixes) {
+        if (type.startsWith(prefix)) {
+            switch (nodeCount(prefix)) {
+            case 4: return {VTK_TETRA, 4};
+            case 5: return {VTK_PYRAMID, 5};
+            case 6: return {VTK_WEDGE, 6};
+            case 8: return {VTK_HEXAHEDRON, 8};
+            case 10: return {VTK_QUADRATIC_TETRA, 10};
+            case 15: return {VTK_QUADRATIC_WEDGE, 15};
+            case 20: return {VTK_QUADRATIC_HEXAHEDRON, 20};
+            default: return {0, 0};
+            }
+        }
+    }
+    for (const char *prefix : surfacePrefixes) {
+        if (type.startsWith(prefix)) {
+            switch (nodeCount(prefix)) {
+            case 3: return {VTK_TRIANGLE, 3};
+            case 4: return {VTK_QUAD, 4};
+            case 6: return {VTK_QUADRATIC_TRIANGLE, 6};
+            case 8: return {VTK_QUADRATIC_QUAD, 8};
+            case 9: return {VTK_BIQUADRATIC_QUAD, 9};
+            default: return {0, 0};
+            }
+        }
+    }
+    return {0, 0};
+}
+
+// 关键字行之后的数据块：到下一个关键字行（'*' 开头且不是 "**" 注释）为止
+const char *findDataEnd(const char *p, const char *end)
+{
+    while (p < end) {
+        if (*p == '*' && (p + 1 >= end || p[1] != '*')) {
+            return p;
+        }
+        p = nextLine(p, end);
+    }
+    return end;
+}
+
+// 关键字行 "*ELEMENT, TYPE=C3D8R, ELSET=x" 中的参数值
+QByteArray parameter(const QList<QByteArray> &parts, const char *key)
+{
+    for (int i = 1; i < parts.size(); ++i) {
+        const int equals = parts[i].indexOf('=');
+        if (equals > 0 && parts[i].left(equals).trimmed().toUpper() == key) {
+            return parts[i].mid(equals + 1).trimmed();
+        }
+    }
+    return QByteArray();
+}
+
+// 数据块首个非注释行的数值个数（*NODE 为 4 或 3，对应三维或二维坐标）
+int valuesOnFirstLine(const char *p, const char *end)
+{
+    while (p < end && *p == '*') {
+        p = nextLine(p, end);
+    }
+    return static_cast<int>(countTokens(p, lineEnd(p, end), '\0'));
+}
+}
+
+MeshReader::SniffResult AbaqusInpReader::sniff(const QByteArray &head) const
+{
+    const QByteArray upper = head.toUpper();
+    if (upper.startsWith("*HEADING") || upper.startsWith("*NODE") || upper.contains("\n*NODE")
+        || upper.contains("\n*ELEMENT") || upper.contains("\n*PART")) {
+        return Matched;
+    }
+    // 开头只有注释时无法判断
+    return upper.startsWith("**") ? Unknown : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> AbaqusInpReader::read(const QString &fileName, QString *error)
+{
+    TRACE_SCOPE("AbaqusInpReader::read", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(fileName);
+    const uchar *mapped = file.open(QIODevice::ReadOnly) && file.size() > 0 ? file.map(0, file.size()) : nullptr;
+    if (!mapped) {
+        if (error) {
+            *error = QString("无法打开文件: %1").arg(file.errorString());
+        }
+        return nullptr;
+    }
+    const char *p = reinterpret_cast<const char *>(mapped);
+    const char *end = p + file.size();
+
+    MeshBuilder builder;
+    int part = 0;
+    bool hasParts = false;
+    QSet<QByteArray> skippedTypes;
+
+    while (p < end) {
+        const char *lineStart = p;
+        p = nextLine(p, end);
+        if (*lineStart != '*' || (lineStart + 1 < end && lineStart[1] == '*')) {
+            continue;
+        }
+
+        const QList<QByteArray> parts = QByteArray(lineStart, static_cast<int>(lineEnd(lineStart, end) - lineStart)).split(',');
+        const QByteArray keyword = parts[0].trimmed().toUpper();
+
+        if (keyword == "*PART" || keyword == "*END PART") {
+            ++part;
+            hasParts = true;
+        } else if (keyword == "*INCLUDE") {
+            qDebug() << "AbaqusInpReader: 忽略 *INCLUDE" << parameter(parts, "INPUT");
+        } else if (keyword == "*NODE") {
+            const char *dataEnd = findDataEnd(p, end);
+            const int perNode = valuesOnFirstLine(p, dataEnd);
+            std::vector<double> values;
+            if (perNode < 3 || perNode > 4 || !parseTokens(p, dataEnd, values, '*') || values.size() % perNode != 0) {
+                if (error) {
+                    *error = "*NODE 数据无效";
+                }
+                return nullptr;
+            }
+
+            const vtkIdType count = static_cast<vtkIdType>(values.size() / perNode);
+            const vtkIdType first = static_cast<vtkIdType>(builder.nodeIds.size());
+            const vtkIdType idOffset = part * PART_ID_STRIDE;
+            builder.nodeIds.resize(first + count);
+            builder.coordinates.resize((first + count) * 3);
+            vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType last) {
+                for (vtkIdType i = begin; i < last; ++i) {
+                    const double *record = values.data() + i * perNode;
+                    double *xyz = builder.coordinates.data() + (first + i) * 3;
+                    builder.nodeIds[first + i] = static_cast<vtkIdType>(record[0]) + idOffset;
+                    xyz[0] = record[1];
+                    xyz[1] = record[2];
+                    xyz[2] = perNode == 4 ? record[3] : 0.0;
+                }
+            });
+            p = dataEnd;
+        } else if (keyword == "*ELEMENT") {
+            const char *dataEnd = findDataEnd(p, end);
+            const QByteArray typeName = parameter(parts, "TYPE");
+            const ElementType type = elementType(typeName);
+            if (type.cellType == 0) {
+                skippedTypes.insert(typeName);
+                p = dataEnd;
+                continue;
+            }
+
+            // 一个单元可以跨多行（超过 16 个数值时续行），按平铺的数值流整体解析
+            std::vector<vtkIdType> records;
+            if (!parseTokens(p, dataEnd, records, '*') || records.size() % (type.nodes + 1) != 0) {
+                if (error) {
+                    *error = QString("*ELEMENT TYPE=%1 数据无效").arg(QString::fromUtf8(typeName));
+                }
+                return nullptr;
+            }
+            builder.appendElements(type.cellType, type.nodes, records.data(),
+                                   static_cast<vtkIdType>(records.size() / (type.nodes + 1)), nullptr,
+                                   part * PART_ID_STRIDE);
+            p = dataEnd;
+        }
+    }
+
+    if (!skippedTypes.isEmpty()) {
+        qDebug() << "AbaqusInpReader: 跳过不支持的单元类型" << skippedTypes.values();
+    }
+    if (builder.nodeIds.empty() || builder.elementCount() == 0) {
+        if (error) {
+            *error = "文件中没有节点或单元";
+        }
+        return nullptr;
+    }
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = builder.build(error);
+    if (grid && hasParts) {
+        // 去掉部件间隔，NodeID 显示求解器中的节点号
+        vtkIdTypeArray *nodeIds = vtkIdTypeArray::SafeDownCast(grid->GetPointData()->GetArray("NodeID"));
+        for (vtkIdType i = 0; nodeIds && i < nodeIds->GetNumberOfValues(); ++i) {
+            nodeIds->SetValue(i, nodeIds->GetValue(i) % PART_ID_STRIDE);
+        }
+    }
+
+    if (grid) {
+        qDebug() << "AbaqusInpReader: 节点数:" << grid->GetNumberOfPoints() << "单元数:" << grid->GetNumberOfCells()
+                 << "耗时(ms):" << timer.elapsed();
+    }
+    return grid;
+}
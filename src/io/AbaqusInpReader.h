@@ -0,0 +1,19 @@
+#ifndef ABAQUSINPREADER_H
+#define ABAQUSINPREADER_H
+
+#include "ReaderRegistry.h"
+
+// Abaqus 输入文件 (.inp) 网格读取：*NODE 与 *ELEMENT 数据块按行切分后并行解析，
+// 支持实体、壳/平面、梁/杆单元的一阶与二阶类型。
+// 各 *PART 的节点号相互独立；装配体中实例的平移/旋转不做变换，部件按自身坐标显示
+class AbaqusInpReader : public MeshReader
+{
+public:
+    QString name() const override { return "Abaqus输入文件"; }
+    QStringList extensions() const override { return QStringList() << "inp"; }
+    int capabilities() const override { return Mesh | Parallel; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+#endif // ABAQUSINPREADER_H
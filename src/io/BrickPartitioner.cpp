@@ -0,0 +1,305 @@
+#include "BrickPartitioner.h"
+#include "BrickStore.h"
+#include "core/MeshReorderer.h"
+#include "core/SurfaceExtractor.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkAppendFilter.h>
+#include <vtkCellArray.h>
+#include <vtkCellType.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkPoints.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkErrorCode.h>
+#include <vtkXMLUnstructuredGridWriter.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+struct Segment
+{
+    vtkIdType begin;
+    vtkIdType end;
+};
+
+// 单元形心；float 足以区分空间位置，内存比 double 减半
+std::vector<float> cellCentroids(vtkUnstructuredGrid *grid)
+{
+    TRACE_SCOPE("BrickPartitioner::cellCentroids", "compute");
+    const vtkIdType numCells = grid->GetNumberOfCells();
+    std::vector<float> centroids(static_cast<size_t>(3 * numCells));
+    vtkCellArray *cells = grid->GetCells();
+    vtkPoints *points = grid->GetPoints();
+    vtkSMPThreadLocalObject<vtkIdList> localIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType first, vtkIdType last) {
+        vtkIdList *ids = localIds.Local();
+        for (vtkIdType cellId = first; cellId < last; ++cellId) {
+            cells->GetCellAtId(cellId, ids);
+            double sum[3] = {0.0, 0.0, 0.0};
+            for (vtkIdType j = 0; j < ids->GetNumberOfIds(); ++j) {
+                double x[3];
+                points->GetPoint(ids->GetId(j), x);
+                sum[0] += x[0];
+                sum[1] += x[1];
+                sum[2] += x[2];
+            }
+            const double count = static_cast<double>(std::max<vtkIdType>(1, ids->GetNumberOfIds()));
+            for (int k = 0; k < 3; ++k) {
+                centroids[static_cast<size_t>(3 * cellId + k)] = static_cast<float>(sum[k] / count);
+            }
+        }
+    });
+    return centroids;
+}
+
+// 递归二分：逐层处理，同一层的各段互不相交，在线程池上并行；
+// 比较时形心相同再按单元号，划分结果与 nth_element 的实现和线程数无关
+std::vector<Segment> bisect(std::vector<vtkIdType> &cellIds, const std::vector<float> &centroids,
+                            vtkIdType cellsPerBrick)
+{
+    TRACE_SCOPE("BrickPartitioner::bisect", "compute");
+    std::vector<Segment> bricks;
+    std::vector<Segment> level(1, Segment{0, static_cast<vtkIdType>(cellIds.size())});
+    while (!level.empty()) {
+        std::vector<char> split(level.size(), 0);
+        vtkSMPTools::For(0, static_cast<vtkIdType>(level.size()), 1, [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType i = first; i < last; ++i) {
+                const Segment segment = level[static_cast<size_t>(i)];
+                if (segment.end - segment.begin <= cellsPerBrick) {
+                    continue;
+                }
+                float low[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                                std::numeric_limits<float>::max()};
+                float high[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                                 std::numeric_limits<float>::lowest()};
+                for (vtkIdType j = segment.begin; j < segment.end; ++j) {
+                    const float *centroid = &centroids[static_cast<size_t>(3 * cellIds[static_cast<size_t>(j)])];
+                    for (int k = 0; k < 3; ++k) {
+                        low[k] = std::min(low[k], centroid[k]);
+                        high[k] = std::max(high[k], centroid[k]);
+                    }
+                }
+                int axis = 0;
+                for (int k = 1; k < 3; ++k) {
+                    if (high[k] - low[k] > high[axis] - low[axis]) {
+                        axis = k;
+                    }
+                }
+                const vtkIdType middle = segment.begin + (segment.end - segment.begin) / 2;
+                std::nth_element(cellIds.begin() + segment.begin, cellIds.begin() + middle, cellIds.begin() + segment.end,
+                                 [&](vtkIdType a, vtkIdType b) {
+                                     const float ca = centroids[static_cast<size_t>(3 * a + axis)];
+                                     const float cb = centroids[static_cast<size_t>(3 * b + axis)];
+                                     return ca < cb || (ca == cb && a < b);
+                                 });
+                split[static_cast<size_t>(i)] = 1;
+            }
+        });
+
+        std::vector<Segment> next;
+        for (size_t i = 0; i < level.size(); ++i) {
+            if (split[i]) {
+                const vtkIdType middle = level[i].begin + (level[i].end - level[i].begin) / 2;
+                next.push_back(Segment{level[i].begin, middle});
+                next.push_back(Segment{middle, level[i].end});
+            } else {
+                bricks.push_back(level[i]);
+            }
+        }
+        level.swap(next);
+    }
+
+    // 按在 cellIds 中的位置排序即二分树的深度优先顺序，相邻编号的块在空间上也相邻
+    std::sort(bricks.begin(), bricks.end(), [](const Segment &a, const Segment &b) { return a.begin < b.begin; });
+    return bricks;
+}
+
+// 取出 cellIds（升序）对应的单元及其所用的点，点按原编号升序重新编号
+vtkSmartPointer<vtkUnstructuredGrid> extractBrick(vtkUnstructuredGrid *grid, const std::vector<vtkIdType> &cellIds)
+{
+    vtkCellArray *cells = grid->GetCells();
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+
+    std::vector<vtkIdType> pointIds;
+    for (vtkIdType cellId : cellIds) {
+        cells->GetCellAtId(cellId, ids);
+        pointIds.insert(pointIds.end(), ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfIds());
+    }
+    std::sort(pointIds.begin(), pointIds.end());
+    pointIds.erase(std::unique(pointIds.begin(), pointIds.end()), pointIds.end());
+
+    vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfValues(static_cast<vtkIdType>(cellIds.size()) + 1);
+    offsets->SetValue(0, 0);
+    for (size_t i = 0; i < cellIds.size(); ++i) {
+        cells->GetCellAtId(cellIds[i], ids);
+        for (vtkIdType j = 0; j < ids->GetNumberOfIds(); ++j) {
+            connectivity->InsertNextValue(
+                std::lower_bound(pointIds.begin(), pointIds.end(), ids->GetId(j)) - pointIds.begin());
+        }
+        offsets->SetValue(static_cast<vtkIdType>(i) + 1, connectivity->GetNumberOfValues());
+    }
+    vtkSmartPointer<vtkCellArray> brickCells = vtkSmartPointer<vtkCellArray>::New();
+    brickCells->SetData(offsets, connectivity);
+
+    vtkSmartPointer<vtkUnstructuredGrid> brick = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(vtkDataArray::SafeDownCast(MeshReorderer::gathered(grid->GetPoints()->GetData(), pointIds)));
+    brick->SetPoints(points);
+    brick->SetCells(vtkUnsignedCharArray::SafeDownCast(MeshReorderer::gathered(grid->GetCellTypesArray(), cellIds)),
+                    brickCells);
+    MeshReorderer::gatherAttributes(grid->GetPointData(), pointIds, brick->GetPointData());
+    MeshReorderer::gatherAttributes(grid->GetCellData(), cellIds, brick->GetCellData());
+    return brick;
+}
+
+// 单分量数组记录取值范围，多分量数组记录模的范围
+void addRanges(vtkDataSetAttributes *attributes, bool isPointData, BrickStore::Brick &brick)
+{
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i) {
+        vtkDataArray *array = attributes->GetArray(i);
+        if (!array || !array->GetName() || array->GetNumberOfTuples() == 0) {
+            continue;
+        }
+        double range[2];
+        array->GetRange(range, array->GetNumberOfComponents() == 1 ? 0 : -1);
+        brick.ranges.insert(BrickStore::rangeKey(QString::fromUtf8(array->GetName()), isPointData),
+                            qMakePair(range[0], range[1]));
+    }
+}
+
+bool writeGrid(vtkUnstructuredGrid *grid, const QString &fileName, int compressionLevel, QString *error)
+{
+    TRACE_SCOPE("BrickPartitioner::writeGrid", "io");
+    const std::string path = fileName.toStdString();
+    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+    writer->SetInputData(grid);
+    writer->SetFileName(path.c_str());
+    // 追加的原始二进制，VTUParser 读取时可直接并行拷贝/解压
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    writer->SetHeaderTypeToUInt64();
+    if (compressionLevel > 0) {
+        writer->SetCompressorTypeToZLib();
+        writer->SetCompressionLevel(compressionLevel);
+    } else {
+        writer->SetCompressorTypeToNone();
+    }
+    if (writer->Write() != 1 || writer->GetErrorCode() != vtkErrorCode::NoError) {
+        if (error) {
+            *error = QString("写入 %1 失败: %2").arg(QFileInfo(fileName).fileName())
+                         .arg(vtkErrorCode::GetStringFromErrorCode(writer->GetErrorCode()));
+        }
+        return false;
+    }
+    return true;
+}
+}
+
+bool BrickPartitioner::partition(vtkUnstructuredGrid *grid, const QString &indexFileName, vtkIdType cellsPerBrick,
+                                 int compressionLevel, QString *error)
+{
+    TRACE_SCOPE("BrickPartitioner::partition", "compute");
+    if (!grid || !grid->GetPoints() || grid->GetNumberOfCells() == 0 || cellsPerBrick < 1) {
+        if (error) {
+            *error = "网格为空或每块单元数无效";
+        }
+        return false;
+    }
+    vtkUnsignedCharArray *types = grid->GetCellTypesArray();
+    const unsigned char *typesBegin = types->GetPointer(0);
+    const unsigned char *typesEnd = typesBegin + types->GetNumberOfValues();
+    if (std::find(typesBegin, typesEnd, static_cast<unsigned char>(VTK_POLYHEDRON)) != typesEnd) {
+        if (error) {
+            *error = "含多面体单元的网格不支持分块";
+        }
+        return false;
+    }
+
+    const QFileInfo indexInfo(indexFileName);
+    const QDir directory(indexInfo.absoluteDir().filePath(indexInfo.completeBaseName() + "_bricks"));
+    if (!directory.exists() && !QDir().mkpath(directory.absolutePath())) {
+        if (error) {
+            *error = QString("无法创建目录 %1").arg(directory.absolutePath());
+        }
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<vtkIdType> cellIds(static_cast<size_t>(grid->GetNumberOfCells()));
+    std::iota(cellIds.begin(), cellIds.end(), vtkIdType(0));
+    std::vector<Segment> segments;
+    {
+        const std::vector<float> centroids = cellCentroids(grid);
+        segments = bisect(cellIds, centroids, cellsPerBrick);
+    }
+    qDebug() << "BrickPartitioner: 划分为" << segments.size() << "块，耗时(ms):" << timer.elapsed();
+
+    // 各块独立提取、统计并写盘；同时在处理的块数不超过线程数，内存只多占这几块
+    BrickStore::Index index;
+    index.numberOfPoints = grid->GetNumberOfPoints();
+    index.numberOfCells = grid->GetNumberOfCells();
+    grid->GetBounds(index.bounds);
+    index.bricks.resize(segments.size());
+    std::vector<QString> errors(segments.size());
+    std::atomic<int> written(0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(segments.size()), 1, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            const Segment &segment = segments[static_cast<size_t>(i)];
+            std::vector<vtkIdType> brickCells(cellIds.begin() + segment.begin, cellIds.begin() + segment.end);
+            std::sort(brickCells.begin(), brickCells.end());
+            vtkSmartPointer<vtkUnstructuredGrid> brick = extractBrick(grid, brickCells);
+
+            BrickStore::Brick &entry = index.bricks[static_cast<size_t>(i)];
+            entry.fileName = directory.absoluteFilePath(QString("brick_%1.vtu").arg(i, 5, 10, QChar('0')));
+            entry.numberOfPoints = brick->GetNumberOfPoints();
+            entry.numberOfCells = brick->GetNumberOfCells();
+            entry.bytes = static_cast<size_t>(brick->GetActualMemorySize()) * 1024;
+            brick->GetBounds(entry.bounds);
+            addRanges(brick->GetPointData(), true, entry);
+            addRanges(brick->GetCellData(), false, entry);
+            writeGrid(brick, entry.fileName, compressionLevel, &errors[static_cast<size_t>(i)]);
+
+            const int count = ++written;
+            if (count % 100 == 0) {
+                qDebug() << "BrickPartitioner: 已写出" << count << "/" << segments.size() << "块";
+            }
+        }
+    });
+    for (const QString &brickError : errors) {
+        if (!brickError.isEmpty()) {
+            if (error) {
+                *error = brickError;
+            }
+            return false;
+        }
+    }
+
+    // 概览：整体外表面（面与线单元），查看时作为主视图的数据集
+    vtkSmartPointer<vtkAppendFilter> overview = vtkSmartPointer<vtkAppendFilter>::New();
+    overview->AddInputData(SurfaceExtractor::extract(grid));
+    overview->Update();
+    index.overviewFileName = directory.absoluteFilePath("overview.vtu");
+    if (!writeGrid(overview->GetOutput(), index.overviewFileName, compressionLevel, error)
+        || !BrickStore::writeIndex(indexInfo.absoluteFilePath(), index, error)) {
+        return false;
+    }
+
+    qDebug() << "BrickPartitioner: 写出" << index.bricks.size() << "块与概览（" << overview->GetOutput()->GetNumberOfCells()
+             << "个面），总耗时(ms):" << timer.elapsed();
+    return true;
+}
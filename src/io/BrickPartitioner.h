@@ -0,0 +1,23 @@
+#ifndef BRICKPARTITIONER_H
+#define BRICKPARTITIONER_H
+
+#include <QString>
+
+#include <vtkUnstructuredGrid.h>
+
+// 分块预处理：按单元形心递归二分（每次沿形心包围盒的最长轴取中位数）把网格切成单元数相近的空间块，
+// 每块带上所用的点与全部点/单元数组写成独立的二进制 VTU。块边界上的点在相邻块中各存一份，
+// 每块都能单独剖切、提取等值面，拼起来与整体处理的结果一致。
+// 另写出整体外表面作为概览，以及记录各块包围盒、数组范围的索引文件（见 BrickStore）。
+//
+// 预处理需要把整个模型读入内存一次（可在内存更大的机器上进行），之后查看时只按需读入块
+class BrickPartitioner
+{
+public:
+    // 块文件与概览写在索引文件旁的 <索引名>_bricks 目录中；compressionLevel 为 0 时不压缩（读取最快）。
+    // 含多面体单元的网格返回 false
+    static bool partition(vtkUnstructuredGrid *grid, const QString &indexFileName, vtkIdType cellsPerBrick,
+                          int compressionLevel = 0, QString *error = nullptr);
+};
+
+#endif // BRICKPARTITIONER_H
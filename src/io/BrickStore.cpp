@@ -0,0 +1,426 @@
+#include "BrickStore.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <vtkSMPTools.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+const char *BrickStore::INDEX_EXTENSION = "fembricks";
+
+namespace
+{
+// 索引的版本键：QJsonDocument 按键名排序输出，大写开头的键排在最前，嗅探只需读文件开头
+const char *VERSION_KEY = "FEMBricksVersion";
+const int INDEX_VERSION = 1;
+
+// 未设置时的缓存预算
+const size_t DEFAULT_CACHE_BYTES = size_t(1024) * 1024 * 1024;
+
+QJsonArray toJson(const double bounds[6])
+{
+    QJsonArray array;
+    for (int i = 0; i < 6; ++i) {
+        array.append(bounds[i]);
+    }
+    return array;
+}
+
+bool fromJson(const QJsonValue &value, double bounds[6])
+{
+    const QJsonArray array = value.toArray();
+    if (array.size() != 6) {
+        return false;
+    }
+    for (int i = 0; i < 6; ++i) {
+        bounds[i] = array[i].toDouble();
+    }
+    return true;
+}
+}
+
+QString BrickStore::rangeKey(const QString &arrayName, bool isPointData)
+{
+    return QString(isPointData ? "P:" : "C:") + arrayName;
+}
+
+bool BrickStore::isIndexFile(const QString &fileName)
+{
+    return QFileInfo(fileName).suffix().toLower() == INDEX_EXTENSION;
+}
+
+bool BrickStore::readIndex(const QString &fileName, Index &index, QString *error)
+{
+    TRACE_SCOPE("BrickStore::readIndex", "io");
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = QString("无法打开分块索引: %1").arg(file.errorString());
+        }
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    const QJsonObject root = document.object();
+    if (document.isNull() || root.value(VERSION_KEY).toInt() != INDEX_VERSION) {
+        if (error) {
+            *error = document.isNull() ? QString("分块索引格式错误: %1").arg(parseError.errorString())
+                                       : QString("不支持的分块索引版本");
+        }
+        return false;
+    }
+
+    const QDir directory = QFileInfo(fileName).absoluteDir();
+    index = Index();
+    index.overviewFileName = QDir::cleanPath(directory.absoluteFilePath(root.value("overview").toString()));
+    index.numberOfPoints = static_cast<vtkIdType>(root.value("points").toDouble());
+    index.numberOfCells = static_cast<vtkIdType>(root.value("cells").toDouble());
+    fromJson(root.value("bounds"), index.bounds);
+
+    const QJsonArray bricks = root.value("bricks").toArray();
+    index.bricks.reserve(static_cast<size_t>(bricks.size()));
+    for (const QJsonValue &value : bricks) {
+        const QJsonObject object = value.toObject();
+        Brick brick;
+        brick.fileName = QDir::cleanPath(directory.absoluteFilePath(object.value("file").toString()));
+        brick.numberOfPoints = static_cast<vtkIdType>(object.value("points").toDouble());
+        brick.numberOfCells = static_cast<vtkIdType>(object.value("cells").toDouble());
+        brick.bytes = static_cast<size_t>(object.value("bytes").toDouble());
+        if (!fromJson(object.value("bounds"), brick.bounds)) {
+            if (error) {
+                *error = QString("分块索引中第 %1 块缺少包围盒").arg(index.bricks.size());
+            }
+            return false;
+        }
+        const QJsonObject ranges = object.value("ranges").toObject();
+        for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+            const QJsonArray range = it.value().toArray();
+            if (range.size() == 2) {
+                brick.ranges.insert(it.key(), qMakePair(range[0].toDouble(), range[1].toDouble()));
+            }
+        }
+        index.bricks.push_back(brick);
+    }
+    if (index.bricks.empty()) {
+        if (error) {
+            *error = "分块索引中没有数据块";
+        }
+        return false;
+    }
+    return true;
+}
+
+bool BrickStore::writeIndex(const QString &fileName, const Index &index, QString *error)
+{
+    const QDir directory = QFileInfo(fileName).absoluteDir();
+    QJsonObject root;
+    root[VERSION_KEY] = INDEX_VERSION;
+    root["overview"] = directory.relativeFilePath(index.overviewFileName);
+    root["points"] = static_cast<double>(index.numberOfPoints);
+    root["cells"] = static_cast<double>(index.numberOfCells);
+    root["bounds"] = toJson(index.bounds);
+
+    QJsonArray bricks;
+    for (const Brick &brick : index.bricks) {
+        QJsonObject object;
+        object["file"] = directory.relativeFilePath(brick.fileName);
+        object["points"] = static_cast<double>(brick.numberOfPoints);
+        object["cells"] = static_cast<double>(brick.numberOfCells);
+        object["bytes"] = static_cast<double>(brick.bytes);
+        object["bounds"] = toJson(brick.bounds);
+        QJsonObject ranges;
+        for (auto it = brick.ranges.begin(); it != brick.ranges.end(); ++it) {
+            // JSON 不能表示无穷大，没有记录范围的数组在查询时视为可能包含任意值
+            if (std::isfinite(it.value().first) && std::isfinite(it.value().second)) {
+                ranges[it.key()] = QJsonArray{it.value().first, it.value().second};
+            }
+        }
+        object["ranges"] = ranges;
+        bricks.append(object);
+    }
+    root["bricks"] = bricks;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) < 0) {
+        if (error) {
+            *error = QString("无法写入分块索引: %1").arg(file.errorString());
+        }
+        return false;
+    }
+    return true;
+}
+
+BrickStore::BrickStore()
+    : m_cacheBytes(0)
+    , m_budget(DEFAULT_CACHE_BYTES)
+    , m_releasePending(false)
+    , m_revision(0)
+    , m_clock(0)
+    , m_precisionMode(PrecisionReducer::Full)
+{
+}
+
+bool BrickStore::open(const QString &indexFileName, QString *error)
+{
+    close();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!readIndex(indexFileName, m_index, error)) {
+        m_index = Index();
+        return false;
+    }
+    qDebug() << "BrickStore: 打开分块模型" << QFileInfo(indexFileName).fileName() << "块数:" << m_index.bricks.size()
+             << "单元数:" << m_index.numberOfCells;
+    return true;
+}
+
+void BrickStore::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    clearCache();
+    m_index = Index();
+    ++m_revision;
+}
+
+void BrickStore::setPrecisionMode(PrecisionReducer::Mode mode, const QStringList &fullPrecisionArrays)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_precisionMode = mode;
+    m_fullPrecisionArrays = fullPrecisionArrays;
+}
+
+bool BrickStore::range(const QString &arrayName, bool isPointData, double range[2]) const
+{
+    const QString key = rangeKey(arrayName, isPointData);
+    range[0] = std::numeric_limits<double>::max();
+    range[1] = std::numeric_limits<double>::lowest();
+    bool found = false;
+    for (const Brick &brick : m_index.bricks) {
+        auto it = brick.ranges.constFind(key);
+        if (it != brick.ranges.constEnd()) {
+            range[0] = std::min(range[0], it.value().first);
+            range[1] = std::max(range[1], it.value().second);
+            found = true;
+        }
+    }
+    return found;
+}
+
+std::vector<int> BrickStore::bricksCutByPlane(const double origin[3], const double normal[3]) const
+{
+    std::vector<int> ids;
+    for (size_t i = 0; i < m_index.bricks.size(); ++i) {
+        // 包围盒 8 个角点到平面的有向距离异号（或为零）即相交
+        const double *bounds = m_index.bricks[i].bounds;
+        double low = std::numeric_limits<double>::max();
+        double high = std::numeric_limits<double>::lowest();
+        for (int corner = 0; corner < 8; ++corner) {
+            const double point[3] = {bounds[corner & 1], bounds[2 + ((corner >> 1) & 1)], bounds[4 + ((corner >> 2) & 1)]};
+            const double distance = (point[0] - origin[0]) * normal[0] + (point[1] - origin[1]) * normal[1]
+                                  + (point[2] - origin[2]) * normal[2];
+            low = std::min(low, distance);
+            high = std::max(high, distance);
+        }
+        if (low <= 0.0 && high >= 0.0) {
+            ids.push_back(static_cast<int>(i));
+        }
+    }
+    return ids;
+}
+
+std::vector<int> BrickStore::bricksInRange(const QString &arrayName, bool isPointData,
+                                           const std::vector<double> &values) const
+{
+    const QString key = rangeKey(arrayName, isPointData);
+    std::vector<int> ids;
+    for (size_t i = 0; i < m_index.bricks.size(); ++i) {
+        auto it = m_index.bricks[i].ranges.constFind(key);
+        const bool hit = it == m_index.bricks[i].ranges.constEnd()
+            || std::any_of(values.begin(), values.end(), [&it](double value) {
+                   return value >= it.value().first && value <= it.value().second;
+               });
+        if (hit) {
+            ids.push_back(static_cast<int>(i));
+        }
+    }
+    return ids;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> BrickStore::load(int id, QString *error) const
+{
+    TRACE_SCOPE("BrickStore::load", "io");
+    const QString &fileName = m_index.bricks[static_cast<size_t>(id)].fileName;
+    vtkSmartPointer<vtkUnstructuredGrid> grid =
+        vtkUnstructuredGrid::SafeDownCast(ReaderRegistry::instance().read(fileName, error));
+    if (!grid) {
+        if (error && error->isEmpty()) {
+            *error = QString("%1 不是非结构网格").arg(QFileInfo(fileName).fileName());
+        }
+        return nullptr;
+    }
+    if (m_precisionMode != PrecisionReducer::Full) {
+        PrecisionReducer::reduce(grid, PrecisionReducer::Float32, m_fullPrecisionArrays);
+    }
+    return grid;
+}
+
+void BrickStore::evict(const std::vector<int> &keep, size_t incoming)
+{
+    while (m_cacheBytes + incoming > m_budget) {
+        auto oldest = m_cache.end();
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            if (std::find(keep.begin(), keep.end(), it.key()) == keep.end()
+                && (oldest == m_cache.end() || it.value().lastUsed < oldest.value().lastUsed)) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_cache.end()) {
+            return;
+        }
+        m_cacheBytes -= oldest.value().bytes;
+        m_cache.erase(oldest);
+    }
+}
+
+bool BrickStore::process(const std::vector<int> &ids, const BrickFunction &function,
+                         std::vector<vtkSmartPointer<vtkPolyData>> &outputs, QString *error)
+{
+    TRACE_SCOPE("BrickStore::process", "compute");
+    std::lock_guard<std::mutex> lock(m_mutex);
+    QElapsedTimer timer;
+    timer.start();
+    outputs.assign(ids.size(), nullptr);
+    // 请求可能是在切换模型之前计算的
+    for (int id : ids) {
+        if (id < 0 || static_cast<size_t>(id) >= m_index.bricks.size()) {
+            if (error) {
+                *error = "分块索引已变化";
+            }
+            return false;
+        }
+    }
+
+    // 已缓存的块排在前面先处理，不会为读入其他块而被挤出后再读一遍
+    std::vector<size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_partition(order.begin(), order.end(), [&](size_t slot) { return m_cache.contains(ids[slot]); });
+
+    size_t loadedCount = 0;
+    size_t next = 0;
+    while (next < order.size()) {
+        // 一批：预算内尽量多的块，至少一块
+        std::vector<int> batch;
+        std::vector<size_t> slots;
+        std::vector<int> missing;
+        size_t batchBytes = 0;
+        size_t missingBytes = 0;
+        while (next < order.size()) {
+            const int id = ids[order[next]];
+            auto cached = m_cache.constFind(id);
+            const bool isCached = cached != m_cache.constEnd();
+            const size_t bytes = isCached ? cached.value().bytes : m_index.bricks[static_cast<size_t>(id)].bytes;
+            if (!batch.empty() && batchBytes + bytes > m_budget) {
+                break;
+            }
+            batch.push_back(id);
+            slots.push_back(order[next]);
+            batchBytes += bytes;
+            if (!isCached) {
+                missing.push_back(id);
+                missingBytes += bytes;
+            }
+            ++next;
+        }
+
+        // 各块文件并行读入（每个文件内部的数据块也由 VTUParser 并行解码）
+        evict(batch, missingBytes);
+        std::vector<vtkSmartPointer<vtkUnstructuredGrid>> grids(missing.size());
+        std::vector<QString> errors(missing.size());
+        vtkSMPTools::For(0, static_cast<vtkIdType>(missing.size()), 1, [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType i = first; i < last; ++i) {
+                grids[i] = load(missing[i], &errors[i]);
+            }
+        });
+        for (size_t i = 0; i < missing.size(); ++i) {
+            if (!grids[i]) {
+                if (error) {
+                    *error = QString("读取第 %1 块失败: %2").arg(missing[i]).arg(errors[i]);
+                }
+                outputs.assign(ids.size(), nullptr);
+                return false;
+            }
+            Entry entry;
+            entry.grid = grids[i];
+            entry.bytes = static_cast<size_t>(grids[i]->GetActualMemorySize()) * 1024;
+            m_cacheBytes += entry.bytes;
+            m_cache.insert(missing[i], entry);
+        }
+        loadedCount += missing.size();
+
+        // 逐块并行处理，每块的输出放回其在 ids 中的位置
+        std::vector<vtkUnstructuredGrid *> batchGrids;
+        for (int id : batch) {
+            Entry &entry = m_cache[id];
+            entry.lastUsed = ++m_clock;
+            batchGrids.push_back(entry.grid);
+        }
+        vtkSMPTools::For(0, static_cast<vtkIdType>(batch.size()), 1, [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType i = first; i < last; ++i) {
+                outputs[slots[i]] = function(batchGrids[i]);
+            }
+        });
+    }
+
+    qDebug() << "BrickStore: 处理" << ids.size() << "块，其中读入" << loadedCount << "块，缓存"
+             << m_cache.size() << "块" << m_cacheBytes / (1024.0 * 1024.0) << "MB，耗时(ms):" << timer.elapsed();
+    if (m_releasePending) {
+        clearCache();
+    }
+    return true;
+}
+
+void BrickStore::release()
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        m_releasePending = true; // 后台正在处理，结束后释放
+        return;
+    }
+    clearCache();
+}
+
+void BrickStore::clearCache()
+{
+    m_cache.clear();
+    m_cacheBytes = 0;
+    m_releasePending = false;
+}
+
+MeshReader::SniffResult BrickIndexReader::sniff(const QByteArray &head) const
+{
+    return head.contains(QByteArray("\"") + VERSION_KEY + "\"") ? Matched : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> BrickIndexReader::read(const QString &fileName, QString *error)
+{
+    BrickStore::Index index;
+    if (!BrickStore::readIndex(fileName, index, error)) {
+        return nullptr;
+    }
+    vtkSmartPointer<vtkDataObject> overview = ReaderRegistry::instance().read(index.overviewFileName, error);
+    if (!vtkUnstructuredGrid::SafeDownCast(overview)) {
+        if (error && error->isEmpty()) {
+            *error = "分块模型的概览不是非结构网格";
+        }
+        return nullptr;
+    }
+    return overview;
+}
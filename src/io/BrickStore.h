@@ -0,0 +1,128 @@
+#ifndef BRICKSTORE_H
+#define BRICKSTORE_H
+
+#include "ReaderRegistry.h"
+#include "core/PrecisionReducer.h"
+
+#include <QString>
+#include <QHash>
+#include <QPair>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+
+// 分块（out-of-core）模式：超出内存的模型由 BrickPartitioner 预先切成磁盘上的空间块，
+// 索引文件 (.fembricks) 记录各块的包围盒与每个数组的取值范围，另有整体外表面作为概览。
+// 主视图只显示概览；剖切、等值面按平面与包围盒、等值与数组范围挑出需要的块，
+// 在缓存预算内分批读入（最近最少使用的块先被挤出），每批在线程池上逐块并行处理后合并结果。
+// process 可在工作线程上调用（同一时间只执行一个，其余等待）；open/close 与索引查询在界面线程上调用
+class BrickStore
+{
+public:
+    struct Brick
+    {
+        QString fileName;                               // 绝对路径
+        vtkIdType numberOfPoints = 0;
+        vtkIdType numberOfCells = 0;
+        size_t bytes = 0;                               // 读入后的内存大小，决定分批
+        double bounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        QHash<QString, QPair<double, double>> ranges;   // rangeKey -> 单分量取值范围，多分量为模的范围
+    };
+
+    struct Index
+    {
+        QString overviewFileName;                       // 绝对路径
+        vtkIdType numberOfPoints = 0;
+        vtkIdType numberOfCells = 0;
+        double bounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        std::vector<Brick> bricks;
+    };
+
+    // 对一块的处理；在工作线程上调用，不得修改传入的块（缓存中的块会被后续操作复用）
+    using BrickFunction = std::function<vtkSmartPointer<vtkPolyData>(vtkUnstructuredGrid *brick)>;
+
+    static const char *INDEX_EXTENSION;
+
+    static QString rangeKey(const QString &arrayName, bool isPointData);
+    static bool isIndexFile(const QString &fileName);
+    // 相对路径以索引文件所在目录为基准
+    static bool readIndex(const QString &fileName, Index &index, QString *error = nullptr);
+    static bool writeIndex(const QString &fileName, const Index &index, QString *error = nullptr);
+
+    BrickStore();
+
+    // 等待正在执行的 process 结束后再切换索引
+    bool open(const QString &indexFileName, QString *error = nullptr);
+    void close();
+    bool isOpen() const { return !m_index.bricks.empty(); }
+    const Index &index() const { return m_index; }
+    // 每次 open/close 递增；后台结果据此判断是否仍属于当前模型
+    int revision() const { return m_revision; }
+
+    // 读入块时的精度：除 Full 外一律转为 float32（剖切、等值面需要真实数值，不做 16 位量化），
+    // fullPrecisionArrays 中的数组保持原样
+    void setPrecisionMode(PrecisionReducer::Mode mode, const QStringList &fullPrecisionArrays = QStringList());
+    // 缓存预算；单个块超出预算时仍会读入，处理完即可被挤出
+    void setCacheBudget(size_t bytes) { m_budget = bytes; }
+    size_t cacheBudget() const { return m_budget; }
+
+    // 所有块合并后的数组范围，没有该数组时返回 false
+    bool range(const QString &arrayName, bool isPointData, double range[2]) const;
+
+    // 包围盒与平面相交的块
+    std::vector<int> bricksCutByPlane(const double origin[3], const double normal[3]) const;
+    // 数组范围包含任一等值的块
+    std::vector<int> bricksInRange(const QString &arrayName, bool isPointData, const std::vector<double> &values) const;
+
+    // 逐块处理 ids 中的块，outputs[i] 对应 ids[i]（与缓存状态、线程数无关）；任一块读取失败时返回 false。
+    // 可在工作线程上调用
+    bool process(const std::vector<int> &ids, const BrickFunction &function,
+                 std::vector<vtkSmartPointer<vtkPolyData>> &outputs, QString *error = nullptr);
+
+    size_t memorySize() const { return m_cacheBytes; }
+    // 正在 process 时不等待，推迟到其结束后释放
+    void release();
+
+private:
+    struct Entry
+    {
+        vtkSmartPointer<vtkUnstructuredGrid> grid;
+        size_t bytes = 0;
+        unsigned long long lastUsed = 0;
+    };
+
+    vtkSmartPointer<vtkUnstructuredGrid> load(int id, QString *error) const;
+    // 挤出不在 keep 中、最近最少使用的块，直到再放入 incoming 字节不超出预算
+    void evict(const std::vector<int> &keep, size_t incoming);
+    void clearCache();
+
+    std::mutex m_mutex;                     // 保护缓存、精度设置与 process 期间的索引
+    Index m_index;
+    QHash<int, Entry> m_cache;
+    std::atomic<size_t> m_cacheBytes;
+    std::atomic<size_t> m_budget;
+    std::atomic<bool> m_releasePending;
+    std::atomic<int> m_revision;
+    unsigned long long m_clock;
+    PrecisionReducer::Mode m_precisionMode;
+    QStringList m_fullPrecisionArrays;
+};
+
+// 分块索引 (.fembricks)：返回概览外表面，分块数据由 MainWindow 另行交给 BrickStore
+class BrickIndexReader : public MeshReader
+{
+public:
+    QString name() const override { return "FEM分块模型索引"; }
+    QStringList extensions() const override { return QStringList() << "fembricks"; }
+    int capabilities() const override { return Mesh | PointResults | CellResults; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+#endif // BRICKSTORE_H
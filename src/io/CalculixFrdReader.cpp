@@ -0,0 +1,405 @@
+#include "CalculixFrdReader.h"
+#include "MeshBuilder.h"
+#include "TextParsing.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <vtkCellType.h>
+#include <vtkFloatArray.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace TextParsing;
+
+namespace
+{
+// 结果与坐标值为 E12.5，每行最多 6 个
+const int VALUE_WIDTH = 12;
+const int VALUES_PER_LINE = 6;
+
+// FRD 中二阶实体的节点顺序与 VTK 不同：先列竖边中点再列顶面边中点；三节点梁中点在末尾
+const int HE20_ORDER[20] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 16, 17, 18, 19, 12, 13, 14, 15};
+const int PE15_ORDER[15] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 14, 9, 10, 11};
+const int BE3_ORDER[3] = {0, 2, 1};
+
+struct ElementType
+{
+    int cellType;
+    int nodes;
+    const int *order;
+};
+
+ElementType elementType(int type)
+{
+    switch (type) {
+    case 1: return {VTK_HEXAHEDRON, 8, nullptr};
+    case 2: return {VTK_WEDGE, 6, nullptr};
+    case 3: return {VTK_TETRA, 4, nullptr};
+    case 4: return {VTK_QUADRATIC_HEXAHEDRON, 20, HE20_ORDER};
+    case 5: return {VTK_QUADRATIC_WEDGE, 15, PE15_ORDER};
+    case 6: return {VTK_QUADRATIC_TETRA, 10, nullptr};
+    case 7: return {VTK_TRIANGLE, 3, nullptr};
+    case 8: return {VTK_QUADRATIC_TRIANGLE, 6, nullptr};
+    case 9: return {VTK_QUAD, 4, nullptr};
+    case 10: return {VTK_QUADRATIC_QUAD, 8, nullptr};
+    case 11: return {VTK_LINE, 2, nullptr};
+    case 12: return {VTK_QUADRATIC_EDGE, 3, BE3_ORDER};
+    default: return {0, 0, nullptr};
+    }
+}
+
+// 记录行 " -1"、续行 " -2"、块结束 " -3"
+inline bool isRecord(const char *line, const char *end, char kind)
+{
+    return end - line >= 3 && line[0] == ' ' && line[1] == '-' && line[2] == kind;
+}
+
+const char *findBlockEnd(const char *p, const char *end)
+{
+    while (p < end && !isRecord(p, end, '3')) {
+        p = nextLine(p, end);
+    }
+    return p;
+}
+
+// 编号字段宽度：短格式 I5，长格式 I10
+inline int idWidth(int format)
+{
+    return format == 1 ? 10 : 5;
+}
+
+// 从 pos 起读取定宽数值，最多 count 个，返回读到的个数
+template <typename T>
+int parseFixedValues(const char *pos, const char *stop, int width, int count, T *out)
+{
+    int read = 0;
+    for (; read < count && pos < stop; pos += width) {
+        if (!parseField(pos, std::min(pos + width, stop), out[read])) {
+            break;
+        }
+        ++read;
+    }
+    return read;
+}
+
+// 行首位置的 " -1" 记录在各块中计数后分配，再并行解析
+std::vector<Chunk> splitRecords(const char *begin, const char *end)
+{
+    return splitChunks(begin, end, [end](const char *line) { return isRecord(line, end, '1'); });
+}
+
+bool parseNodes(const char *begin, const char *end, int format, MeshBuilder &builder)
+{
+    const int width = idWidth(format);
+    std::vector<Chunk> chunks = splitRecords(begin, end);
+    const vtkIdType chunkCount = static_cast<vtkIdType>(chunks.size());
+
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            for (const char *p = chunks[i].begin; p < chunks[i].end; p = nextLine(p, chunks[i].end)) {
+                chunks[i].count += isRecord(p, chunks[i].end, '1') ? 1 : 0;
+            }
+        }
+    });
+
+    vtkIdType total = static_cast<vtkIdType>(builder.nodeIds.size());
+    for (Chunk &chunk : chunks) {
+        chunk.offset = total;
+        total += chunk.count;
+    }
+    builder.nodeIds.resize(total);
+    builder.coordinates.resize(total * 3, 0.0);
+
+    std::atomic<bool> ok(true);
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            vtkIdType node = chunks[i].offset;
+            for (const char *p = chunks[i].begin; p < chunks[i].end; p = nextLine(p, chunks[i].end)) {
+                if (!isRecord(p, chunks[i].end, '1')) {
+                    continue;
+                }
+                const char *stop = lineEnd(p, chunks[i].end);
+                if (!parseField(p + 3, std::min(p + 3 + width, stop), builder.nodeIds[node])
+                    || parseFixedValues(p + 3 + width, stop, VALUE_WIDTH, 3, builder.coordinates.data() + node * 3) != 3) {
+                    ok = false;
+                }
+                ++node;
+            }
+        }
+    });
+    return ok;
+}
+
+bool parseElements(const char *begin, const char *end, int format, MeshBuilder &builder, QSet<int> &skippedTypes)
+{
+    const int width = idWidth(format);
+    const int nodesPerLine = format == 1 ? 10 : 15;
+    std::vector<Chunk> chunks = splitRecords(begin, end);
+    const vtkIdType chunkCount = static_cast<vtkIdType>(chunks.size());
+
+    // 单元记录行上的类型决定节点数：第一遍统计每块的单元数与连接长度
+    auto recordType = [width](const char *p, const char *stop) {
+        int type = 0;
+        parseField(p + 3 + width, std::min(p + 8 + width, stop), type);
+        return type;
+    };
+    std::vector<vtkIdType> slots(chunks.size(), 0);
+    std::vector<QSet<int>> skipped(chunks.size());
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            for (const char *p = chunks[i].begin; p < chunks[i].end; p = nextLine(p, chunks[i].end)) {
+                if (isRecord(p, chunks[i].end, '1')) {
+                    const int type = recordType(p, lineEnd(p, chunks[i].end));
+                    const ElementType element = elementType(type);
+                    if (element.cellType == 0) {
+                        skipped[i].insert(type);
+                        continue;
+                    }
+                    ++chunks[i].count;
+                    slots[i] += element.nodes;
+                }
+            }
+        }
+    });
+
+    const vtkIdType firstElement = builder.elementCount();
+    vtkIdType totalElements = firstElement;
+    vtkIdType totalSlots = builder.offsets.back();
+    std::vector<vtkIdType> slotOffsets(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].offset = totalElements;
+        slotOffsets[i] = totalSlots;
+        totalElements += chunks[i].count;
+        totalSlots += slots[i];
+        skippedTypes.unite(skipped[i]);
+    }
+    builder.elementIds.resize(totalElements);
+    builder.cellTypes.resize(totalElements);
+    builder.offsets.resize(totalElements + 1);
+    builder.connectivity.resize(totalSlots);
+
+    std::atomic<bool> ok(true);
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            vtkIdType element = chunks[i].offset;
+            vtkIdType slot = slotOffsets[i];
+            const char *p = chunks[i].begin;
+            while (p < chunks[i].end) {
+                if (!isRecord(p, chunks[i].end, '1')) {
+                    p = nextLine(p, chunks[i].end);
+                    continue;
+                }
+                const char *stop = lineEnd(p, chunks[i].end);
+                const ElementType type = elementType(recordType(p, stop));
+                vtkIdType id = 0;
+                parseField(p + 3, std::min(p + 3 + width, stop), id);
+                p = nextLine(p, chunks[i].end);
+                if (type.cellType == 0) {
+                    continue;
+                }
+
+                // 节点号在随后的 " -2" 行中
+                vtkIdType nodes[20];
+                int read = 0;
+                while (read < type.nodes && p < chunks[i].end && isRecord(p, chunks[i].end, '2')) {
+                    read += parseFixedValues(p + 3, lineEnd(p, chunks[i].end), width,
+                                             std::min(nodesPerLine, type.nodes - read), nodes + read);
+                    p = nextLine(p, chunks[i].end);
+                }
+                if (read != type.nodes) {
+                    ok = false;
+                }
+
+                builder.elementIds[element] = id;
+                builder.cellTypes[element] = static_cast<unsigned char>(type.cellType);
+                for (int n = 0; n < type.nodes; ++n) {
+                    builder.connectivity[slot + n] = nodes[type.order ? type.order[n] : n];
+                }
+                slot += type.nodes;
+                builder.offsets[element + 1] = slot;
+                ++element;
+            }
+        }
+    });
+    return ok;
+}
+
+// 结果块的数据行：节点号 + 最多 6 个值，其余值在 " -2" 续行中
+bool parseResults(const char *begin, const char *end, int format, int components,
+                  const IdIndex &nodeIndex, float *out)
+{
+    const int width = idWidth(format);
+    std::vector<Chunk> chunks = splitRecords(begin, end);
+    std::atomic<bool> ok(true);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            float *values = nullptr;
+            int read = 0;
+            for (const char *p = chunks[i].begin; p < chunks[i].end; p = nextLine(p, chunks[i].end)) {
+                const char *stop = lineEnd(p, chunks[i].end);
+                if (isRecord(p, chunks[i].end, '1')) {
+                    vtkIdType id = 0;
+                    const vtkIdType point = parseField(p + 3, std::min(p + 3 + width, stop), id) ? nodeIndex.find(id) : -1;
+                    values = point >= 0 ? out + point * components : nullptr;
+                    read = 0;
+                    if (!values) {
+                        ok = false;
+                        continue;
+                    }
+                } else if (!values || !isRecord(p, chunks[i].end, '2')) {
+                    continue;
+                }
+                read += parseFixedValues(p + 3 + width, stop, VALUE_WIDTH,
+                                         std::min(VALUES_PER_LINE, components - read), values + read);
+            }
+        }
+    });
+    return ok;
+}
+
+struct ResultArray
+{
+    QByteArray name;
+    int step;
+    vtkSmartPointer<vtkFloatArray> array;
+};
+}
+
+MeshReader::SniffResult CalculixFrdReader::sniff(const QByteArray &head) const
+{
+    return head.startsWith("    1C") ? Matched : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> CalculixFrdReader::read(const QString &fileName, QString *error)
+{
+    TRACE_SCOPE("CalculixFrdReader::read", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    auto fail = [error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        return vtkSmartPointer<vtkDataObject>();
+    };
+
+    QFile file(fileName);
+    const uchar *mapped = file.open(QIODevice::ReadOnly) && file.size() > 0 ? file.map(0, file.size()) : nullptr;
+    if (!mapped) {
+        return fail(QString("无法打开文件: %1").arg(file.errorString()));
+    }
+    const char *p = reinterpret_cast<const char *>(mapped);
+    const char *end = p + file.size();
+
+    MeshBuilder builder;
+    std::vector<ResultArray> results;
+    QSet<int> skippedTypes;
+
+    while (p < end) {
+        const char *stop = lineEnd(p, end);
+        const char *next = nextLine(p, end);
+        const QByteArray line = QByteArray(p, static_cast<int>(stop - p));
+        const QByteArray trimmed = line.trimmed();
+
+        if (trimmed.startsWith("2C") || trimmed.startsWith("3C")) {
+            const QList<QByteArray> tokens = trimmed.simplified().split(' ');
+            const int format = tokens.last().toInt();
+            if (format > 1) {
+                return fail("不支持二进制格式的 FRD 文件");
+            }
+            const char *blockEnd = findBlockEnd(next, end);
+            const bool ok = trimmed.startsWith("2C") ? parseNodes(next, blockEnd, format, builder)
+                                                     : parseElements(next, blockEnd, format, builder, skippedTypes);
+            if (!ok) {
+                return fail(trimmed.startsWith("2C") ? "节点块数据无效" : "单元块数据无效");
+            }
+            p = nextLine(blockEnd, end);
+            continue;
+        }
+
+        const int key = line.indexOf("100C");
+        if (key >= 0 && trimmed.startsWith("100C")) {
+            // 定宽头记录：集合名、时间值、节点数、说明、类型、步号、分析类型、格式
+            auto column = [&line, key](int from, int to) {
+                return line.mid(key + from, to - from).trimmed();
+            };
+            const int step = column(56, 61).toInt();
+            const int format = column(71, 73).toInt();
+            if (format > 1) {
+                return fail("不支持二进制格式的 FRD 文件");
+            }
+
+            // " -4 名称 分量数 类型" 与各分量的 " -5" 行；第 7 个字段为 1 的分量（如 ALL）不在数据中
+            p = next;
+            QByteArray name;
+            QList<QByteArray> componentNames;
+            while (p < end && (isRecord(p, end, '4') || isRecord(p, end, '5'))) {
+                const QList<QByteArray> tokens = QByteArray(p, static_cast<int>(lineEnd(p, end) - p)).simplified().split(' ');
+                if (tokens.value(0) == "-4") {
+                    name = tokens.value(1);
+                } else if (tokens.size() < 7 || !tokens[6].startsWith('1')) {
+                    componentNames << tokens.value(1);
+                }
+                p = nextLine(p, end);
+            }
+
+            const char *blockEnd = findBlockEnd(p, end);
+            if (!name.isEmpty() && !componentNames.isEmpty() && !builder.nodeIds.empty()) {
+                vtkSmartPointer<vtkFloatArray> array = vtkSmartPointer<vtkFloatArray>::New();
+                array->SetNumberOfComponents(componentNames.size());
+                array->SetNumberOfTuples(static_cast<vtkIdType>(builder.nodeIds.size()));
+                array->FillValue(0.0f);
+                for (int c = 0; c < componentNames.size(); ++c) {
+                    array->SetComponentName(c, componentNames[c].constData());
+                }
+                if (!parseResults(p, blockEnd, format, componentNames.size(), builder.nodeIndex(), array->GetPointer(0))) {
+                    qDebug() << "CalculixFrdReader: 结果" << name << "中有未知节点号";
+                }
+                results.push_back({name, step, array});
+            }
+            p = nextLine(blockEnd, end);
+            continue;
+        }
+
+        if (trimmed == "9999") {
+            break;
+        }
+        p = next;
+    }
+
+    if (!skippedTypes.isEmpty()) {
+        qDebug() << "CalculixFrdReader: 跳过不支持的单元类型" << skippedTypes.values();
+    }
+    if (builder.nodeIds.empty() || builder.elementCount() == 0) {
+        return fail("文件中没有节点或单元");
+    }
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = builder.build(error);
+    if (!grid) {
+        return nullptr;
+    }
+
+    // 只出现在一个步中的结果保留原名，多步结果按 <名称>_t<步号> 命名
+    QMap<QByteArray, QSet<int>> steps;
+    for (const ResultArray &result : results) {
+        steps[result.name].insert(result.step);
+    }
+    for (const ResultArray &result : results) {
+        const QByteArray arrayName = steps[result.name].size() > 1
+            ? result.name + "_t" + QByteArray::number(result.step)
+            : result.name;
+        result.array->SetName(arrayName.constData());
+        grid->GetPointData()->AddArray(result.array);
+    }
+
+    qDebug() << "CalculixFrdReader: 节点数:" << grid->GetNumberOfPoints() << "单元数:" << grid->GetNumberOfCells()
+             << "结果数组:" << results.size() << "耗时(ms):" << timer.elapsed();
+    return grid;
+}
@@ -0,0 +1,19 @@
+#ifndef CALCULIXFRDREADER_H
+#define CALCULIXFRDREADER_H
+
+#include "ReaderRegistry.h"
+
+// CalculiX 结果文件 (.frd, ASCII) 读取：节点块、单元块与各步的节点结果块。
+// 定宽记录按 " -1" 记录行切块后并行解析，结果直接按节点号写入最终数组。
+// 同一结果在多个步中出现时命名为 <名称>_t<步号>，可在线探测中叠加时间序列
+class CalculixFrdReader : public MeshReader
+{
+public:
+    QString name() const override { return "CalculiX结果文件"; }
+    QStringList extensions() const override { return QStringList() << "frd"; }
+    int capabilities() const override { return Mesh | PointResults | TimeSteps | Parallel; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+#endif // CALCULIXFRDREADER_H
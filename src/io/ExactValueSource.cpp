@@ -0,0 +1,201 @@
+#include "ExactValueSource.h"
+#include "ReaderRegistry.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QtConcurrent/QtConcurrent>
+#include <vtkDataSet.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+
+namespace
+{
+// 缓存的数组个数：通常只需要当前着色数组，切换几次后仍可直接查询
+const int MAX_CACHED_ARRAYS = 4;
+}
+
+ExactValueSource::ExactValueSource(QObject *parent)
+    : QObject(parent)
+    , m_generation(0)
+{
+    connect(&m_watcher, &QFutureWatcher<Request>::finished, this, &ExactValueSource::onLoaded);
+}
+
+ExactValueSource::~ExactValueSource()
+{
+    m_watcher.waitForFinished();
+}
+
+void ExactValueSource::setFile(const QString &fileName)
+{
+    m_fileName = fileName;
+    m_stepFiles.clear();
+    invalidate();
+}
+
+void ExactValueSource::setStepFile(int step, const QString &fileName)
+{
+    m_stepFiles.insert(step, fileName);
+    ++m_generation;
+    // 同一步号重新写出时，之前读到的该步数组已过期
+    const QString suffix = QString("_t%1").arg(step);
+    for (const QString &cacheKey : m_arrays.keys()) {
+        if (cacheKey.endsWith(suffix)) {
+            m_arrays.remove(cacheKey);
+            m_recent.removeAll(cacheKey);
+        }
+    }
+    for (const QString &cacheKey : m_unavailable.values()) {
+        if (cacheKey.endsWith(suffix)) {
+            m_unavailable.remove(cacheKey);
+        }
+    }
+}
+
+void ExactValueSource::invalidate()
+{
+    ++m_generation;
+    m_queue.clear();
+    m_unavailable.clear();
+    release();
+}
+
+QString ExactValueSource::sourceFile(const QString &arrayName, QString *fileArrayName) const
+{
+    static const QRegularExpression timeStepName("^(.*)_t(\\d+)$");
+    const QRegularExpressionMatch match = timeStepName.match(arrayName);
+    if (match.hasMatch() && m_stepFiles.contains(match.captured(2).toInt())) {
+        *fileArrayName = match.captured(1);
+        return m_stepFiles.value(match.captured(2).toInt());
+    }
+    *fileArrayName = arrayName;
+    return m_fileName;
+}
+
+QString ExactValueSource::key(const QString &arrayName, bool isPointData)
+{
+    return QString(isPointData ? "P:" : "C:") + arrayName;
+}
+
+ExactValueSource::Status ExactValueSource::tuple(const QString &arrayName, bool isPointData, vtkIdType fileId,
+                                                 std::vector<double> &tuple)
+{
+    const QString cacheKey = key(arrayName, isPointData);
+    if (!isEnabled() || arrayName.isEmpty() || fileId < 0 || m_unavailable.contains(cacheKey)) {
+        return Unavailable;
+    }
+
+    vtkDataArray *array = m_arrays.value(cacheKey);
+    if (!array) {
+        const QPair<QString, bool> request(arrayName, isPointData);
+        if (!m_queue.contains(request)) {
+            m_queue.append(request);
+            startNext();
+        }
+        return Loading;
+    }
+    if (fileId >= array->GetNumberOfTuples()) {
+        return Unavailable;
+    }
+
+    m_recent.removeAll(cacheKey);
+    m_recent.append(cacheKey);
+    tuple.resize(static_cast<size_t>(array->GetNumberOfComponents()));
+    array->GetTuple(fileId, tuple.data());
+    return Ready;
+}
+
+size_t ExactValueSource::memorySize() const
+{
+    size_t total = 0;
+    for (const vtkSmartPointer<vtkDataArray> &array : m_arrays) {
+        total += static_cast<size_t>(array->GetActualMemorySize()) * 1024;
+    }
+    return total;
+}
+
+void ExactValueSource::release()
+{
+    m_arrays.clear();
+    m_recent.clear();
+}
+
+void ExactValueSource::startNext()
+{
+    if (m_watcher.isRunning() || m_queue.isEmpty()) {
+        return;
+    }
+    const QPair<QString, bool> request = m_queue.first();
+    QString fileArrayName;
+    const QString fileName = sourceFile(request.first, &fileArrayName);
+    const int generation = m_generation;
+    m_watcher.setFuture(QtConcurrent::run([fileName, request, fileArrayName, generation]() {
+        Request result = load(fileName, request.first, fileArrayName, request.second);
+        result.generation = generation;
+        return result;
+    }));
+}
+
+ExactValueSource::Request ExactValueSource::load(const QString &fileName, const QString &arrayName,
+                                                 const QString &fileArrayName, bool isPointData)
+{
+    TRACE_SCOPE("ExactValueSource::load", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    Request request;
+    request.fileName = fileName;
+    request.arrayName = arrayName;
+    request.fileArrayName = fileArrayName;
+    request.isPointData = isPointData;
+
+    // 整个文件按原始精度读入后只留下所需数组，其余随数据集一起释放
+    vtkSmartPointer<vtkDataObject> data = ReaderRegistry::instance().read(fileName, &request.error);
+    vtkDataSet *dataSet = vtkDataSet::SafeDownCast(data);
+    if (dataSet) {
+        // 文件本身的数组名就带 _t<step> 后缀时并入时未改名，按原名查找
+        for (const QString &name : {fileArrayName, arrayName}) {
+            const QByteArray utf8 = name.toUtf8();
+            request.array = isPointData ? dataSet->GetPointData()->GetArray(utf8.constData())
+                                        : dataSet->GetCellData()->GetArray(utf8.constData());
+            if (request.array) {
+                break;
+            }
+        }
+        if (!request.array && request.error.isEmpty()) {
+            request.error = QString("文件中没有数组 %1").arg(fileArrayName);
+        }
+    }
+
+    qDebug() << "ExactValueSource: 读取" << QFileInfo(fileName).fileName() << "中的" << fileArrayName
+             << (request.array ? "成功" : request.error) << "耗时(ms):" << timer.elapsed();
+    return request;
+}
+
+void ExactValueSource::onLoaded()
+{
+    const Request request = m_watcher.result();
+
+    // 读取期间切换或改写了文件时丢弃结果；队列保持不动，其中同名的请求（或仍在队首的这一项）按新文件重新读取
+    if (request.generation == m_generation) {
+        // 代号未变时队首就是刚读完的这一项
+        if (!m_queue.isEmpty()) {
+            m_queue.removeFirst();
+        }
+        const QString cacheKey = key(request.arrayName, request.isPointData);
+        if (request.array) {
+            m_arrays.insert(cacheKey, request.array);
+            m_recent.removeAll(cacheKey);
+            m_recent.append(cacheKey);
+            while (m_recent.size() > MAX_CACHED_ARRAYS) {
+                m_arrays.remove(m_recent.takeFirst());
+            }
+            emit arrayReady(request.arrayName, request.isPointData);
+        } else {
+            m_unavailable.insert(cacheKey);
+        }
+    }
+    startNext();
+}
@@ -0,0 +1,83 @@
+#ifndef EXACTVALUESOURCE_H
+#define EXACTVALUESOURCE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QFutureWatcher>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkDataArray.h>
+
+// 原文件中的精确值：降精度加载后内存里只有 float32 或 16 位量化的数组，
+// 拾取时按需在后台线程重新读取原文件，只保留被查询的数组（文件中的原始精度与编号），
+// 最近使用的若干个数组留在缓存中，之后同一数组的查询直接返回
+class ExactValueSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Status
+    {
+        Ready,          // 已返回精确值
+        Loading,        // 正在后台读取，完成后发出 arrayReady
+        Unavailable     // 未设置文件、文件中没有该数组（派生场、时间步数组）或读取失败
+    };
+
+    explicit ExactValueSource(QObject *parent = nullptr);
+    ~ExactValueSource();
+
+    // 切换原文件并清空缓存与时间步文件；传入空串时停用（完整精度加载时不需要）
+    void setFile(const QString &fileName);
+    bool isEnabled() const { return !m_fileName.isEmpty(); }
+    // 监视到的新时间步文件：并入时命名为 <名称>_t<step> 的数组改从该文件中按 <名称> 读取
+    void setStepFile(int step, const QString &fileName);
+    // 原文件被改写：丢弃缓存的数组，保留文件对应关系
+    void invalidate();
+
+    // 文件中编号为 fileId 的元组，各分量写入 tuple
+    Status tuple(const QString &arrayName, bool isPointData, vtkIdType fileId, std::vector<double> &tuple);
+
+    size_t memorySize() const;
+    void release();
+
+signals:
+    void arrayReady(const QString &arrayName, bool isPointData);
+
+private:
+    struct Request
+    {
+        QString fileName;
+        QString arrayName;          // 界面中的数组名
+        QString fileArrayName;      // 文件中的数组名（时间步数组去掉 _t<step> 后缀）
+        bool isPointData = true;
+        int generation = 0;
+        vtkSmartPointer<vtkDataArray> array;
+        QString error;
+    };
+
+    static QString key(const QString &arrayName, bool isPointData);
+    // 数组所在的文件及其在文件中的名称
+    QString sourceFile(const QString &arrayName, QString *fileArrayName) const;
+    static Request load(const QString &fileName, const QString &arrayName, const QString &fileArrayName,
+                        bool isPointData);
+    void startNext();
+    void onLoaded();
+
+    QString m_fileName;
+    QHash<int, QString> m_stepFiles;
+    int m_generation;                       // 文件改写或对应关系变化时递增，读取期间变化的结果丢弃
+    QHash<QString, vtkSmartPointer<vtkDataArray>> m_arrays;
+    QStringList m_recent;                   // 缓存键，最近使用的在末尾
+    QSet<QString> m_unavailable;
+    QList<QPair<QString, bool>> m_queue;
+    QFutureWatcher<Request> m_watcher;
+};
+
+#endif // EXACTVALUESOURCE_H
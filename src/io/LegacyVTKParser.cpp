@@ -0,0 +1,405 @@
+#include "LegacyVTKParser.h"
+#include "TextParsing.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QByteArray>
+#include <vtkSMPTools.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetAttributes.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using TextParsing::isSpace;
+
+namespace
+{
+inline bool startsWithNoCase(const char *p, const char *end, const char *word)
+{
+    for (; *word; ++p, ++word) {
+        if (p >= end || (*p | 0x20) != *word) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 数值块结束于下一行以字母开头的关键字/数组名行（nan、inf 仍属于数值）
+const char *findBlockEnd(const char *p, const char *end)
+{
+    while (p < end) {
+        const char *q = p;
+        while (q < end && (*q == ' ' || *q == '\t')) {
+            ++q;
+        }
+        if (q < end && ((*q >= 'A' && *q <= 'Z') || (*q >= 'a' && *q <= 'z'))
+            && !startsWithNoCase(q, end, "nan") && !startsWithNoCase(q, end, "inf")) {
+            return p;
+        }
+        const void *newline = std::memchr(q, '\n', end - q);
+        if (!newline) {
+            return end;
+        }
+        p = static_cast<const char *>(newline) + 1;
+    }
+    return end;
+}
+
+bool parseArray(vtkDataArray *array, const char *begin, const char *end)
+{
+    const vtkIdType expected = array->GetNumberOfValues();
+    bool ok = false;
+    switch (array->GetDataType()) {
+        vtkTemplateMacro(ok = TextParsing::parseTokens(begin, end, static_cast<VTK_TT *>(array->GetVoidPointer(0)), expected) >= 0);
+    default:
+        break;
+    }
+    return ok;
+}
+
+int dataTypeFromName(const QByteArray &name)
+{
+    const QByteArray type = name.toLower();
+    if (type == "float") return VTK_FLOAT;
+    if (type == "double") return VTK_DOUBLE;
+    if (type == "int") return VTK_INT;
+    if (type == "unsigned_int") return VTK_UNSIGNED_INT;
+    if (type == "long") return VTK_LONG;
+    if (type == "unsigned_long") return VTK_UNSIGNED_LONG;
+    if (type == "short") return VTK_SHORT;
+    if (type == "unsigned_short") return VTK_UNSIGNED_SHORT;
+    if (type == "char") return VTK_CHAR;
+    if (type == "unsigned_char") return VTK_UNSIGNED_CHAR;
+    if (type == "vtkidtype") return VTK_ID_TYPE;
+    if (type == "vtktypeint64") return VTK_TYPE_INT64;
+    if (type == "vtktypeuint64") return VTK_TYPE_UINT64;
+    if (type == "vtktypeint32") return VTK_TYPE_INT32;
+    if (type == "vtktypeuint32") return VTK_TYPE_UINT32;
+    return -1;
+}
+
+// 关键字行的顺序读取
+class Cursor
+{
+public:
+    Cursor(const char *begin, const char *end) : p(begin), end(end) {}
+
+    // 下一行原样内容（标题行可以为空）
+    QByteArray rawLine()
+    {
+        const char *start = p;
+        const void *newline = std::memchr(p, '\n', end - p);
+        p = newline ? static_cast<const char *>(newline) + 1 : end;
+        const char *stop = newline ? static_cast<const char *>(newline) : end;
+        return QByteArray(start, static_cast<int>(stop - start)).trimmed();
+    }
+
+    // 下一个非空行，按空白拆分为记号
+    QList<QByteArray> tokens()
+    {
+        while (p < end) {
+            const QByteArray line = rawLine();
+            if (!line.isEmpty()) {
+                return line.simplified().split(' ');
+            }
+        }
+        return QList<QByteArray>();
+    }
+
+    // 下一非空行是否以 keyword 开头（不消耗）
+    bool peek(const char *keyword)
+    {
+        const char *q = p;
+        while (q < end && isSpace(*q)) {
+            ++q;
+        }
+        const size_t length = std::strlen(keyword);
+        return static_cast<size_t>(end - q) >= length && std::memcmp(q, keyword, length) == 0;
+    }
+
+    // 5.1 版本在数组后附带 METADATA 段，以空行结束
+    void skipMetadata()
+    {
+        if (!peek("METADATA")) {
+            return;
+        }
+        tokens();
+        while (p < end && !rawLine().isEmpty()) {
+        }
+    }
+
+    // 读取 numberOfTuples × numberOfComponents 个数值到新建数组
+    vtkSmartPointer<vtkDataArray> readArray(int dataType, const QByteArray &name, int components,
+                                            vtkIdType numberOfTuples)
+    {
+        if (dataType < 0 || components <= 0 || numberOfTuples < 0) {
+            return nullptr;
+        }
+        vtkSmartPointer<vtkDataArray> array = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(dataType));
+        if (!array) {
+            return nullptr;
+        }
+        if (!name.isEmpty()) {
+            array->SetName(QByteArray::fromPercentEncoding(name).constData());
+        }
+        array->SetNumberOfComponents(components);
+        array->SetNumberOfTuples(numberOfTuples);
+
+        const char *blockEnd = findBlockEnd(p, end);
+        if (!parseArray(array, p, blockEnd)) {
+            return nullptr;
+        }
+        p = blockEnd;
+        skipMetadata();
+        return array;
+    }
+
+    const char *p;
+    const char *end;
+};
+
+void addAttribute(vtkDataSetAttributes *attributes, vtkDataArray *array, int attributeType)
+{
+    // 与 vtkUnstructuredGridReader 一致：每类属性第一个数组设为活动属性，其余作为普通数组
+    if (attributeType >= 0 && !attributes->GetAttribute(attributeType)) {
+        attributes->SetAttribute(array, attributeType);
+    } else {
+        attributes->AddArray(array);
+    }
+}
+
+// 旧格式 "n id0 id1 ..." 转为偏移 + 连接数组，连接数组并行拷贝
+bool buildLegacyCells(const std::vector<vtkIdType> &legacy, vtkIdType cellCount, vtkCellArray *cells)
+{
+    vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfValues(cellCount + 1);
+    vtkIdType *offsetData = offsets->GetPointer(0);
+
+    const vtkIdType size = static_cast<vtkIdType>(legacy.size());
+    vtkIdType position = 0;
+    vtkIdType connectivitySize = 0;
+    for (vtkIdType i = 0; i < cellCount; ++i) {
+        if (position >= size) {
+            return false;
+        }
+        const vtkIdType pointCount = legacy[position];
+        if (pointCount < 0 || position + 1 + pointCount > size) {
+            return false;
+        }
+        offsetData[i] = connectivitySize;
+        connectivitySize += pointCount;
+        position += pointCount + 1;
+    }
+    offsetData[cellCount] = connectivitySize;
+    if (position != size) {
+        return false;
+    }
+
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfValues(connectivitySize);
+    vtkIdType *connectivityData = connectivity->GetPointer(0);
+    vtkSMPTools::For(0, cellCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            // 第 i 个单元在旧格式中前面还有 i+1 个计数值
+            const vtkIdType *source = legacy.data() + offsetData[i] + i + 1;
+            std::copy(source, source + (offsetData[i + 1] - offsetData[i]), connectivityData + offsetData[i]);
+        }
+    });
+
+    cells->SetData(offsets.Get(), connectivity.Get());
+    return true;
+}
+
+void fail(QString *error, const QString &message)
+{
+    if (error) {
+        *error = message;
+    }
+}
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> LegacyVTKParser::read(const QString &fileName, QString *error)
+{
+    TRACE_SCOPE("LegacyVTKParser::read", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        fail(error, QString("无法打开文件: %1").arg(file.errorString()));
+        return nullptr;
+    }
+    const qint64 fileSize = file.size();
+    const uchar *mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    if (!mapped) {
+        fail(error, "无法映射文件");
+        return nullptr;
+    }
+
+    Cursor cursor(reinterpret_cast<const char *>(mapped), reinterpret_cast<const char *>(mapped) + fileSize);
+
+    // 文件头：版本行、标题行、ASCII/BINARY、数据集类型
+    const QByteArray versionLine = cursor.rawLine();
+    if (!versionLine.startsWith("# vtk DataFile Version")) {
+        fail(error, "不是 VTK 旧版格式文件");
+        return nullptr;
+    }
+    const double version = versionLine.mid(versionLine.lastIndexOf(' ') + 1).toDouble();
+    cursor.rawLine();
+    if (cursor.rawLine().toUpper() != "ASCII") {
+        fail(error, "仅支持 ASCII 编码");
+        return nullptr;
+    }
+    QList<QByteArray> tokens = cursor.tokens();
+    if (tokens.size() < 2 || tokens[0].toUpper() != "DATASET" || tokens[1].toUpper() != "UNSTRUCTURED_GRID") {
+        fail(error, "仅支持 UNSTRUCTURED_GRID 数据集");
+        return nullptr;
+    }
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    vtkSmartPointer<vtkCellArray> cells;
+    vtkSmartPointer<vtkUnsignedCharArray> cellTypes;
+    vtkDataSetAttributes *attributes = nullptr;
+    vtkIdType attributeTuples = 0;
+
+    while (!(tokens = cursor.tokens()).isEmpty()) {
+        const QByteArray keyword = tokens[0].toUpper();
+
+        if (keyword == "POINTS" && tokens.size() >= 3) {
+            vtkSmartPointer<vtkDataArray> coordinates = cursor.readArray(dataTypeFromName(tokens[2]), QByteArray(), 3,
+                                                                         tokens[1].toLongLong());
+            if (!coordinates) {
+                fail(error, "POINTS 数据无效");
+                return nullptr;
+            }
+            vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+            points->SetData(coordinates);
+            grid->SetPoints(points);
+        } else if (keyword == "CELLS" && tokens.size() >= 3) {
+            cells = vtkSmartPointer<vtkCellArray>::New();
+            if (version >= 5.0) {
+                // 5.1：OFFSETS 与 CONNECTIVITY 两个数组，直接作为单元数组存储
+                vtkSmartPointer<vtkDataArray> offsets;
+                vtkSmartPointer<vtkDataArray> connectivity;
+                if (cursor.peek("OFFSETS")) {
+                    cursor.tokens();
+                    offsets = cursor.readArray(VTK_ID_TYPE, QByteArray(), 1, tokens[1].toLongLong());
+                }
+                if (offsets && cursor.peek("CONNECTIVITY")) {
+                    cursor.tokens();
+                    connectivity = cursor.readArray(VTK_ID_TYPE, QByteArray(), 1, tokens[2].toLongLong());
+                }
+                if (!connectivity) {
+                    fail(error, "CELLS 数据无效");
+                    return nullptr;
+                }
+                cells->SetData(vtkIdTypeArray::SafeDownCast(offsets), vtkIdTypeArray::SafeDownCast(connectivity));
+            } else {
+                const vtkIdType cellCount = tokens[1].toLongLong();
+                std::vector<vtkIdType> legacy(static_cast<size_t>(std::max<qlonglong>(0, tokens[2].toLongLong())));
+                const char *blockEnd = findBlockEnd(cursor.p, cursor.end);
+                if (TextParsing::parseTokens(cursor.p, blockEnd, legacy.data(), static_cast<vtkIdType>(legacy.size())) < 0
+                    || !buildLegacyCells(legacy, cellCount, cells)) {
+                    fail(error, "CELLS 数据无效");
+                    return nullptr;
+                }
+                cursor.p = blockEnd;
+            }
+        } else if (keyword == "CELL_TYPES" && tokens.size() >= 2) {
+            cellTypes = vtkUnsignedCharArray::SafeDownCast(cursor.readArray(VTK_UNSIGNED_CHAR, QByteArray(), 1,
+                                                                            tokens[1].toLongLong()));
+            if (!cellTypes) {
+                fail(error, "CELL_TYPES 数据无效");
+                return nullptr;
+            }
+        } else if ((keyword == "POINT_DATA" || keyword == "CELL_DATA") && tokens.size() >= 2) {
+            attributes = keyword == "POINT_DATA" ? static_cast<vtkDataSetAttributes *>(grid->GetPointData())
+                                                 : static_cast<vtkDataSetAttributes *>(grid->GetCellData());
+            attributeTuples = tokens[1].toLongLong();
+        } else if (keyword == "METADATA") {
+            while (cursor.p < cursor.end && !cursor.rawLine().isEmpty()) {
+            }
+        } else if (attributes && (keyword == "SCALARS" || keyword == "VECTORS" || keyword == "NORMALS"
+                                  || keyword == "TENSORS" || keyword == "TENSORS6" || keyword == "TEXTURE_COORDINATES"
+                                  || keyword == "GLOBAL_IDS" || keyword == "PEDIGREE_IDS") && tokens.size() >= 3) {
+            int components = 1;
+            int attributeType = -1;
+            QByteArray typeName = tokens[2];
+            if (keyword == "SCALARS") {
+                components = tokens.size() >= 4 ? tokens[3].toInt() : 1;
+                attributeType = vtkDataSetAttributes::SCALARS;
+                if (cursor.peek("LOOKUP_TABLE")) {
+                    cursor.tokens();
+                }
+            } else if (keyword == "VECTORS") {
+                components = 3;
+                attributeType = vtkDataSetAttributes::VECTORS;
+            } else if (keyword == "NORMALS") {
+                components = 3;
+                attributeType = vtkDataSetAttributes::NORMALS;
+            } else if (keyword == "TENSORS") {
+                components = 9;
+                attributeType = vtkDataSetAttributes::TENSORS;
+            } else if (keyword == "TENSORS6") {
+                components = 6;
+            } else if (keyword == "TEXTURE_COORDINATES") {
+                components = tokens[2].toInt();
+                typeName = tokens.value(3);
+                attributeType = vtkDataSetAttributes::TCOORDS;
+            } else if (keyword == "GLOBAL_IDS") {
+                attributeType = vtkDataSetAttributes::GLOBALIDS;
+            } else {
+                attributeType = vtkDataSetAttributes::PEDIGREEIDS;
+            }
+
+            vtkSmartPointer<vtkDataArray> array = cursor.readArray(dataTypeFromName(typeName), tokens[1], components,
+                                                                   attributeTuples);
+            if (!array) {
+                fail(error, QString("%1 %2 数据无效或类型不支持").arg(QString::fromUtf8(keyword)).arg(QString::fromUtf8(tokens[1])));
+                return nullptr;
+            }
+            addAttribute(attributes, array, attributeType);
+        } else if (keyword == "FIELD" && tokens.size() >= 3) {
+            // 数据段之外的 FIELD 属于数据集字段数据
+            vtkFieldData *fieldData = attributes ? static_cast<vtkFieldData *>(attributes) : grid->GetFieldData();
+            const int arrayCount = tokens[2].toInt();
+            for (int i = 0; i < arrayCount; ++i) {
+                const QList<QByteArray> header = cursor.tokens();
+                if (header.value(0) == "NULL_ARRAY") {
+                    continue;
+                }
+                vtkSmartPointer<vtkDataArray> array = header.size() >= 4
+                    ? cursor.readArray(dataTypeFromName(header[3]), header[0], header[1].toInt(), header[2].toLongLong())
+                    : nullptr;
+                if (!array) {
+                    fail(error, QString("FIELD 数组 %1 无效或类型不支持").arg(QString::fromUtf8(header.value(0))));
+                    return nullptr;
+                }
+                fieldData->AddArray(array);
+            }
+        } else {
+            fail(error, QString("不支持的段: %1").arg(QString::fromUtf8(tokens[0])));
+            return nullptr;
+        }
+    }
+
+    if (!grid->GetPoints() || !cells || !cellTypes || cellTypes->GetNumberOfValues() != cells->GetNumberOfCells()) {
+        fail(error, "缺少 POINTS、CELLS 或 CELL_TYPES");
+        return nullptr;
+    }
+    grid->SetCells(cellTypes, cells);
+
+    qDebug() << "LegacyVTKParser: 读取" << fileName << "点数:" << grid->GetNumberOfPoints()
+             << "单元数:" << grid->GetNumberOfCells() << "线程数:" << vtkSMPTools::GetEstimatedNumberOfThreads()
+             << "耗时(ms):" << timer.elapsed();
+    return grid;
+}
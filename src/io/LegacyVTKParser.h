@@ -0,0 +1,24 @@
+#ifndef LEGACYVTKPARSER_H
+#define LEGACYVTKPARSER_H
+
+#include <QString>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+// ASCII 旧版 .vtk 非结构网格的快速读取：
+// 文件整体内存映射，关键字行顺序解析，大段数值块按行边界切分后在 vtkSMPTools 线程池上
+// 先并行计数、再并行用 std::from_chars 直接写入预分配的数组，不经过中间字符串
+//
+// 支持版本 2.0-5.1 的 POINTS / CELLS（含 5.1 的 OFFSETS/CONNECTIVITY）/ CELL_TYPES，
+// 以及 POINT_DATA / CELL_DATA 中的 SCALARS、VECTORS、NORMALS、TENSORS、
+// TEXTURE_COORDINATES、GLOBAL_IDS、PEDIGREE_IDS 与 FIELD 数值数组。
+// 二进制文件、字符串数组、自定义查找表等返回空并给出原因，由调用方回退到 vtkUnstructuredGridReader
+class LegacyVTKParser
+{
+public:
+    // 读取失败时返回空，error 中给出原因
+    static vtkSmartPointer<vtkUnstructuredGrid> read(const QString &fileName, QString *error = nullptr);
+};
+
+#endif // LEGACYVTKPARSER_H
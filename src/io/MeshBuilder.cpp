@@ -0,0 +1,119 @@
+#include "MeshBuilder.h"
+#include <vtkSMPTools.h>
+#include <vtkPoints.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkCellArray.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <algorithm>
+#include <atomic>
+
+MeshBuilder::MeshBuilder()
+    : m_indexBuilt(false)
+{
+    offsets.push_back(0);
+}
+
+void MeshBuilder::appendElements(int cellType, int nodesPerElement, const vtkIdType *records, vtkIdType count,
+                                 const int *order, vtkIdType nodeIdOffset)
+{
+    const vtkIdType firstElement = elementCount();
+    const vtkIdType firstSlot = offsets.back();
+    elementIds.resize(firstElement + count);
+    cellTypes.resize(firstElement + count, static_cast<unsigned char>(cellType));
+    offsets.resize(firstElement + count + 1);
+    connectivity.resize(firstSlot + count * nodesPerElement);
+
+    const vtkIdType stride = nodesPerElement + 1;
+    vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i) {
+            const vtkIdType *record = records + i * stride;
+            vtkIdType *nodes = connectivity.data() + firstSlot + i * nodesPerElement;
+            elementIds[firstElement + i] = record[0];
+            offsets[firstElement + i + 1] = firstSlot + (i + 1) * nodesPerElement;
+            for (int n = 0; n < nodesPerElement; ++n) {
+                nodes[n] = record[1 + (order ? order[n] : n)] + nodeIdOffset;
+            }
+        }
+    });
+}
+
+const TextParsing::IdIndex &MeshBuilder::nodeIndex()
+{
+    if (!m_indexBuilt) {
+        m_nodeIndex.build(nodeIds.data(), static_cast<vtkIdType>(nodeIds.size()));
+        m_indexBuilt = true;
+    }
+    return m_nodeIndex;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> MeshBuilder::build(QString *error)
+{
+    const vtkIdType pointCount = static_cast<vtkIdType>(nodeIds.size());
+    const vtkIdType cellCount = elementCount();
+    const TextParsing::IdIndex &index = nodeIndex();
+
+    // 节点号 → 点索引
+    vtkSmartPointer<vtkIdTypeArray> connectivityArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivityArray->SetNumberOfValues(static_cast<vtkIdType>(connectivity.size()));
+    vtkIdType *connectivityData = connectivityArray->GetPointer(0);
+    std::atomic<vtkIdType> missingNode(-1);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(connectivity.size()), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i) {
+            const vtkIdType point = index.find(connectivity[i]);
+            if (point < 0) {
+                missingNode = connectivity[i];
+            }
+            connectivityData[i] = std::max<vtkIdType>(point, 0);
+        }
+    });
+    if (missingNode >= 0) {
+        if (error) {
+            *error = QString("单元引用了不存在的节点 %1").arg(missingNode.load());
+        }
+        return nullptr;
+    }
+    std::vector<vtkIdType>().swap(connectivity);
+
+    vtkSmartPointer<vtkDoubleArray> coordinateArray = vtkSmartPointer<vtkDoubleArray>::New();
+    coordinateArray->SetNumberOfComponents(3);
+    coordinateArray->SetNumberOfTuples(pointCount);
+    std::copy(coordinates.begin(), coordinates.end(), coordinateArray->GetPointer(0));
+    std::vector<double>().swap(coordinates);
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(coordinateArray);
+
+    vtkSmartPointer<vtkIdTypeArray> offsetArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsetArray->SetNumberOfValues(cellCount + 1);
+    std::copy(offsets.begin(), offsets.end(), offsetArray->GetPointer(0));
+    std::vector<vtkIdType>(1, 0).swap(offsets);
+
+    vtkSmartPointer<vtkUnsignedCharArray> typeArray = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    typeArray->SetNumberOfValues(cellCount);
+    std::copy(cellTypes.begin(), cellTypes.end(), typeArray->GetPointer(0));
+    std::vector<unsigned char>().swap(cellTypes);
+
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(offsetArray.Get(), connectivityArray.Get());
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grid->SetPoints(points);
+    grid->SetCells(typeArray, cells);
+
+    vtkSmartPointer<vtkIdTypeArray> nodeIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    nodeIdArray->SetName("NodeID");
+    nodeIdArray->SetNumberOfValues(pointCount);
+    std::copy(nodeIds.begin(), nodeIds.end(), nodeIdArray->GetPointer(0));
+    grid->GetPointData()->AddArray(nodeIdArray);
+
+    vtkSmartPointer<vtkIdTypeArray> elementIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    elementIdArray->SetName("ElementID");
+    elementIdArray->SetNumberOfValues(cellCount);
+    std::copy(elementIds.begin(), elementIds.end(), elementIdArray->GetPointer(0));
+    std::vector<vtkIdType>().swap(elementIds);
+    grid->GetCellData()->AddArray(elementIdArray);
+
+    return grid;
+}
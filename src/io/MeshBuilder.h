@@ -0,0 +1,46 @@
+#ifndef MESHBUILDER_H
+#define MESHBUILDER_H
+
+#include "TextParsing.h"
+
+#include <QString>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+// 求解器网格的组装：读取器把节点（原始节点号 + 坐标）和单元（原始单元号、VTK 类型、
+// 以原始节点号表示的连接）写入这里的数组，build 时并行把节点号换成点索引并生成网格，
+// 同时附带 NodeID / ElementID 数组，拾取时可对应回求解器编号
+class MeshBuilder
+{
+public:
+    std::vector<vtkIdType> nodeIds;
+    std::vector<double> coordinates;        // x0 y0 z0 x1 ...
+    std::vector<vtkIdType> elementIds;
+    std::vector<unsigned char> cellTypes;
+    std::vector<vtkIdType> offsets;         // 每个单元在 connectivity 中的起点，末尾为总长度
+    std::vector<vtkIdType> connectivity;    // 原始节点号
+
+    MeshBuilder();
+
+    vtkIdType elementCount() const { return static_cast<vtkIdType>(cellTypes.size()); }
+
+    // 追加一批节点数相同的单元；records 为平铺的 (单元号, 节点号 × nodesPerElement)，
+    // order 非空时 VTK 第 i 个节点取自求解器第 order[i] 个节点，nodeIdOffset 加到每个节点号上
+    void appendElements(int cellType, int nodesPerElement, const vtkIdType *records, vtkIdType count,
+                        const int *order = nullptr, vtkIdType nodeIdOffset = 0);
+
+    // 原始节点号到点索引的映射，节点全部读入后建立（结果块按节点号写入时需要）
+    const TextParsing::IdIndex &nodeIndex();
+
+    // 生成网格并释放上面的中间数组；有单元引用不存在的节点时返回空
+    vtkSmartPointer<vtkUnstructuredGrid> build(QString *error);
+
+private:
+    TextParsing::IdIndex m_nodeIndex;
+    bool m_indexBuilt;
+};
+
+#endif // MESHBUILDER_H
@@ -0,0 +1,403 @@
+#include "NastranBdfReader.h"
+#include "MeshBuilder.h"
+#include "TextParsing.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <vtkCellType.h>
+#include <vtkCellData.h>
+#include <vtkIntArray.h>
+#include <vtkSMPTools.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace TextParsing;
+
+namespace
+{
+struct Field
+{
+    const char *begin;
+    const char *end;
+};
+
+// 二阶实体单元中 Nastran 与 VTK 的节点顺序不同：Nastran 先列竖边中点再列顶面边中点
+const int HEXA20_ORDER[20] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 16, 17, 18, 19, 12, 13, 14, 15};
+const int PENTA15_ORDER[15] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 14, 9, 10, 11};
+
+struct ElementCard
+{
+    const char *name;
+    int firstNode;          // 第一个节点所在的数据字段
+    int linearNodes;
+    int linearType;
+    int quadraticNodes;     // 0 表示没有二阶形式
+    int quadraticType;
+    const int *order;       // 二阶形式的节点重排
+};
+
+const ElementCard ELEMENT_CARDS[] = {
+    {"CTRIA3", 2, 3, VTK_TRIANGLE, 0, 0, nullptr},
+    {"CTRIAR", 2, 3, VTK_TRIANGLE, 0, 0, nullptr},
+    {"CTRIA6", 2, 3, VTK_TRIANGLE, 6, VTK_QUADRATIC_TRIANGLE, nullptr},
+    {"CQUAD4", 2, 4, VTK_QUAD, 0, 0, nullptr},
+    {"CQUADR", 2, 4, VTK_QUAD, 0, 0, nullptr},
+    {"CSHEAR", 2, 4, VTK_QUAD, 0, 0, nullptr},
+    {"CQUAD8", 2, 4, VTK_QUAD, 8, VTK_QUADRATIC_QUAD, nullptr},
+    {"CTETRA", 2, 4, VTK_TETRA, 10, VTK_QUADRATIC_TETRA, nullptr},
+    {"CPYRAM", 2, 5, VTK_PYRAMID, 13, VTK_QUADRATIC_PYRAMID, nullptr},
+    {"CPENTA", 2, 6, VTK_WEDGE, 15, VTK_QUADRATIC_WEDGE, PENTA15_ORDER},
+    {"CHEXA", 2, 8, VTK_HEXAHEDRON, 20, VTK_QUADRATIC_HEXAHEDRON, HEXA20_ORDER},
+    {"CBAR", 2, 2, VTK_LINE, 0, 0, nullptr},
+    {"CBEAM", 2, 2, VTK_LINE, 0, 0, nullptr},
+    {"CROD", 2, 2, VTK_LINE, 0, 0, nullptr},
+    {"CTUBE", 2, 2, VTK_LINE, 0, 0, nullptr},
+    {"CONROD", 1, 2, VTK_LINE, 0, 0, nullptr},
+};
+
+// 单个块的解析结果，按块顺序合并
+struct ChunkCards
+{
+    std::vector<vtkIdType> nodeIds;
+    std::vector<double> coordinates;
+    std::vector<vtkIdType> elementIds;
+    std::vector<unsigned char> cellTypes;
+    std::vector<vtkIdType> nodeCounts;
+    std::vector<vtkIdType> connectivity;
+    std::vector<int> propertyIds;
+    vtkIdType nonBasicGrids = 0;
+};
+
+bool parseInteger(const Field &field, vtkIdType &value)
+{
+    return parseField(field.begin, field.end, value);
+}
+
+// Nastran 实数可以省略 E："1.5-3" 即 1.5E-3，也可以用 Fortran 的 D 指数
+bool parseReal(const Field &field, double &value)
+{
+    const char *begin = field.begin;
+    const char *end = field.end;
+    while (begin < end && isSpace(*begin)) {
+        ++begin;
+    }
+    while (end > begin && isSpace(end[-1])) {
+        --end;
+    }
+    if (begin < end && *begin == '+') {
+        ++begin;
+    }
+    if (begin == end) {
+        return false;
+    }
+
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    if (result.ptr == end) {
+        return true;
+    }
+
+    const char *exponentBegin = result.ptr;
+    if (*exponentBegin == 'D' || *exponentBegin == 'd') {
+        ++exponentBegin;
+    }
+    if (exponentBegin < end && *exponentBegin == '+') {
+        ++exponentBegin;
+    }
+    int exponent = 0;
+    std::from_chars_result exponentResult = std::from_chars(exponentBegin, end, exponent);
+    if (exponentResult.ec != std::errc() || exponentResult.ptr != end) {
+        return false;
+    }
+    value *= std::pow(10.0, exponent);
+    return true;
+}
+
+// 把一行拆成数据字段：自由格式按逗号，大字段每行 4 个 16 列字段，小字段每行 8 个 8 列字段。
+// 每行固定补足 8 个（大字段 4 个）字段，使续行中的字段序号与 Nastran 定义一致
+void splitFields(const char *line, const char *stop, bool large, Field *keyword, std::vector<Field> &fields)
+{
+    if (std::memchr(line, ',', stop - line)) {
+        const char *p = line;
+        int index = 0;
+        while (true) {
+            const void *found = std::memchr(p, ',', stop - p);
+            const char *comma = found ? static_cast<const char *>(found) : stop;
+            if (index == 0) {
+                if (keyword) {
+                    *keyword = {p, comma};
+                }
+            } else if (index <= 8) {
+                fields.push_back({p, comma});
+            }
+            ++index;
+            if (comma == stop) {
+                break;
+            }
+            p = comma + 1;
+        }
+        for (; index <= 8; ++index) {
+            fields.push_back({stop, stop});
+        }
+        return;
+    }
+
+    if (keyword) {
+        *keyword = {line, std::min(line + 8, stop)};
+    }
+    const int width = large ? 16 : 8;
+    const int count = large ? 4 : 8;
+    for (int i = 0; i < count; ++i) {
+        const char *begin = std::min(line + 8 + i * width, stop);
+        fields.push_back({begin, std::min(begin + width, stop)});
+    }
+}
+
+std::string cardName(const Field &keyword)
+{
+    std::string name;
+    for (const char *p = keyword.begin; p < keyword.end; ++p) {
+        if (!isSpace(*p) && *p != '*') {
+            name.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(*p))));
+        }
+    }
+    return name;
+}
+
+bool isLargeField(const Field &keyword)
+{
+    const char *end = keyword.end;
+    while (end > keyword.begin && isSpace(end[-1])) {
+        --end;
+    }
+    return end > keyword.begin && end[-1] == '*';
+}
+
+void finishCard(const Field &keyword, const std::vector<Field> &fields, ChunkCards &out)
+{
+    const std::string name = cardName(keyword);
+    auto field = [&fields](size_t index) {
+        return index < fields.size() ? fields[index] : Field{nullptr, nullptr};
+    };
+
+    if (name == "GRID") {
+        vtkIdType id = 0;
+        vtkIdType coordinateSystem = 0;
+        double xyz[3] = {0.0, 0.0, 0.0};
+        if (!parseInteger(field(0), id)) {
+            return;
+        }
+        if (parseInteger(field(1), coordinateSystem) && coordinateSystem != 0) {
+            ++out.nonBasicGrids;
+        }
+        for (int c = 0; c < 3; ++c) {
+            parseReal(field(2 + c), xyz[c]);
+        }
+        out.nodeIds.push_back(id);
+        out.coordinates.insert(out.coordinates.end(), xyz, xyz + 3);
+        return;
+    }
+
+    for (const ElementCard &card : ELEMENT_CARDS) {
+        if (name != card.name) {
+            continue;
+        }
+
+        vtkIdType nodes[20];
+        int available = 0;
+        const int maxNodes = std::max(card.linearNodes, card.quadraticNodes);
+        for (; available < maxNodes; ++available) {
+            if (!parseInteger(field(card.firstNode + available), nodes[available]) || nodes[available] <= 0) {
+                break;
+            }
+        }
+
+        // 中间节点不全时按一阶单元处理
+        const bool quadratic = card.quadraticNodes > 0 && available >= card.quadraticNodes;
+        const int nodeCount = quadratic ? card.quadraticNodes : card.linearNodes;
+        vtkIdType elementId = 0;
+        vtkIdType propertyId = 0;
+        if (available < nodeCount || !parseInteger(field(0), elementId)) {
+            return;
+        }
+        if (card.firstNode == 2) {
+            parseInteger(field(1), propertyId);
+        }
+
+        out.elementIds.push_back(elementId);
+        out.cellTypes.push_back(static_cast<unsigned char>(quadratic ? card.quadraticType : card.linearType));
+        out.nodeCounts.push_back(nodeCount);
+        out.propertyIds.push_back(static_cast<int>(propertyId));
+        for (int n = 0; n < nodeCount; ++n) {
+            out.connectivity.push_back(nodes[quadratic && card.order ? card.order[n] : n]);
+        }
+        return;
+    }
+}
+
+void parseCards(const char *begin, const char *end, ChunkCards &out)
+{
+    std::vector<Field> fields;
+    Field keyword = {nullptr, nullptr};
+    bool large = false;
+
+    for (const char *p = begin; p < end; p = nextLine(p, end)) {
+        const char *stop = lineEnd(p, end);
+        const char *first = p;
+        while (first < stop && isSpace(*first)) {
+            ++first;
+        }
+        if (first == stop || *p == '$') {
+            continue;
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(*p))) {
+            if (keyword.begin) {
+                finishCard(keyword, fields, out);
+            }
+            fields.clear();
+            Field lineKeyword;
+            splitFields(p, stop, false, &lineKeyword, fields);
+            large = isLargeField(lineKeyword);
+            if (large) {
+                // 按大字段重新拆分
+                fields.clear();
+                splitFields(p, stop, true, &lineKeyword, fields);
+            }
+            keyword = lineKeyword;
+        } else if (keyword.begin) {
+            Field marker;
+            splitFields(p, stop, large || *p == '*', &marker, fields);
+        }
+    }
+    if (keyword.begin) {
+        finishCard(keyword, fields, out);
+    }
+}
+}
+
+MeshReader::SniffResult NastranBdfReader::sniff(const QByteArray &head) const
+{
+    const QByteArray upper = head.toUpper();
+    if (upper.contains("BEGIN BULK") || upper.contains("\nCEND") || upper.startsWith("GRID")
+        || upper.contains("\nGRID") || upper.contains("\nCQUAD4") || upper.contains("\nCTETRA")
+        || upper.contains("\nCHEXA")) {
+        return Matched;
+    }
+    // 开头只有注释时无法判断
+    return upper.startsWith("$") ? Unknown : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> NastranBdfReader::read(const QString &fileName, QString *error)
+{
+    TRACE_SCOPE("NastranBdfReader::read", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(fileName);
+    const uchar *mapped = file.open(QIODevice::ReadOnly) && file.size() > 0 ? file.map(0, file.size()) : nullptr;
+    if (!mapped) {
+        if (error) {
+            *error = QString("无法打开文件: %1").arg(file.errorString());
+        }
+        return nullptr;
+    }
+    const char *fileBegin = reinterpret_cast<const char *>(mapped);
+    const char *fileEnd = fileBegin + file.size();
+
+    // 只解析批量数据段；没有 BEGIN BULK 时视为纯批量数据文件
+    const QByteArray content = QByteArray::fromRawData(fileBegin, file.size());
+    const qsizetype bulkPosition = content.indexOf("BEGIN BULK");
+    const char *begin = bulkPosition >= 0 ? nextLine(fileBegin + bulkPosition, fileEnd) : fileBegin;
+    const qsizetype endPosition = content.indexOf("ENDDATA", begin - fileBegin);
+    const char *end = endPosition >= 0 ? fileBegin + endPosition : fileEnd;
+
+    // 只在新卡片（字母开头的行）前切块，续行与所属卡片在同一块中
+    std::vector<Chunk> chunks = splitChunks(begin, end, [](const char *line) {
+        return std::isalpha(static_cast<unsigned char>(*line)) != 0;
+    });
+    std::vector<ChunkCards> results(chunks.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            parseCards(chunks[i].begin, chunks[i].end, results[i]);
+        }
+    });
+
+    // 按块顺序合并
+    struct Offsets
+    {
+        vtkIdType nodes;
+        vtkIdType elements;
+        vtkIdType connectivity;
+    };
+    std::vector<Offsets> offsets(results.size());
+    Offsets total = {0, 0, 0};
+    vtkIdType nonBasicGrids = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        offsets[i] = total;
+        total.nodes += static_cast<vtkIdType>(results[i].nodeIds.size());
+        total.elements += static_cast<vtkIdType>(results[i].elementIds.size());
+        total.connectivity += static_cast<vtkIdType>(results[i].connectivity.size());
+        nonBasicGrids += results[i].nonBasicGrids;
+    }
+    if (total.nodes == 0 || total.elements == 0) {
+        if (error) {
+            *error = "文件中没有 GRID 或支持的单元卡";
+        }
+        return nullptr;
+    }
+
+    MeshBuilder builder;
+    builder.nodeIds.resize(total.nodes);
+    builder.coordinates.resize(total.nodes * 3);
+    builder.elementIds.resize(total.elements);
+    builder.cellTypes.resize(total.elements);
+    builder.offsets.resize(total.elements + 1);
+    builder.connectivity.resize(total.connectivity);
+    std::vector<int> propertyIds(total.elements);
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(results.size()), [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            ChunkCards &chunk = results[i];
+            const Offsets &base = offsets[i];
+            std::copy(chunk.nodeIds.begin(), chunk.nodeIds.end(), builder.nodeIds.begin() + base.nodes);
+            std::copy(chunk.coordinates.begin(), chunk.coordinates.end(), builder.coordinates.begin() + base.nodes * 3);
+            std::copy(chunk.elementIds.begin(), chunk.elementIds.end(), builder.elementIds.begin() + base.elements);
+            std::copy(chunk.cellTypes.begin(), chunk.cellTypes.end(), builder.cellTypes.begin() + base.elements);
+            std::copy(chunk.propertyIds.begin(), chunk.propertyIds.end(), propertyIds.begin() + base.elements);
+            std::copy(chunk.connectivity.begin(), chunk.connectivity.end(), builder.connectivity.begin() + base.connectivity);
+            vtkIdType offset = base.connectivity;
+            for (size_t e = 0; e < chunk.nodeCounts.size(); ++e) {
+                offset += chunk.nodeCounts[e];
+                builder.offsets[base.elements + e + 1] = offset;
+            }
+            chunk = ChunkCards();
+        }
+    });
+    builder.offsets[0] = 0;
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = builder.build(error);
+    if (!grid) {
+        return nullptr;
+    }
+
+    vtkSmartPointer<vtkIntArray> propertyArray = vtkSmartPointer<vtkIntArray>::New();
+    propertyArray->SetName("PID");
+    propertyArray->SetNumberOfValues(total.elements);
+    std::copy(propertyIds.begin(), propertyIds.end(), propertyArray->GetPointer(0));
+    grid->GetCellData()->AddArray(propertyArray);
+
+    if (nonBasicGrids > 0) {
+        qDebug() << "NastranBdfReader:" << nonBasicGrids << "个节点使用非基本坐标系，坐标未做变换";
+    }
+    qDebug() << "NastranBdfReader: 节点数:" << grid->GetNumberOfPoints() << "单元数:" << grid->GetNumberOfCells()
+             << "块数:" << chunks.size() << "耗时(ms):" << timer.elapsed();
+    return grid;
+}
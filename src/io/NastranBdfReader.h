@@ -0,0 +1,20 @@
+#ifndef NASTRANBDFREADER_H
+#define NASTRANBDFREADER_H
+
+#include "ReaderRegistry.h"
+
+// Nastran 批量数据 (.bdf/.nas/.dat) 网格读取：BEGIN BULK 到 ENDDATA 之间的卡片
+// 在新卡片行首切块后并行解析，支持小字段、大字段 (GRID*) 与自由格式（逗号分隔）及续行。
+// 读取 GRID 与常用单元卡（CTRIA3/6、CQUAD4/8、CTETRA、CPYRAM、CPENTA、CHEXA、CBAR、CBEAM、CROD 等），
+// 属性号作为单元数组 PID；非基本坐标系 (CP≠0) 的节点坐标按基本坐标系处理
+class NastranBdfReader : public MeshReader
+{
+public:
+    QString name() const override { return "Nastran批量数据"; }
+    QStringList extensions() const override { return QStringList() << "bdf" << "nas" << "dat"; }
+    int capabilities() const override { return Mesh | Parallel; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+#endif // NASTRANBDFREADER_H
@@ -0,0 +1,106 @@
+#include "ReaderRegistry.h"
+#include "VTKReaders.h"
+#include "AbaqusInpReader.h"
+#include "NastranBdfReader.h"
+#include "CalculixFrdReader.h"
+#include "BrickStore.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+namespace
+{
+// 内容嗅探读取的文件开头字节数
+const qint64 SNIFF_BYTES = 8192;
+}
+
+ReaderRegistry &ReaderRegistry::instance()
+{
+    static ReaderRegistry registry;
+    return registry;
+}
+
+ReaderRegistry::ReaderRegistry()
+{
+    registerReader(std::unique_ptr<MeshReader>(new VtuReader()));
+    registerReader(std::unique_ptr<MeshReader>(new LegacyVtkReader()));
+    registerReader(std::unique_ptr<MeshReader>(new AbaqusInpReader()));
+    registerReader(std::unique_ptr<MeshReader>(new NastranBdfReader()));
+    registerReader(std::unique_ptr<MeshReader>(new CalculixFrdReader()));
+    registerReader(std::unique_ptr<MeshReader>(new BrickIndexReader()));
+    registerReader(std::unique_ptr<MeshReader>(new StlReader()));
+    registerReader(std::unique_ptr<MeshReader>(new ObjReader()));
+    registerReader(std::unique_ptr<MeshReader>(new PlyReader()));
+}
+
+void ReaderRegistry::registerReader(std::unique_ptr<MeshReader> reader)
+{
+    if (reader) {
+        m_readers.push_back(std::move(reader));
+    }
+}
+
+MeshReader *ReaderRegistry::findReader(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    const QByteArray head = file.read(SNIFF_BYTES);
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+
+    // 内容确认 > 内容无法判断但扩展名匹配；同等情况下扩展名匹配者优先
+    MeshReader *best = nullptr;
+    int bestScore = 0;
+    for (const std::unique_ptr<MeshReader> &reader : m_readers) {
+        const MeshReader::SniffResult sniffed = reader->sniff(head);
+        const bool extensionMatched = reader->extensions().contains(suffix);
+        if (sniffed == MeshReader::NotMatched || (sniffed == MeshReader::Unknown && !extensionMatched)) {
+            continue;
+        }
+        const int score = static_cast<int>(sniffed) * 2 + (extensionMatched ? 1 : 0);
+        if (score > bestScore) {
+            best = reader.get();
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+vtkSmartPointer<vtkDataObject> ReaderRegistry::read(const QString &fileName, QString *error) const
+{
+    TRACE_SCOPE("ReaderRegistry::read", "io");
+    MeshReader *reader = findReader(fileName);
+    if (!reader) {
+        if (error) {
+            *error = QString("不支持的文件格式: %1").arg(QFileInfo(fileName).fileName());
+        }
+        return nullptr;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    vtkSmartPointer<vtkDataObject> data = reader->read(fileName, error);
+    qDebug() << "ReaderRegistry:" << reader->name() << "读取" << QFileInfo(fileName).fileName()
+             << (data ? "成功" : "失败") << "耗时(ms):" << timer.elapsed();
+    return data;
+}
+
+QString ReaderRegistry::fileDialogFilter() const
+{
+    QStringList allPatterns;
+    QStringList filters;
+    for (const std::unique_ptr<MeshReader> &reader : m_readers) {
+        QStringList patterns;
+        for (const QString &extension : reader->extensions()) {
+            patterns << QString("*.%1").arg(extension);
+        }
+        allPatterns << patterns;
+        filters << QString("%1 (%2)").arg(reader->name()).arg(patterns.join(' '));
+    }
+    filters.prepend(QString("所有支持的文件 (%1)").arg(allPatterns.join(' ')));
+    filters << "所有文件 (*.*)";
+    return filters.join(";;");
+}
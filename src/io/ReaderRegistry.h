@@ -0,0 +1,73 @@
+#ifndef READERREGISTRY_H
+#define READERREGISTRY_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkDataObject.h>
+
+// 文件读取器插件接口：声明名称、扩展名与能力，并能根据文件开头内容判断格式
+class MeshReader
+{
+public:
+    // 能力标志
+    enum Capability {
+        Mesh = 0x01,            // 点与单元
+        PointResults = 0x02,    // 点结果数组
+        CellResults = 0x04,     // 单元结果数组
+        TimeSteps = 0x08,       // 多个载荷步/时间步，按 <名称>_t<序号> 命名
+        Parallel = 0x10,        // 多线程解析
+        SurfaceOnly = 0x20      // 纯几何表面（输出 vtkPolyData）
+    };
+
+    // sniff 的返回值
+    enum SniffResult {
+        NotMatched = 0,         // 确定不是本格式
+        Unknown = 1,            // 内容无法判断（如二进制 STL），仅凭扩展名
+        Matched = 2             // 内容确认是本格式
+    };
+
+    virtual ~MeshReader() {}
+
+    virtual QString name() const = 0;
+    // 小写扩展名，不含点
+    virtual QStringList extensions() const = 0;
+    virtual int capabilities() const = 0;
+    // head 为文件开头若干 KB
+    virtual SniffResult sniff(const QByteArray &head) const = 0;
+    // 输出 vtkUnstructuredGrid 或 vtkPolyData；失败返回空并给出原因
+    virtual vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) = 0;
+};
+
+// 读取器注册表：按内容嗅探和扩展名为文件选择读取器。
+// 内容确认的读取器优先于仅扩展名匹配的读取器，因此扩展名不规范的求解器文件也能打开
+class ReaderRegistry
+{
+public:
+    // 首次调用时注册内置读取器
+    static ReaderRegistry &instance();
+
+    void registerReader(std::unique_ptr<MeshReader> reader);
+    const std::vector<std::unique_ptr<MeshReader>> &readers() const { return m_readers; }
+
+    // 找不到合适的读取器时返回空
+    MeshReader *findReader(const QString &fileName) const;
+
+    // 选择读取器并读取
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error = nullptr) const;
+
+    // 打开文件对话框的过滤器："所有支持的文件" + 每个读取器一项
+    QString fileDialogFilter() const;
+
+private:
+    ReaderRegistry();
+
+    std::vector<std::unique_ptr<MeshReader>> m_readers;
+};
+
+#endif // READERREGISTRY_H
@@ -0,0 +1,403 @@
+#include "ResultWatcher.h"
+#include "ReaderRegistry.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QRegularExpression>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrent>
+#include <vtkSMPTools.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetAttributes.h>
+#include <vtkFieldData.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// 求解器写文件时会连续触发多次通知，大小与修改时间在该间隔内不再变化才读取
+const int SETTLE_MS = 1000;
+// 哈希与比较的分块大小（值个数）；固定大小使哈希结果与线程数无关
+const vtkIdType HASH_BLOCK = 1 << 16;
+const quint64 FNV_OFFSET = 0xcbf29ce484222325ULL;
+const quint64 FNV_PRIME = 0x100000001b3ULL;
+
+inline quint64 combine(quint64 hash, quint64 value)
+{
+    return (hash ^ value) * FNV_PRIME;
+}
+
+// 各值转为 64 位整数后分块哈希，32 位与 64 位存储的同一连接数组哈希相同
+quint64 hashValues(vtkDataArray *array)
+{
+    if (!array) {
+        return 0;
+    }
+    const vtkIdType count = array->GetNumberOfValues();
+    const vtkIdType blocks = (count + HASH_BLOCK - 1) / HASH_BLOCK;
+    std::vector<quint64> blockHashes(static_cast<size_t>(blocks));
+    switch (array->GetDataType()) {
+        vtkTemplateMacro(
+            const VTK_TT *values = static_cast<const VTK_TT *>(array->GetVoidPointer(0));
+            vtkSMPTools::For(0, blocks, [&](vtkIdType first, vtkIdType last) {
+                for (vtkIdType b = first; b < last; ++b) {
+                    quint64 hash = FNV_OFFSET;
+                    const vtkIdType end = std::min(count, (b + 1) * HASH_BLOCK);
+                    for (vtkIdType i = b * HASH_BLOCK; i < end; ++i) {
+                        hash = combine(hash, static_cast<quint64>(static_cast<long long>(values[i])));
+                    }
+                    blockHashes[b] = hash;
+                }
+            }));
+    default:
+        return 0;
+    }
+
+    quint64 hash = combine(FNV_OFFSET, static_cast<quint64>(count));
+    for (quint64 blockHash : blockHashes) {
+        hash = combine(hash, blockHash);
+    }
+    return hash;
+}
+
+// 类型、形状与内容完全相同（分块并行比较）
+bool sameArray(vtkDataArray *a, vtkDataArray *b)
+{
+    if (a == b) {
+        return true;
+    }
+    if (!a || !b || a->GetDataType() != b->GetDataType() || a->GetNumberOfComponents() != b->GetNumberOfComponents()
+        || a->GetNumberOfTuples() != b->GetNumberOfTuples()) {
+        return false;
+    }
+
+    const size_t valueSize = static_cast<size_t>(a->GetDataTypeSize());
+    const vtkIdType count = a->GetNumberOfValues();
+    const char *dataA = static_cast<const char *>(a->GetVoidPointer(0));
+    const char *dataB = static_cast<const char *>(b->GetVoidPointer(0));
+    std::atomic<bool> same(true);
+    vtkSMPTools::For(0, (count + HASH_BLOCK - 1) / HASH_BLOCK, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType block = first; block < last && same; ++block) {
+            const vtkIdType begin = block * HASH_BLOCK;
+            const size_t bytes = static_cast<size_t>(std::min(count, begin + HASH_BLOCK) - begin) * valueSize;
+            if (std::memcmp(dataA + begin * valueSize, dataB + begin * valueSize, bytes) != 0) {
+                same = false;
+            }
+        }
+    });
+    return same;
+}
+
+// incoming 中当前数据没有或内容不同的数组
+QStringList changedArrays(vtkFieldData *current, vtkFieldData *incoming)
+{
+    QStringList names;
+    for (int i = 0; i < incoming->GetNumberOfArrays(); ++i) {
+        vtkAbstractArray *array = incoming->GetAbstractArray(i);
+        if (!array || !array->GetName()) {
+            continue;
+        }
+        vtkDataArray *existing = current ? current->GetArray(array->GetName()) : nullptr;
+        if (!sameArray(existing, vtkDataArray::SafeDownCast(array))) {
+            names << QString::fromUtf8(array->GetName());
+        }
+    }
+    return names;
+}
+
+// 每步一个文件时：与当前数据相同的数组（节点号、单元号、不随时间变化的场）不再重复加入，
+// 其余数组按线探测时间序列的约定命名为 <名称>_t<步号>
+void renameTimeStepArrays(vtkFieldData *incoming, vtkFieldData *current, int step)
+{
+    static const QRegularExpression timeStepName("_t\\d+$");
+    for (int i = incoming->GetNumberOfArrays() - 1; i >= 0; --i) {
+        vtkAbstractArray *array = incoming->GetAbstractArray(i);
+        if (!array || !array->GetName()) {
+            continue;
+        }
+        const QString name = QString::fromUtf8(array->GetName());
+        vtkDataArray *existing = current ? current->GetArray(array->GetName()) : nullptr;
+        if (existing && sameArray(existing, vtkDataArray::SafeDownCast(array))) {
+            incoming->RemoveArray(i);
+        } else if (!timeStepName.match(name).hasMatch()) {
+            array->SetName(QString("%1_t%2").arg(name).arg(step).toUtf8().constData());
+        }
+    }
+}
+}
+
+ResultWatcher::ResultWatcher(QObject *parent)
+    : QObject(parent)
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_settleTimer(new QTimer(this))
+    , m_nextStep(1)
+    , m_reorderMethod(MeshReorderer::None)
+    , m_precisionMode(PrecisionReducer::Full)
+{
+    m_settleTimer->setSingleShot(true);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &ResultWatcher::onFileChanged);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &ResultWatcher::onDirectoryChanged);
+    connect(m_settleTimer, &QTimer::timeout, this, &ResultWatcher::onSettleTimeout);
+    connect(&m_future, &QFutureWatcher<Reload>::finished, this, [this]() {
+        // 读取期间已停止监视时丢弃结果
+        if (isWatching()) {
+            emit reloadReady(m_future.result());
+        }
+        startNext();
+    });
+}
+
+ResultWatcher::~ResultWatcher()
+{
+    m_future.waitForFinished();
+}
+
+void ResultWatcher::start(const QString &fileName)
+{
+    stop();
+    const QFileInfo info(fileName);
+    m_fileName = info.absoluteFilePath();
+    m_directory = info.absolutePath();
+    m_suffix = info.suffix().toLower();
+    m_nextStep = 1;
+    m_steps.insert(m_fileName, -1);
+
+    const QStringList entries = directoryEntries();
+    m_knownFiles = QSet<QString>(entries.begin(), entries.end());
+    m_watcher->addPath(m_fileName);
+    m_watcher->addPath(m_directory);
+    qDebug() << "ResultWatcher: 监视" << m_fileName << "及目录中新的 ." << m_suffix << "文件";
+}
+
+void ResultWatcher::stop()
+{
+    if (!m_watcher->files().isEmpty()) {
+        m_watcher->removePaths(m_watcher->files());
+    }
+    if (!m_watcher->directories().isEmpty()) {
+        m_watcher->removePaths(m_watcher->directories());
+    }
+    m_settleTimer->stop();
+    m_fileName.clear();
+    m_directory.clear();
+    m_knownFiles.clear();
+    m_steps.clear();
+    m_pending.clear();
+    m_queue.clear();
+}
+
+ResultWatcher::Stamp ResultWatcher::stamp(const QString &path)
+{
+    const QFileInfo info(path);
+    return info.exists() ? Stamp(info.size(), info.lastModified().toMSecsSinceEpoch()) : Stamp(-1, -1);
+}
+
+QStringList ResultWatcher::directoryEntries() const
+{
+    QStringList entries;
+    const QFileInfoList infos = QDir(m_directory).entryInfoList(QStringList() << "*." + m_suffix, QDir::Files);
+    for (const QFileInfo &info : infos) {
+        entries << info.absoluteFilePath();
+    }
+    return entries;
+}
+
+int ResultWatcher::stepFromName(const QString &path)
+{
+    // result_0012.vtu -> 12；没有数字时按出现顺序编号
+    static const QRegularExpression trailingNumber("(\\d+)$");
+    const QRegularExpressionMatch match = trailingNumber.match(QFileInfo(path).completeBaseName());
+    return match.hasMatch() ? match.captured(1).toInt() : m_nextStep++;
+}
+
+void ResultWatcher::onFileChanged(const QString &path)
+{
+    // 先删除再改名写入的文件会从监视列表中移除，需要重新加入
+    if (QFileInfo::exists(path) && !m_watcher->files().contains(path)) {
+        m_watcher->addPath(path);
+    }
+    schedule(path);
+}
+
+void ResultWatcher::onDirectoryChanged(const QString &path)
+{
+    Q_UNUSED(path);
+    for (const QString &entry : directoryEntries()) {
+        if (m_knownFiles.contains(entry)) {
+            continue;
+        }
+        m_knownFiles.insert(entry);
+        m_steps.insert(entry, stepFromName(entry));
+        m_watcher->addPath(entry);
+        schedule(entry);
+    }
+}
+
+void ResultWatcher::schedule(const QString &path)
+{
+    if (!m_steps.contains(path)) {
+        return;
+    }
+    m_pending.insert(path, stamp(path));
+    m_settleTimer->start(SETTLE_MS);
+}
+
+void ResultWatcher::onSettleTimeout()
+{
+    bool waiting = false;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        const Stamp current = stamp(it.key());
+        if (current.first < 0) {
+            it = m_pending.erase(it);
+        } else if (current != it.value()) {
+            // 仍在写入
+            it.value() = current;
+            waiting = true;
+            ++it;
+        } else {
+            if (!m_queue.contains(it.key())) {
+                m_queue << it.key();
+            }
+            it = m_pending.erase(it);
+        }
+    }
+    if (waiting) {
+        m_settleTimer->start(SETTLE_MS);
+    }
+    startNext();
+}
+
+void ResultWatcher::startNext()
+{
+    if (m_future.isRunning() || m_queue.isEmpty() || !isWatching()) {
+        return;
+    }
+
+    const QString fileName = m_queue.takeFirst();
+    const int step = m_steps.value(fileName, -1);
+    // 快照只复制数组引用；界面线程之后对当前数据集增删数组不影响后台比较
+    vtkSmartPointer<vtkUnstructuredGrid> snapshot;
+    if (m_currentData) {
+        snapshot = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        snapshot->ShallowCopy(m_currentData);
+    }
+    const MeshReorderer::Method reorderMethod = m_reorderMethod;
+    const PrecisionReducer::Mode precisionMode = m_precisionMode;
+    const QStringList fullPrecisionArrays = m_fullPrecisionArrays;
+    m_future.setFuture(QtConcurrent::run([fileName, step, snapshot, reorderMethod, precisionMode, fullPrecisionArrays]() {
+        return load(fileName, step, snapshot, reorderMethod, precisionMode, fullPrecisionArrays);
+    }));
+}
+
+ResultWatcher::Reload ResultWatcher::load(const QString &fileName, int step, vtkSmartPointer<vtkUnstructuredGrid> snapshot,
+                                          MeshReorderer::Method reorderMethod, PrecisionReducer::Mode precisionMode,
+                                          const QStringList &fullPrecisionArrays)
+{
+    TRACE_SCOPE("ResultWatcher::load", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    Reload reload;
+    reload.fileName = fileName;
+    reload.step = step;
+    QString error;
+    reload.data = vtkUnstructuredGrid::SafeDownCast(ReaderRegistry::instance().read(fileName, &error));
+    if (!reload.data) {
+        reload.error = error.isEmpty() ? QString("不是非结构网格") : error;
+        return reload;
+    }
+
+    // 当前数据集加载时重排过：同一网格沿用其记录的顺序，拓扑哈希才可比；网格变化时按当前方式重排
+    if (!MeshReorderer::reorderLike(reload.data, snapshot)) {
+        MeshReorderer::reorder(reload.data, reorderMethod);
+    }
+    reload.topologyChanged = !snapshot || topologyHash(snapshot) != topologyHash(reload.data);
+    // 只有并入当前网格的新时间步才按 <名称>_t<步号> 命名；网格变化时整体替换数据集，按普通重新加载处理
+    const bool mergeStep = step >= 0 && !reload.topologyChanged;
+
+    // 与当前数据集相同的降精度转换在比较之前完成，未变化的数组转换后仍逐字节相同；
+    // 新时间步的数组供线探测时间序列使用，与打开文件时一样不量化
+    if (mergeStep && precisionMode == PrecisionReducer::Quantized16) {
+        precisionMode = PrecisionReducer::Float32;
+    }
+    PrecisionReducer::reduce(reload.data, precisionMode, fullPrecisionArrays);
+
+    if (mergeStep) {
+        renameTimeStepArrays(reload.data->GetPointData(), snapshot->GetPointData(), step);
+        renameTimeStepArrays(reload.data->GetCellData(), snapshot->GetCellData(), step);
+        renameTimeStepArrays(reload.data->GetFieldData(), snapshot->GetFieldData(), step);
+    }
+
+    if (!reload.topologyChanged) {
+        reload.pointsChanged = !snapshot->GetPoints() || !reload.data->GetPoints()
+            || !sameArray(snapshot->GetPoints()->GetData(), reload.data->GetPoints()->GetData());
+        reload.pointArrays = changedArrays(snapshot->GetPointData(), reload.data->GetPointData());
+        reload.cellArrays = changedArrays(snapshot->GetCellData(), reload.data->GetCellData());
+        reload.fieldArrays = changedArrays(snapshot->GetFieldData(), reload.data->GetFieldData());
+    }
+    reload.readMs = timer.elapsed();
+
+    qDebug() << "ResultWatcher: 重新读取" << fileName << "拓扑变化:" << reload.topologyChanged
+             << "点坐标变化:" << reload.pointsChanged << "点数组:" << reload.pointArrays
+             << "单元数组:" << reload.cellArrays << "量化数组:" << reload.fieldArrays << "耗时(ms):" << reload.readMs;
+    return reload;
+}
+
+quint64 ResultWatcher::topologyHash(vtkUnstructuredGrid *grid)
+{
+    quint64 hash = combine(FNV_OFFSET, static_cast<quint64>(grid->GetNumberOfPoints()));
+    hash = combine(hash, static_cast<quint64>(grid->GetNumberOfCells()));
+    if (vtkCellArray *cells = grid->GetCells()) {
+        hash = combine(hash, hashValues(cells->GetOffsetsArray()));
+        hash = combine(hash, hashValues(cells->GetConnectivityArray()));
+    }
+    return combine(hash, hashValues(grid->GetCellTypesArray()));
+}
+
+int ResultWatcher::merge(vtkUnstructuredGrid *current, const Reload &reload)
+{
+    if (!current || !reload.data || reload.topologyChanged) {
+        return 0;
+    }
+
+    int updated = 0;
+    if (reload.pointsChanged && reload.data->GetPoints()) {
+        // 换用新的 vtkPoints，不修改可能仍被后台任务引用的旧对象
+        vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+        points->SetData(reload.data->GetPoints()->GetData());
+        current->SetPoints(points);
+        ++updated;
+    }
+    for (const QString &name : reload.pointArrays) {
+        if (vtkAbstractArray *array = reload.data->GetPointData()->GetAbstractArray(name.toUtf8().constData())) {
+            current->GetPointData()->AddArray(array);
+            ++updated;
+        }
+    }
+    for (const QString &name : reload.cellArrays) {
+        if (vtkAbstractArray *array = reload.data->GetCellData()->GetAbstractArray(name.toUtf8().constData())) {
+            current->GetCellData()->AddArray(array);
+            ++updated;
+        }
+    }
+    for (const QString &name : reload.fieldArrays) {
+        if (vtkAbstractArray *array = reload.data->GetFieldData()->GetAbstractArray(name.toUtf8().constData())) {
+            current->GetFieldData()->AddArray(array);
+            ++updated;
+        }
+    }
+    if (updated > 0) {
+        current->Modified();
+    }
+    return updated;
+}
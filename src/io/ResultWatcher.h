@@ -0,0 +1,109 @@
+#ifndef RESULTWATCHER_H
+#define RESULTWATCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QFutureWatcher>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include "core/MeshReorderer.h"
+#include "core/PrecisionReducer.h"
+
+class QFileSystemWatcher;
+class QTimer;
+
+// 求解器结果文件监视：监视当前文件与其所在目录，文件被重写或目录中出现同扩展名的新文件
+// （每步一个文件的输出）时，待文件大小与修改时间稳定后在后台线程重新读取，
+// 并与当前数据集的浅拷贝快照比较：拓扑哈希（点数、单元类型、偏移与连接）不变时
+// 只列出新增或内容有变化的数组，由 merge 合并进当前数据集，拓扑变化时才整体替换
+class ResultWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 一次后台重读的结果
+    struct Reload
+    {
+        QString fileName;
+        int step = -1;                          // 新时间步文件的步号（文件名末尾的数字）；重写的当前文件为 -1
+        vtkSmartPointer<vtkUnstructuredGrid> data;
+        QString error;
+        bool topologyChanged = false;           // 网格变化：data 整体替换当前数据集，数组保持原名（时间步文件也不改名）
+        bool pointsChanged = false;
+        QStringList pointArrays;                // 新增或有变化的点/单元数组（新时间步已命名为 <名称>_t<步号>）
+        QStringList cellArrays;
+        QStringList fieldArrays;                // 降精度加载时 FieldData 中新增或有变化的量化数组
+        qint64 readMs = 0;
+    };
+
+    explicit ResultWatcher(QObject *parent = nullptr);
+    ~ResultWatcher();
+
+    // 开始监视 fileName 及其目录；再次调用时改为监视新文件
+    void start(const QString &fileName);
+    void stop();
+    bool isWatching() const { return !m_fileName.isEmpty(); }
+
+    // 当前显示的数据集，每次重读开始时在界面线程对其做浅拷贝快照用于比较
+    void setCurrentData(vtkUnstructuredGrid *data) { m_currentData = data; }
+
+    // 重新读取的网格与当前数据集拓扑不同时使用的重排方式，应与加载时一致
+    void setReorderMethod(MeshReorderer::Method method) { m_reorderMethod = method; }
+
+    // 重新读取的数据按当前数据集加载时的精度模式转换，转换结果确定，数组比较仍然有效
+    void setPrecisionMode(PrecisionReducer::Mode mode, const QStringList &fullPrecisionArrays = QStringList())
+    {
+        m_precisionMode = mode;
+        m_fullPrecisionArrays = fullPrecisionArrays;
+    }
+
+    // 拓扑哈希：点数、单元类型、偏移与连接数组按固定大小分块并行计算，结果与线程数无关
+    static quint64 topologyHash(vtkUnstructuredGrid *grid);
+
+    // 拓扑未变时把 reload 中列出的数组与点坐标并入 current，返回更新的数组个数（含点坐标）
+    static int merge(vtkUnstructuredGrid *current, const Reload &reload);
+
+signals:
+    void reloadReady(const ResultWatcher::Reload &reload);
+
+private slots:
+    void onFileChanged(const QString &path);
+    void onDirectoryChanged(const QString &path);
+    void onSettleTimeout();
+
+private:
+    typedef QPair<qint64, qint64> Stamp;    // 大小与修改时间
+
+    static Stamp stamp(const QString &path);
+    static Reload load(const QString &fileName, int step, vtkSmartPointer<vtkUnstructuredGrid> snapshot,
+                       MeshReorderer::Method reorderMethod, PrecisionReducer::Mode precisionMode,
+                       const QStringList &fullPrecisionArrays);
+    QStringList directoryEntries() const;
+    int stepFromName(const QString &path);
+    void schedule(const QString &path);
+    void startNext();
+
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_settleTimer;
+    QFutureWatcher<Reload> m_future;
+    QString m_fileName;
+    QString m_directory;
+    QString m_suffix;
+    QSet<QString> m_knownFiles;
+    QHash<QString, int> m_steps;
+    QHash<QString, Stamp> m_pending;
+    QStringList m_queue;
+    int m_nextStep;
+    MeshReorderer::Method m_reorderMethod;
+    PrecisionReducer::Mode m_precisionMode;
+    QStringList m_fullPrecisionArrays;
+    vtkSmartPointer<vtkUnstructuredGrid> m_currentData;
+};
+
+#endif // RESULTWATCHER_H
@@ -0,0 +1,313 @@
+#ifndef TEXTPARSING_H
+#define TEXTPARSING_H
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <vtkSMPTools.h>
+#include <vtkType.h>
+
+// 文本网格/结果文件的并行解析工具，供各格式读取器共用：
+// 内存映射的缓冲区按行边界切块，各块在 vtkSMPTools 线程池上先计数、再用 std::from_chars
+// 直接解析到预分配的输出位置
+namespace TextParsing
+{
+// 过小的块调度开销大于解析本身
+const size_t MIN_CHUNK_BYTES = 1 << 20;
+
+struct Chunk
+{
+    const char *begin;
+    const char *end;
+    vtkIdType offset;
+    vtkIdType count;
+};
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// 数值之间的分隔符：空白与逗号（INP、自由格式 BDF）
+inline bool isSeparator(char c)
+{
+    return isSpace(c) || c == ',';
+}
+
+// 下一行的行首（没有换行时为 end）
+inline const char *nextLine(const char *p, const char *end)
+{
+    const void *newline = std::memchr(p, '\n', end - p);
+    return newline ? static_cast<const char *>(newline) + 1 : end;
+}
+
+// 本行行尾（不含换行符）
+inline const char *lineEnd(const char *p, const char *end)
+{
+    const void *newline = std::memchr(p, '\n', end - p);
+    const char *stop = newline ? static_cast<const char *>(newline) : end;
+    while (stop > p && stop[-1] == '\r') {
+        --stop;
+    }
+    return stop;
+}
+
+// 按行边界切块；canSplitBefore 非空时只在它认可的行首切分，使多行记录不被拆开
+inline std::vector<Chunk> splitChunks(const char *begin, const char *end,
+                                      const std::function<bool(const char *)> &canSplitBefore = nullptr)
+{
+    const size_t length = static_cast<size_t>(end - begin);
+    const size_t maxChunks = static_cast<size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads())) * 4;
+    const size_t chunkCount = std::max<size_t>(1, std::min(length / MIN_CHUNK_BYTES, maxChunks));
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunkCount);
+    const char *start = begin;
+    for (size_t i = 1; i <= chunkCount && start < end; ++i) {
+        const char *stop = end;
+        if (i < chunkCount) {
+            stop = nextLine(std::max(start, begin + length / chunkCount * i), end);
+            while (canSplitBefore && stop < end && !canSplitBefore(stop)) {
+                stop = nextLine(stop, end);
+            }
+        }
+        if (stop > start) {
+            chunks.push_back({start, stop, 0, 0});
+        }
+        start = stop;
+    }
+    return chunks;
+}
+
+// 跳过分隔符与注释行（行首为 comment 的行），返回下一个记号的起点
+inline const char *skipSeparators(const char *p, const char *chunkBegin, const char *end, char comment)
+{
+    while (p < end) {
+        if (isSeparator(*p)) {
+            ++p;
+        } else if (comment && *p == comment && (p == chunkBegin || p[-1] == '\n')) {
+            p = nextLine(p, end);
+        } else {
+            break;
+        }
+    }
+    return p;
+}
+
+inline vtkIdType countTokens(const char *begin, const char *end, char comment)
+{
+    vtkIdType count = 0;
+    const char *p = skipSeparators(begin, begin, end, comment);
+    while (p < end) {
+        ++count;
+        while (p < end && !isSeparator(*p)) {
+            ++p;
+        }
+        p = skipSeparators(p, begin, end, comment);
+    }
+    return count;
+}
+
+// 超出 float 范围（如 1e-50）时 from_chars 报错，按 strtod 取 0 或无穷
+template <typename T>
+inline T outOfRangeValue(const char *begin, const char *end)
+{
+    char buffer[64];
+    const size_t length = std::min(static_cast<size_t>(end - begin), sizeof(buffer) - 1);
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+    return static_cast<T>(std::strtod(buffer, nullptr));
+}
+
+// 解析一个以分隔符结束的数值，返回数值之后的位置；格式错误返回空
+template <typename T>
+inline const char *parseValue(const char *p, const char *end, T &value)
+{
+    if (*p == '+') {
+        ++p;
+    }
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if constexpr (std::is_floating_point<T>::value) {
+        if (result.ec == std::errc::result_out_of_range) {
+            const char *stop = p;
+            while (stop < end && !isSeparator(*stop)) {
+                ++stop;
+            }
+            value = outOfRangeValue<T>(p, stop);
+            result.ptr = stop;
+            result.ec = std::errc();
+        }
+    }
+    if (result.ec != std::errc() || (result.ptr != end && !isSeparator(*result.ptr))) {
+        return nullptr;
+    }
+    return result.ptr;
+}
+
+// 定宽字段（FRD、小字段 BDF）：去掉两端空白后整体解析，空字段或格式错误返回 false
+template <typename T>
+inline bool parseField(const char *begin, const char *end, T &value)
+{
+    while (begin < end && isSpace(*begin)) {
+        ++begin;
+    }
+    while (end > begin && isSpace(end[-1])) {
+        --end;
+    }
+    if (begin < end && *begin == '+') {
+        ++begin;
+    }
+    if (begin == end) {
+        return false;
+    }
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    if constexpr (std::is_floating_point<T>::value) {
+        if (result.ec == std::errc::result_out_of_range) {
+            value = outOfRangeValue<T>(begin, end);
+            return true;
+        }
+    }
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+template <typename T>
+bool parseChunk(const Chunk &chunk, T *out, char comment)
+{
+    const char *p = chunk.begin;
+    for (vtkIdType i = 0; i < chunk.count; ++i) {
+        p = skipSeparators(p, chunk.begin, chunk.end, comment);
+        p = parseValue(p, chunk.end, out[i]);
+        if (!p) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 两遍并行：先统计每块的数值个数得到写入偏移，再各块直接解析到 out 的对应位置。
+// expected 为 -1 时不检查总数；返回数值总数，格式错误或数量不符返回 -1
+template <typename T>
+vtkIdType parseTokens(const char *begin, const char *end, T *out, vtkIdType expected, char comment = '\0')
+{
+    std::vector<Chunk> chunks = splitChunks(begin, end);
+    const vtkIdType chunkCount = static_cast<vtkIdType>(chunks.size());
+
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            chunks[i].count = countTokens(chunks[i].begin, chunks[i].end, comment);
+        }
+    });
+
+    vtkIdType total = 0;
+    for (Chunk &chunk : chunks) {
+        chunk.offset = total;
+        total += chunk.count;
+    }
+    if (expected >= 0 && total != expected) {
+        return -1;
+    }
+
+    std::atomic<bool> ok(true);
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last && ok; ++i) {
+            if (!parseChunk(chunks[i], out + chunks[i].offset, comment)) {
+                ok = false;
+            }
+        }
+    });
+    return ok ? total : -1;
+}
+
+// 数值个数事先未知时：计数后分配 out 再解析
+template <typename T>
+bool parseTokens(const char *begin, const char *end, std::vector<T> &out, char comment = '\0')
+{
+    std::vector<Chunk> chunks = splitChunks(begin, end);
+    const vtkIdType chunkCount = static_cast<vtkIdType>(chunks.size());
+
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last; ++i) {
+            chunks[i].count = countTokens(chunks[i].begin, chunks[i].end, comment);
+        }
+    });
+
+    vtkIdType total = 0;
+    for (Chunk &chunk : chunks) {
+        chunk.offset = total;
+        total += chunk.count;
+    }
+    out.resize(static_cast<size_t>(total));
+
+    std::atomic<bool> ok(true);
+    vtkSMPTools::For(0, chunkCount, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType i = first; i < last && ok; ++i) {
+            if (!parseChunk(chunks[i], out.data() + chunks[i].offset, comment)) {
+                ok = false;
+            }
+        }
+    });
+    return ok;
+}
+
+// 原始编号（节点号、单元号）到连续索引的映射：编号较密时用数组，否则用哈希表
+class IdIndex
+{
+public:
+    void build(const vtkIdType *ids, vtkIdType count, vtkIdType indexOffset = 0)
+    {
+        m_dense.clear();
+        m_sparse.clear();
+        m_minId = 0;
+        if (count <= 0) {
+            return;
+        }
+
+        vtkIdType minId = ids[0];
+        vtkIdType maxId = ids[0];
+        for (vtkIdType i = 1; i < count; ++i) {
+            minId = std::min(minId, ids[i]);
+            maxId = std::max(maxId, ids[i]);
+        }
+
+        m_minId = minId;
+        m_useDense = maxId - minId < 4 * count + 1024;
+        if (m_useDense) {
+            m_dense.assign(static_cast<size_t>(maxId - minId + 1), -1);
+            for (vtkIdType i = 0; i < count; ++i) {
+                m_dense[ids[i] - minId] = indexOffset + i;
+            }
+        } else {
+            m_sparse.reserve(static_cast<size_t>(count));
+            for (vtkIdType i = 0; i < count; ++i) {
+                m_sparse[ids[i]] = indexOffset + i;
+            }
+        }
+    }
+
+    // 未找到返回 -1；只读，可在多个线程中同时调用
+    vtkIdType find(vtkIdType id) const
+    {
+        if (m_useDense) {
+            const vtkIdType slot = id - m_minId;
+            return slot >= 0 && slot < static_cast<vtkIdType>(m_dense.size()) ? m_dense[slot] : -1;
+        }
+        auto it = m_sparse.find(id);
+        return it != m_sparse.end() ? it->second : -1;
+    }
+
+private:
+    vtkIdType m_minId = 0;
+    bool m_useDense = true;
+    std::vector<vtkIdType> m_dense;
+    std::unordered_map<vtkIdType, vtkIdType> m_sparse;
+};
+}
+
+#endif // TEXTPARSING_H
@@ -0,0 +1,101 @@
+#include "VTKReaders.h"
+#include "LegacyVTKParser.h"
+#include "VTUParser.h"
+#include <QDebug>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+#include <vtkXMLUnstructuredGridReader.h>
+#include <vtkUnstructuredGridReader.h>
+#include <vtkSTLReader.h>
+#include <vtkOBJReader.h>
+#include <vtkPLYReader.h>
+
+namespace
+{
+// 浅拷贝出数据后释放读取器，不再保留读取器自身的输出与缓冲
+template <typename Reader>
+vtkSmartPointer<vtkDataObject> readWith(const QString &fileName, const char *formatName, QString *error)
+{
+    vtkSmartPointer<Reader> reader = vtkSmartPointer<Reader>::New();
+    reader->SetFileName(fileName.toStdString().c_str());
+    reader->Update();
+
+    auto *output = reader->GetOutput();
+    if (!output || output->GetNumberOfCells() == 0) {
+        if (error) {
+            *error = QString("无法读取%1文件或文件为空").arg(formatName);
+        }
+        return nullptr;
+    }
+    vtkSmartPointer<vtkDataObject> data = vtkSmartPointer<vtkDataObject>::Take(output->NewInstance());
+    data->ShallowCopy(output);
+    return data;
+}
+}
+
+MeshReader::SniffResult VtuReader::sniff(const QByteArray &head) const
+{
+    return head.contains("<VTKFile") && head.contains("UnstructuredGrid") ? Matched : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> VtuReader::read(const QString &fileName, QString *error)
+{
+    QString parseError;
+    vtkSmartPointer<vtkUnstructuredGrid> parsed = VTUParser::read(fileName, &parseError);
+    if (parsed && parsed->GetNumberOfCells() > 0) {
+        return parsed;
+    }
+    qDebug() << "VTUParser: 改用 vtkXMLUnstructuredGridReader:" << parseError;
+    return readWith<vtkXMLUnstructuredGridReader>(fileName, "VTU", error);
+}
+
+MeshReader::SniffResult LegacyVtkReader::sniff(const QByteArray &head) const
+{
+    if (!head.startsWith("# vtk DataFile")) {
+        return NotMatched;
+    }
+    return head.contains("UNSTRUCTURED_GRID") ? Matched : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> LegacyVtkReader::read(const QString &fileName, QString *error)
+{
+    QString parseError;
+    vtkSmartPointer<vtkUnstructuredGrid> parsed = LegacyVTKParser::read(fileName, &parseError);
+    if (parsed && parsed->GetNumberOfCells() > 0) {
+        return parsed;
+    }
+    qDebug() << "LegacyVTKParser: 改用 vtkUnstructuredGridReader:" << parseError;
+    return readWith<vtkUnstructuredGridReader>(fileName, "VTK", error);
+}
+
+MeshReader::SniffResult StlReader::sniff(const QByteArray &head) const
+{
+    // 二进制 STL 没有固定文件头，只能依据扩展名
+    return head.startsWith("solid") ? Matched : Unknown;
+}
+
+vtkSmartPointer<vtkDataObject> StlReader::read(const QString &fileName, QString *error)
+{
+    return readWith<vtkSTLReader>(fileName, "STL", error);
+}
+
+MeshReader::SniffResult ObjReader::sniff(const QByteArray &head) const
+{
+    Q_UNUSED(head);
+    return Unknown;
+}
+
+vtkSmartPointer<vtkDataObject> ObjReader::read(const QString &fileName, QString *error)
+{
+    return readWith<vtkOBJReader>(fileName, "OBJ", error);
+}
+
+MeshReader::SniffResult PlyReader::sniff(const QByteArray &head) const
+{
+    return head.startsWith("ply") ? Matched : NotMatched;
+}
+
+vtkSmartPointer<vtkDataObject> PlyReader::read(const QString &fileName, QString *error)
+{
+    return readWith<vtkPLYReader>(fileName, "PLY", error);
+}
@@ -0,0 +1,61 @@
+#ifndef VTKREADERS_H
+#define VTKREADERS_H
+
+#include "ReaderRegistry.h"
+
+// VTK 自带格式的读取器插件
+
+// VTK XML 非结构网格 (.vtu)：用 VTUParser 并行解码，不支持的内容回退到 vtkXMLUnstructuredGridReader
+class VtuReader : public MeshReader
+{
+public:
+    QString name() const override { return "VTK XML非结构网格"; }
+    QStringList extensions() const override { return QStringList() << "vtu"; }
+    int capabilities() const override { return Mesh | PointResults | CellResults | Parallel; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+// VTK 旧版格式 (.vtk)：ASCII 用 LegacyVTKParser 并行解析，其余回退到 vtkUnstructuredGridReader
+class LegacyVtkReader : public MeshReader
+{
+public:
+    QString name() const override { return "VTK旧版格式"; }
+    QStringList extensions() const override { return QStringList() << "vtk"; }
+    int capabilities() const override { return Mesh | PointResults | CellResults | Parallel; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+// STL（ASCII 与二进制）
+class StlReader : public MeshReader
+{
+public:
+    QString name() const override { return "STL文件"; }
+    QStringList extensions() const override { return QStringList() << "stl"; }
+    int capabilities() const override { return SurfaceOnly; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+class ObjReader : public MeshReader
+{
+public:
+    QString name() const override { return "OBJ文件"; }
+    QStringList extensions() const override { return QStringList() << "obj"; }
+    int capabilities() const override { return SurfaceOnly; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+class PlyReader : public MeshReader
+{
+public:
+    QString name() const override { return "PLY文件"; }
+    QStringList extensions() const override { return QStringList() << "ply"; }
+    int capabilities() const override { return SurfaceOnly; }
+    SniffResult sniff(const QByteArray &head) const override;
+    vtkSmartPointer<vtkDataObject> read(const QString &fileName, QString *error) override;
+};
+
+#endif // VTKREADERS_H
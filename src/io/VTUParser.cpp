@@ -0,0 +1,875 @@
+#include "VTUParser.h"
+#include "TextParsing.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+#include <vtkSMPTools.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkDataArray.h>
+#include <vtkDataSetAttributes.h>
+#include <vtkFieldData.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkDataCompressor.h>
+#include <vtkZLibDataCompressor.h>
+#include <vtkLZ4DataCompressor.h>
+#include <vtkLZMADataCompressor.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using TextParsing::isSpace;
+
+namespace
+{
+// 并行任务的粒度：base64 按 4 字符对齐分段，未压缩的原始数据按段拷贝
+const size_t BASE64_PIECE_CHARS = size_t(4) << 20;
+const size_t COPY_PIECE_BYTES = size_t(4) << 20;
+
+struct Base64Table
+{
+    signed char values[256];
+
+    constexpr Base64Table() : values()
+    {
+        for (int i = 0; i < 256; ++i) {
+            values[i] = -1;
+        }
+        for (int i = 0; i < 26; ++i) {
+            values['A' + i] = static_cast<signed char>(i);
+            values['a' + i] = static_cast<signed char>(26 + i);
+        }
+        for (int i = 0; i < 10; ++i) {
+            values['0' + i] = static_cast<signed char>(52 + i);
+        }
+        values[static_cast<int>('+')] = 62;
+        values[static_cast<int>('/')] = 63;
+    }
+};
+
+constexpr Base64Table BASE64;
+
+inline size_t base64Chars(size_t bytes)
+{
+    return (bytes + 2) / 3 * 4;
+}
+
+// chars 为 4 的倍数，'=' 填充只出现在最后一组；返回写入的字节数，非法字符或超出 capacity 返回 -1
+long long decodeBase64(const char *text, size_t chars, unsigned char *out, size_t capacity)
+{
+    size_t written = 0;
+    for (size_t i = 0; i + 4 <= chars; i += 4) {
+        const unsigned char *q = reinterpret_cast<const unsigned char *>(text + i);
+        const int a = BASE64.values[q[0]];
+        const int b = BASE64.values[q[1]];
+        const int c = q[2] == '=' ? 0 : BASE64.values[q[2]];
+        const int d = q[3] == '=' ? 0 : BASE64.values[q[3]];
+        if (a < 0 || b < 0 || c < 0 || d < 0) {
+            return -1;
+        }
+        const size_t bytes = q[2] == '=' ? 1 : (q[3] == '=' ? 2 : 3);
+        if (written + bytes > capacity) {
+            return -1;
+        }
+        const unsigned value = (unsigned(a) << 18) | (unsigned(b) << 12) | (unsigned(c) << 6) | unsigned(d);
+        out[written] = static_cast<unsigned char>(value >> 16);
+        if (bytes > 1) {
+            out[written + 1] = static_cast<unsigned char>(value >> 8);
+        }
+        if (bytes > 2) {
+            out[written + 2] = static_cast<unsigned char>(value);
+        }
+        written += bytes;
+    }
+    return static_cast<long long>(written);
+}
+
+const char *findText(const char *p, const char *end, const char *text)
+{
+    const char *found = std::search(p, end, text, text + std::strlen(text));
+    return found == end ? nullptr : found;
+}
+
+QByteArray unescape(QByteArray value)
+{
+    if (value.contains('&')) {
+        value.replace("&lt;", "<").replace("&gt;", ">").replace("&quot;", "\"").replace("&apos;", "'").replace("&amp;", "&");
+    }
+    return value;
+}
+
+struct Tag
+{
+    QByteArray name;
+    bool closing = false;
+    bool selfClosing = false;
+    QHash<QByteArray, QByteArray> attributes;
+};
+
+// 读取 p 之后的下一个标签（跳过声明与注释），返回标签后的位置；没有标签或格式错误返回空
+const char *nextTag(const char *p, const char *end, Tag &tag)
+{
+    tag = Tag();
+    while (true) {
+        p = static_cast<const char *>(std::memchr(p, '<', end - p));
+        if (!p) {
+            return nullptr;
+        }
+        if (end - p >= 4 && std::memcmp(p, "<!--", 4) == 0) {
+            p = findText(p + 4, end, "-->");
+        } else if (end - p >= 2 && p[1] == '?') {
+            p = findText(p + 2, end, "?>");
+        } else {
+            break;
+        }
+        if (!p) {
+            return nullptr;
+        }
+    }
+
+    ++p;
+    if (p < end && *p == '/') {
+        tag.closing = true;
+        ++p;
+    }
+    const char *nameBegin = p;
+    while (p < end && !isSpace(*p) && *p != '/' && *p != '>') {
+        ++p;
+    }
+    tag.name = QByteArray(nameBegin, static_cast<int>(p - nameBegin));
+
+    while (p < end) {
+        while (p < end && isSpace(*p)) {
+            ++p;
+        }
+        if (p >= end) {
+            return nullptr;
+        }
+        if (*p == '>') {
+            return p + 1;
+        }
+        if (*p == '/') {
+            tag.selfClosing = true;
+            ++p;
+            continue;
+        }
+
+        const char *keyBegin = p;
+        while (p < end && *p != '=' && !isSpace(*p) && *p != '>' && *p != '/') {
+            ++p;
+        }
+        const QByteArray key(keyBegin, static_cast<int>(p - keyBegin));
+        while (p < end && isSpace(*p)) {
+            ++p;
+        }
+        if (p >= end || *p != '=') {
+            return nullptr;
+        }
+        ++p;
+        while (p < end && isSpace(*p)) {
+            ++p;
+        }
+        if (p >= end || (*p != '"' && *p != '\'')) {
+            return nullptr;
+        }
+        const char quote = *p++;
+        const char *valueBegin = p;
+        p = static_cast<const char *>(std::memchr(p, quote, end - p));
+        if (!p) {
+            return nullptr;
+        }
+        tag.attributes.insert(key, unescape(QByteArray(valueBegin, static_cast<int>(p - valueBegin))));
+        ++p;
+    }
+    return nullptr;
+}
+
+enum Section {
+    NO_SECTION,
+    POINT_DATA,
+    CELL_DATA,
+    FIELD_DATA,
+    POINTS,
+    CELLS
+};
+
+struct ArrayInfo
+{
+    Section section;
+    QByteArray name;
+    int dataType;
+    int components;
+    vtkIdType tuples;               // XML 中可确定的元组数，未知为 -1
+    bool idType;                    // IdType="1"：与 vtkXMLUnstructuredGridReader 一样读成 vtkIdTypeArray
+    QList<QByteArray> componentNames;
+    bool appended;
+    size_t offset;                  // 追加数据中的偏移
+    const char *text;               // 内联 base64 文本
+    const char *textEnd;
+    vtkSmartPointer<vtkDataArray> array;
+};
+
+int dataTypeFromName(const QByteArray &name)
+{
+    if (name == "Float32") return VTK_TYPE_FLOAT32;
+    if (name == "Float64") return VTK_TYPE_FLOAT64;
+    if (name == "Int8") return VTK_TYPE_INT8;
+    if (name == "UInt8") return VTK_TYPE_UINT8;
+    if (name == "Int16") return VTK_TYPE_INT16;
+    if (name == "UInt16") return VTK_TYPE_UINT16;
+    if (name == "Int32") return VTK_TYPE_INT32;
+    if (name == "UInt32") return VTK_TYPE_UINT32;
+    if (name == "Int64") return VTK_TYPE_INT64;
+    if (name == "UInt64") return VTK_TYPE_UINT64;
+    return -1;
+}
+
+// 与 vtkIdType 宽度相同的整数类型可直接解码进 vtkIdTypeArray（VTK_TYPE_INT64 即 VTK_LONG_LONG，不等于 VTK_ID_TYPE）
+bool isIdTypeSized(int dataType)
+{
+    return (dataType == VTK_TYPE_INT64 || dataType == VTK_TYPE_INT32)
+        && vtkDataArray::GetDataTypeSize(dataType) == static_cast<int>(sizeof(vtkIdType));
+}
+
+// DataArray 元素的内容：跳过 InformationKey 等子元素，深度 0 的文本为内联数据
+const char *readArrayContent(const char *p, const char *end, ArrayInfo &info)
+{
+    int depth = 0;
+    Tag tag;
+    while (p < end) {
+        const char *lt = static_cast<const char *>(std::memchr(p, '<', end - p));
+        if (!lt) {
+            return nullptr;
+        }
+        if (depth == 0) {
+            const char *textBegin = p;
+            const char *textEnd = lt;
+            while (textBegin < textEnd && isSpace(*textBegin)) {
+                ++textBegin;
+            }
+            while (textEnd > textBegin && isSpace(textEnd[-1])) {
+                --textEnd;
+            }
+            if (textBegin < textEnd) {
+                info.text = textBegin;
+                info.textEnd = textEnd;
+            }
+        }
+        p = nextTag(lt, end, tag);
+        if (!p) {
+            return nullptr;
+        }
+        if (tag.closing) {
+            if (depth == 0) {
+                return p;
+            }
+            --depth;
+        } else if (!tag.selfClosing) {
+            ++depth;
+        }
+    }
+    return nullptr;
+}
+
+vtkSmartPointer<vtkDataCompressor> createCompressor(const QByteArray &name)
+{
+    if (name == "vtkZLibDataCompressor") {
+        return vtkSmartPointer<vtkZLibDataCompressor>::New();
+    }
+    if (name == "vtkLZ4DataCompressor") {
+        return vtkSmartPointer<vtkLZ4DataCompressor>::New();
+    }
+    if (name == "vtkLZMADataCompressor") {
+        return vtkSmartPointer<vtkLZMADataCompressor>::New();
+    }
+    return nullptr;
+}
+
+// 所有数组的解码任务：先并行解 base64 段，再并行解压/拷贝各数据块
+class Decoder
+{
+public:
+    Decoder(int headerSize, const QByteArray &compressor, const char *appended, bool rawAppended, const char *end)
+        : m_headerSize(headerSize)
+        , m_compressor(compressor)
+        , m_appended(appended)
+        , m_rawAppended(rawAppended)
+        , m_end(end)
+    {
+    }
+
+    // 读取数组的数据头，按其中的字节数分配数组并登记解码任务
+    bool add(ArrayInfo &info)
+    {
+        const char *text = nullptr;
+        size_t textSize = 0;
+        const unsigned char *raw = nullptr;
+        if (info.appended) {
+            if (!m_appended || info.offset >= static_cast<size_t>(m_end - m_appended)) {
+                return false;
+            }
+            if (m_rawAppended) {
+                raw = reinterpret_cast<const unsigned char *>(m_appended + info.offset);
+            } else {
+                text = m_appended + info.offset;
+                textSize = static_cast<size_t>(m_end - text);
+            }
+        } else {
+            if (!info.text) {
+                return false;
+            }
+            text = info.text;
+            textSize = static_cast<size_t>(info.textEnd - info.text);
+            if (std::any_of(text, info.textEnd, isSpace)) {
+                // 分行的内联数据先去掉空白
+                m_texts.emplace_back();
+                std::string &compact = m_texts.back();
+                compact.reserve(textSize);
+                std::copy_if(text, info.textEnd, std::back_inserter(compact), [](char c) { return !isSpace(c); });
+                text = compact.data();
+                textSize = compact.size();
+            }
+        }
+        return m_compressor.isEmpty() ? addUncompressed(info, raw, text, textSize)
+                                      : addCompressed(info, raw, text, textSize);
+    }
+
+    bool run()
+    {
+        std::atomic<bool> ok(true);
+        vtkSMPTools::For(0, static_cast<vtkIdType>(m_pieces.size()), 1, [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType i = first; i < last; ++i) {
+                const Piece &piece = m_pieces[i];
+                if (decodeBase64(piece.text, piece.chars, piece.target, piece.bytes) != static_cast<long long>(piece.bytes)) {
+                    ok = false;
+                }
+            }
+        });
+        if (!ok) {
+            return false;
+        }
+
+        vtkSMPTools::For(0, static_cast<vtkIdType>(m_blocks.size()), [&](vtkIdType first, vtkIdType last) {
+            // 压缩器各线程各用一个实例
+            vtkSmartPointer<vtkDataCompressor> compressor;
+            for (vtkIdType i = first; i < last; ++i) {
+                const Block &block = m_blocks[i];
+                if (!block.compressed) {
+                    std::memcpy(block.target, block.source, block.targetSize);
+                    continue;
+                }
+                if (!compressor) {
+                    compressor = createCompressor(m_compressor);
+                }
+                if (compressor->Uncompress(block.source, block.sourceSize, block.target, block.targetSize) != block.targetSize) {
+                    ok = false;
+                }
+            }
+        });
+        return ok;
+    }
+
+    size_t blockCount() const { return m_blocks.size(); }
+
+private:
+    struct Piece
+    {
+        const char *text;
+        size_t chars;
+        unsigned char *target;
+        size_t bytes;
+    };
+
+    struct Block
+    {
+        const unsigned char *source;
+        size_t sourceSize;
+        unsigned char *target;
+        size_t targetSize;
+        bool compressed;
+    };
+
+    uint64_t headerWord(const unsigned char *p) const
+    {
+        if (m_headerSize == 8) {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    bool fits(const void *p, size_t bytes) const
+    {
+        const char *begin = static_cast<const char *>(p);
+        return begin <= m_end && bytes <= static_cast<size_t>(m_end - begin);
+    }
+
+    void addPieces(const char *text, size_t bytes, unsigned char *target)
+    {
+        const size_t chars = base64Chars(bytes);
+        for (size_t start = 0; start < chars; start += BASE64_PIECE_CHARS) {
+            const size_t pieceChars = std::min(BASE64_PIECE_CHARS, chars - start);
+            const size_t offset = start / 4 * 3;
+            m_pieces.push_back({text + start, pieceChars, target + offset, std::min(pieceChars / 4 * 3, bytes - offset)});
+        }
+    }
+
+    void addCopy(const unsigned char *source, size_t bytes, unsigned char *target)
+    {
+        for (size_t start = 0; start < bytes; start += COPY_PIECE_BYTES) {
+            const size_t size = std::min(COPY_PIECE_BYTES, bytes - start);
+            m_blocks.push_back({source + start, size, target + start, size, false});
+        }
+    }
+
+    unsigned char *buffer(size_t bytes)
+    {
+        m_buffers.emplace_back(bytes);
+        return m_buffers.back().data();
+    }
+
+    // 未压缩：[字节数][数据]；base64 时数据头通常单独编码（VTK 写出的方式），也兼容合在一起编码
+    bool addUncompressed(ArrayInfo &info, const unsigned char *raw, const char *text, size_t textSize)
+    {
+        if (raw) {
+            if (!fits(raw, m_headerSize)) {
+                return false;
+            }
+            const size_t bytes = headerWord(raw);
+            const unsigned char *data = raw + m_headerSize;
+            unsigned char *target = allocate(info, bytes);
+            if (!target || !fits(data, bytes)) {
+                return false;
+            }
+            addCopy(data, bytes, target);
+            return true;
+        }
+
+        const size_t headerChars = base64Chars(m_headerSize);
+        unsigned char header[16];
+        if (textSize < headerChars || decodeBase64(text, headerChars, header, sizeof(header)) < m_headerSize) {
+            return false;
+        }
+        const size_t bytes = headerWord(header);
+        unsigned char *target = allocate(info, bytes);
+        if (!target) {
+            return false;
+        }
+        if (text[headerChars - 1] == '=') {
+            if (base64Chars(bytes) > textSize - headerChars) {
+                return false;
+            }
+            addPieces(text + headerChars, bytes, target);
+        } else {
+            const size_t total = m_headerSize + bytes;
+            if (base64Chars(total) > textSize) {
+                return false;
+            }
+            unsigned char *decoded = buffer(total);
+            addPieces(text, total, decoded);
+            m_blocks.push_back({decoded + m_headerSize, bytes, target, bytes, false});
+        }
+        return true;
+    }
+
+    // 压缩：[块数][块大小][末块大小][各块压缩后大小...][压缩块...]，base64 时数据头单独编码
+    bool addCompressed(ArrayInfo &info, const unsigned char *raw, const char *text, size_t textSize)
+    {
+        std::vector<unsigned char> decodedHeader;
+        const unsigned char *header = raw;
+        size_t headerBytes = 3 * m_headerSize;
+        if (raw) {
+            if (!fits(raw, headerBytes)) {
+                return false;
+            }
+        } else {
+            decodedHeader.resize(headerBytes);
+            if (textSize < base64Chars(headerBytes)
+                || decodeBase64(text, base64Chars(headerBytes), decodedHeader.data(), headerBytes) != static_cast<long long>(headerBytes)) {
+                return false;
+            }
+            header = decodedHeader.data();
+        }
+
+        const uint64_t blockCount = headerWord(header);
+        const uint64_t blockSize = headerWord(header + m_headerSize);
+        const uint64_t lastSize = headerWord(header + 2 * m_headerSize);
+        const size_t available = raw ? static_cast<size_t>(m_end - reinterpret_cast<const char *>(raw)) : textSize;
+        if ((blockCount > 0 && blockSize == 0) || blockCount > available / m_headerSize) {
+            return false;
+        }
+        headerBytes = (3 + blockCount) * m_headerSize;
+        if (raw) {
+            if (!fits(raw, headerBytes)) {
+                return false;
+            }
+        } else {
+            decodedHeader.resize(headerBytes);
+            if (textSize < base64Chars(headerBytes)
+                || decodeBase64(text, base64Chars(headerBytes), decodedHeader.data(), headerBytes) != static_cast<long long>(headerBytes)) {
+                return false;
+            }
+            header = decodedHeader.data();
+        }
+
+        size_t compressedTotal = 0;
+        for (uint64_t i = 0; i < blockCount; ++i) {
+            compressedTotal += headerWord(header + (3 + i) * m_headerSize);
+        }
+        const size_t bytes = blockCount == 0 ? 0 : (blockCount - 1) * blockSize + (lastSize ? lastSize : blockSize);
+        unsigned char *target = allocate(info, bytes);
+        if (!target) {
+            return false;
+        }
+
+        const unsigned char *data = nullptr;
+        if (raw) {
+            data = raw + headerBytes;
+            if (!fits(data, compressedTotal)) {
+                return false;
+            }
+        } else {
+            const size_t headerChars = base64Chars(headerBytes);
+            if (base64Chars(compressedTotal) > textSize - headerChars) {
+                return false;
+            }
+            unsigned char *decoded = buffer(compressedTotal);
+            addPieces(text + headerChars, compressedTotal, decoded);
+            data = decoded;
+        }
+
+        for (uint64_t i = 0; i < blockCount; ++i) {
+            const size_t compressedSize = headerWord(header + (3 + i) * m_headerSize);
+            const size_t size = i + 1 == blockCount && lastSize ? lastSize : blockSize;
+            m_blocks.push_back({data, compressedSize, target + i * blockSize, size, true});
+            data += compressedSize;
+        }
+        return true;
+    }
+
+    // 按数据头中的字节数创建数组；连接与偏移数组以及 IdType 数组与 vtkIdType 同宽时直接解码进 vtkIdTypeArray，
+    // 偏移数组前留出 0 的位置
+    unsigned char *allocate(ArrayInfo &info, size_t bytes)
+    {
+        const size_t tupleBytes = static_cast<size_t>(vtkDataArray::GetDataTypeSize(info.dataType)) * info.components;
+        if (tupleBytes == 0 || bytes % tupleBytes != 0) {
+            return nullptr;
+        }
+        const vtkIdType tuples = static_cast<vtkIdType>(bytes / tupleBytes);
+        if (info.tuples >= 0 && tuples != info.tuples) {
+            return nullptr;
+        }
+
+        unsigned char *target = nullptr;
+        const bool idSized = isIdTypeSized(info.dataType);
+        if (info.section == CELLS && idSized && (info.name == "connectivity" || info.name == "offsets")) {
+            vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+            const bool leadingZero = info.name == "offsets";
+            ids->SetNumberOfValues(tuples + (leadingZero ? 1 : 0));
+            if (leadingZero) {
+                ids->SetValue(0, 0);
+            }
+            target = reinterpret_cast<unsigned char *>(ids->GetPointer(leadingZero ? 1 : 0));
+            info.array = ids;
+        } else if (info.idType && idSized) {
+            vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+            ids->SetNumberOfComponents(info.components);
+            ids->SetNumberOfTuples(tuples);
+            target = reinterpret_cast<unsigned char *>(ids->GetPointer(0));
+            info.array = ids;
+        } else {
+            info.array = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(info.dataType));
+            info.array->SetNumberOfComponents(info.components);
+            info.array->SetNumberOfTuples(tuples);
+            target = static_cast<unsigned char *>(info.array->GetVoidPointer(0));
+        }
+        info.array->SetName(info.name.constData());
+        for (int c = 0; c < info.componentNames.size(); ++c) {
+            info.array->SetComponentName(c, info.componentNames[c].constData());
+        }
+        // 空数组没有有效指针，给出任意非空地址（不会写入）
+        return target ? target : reinterpret_cast<unsigned char *>(&m_empty);
+    }
+
+    int m_headerSize;
+    QByteArray m_compressor;
+    const char *m_appended;
+    bool m_rawAppended;
+    const char *m_end;
+    std::vector<Piece> m_pieces;
+    std::vector<Block> m_blocks;
+    std::deque<std::vector<unsigned char>> m_buffers;
+    std::deque<std::string> m_texts;
+    unsigned char m_empty = 0;
+};
+
+// 文件中的连接/偏移数组或 IdType 数组与 vtkIdType 宽度不同时并行转换；偏移数组补上开头的 0
+vtkSmartPointer<vtkIdTypeArray> toIdArray(vtkDataArray *array, bool leadingZero)
+{
+    if (vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(array)) {
+        return ids;
+    }
+    vtkSmartPointer<vtkIdTypeArray> ids = vtkSmartPointer<vtkIdTypeArray>::New();
+    const vtkIdType count = array->GetNumberOfValues();
+    const vtkIdType shift = leadingZero ? 1 : 0;
+    if (!leadingZero) {
+        ids->SetNumberOfComponents(array->GetNumberOfComponents());
+    }
+    ids->SetNumberOfValues(count + shift);
+    vtkIdType *out = ids->GetPointer(0);
+    if (leadingZero) {
+        out[0] = 0;
+    }
+    switch (array->GetDataType()) {
+        vtkTemplateMacro(
+            const VTK_TT *in = static_cast<const VTK_TT *>(array->GetVoidPointer(0));
+            vtkSMPTools::For(0, count, [&](vtkIdType first, vtkIdType last) {
+                for (vtkIdType i = first; i < last; ++i) {
+                    out[i + shift] = static_cast<vtkIdType>(in[i]);
+                }
+            }));
+    default:
+        return nullptr;
+    }
+    return ids;
+}
+
+void fail(QString *error, const QString &message)
+{
+    if (error) {
+        *error = message;
+    }
+}
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> VTUParser::read(const QString &fileName, QString *error)
+{
+    TRACE_SCOPE("VTUParser::read", "io");
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        fail(error, QString("无法打开文件: %1").arg(file.errorString()));
+        return nullptr;
+    }
+    const uchar *mapped = file.map(0, file.size());
+    if (!mapped) {
+        fail(error, "无法映射文件");
+        return nullptr;
+    }
+    const char *p = reinterpret_cast<const char *>(mapped);
+    const char *end = p + file.size();
+
+    // XML 头：数组的类型、形状与数据位置；遇到 AppendedData 即停止，其后是二进制数据
+    int headerSize = 4;
+    QByteArray compressor;
+    const char *appended = nullptr;
+    bool rawAppended = true;
+    vtkIdType numberOfPoints = -1;
+    vtkIdType numberOfCells = -1;
+    int pieces = 0;
+    Section section = NO_SECTION;
+    QHash<QByteArray, QByteArray> activeAttributes[2];
+    std::vector<ArrayInfo> arrays;
+
+    Tag tag;
+    while (const char *next = nextTag(p, end, tag)) {
+        p = next;
+        if (tag.name == "VTKFile" && !tag.closing) {
+            if (tag.attributes.value("type") != "UnstructuredGrid") {
+                fail(error, "不是非结构网格文件");
+                return nullptr;
+            }
+            if (tag.attributes.value("byte_order", "LittleEndian") != "LittleEndian") {
+                fail(error, "不支持大端字节序");
+                return nullptr;
+            }
+            headerSize = tag.attributes.value("header_type", "UInt32") == "UInt64" ? 8 : 4;
+            compressor = tag.attributes.value("compressor");
+            if (!compressor.isEmpty() && !createCompressor(compressor)) {
+                fail(error, QString("不支持的压缩器: %1").arg(QString::fromUtf8(compressor)));
+                return nullptr;
+            }
+        } else if (tag.name == "VTKFile") {
+            break;
+        } else if (tag.name == "Piece" && !tag.closing) {
+            if (++pieces > 1) {
+                fail(error, "不支持多个 Piece");
+                return nullptr;
+            }
+            numberOfPoints = tag.attributes.value("NumberOfPoints").toLongLong();
+            numberOfCells = tag.attributes.value("NumberOfCells").toLongLong();
+        } else if (tag.name == "PointData" || tag.name == "CellData" || tag.name == "FieldData"
+                   || tag.name == "Points" || tag.name == "Cells") {
+            if (tag.closing || tag.selfClosing) {
+                section = NO_SECTION;
+                continue;
+            }
+            section = tag.name == "PointData" ? POINT_DATA
+                    : tag.name == "CellData" ? CELL_DATA
+                    : tag.name == "FieldData" ? FIELD_DATA
+                    : tag.name == "Points" ? POINTS : CELLS;
+            if (section == POINT_DATA || section == CELL_DATA) {
+                activeAttributes[section == POINT_DATA ? 0 : 1] = tag.attributes;
+            }
+        } else if (tag.name == "DataArray" && !tag.closing) {
+            ArrayInfo info = {};
+            info.section = section;
+            info.name = tag.attributes.value("Name");
+            info.dataType = dataTypeFromName(tag.attributes.value("type"));
+            info.components = std::max(1, tag.attributes.value("NumberOfComponents", "1").toInt());
+            info.tuples = tag.attributes.contains("NumberOfTuples") ? tag.attributes.value("NumberOfTuples").toLongLong() : -1;
+            info.idType = tag.attributes.value("IdType") == "1";
+            for (int c = 0; c < info.components && tag.attributes.contains("ComponentName" + QByteArray::number(c)); ++c) {
+                info.componentNames << tag.attributes.value("ComponentName" + QByteArray::number(c));
+            }
+            const QByteArray format = tag.attributes.value("format");
+            info.appended = format == "appended";
+            info.offset = tag.attributes.value("offset").toULongLong();
+
+            if (section == NO_SECTION || info.dataType < 0 || (format != "appended" && format != "binary")) {
+                fail(error, QString("数组 %1 的类型或格式不支持: %2 %3")
+                     .arg(QString::fromUtf8(info.name))
+                     .arg(QString::fromUtf8(tag.attributes.value("type")))
+                     .arg(QString::fromUtf8(format)));
+                return nullptr;
+            }
+            if (section == CELLS && info.name != "connectivity" && info.name != "offsets" && info.name != "types") {
+                fail(error, QString("不支持的单元数组: %1（多面体单元）").arg(QString::fromUtf8(info.name)));
+                return nullptr;
+            }
+            if (!tag.selfClosing) {
+                p = readArrayContent(p, end, info);
+                if (!p) {
+                    fail(error, "XML 格式错误");
+                    return nullptr;
+                }
+            }
+            arrays.push_back(info);
+        } else if (tag.name == "AppendedData" && !tag.closing) {
+            rawAppended = tag.attributes.value("encoding", "raw") == "raw";
+            appended = static_cast<const char *>(std::memchr(p, '_', end - p));
+            if (!appended) {
+                fail(error, "AppendedData 缺少起始标记");
+                return nullptr;
+            }
+            ++appended;
+            break;
+        }
+    }
+
+    if (pieces != 1 || numberOfPoints < 0 || numberOfCells < 0) {
+        fail(error, "缺少 Piece 或点数/单元数");
+        return nullptr;
+    }
+
+    // 可由 Piece 确定元组数的数组在分配时校验
+    for (ArrayInfo &info : arrays) {
+        if (info.section == POINT_DATA || info.section == POINTS) {
+            info.tuples = numberOfPoints;
+        } else if (info.section == CELL_DATA || (info.section == CELLS && info.name != "connectivity")) {
+            info.tuples = numberOfCells;
+        }
+    }
+
+    Decoder decoder(headerSize, compressor, appended, rawAppended, end);
+    for (ArrayInfo &info : arrays) {
+        if (!decoder.add(info)) {
+            fail(error, QString("数组 %1 的数据头无效").arg(QString::fromUtf8(info.name)));
+            return nullptr;
+        }
+    }
+    if (!decoder.run()) {
+        fail(error, "数据解码或解压失败");
+        return nullptr;
+    }
+
+    vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    vtkSmartPointer<vtkIdTypeArray> offsets;
+    vtkSmartPointer<vtkIdTypeArray> connectivity;
+    vtkSmartPointer<vtkUnsignedCharArray> cellTypes;
+    for (ArrayInfo &info : arrays) {
+        if (info.idType && info.section != CELLS && !vtkIdTypeArray::SafeDownCast(info.array)) {
+            if (vtkSmartPointer<vtkIdTypeArray> ids = toIdArray(info.array, false)) {
+                ids->SetName(info.array->GetName());
+                for (int c = 0; c < info.componentNames.size(); ++c) {
+                    ids->SetComponentName(c, info.componentNames[c].constData());
+                }
+                info.array = ids;
+            }
+        }
+        switch (info.section) {
+        case POINTS: {
+            if (info.array->GetNumberOfComponents() != 3) {
+                fail(error, "Points 数组必须为 3 个分量");
+                return nullptr;
+            }
+            vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+            points->SetData(info.array);
+            grid->SetPoints(points);
+            break;
+        }
+        case CELLS:
+            if (info.name == "offsets") {
+                offsets = toIdArray(info.array, true);
+            } else if (info.name == "connectivity") {
+                connectivity = toIdArray(info.array, false);
+            } else {
+                cellTypes = vtkUnsignedCharArray::SafeDownCast(info.array);
+            }
+            break;
+        case POINT_DATA:
+            grid->GetPointData()->AddArray(info.array);
+            break;
+        case CELL_DATA:
+            grid->GetCellData()->AddArray(info.array);
+            break;
+        case FIELD_DATA:
+            grid->GetFieldData()->AddArray(info.array);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!offsets || !connectivity || !cellTypes || (numberOfPoints > 0 && !grid->GetPoints())
+        || offsets->GetValue(numberOfCells) != connectivity->GetNumberOfValues()) {
+        fail(error, "缺少 Points 或 Cells 数组，或单元偏移与连接数组不一致");
+        return nullptr;
+    }
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(offsets.Get(), connectivity.Get());
+    grid->SetCells(cellTypes, cells);
+
+    // 与 vtkXMLUnstructuredGridReader 一致：PointData/CellData 的 Scalars、Vectors 等属性指定活动数组
+    vtkDataSetAttributes *attributes[2] = {grid->GetPointData(), grid->GetCellData()};
+    for (int i = 0; i < 2; ++i) {
+        for (int type = 0; type < vtkDataSetAttributes::NUM_ATTRIBUTES; ++type) {
+            const QByteArray name = activeAttributes[i].value(vtkDataSetAttributes::GetAttributeTypeAsString(type));
+            if (!name.isEmpty()) {
+                attributes[i]->SetActiveAttribute(name.constData(), type);
+            }
+        }
+    }
+
+    qDebug() << "VTUParser: 读取" << fileName << "点数:" << grid->GetNumberOfPoints()
+             << "单元数:" << grid->GetNumberOfCells() << "数据块:" << decoder.blockCount()
+             << "线程数:" << vtkSMPTools::GetEstimatedNumberOfThreads() << "耗时(ms):" << timer.elapsed();
+    return grid;
+}
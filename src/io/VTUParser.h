@@ -0,0 +1,25 @@
+#ifndef VTUPARSER_H
+#define VTUPARSER_H
+
+#include <QString>
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+// VTK XML 非结构网格 (.vtu) 的快速读取：
+// 文件整体内存映射，自行解析 XML 头得到各数组的位置，再把所有数组的 base64 段与
+// 压缩块（zlib / LZ4 / LZMA）汇总成一张任务表，在 vtkSMPTools 线程池上并行解码，
+// 直接写入最终数组；vtkXMLUnstructuredGridReader 则逐块串行解压。
+//
+// 支持单个 Piece 的 appended（raw / base64）与 binary（内联 base64）数据、
+// UInt32/UInt64 数据头、点/单元/场数据数组及其活动属性与分量名。
+// ASCII 数组、字符串/位数组、大端字节序、多个 Piece、多面体单元等返回空并给出原因，
+// 由调用方回退到 vtkXMLUnstructuredGridReader
+class VTUParser
+{
+public:
+    // 读取失败时返回空，error 中给出原因
+    static vtkSmartPointer<vtkUnstructuredGrid> read(const QString &fileName, QString *error = nullptr);
+};
+
+#endif // VTUPARSER_H
@@ -1,12 +1,24 @@
 #include <QApplication>
 #include "MainWindow.h"
+#include "visualization/HeadlessRenderer.h"
 
 int main(int argc, char *argv[])
 {
+    // 无界面导出：不创建窗口，直接渲染并保存图像
+    if (HeadlessRenderer::isRequested(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        return HeadlessRenderer::run(app.arguments());
+    }
+
+    // 没有可用 GPU 时让 Qt 加载软件 OpenGL（opengl32sw）
+    if (HeadlessRenderer::softwareOpenGLRequested(argc, argv)) {
+        QCoreApplication::setAttribute(Qt::AA_UseSoftwareOpenGL);
+    }
+
     QApplication app(argc, argv);
     
     MainWindow window;
     window.show();
     
     return app.exec();
-}
\ No newline at end of file
+}
@@ -1,17 +1,28 @@
 #include "ClippingWidget.h"
+#include "core/TraceRecorder.h"
+#include "io/BrickStore.h"
+#include <QDebug>
+#include <QtConcurrent/QtConcurrent>
+#include <vtkCutter.h>
 
 ClippingWidget::ClippingWidget(QWidget *parent)
     : QWidget(parent)
     , m_renderer(nullptr)
     , m_inputData(nullptr)
+    , m_bricks(nullptr)
+    , m_sectionPending(false)
+    , m_sectionValid(false)
+    , m_sectionRevision(0)
     , m_clippingEnabled(false)
 {
     setupUI();
     setupVTK();
+    connect(&m_sectionWatcher, &QFutureWatcher<SectionResult>::finished, this, &ClippingWidget::onBrickSectionReady);
 }
 
 ClippingWidget::~ClippingWidget()
 {
+    m_sectionWatcher.waitForFinished();
 }
 
 void ClippingWidget::setupUI()
@@ -109,6 +120,8 @@ void ClippingWidget::setupVTK()
     
     m_clippedActor = vtkSmartPointer<vtkActor>::New();
     m_clippedActor->SetMapper(m_clippedMapper);
+    
+    m_brickAppend = vtkSmartPointer<vtkAppendFilter>::New();
 }
 
 void ClippingWidget::setData(vtkUnstructuredGrid *data)
@@ -125,8 +138,32 @@ void ClippingWidget::setRenderer(vtkRenderer *renderer)
     m_renderer = renderer;
 }
 
+void ClippingWidget::setBrickStore(BrickStore *store)
+{
+    // 外表面保留在剖切一侧的部分加上剖切面处的截面，就是整个模型剖切后可见的全部
+    if (store && store == m_bricks && store->revision() == m_sectionRevision) {
+        return; // 同一模型（如切换着色数组），已有的截面仍然有效
+    }
+    if (!store) {
+        // 退出分块模式时后台计算不能再访问原来的 BrickStore
+        m_sectionWatcher.waitForFinished();
+    }
+    m_sectionPending = false;
+    m_sectionValid = false;
+    m_sectionRevision = store ? store->revision() : 0;
+    m_bricks = store;
+    m_brickAppend->RemoveAllInputs();
+    if (m_bricks) {
+        m_brickAppend->AddInputConnection(m_clipFilter->GetOutputPort());
+        m_clippedMapper->SetInputConnection(m_brickAppend->GetOutputPort());
+    } else {
+        m_clippedMapper->SetInputConnection(m_clipFilter->GetOutputPort());
+    }
+}
+
 void ClippingWidget::onClippingEnabledChanged(bool enabled)
 {
+    TRACE_SCOPE("ClippingWidget::onClippingEnabledChanged", "ui");
     m_clippingEnabled = enabled;
     
     // 设置属性供外部查询
@@ -138,11 +175,17 @@ void ClippingWidget::onClippingEnabledChanged(bool enabled)
     m_normalYSlider->setEnabled(enabled);
     m_normalZSlider->setEnabled(enabled);
     
+    // 分块模式的截面不在管线中，启用时先按当前平面计算
+    if (enabled && m_bricks && m_inputData) {
+        updateBrickSection();
+    }
+    
     emit clippingChanged();
 }
 
 void ClippingWidget::onPlanePositionChanged()
 {
+    TRACE_SCOPE("ClippingWidget::onPlanePositionChanged", "ui");
     if (!m_inputData) return;
     
     int value = m_planePositionSlider->value();
@@ -193,6 +236,7 @@ void ClippingWidget::onPlanePositionChanged()
 
 void ClippingWidget::onPlaneNormalChanged()
 {
+    TRACE_SCOPE("ClippingWidget::onPlaneNormalChanged", "ui");
     double nx = m_normalXSlider->value() / 100.0;
     double ny = m_normalYSlider->value() / 100.0;
     double nz = m_normalZSlider->value() / 100.0;
@@ -223,8 +267,87 @@ void ClippingWidget::updateClipping()
     if (!m_inputData || !m_renderer) return;
     
     if (m_clippingEnabled) {
-        m_clipFilter->Update();
+        if (m_bricks) {
+            // 外表面的剖切立即更新，各块截面在后台计算完成后补上
+            updateBrickSection();
+            m_brickAppend->Update();
+        } else {
+            m_clipFilter->Update();
+        }
         emit clippingChanged();
     }
 }
 
+void ClippingWidget::updateBrickSection()
+{
+    double plane[6];
+    m_clippingPlane->GetOrigin(plane);
+    m_clippingPlane->GetNormal(plane + 3);
+    if (m_sectionValid && std::equal(plane, plane + 6, m_sectionPlane)) {
+        return; // 平面未变（如切换着色数组），沿用已有截面
+    }
+    if (m_sectionWatcher.isRunning()) {
+        // 拖动滑块期间只保留最新的平面，中间的请求直接丢弃
+        m_sectionPending = true;
+        return;
+    }
+    
+    std::copy(plane, plane + 6, m_sectionPlane);
+    m_sectionValid = true;
+    
+    // 只读入包围盒与平面相交的块，各块在线程池上各自求截面；读盘与剖切都不占用界面线程
+    BrickStore *bricks = m_bricks;
+    const std::vector<int> ids = bricks->bricksCutByPlane(plane, plane + 3);
+    const int revision = m_sectionRevision;
+    m_sectionWatcher.setFuture(QtConcurrent::run([bricks, ids, revision, plane]() {
+        TRACE_SCOPE("ClippingWidget::updateBrickSection", "compute");
+        SectionResult result;
+        result.revision = revision;
+        QString error;
+        const bool ok = bricks->process(ids,
+            [&plane](vtkUnstructuredGrid *brick) {
+                vtkSmartPointer<vtkPlane> cutPlane = vtkSmartPointer<vtkPlane>::New();
+                cutPlane->SetOrigin(plane[0], plane[1], plane[2]);
+                cutPlane->SetNormal(plane[3], plane[4], plane[5]);
+                vtkSmartPointer<vtkCutter> cutter = vtkSmartPointer<vtkCutter>::New();
+                cutter->SetCutFunction(cutPlane);
+                cutter->SetInputData(brick);
+                cutter->Update();
+                return vtkSmartPointer<vtkPolyData>(cutter->GetOutput());
+            }, result.sections, &error);
+        if (!ok) {
+            qDebug() << "ClippingWidget: 分块截面失败:" << error;
+        }
+        return result;
+    }));
+}
+
+void ClippingWidget::onBrickSectionReady()
+{
+    const SectionResult result = m_sectionWatcher.result();
+    if (!m_bricks || result.revision != m_bricks->revision()) {
+        // 属于之前的模型；计算期间为新模型发出的请求被推迟了，现在补上
+        if (m_bricks && m_sectionPending) {
+            m_sectionPending = false;
+            updateBrickSection();
+        }
+        return;
+    }
+    
+    // 计算期间平面又变了时先显示这次的结果，再按最新平面计算
+    m_brickAppend->RemoveAllInputs();
+    m_brickAppend->AddInputConnection(m_clipFilter->GetOutputPort());
+    for (const vtkSmartPointer<vtkPolyData> &section : result.sections) {
+        if (section && section->GetNumberOfCells() > 0) {
+            m_brickAppend->AddInputData(section);
+        }
+    }
+    if (m_clippingEnabled && m_inputData) {
+        m_brickAppend->Update();
+        emit clippingChanged();
+    }
+    if (m_sectionPending) {
+        m_sectionPending = false;
+        updateBrickSection();
+    }
+}
@@ -8,15 +8,21 @@
 #include <QSlider>
 #include <QCheckBox>
 #include <QGroupBox>
+#include <QFutureWatcher>
 
 #include <vtkSmartPointer.h>
 #include <vtkPlane.h>
 #include <vtkClipDataSet.h>
+#include <vtkAppendFilter.h>
 #include <vtkDataSetMapper.h>
 #include <vtkActor.h>
 #include <vtkRenderer.h>
 #include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
 #include <cmath>
+#include <vector>
+
+class BrickStore;
 
 class ClippingWidget : public QWidget
 {
@@ -28,7 +34,16 @@ public:
 
     void setData(vtkUnstructuredGrid *data);
     void setRenderer(vtkRenderer *renderer);
+    // 分块模式：data 为模型外表面，剖切结果再并上与平面相交各块的截面；传入空指针恢复普通模式。
+    // 截面在后台线程上计算，清除前等待正在进行的计算结束
+    void setBrickStore(BrickStore *store);
     vtkActor* getClippedActor() const { return m_clippedActor; }
+    vtkAlgorithm* getClipFilter() const { return m_clipFilter; }
+    // 显示的剖切结果（分块模式下含各块截面）
+    vtkAlgorithm* getOutputFilter() const
+    {
+        return m_bricks ? static_cast<vtkAlgorithm *>(m_brickAppend) : static_cast<vtkAlgorithm *>(m_clipFilter);
+    }
 
 signals:
     void clippingChanged();
@@ -37,11 +52,19 @@ private slots:
     void onClippingEnabledChanged(bool enabled);
     void onPlanePositionChanged();
     void onPlaneNormalChanged();
+    void onBrickSectionReady();
 
 private:
+    struct SectionResult
+    {
+        int revision = 0;
+        std::vector<vtkSmartPointer<vtkPolyData>> sections;
+    };
+
     void setupUI();
     void setupVTK();
     void updateClipping();
+    void updateBrickSection();
 
     // UI组件
     QCheckBox *m_enableClippingCheckBox;
@@ -59,6 +82,13 @@ private:
     vtkSmartPointer<vtkActor> m_clippedActor;
     vtkSmartPointer<vtkRenderer> m_renderer;
     vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
+    vtkSmartPointer<vtkAppendFilter> m_brickAppend;    // 分块模式：外表面剖切结果 + 各块截面
+    BrickStore *m_bricks;
+    QFutureWatcher<SectionResult> m_sectionWatcher;
+    bool m_sectionPending;                  // 计算期间平面又变了，结束后按最新平面再算一次
+    bool m_sectionValid;                    // m_sectionPlane 对应的截面已计算或正在计算
+    int m_sectionRevision;
+    double m_sectionPlane[6];               // 原点与法向
 
     bool m_clippingEnabled;
 };
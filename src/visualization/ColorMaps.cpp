@@ -0,0 +1,198 @@
+#include "ColorMaps.h"
+#include <QDebug>
+#include <array>
+#include <cstddef>
+
+namespace
+{
+struct Rgb
+{
+    double r;
+    double g;
+    double b;
+};
+
+template <std::size_t N>
+using ColorTable = std::array<std::array<unsigned char, 3>, N>;
+
+constexpr double clamp01(double v)
+{
+    return v < 0.0 ? 0.0 : (v > 1.0 ? 1.0 : v);
+}
+
+constexpr unsigned char toByte(double v)
+{
+    return static_cast<unsigned char>(clamp01(v) * 255.0 + 0.5);
+}
+
+// HSV -> RGB，与 vtkLookupTable 的色相渐变一致（色相取值 0~1）
+constexpr Rgb hsvToRgb(double h, double s, double v)
+{
+    const double hue = (h - static_cast<int>(h)) * 6.0;
+    const int sector = static_cast<int>(hue);
+    const double f = hue - sector;
+    const double p = v * (1.0 - s);
+    const double q = v * (1.0 - s * f);
+    const double t = v * (1.0 - s * (1.0 - f));
+    switch (sector % 6) {
+    case 0: return {v, t, p};
+    case 1: return {q, v, p};
+    case 2: return {p, v, t};
+    case 3: return {p, q, v};
+    case 4: return {t, p, v};
+    default: return {v, p, q};
+    }
+}
+
+// 沿用原有 SetHueRange/SetSaturationRange/SetValueRange 参数的线性HSV渐变
+template <std::size_t N>
+constexpr ColorTable<N> hsvRamp(double h0, double h1, double s0, double s1, double v0, double v1)
+{
+    ColorTable<N> table{};
+    for (std::size_t i = 0; i < N; ++i) {
+        const double t = static_cast<double>(i) / (N - 1);
+        const Rgb c = hsvToRgb(h0 + (h1 - h0) * t, s0 + (s1 - s0) * t, v0 + (v1 - v0) * t);
+        table[i] = {toByte(c.r), toByte(c.g), toByte(c.b)};
+    }
+    return table;
+}
+
+// 由等间距控制点线性插值得到的表
+template <std::size_t N, std::size_t K>
+constexpr ColorTable<N> anchorRamp(const unsigned char (&anchors)[K][3])
+{
+    ColorTable<N> table{};
+    for (std::size_t i = 0; i < N; ++i) {
+        const double position = static_cast<double>(i) * (K - 1) / (N - 1);
+        std::size_t segment = static_cast<std::size_t>(position);
+        if (segment >= K - 1) {
+            segment = K - 2;
+        }
+        const double f = position - segment;
+        for (int c = 0; c < 3; ++c) {
+            const double value = anchors[segment][c] + (anchors[segment + 1][c] - anchors[segment][c]) * f;
+            table[i][c] = static_cast<unsigned char>(value + 0.5);
+        }
+    }
+    return table;
+}
+
+// Turbo 的多项式近似
+template <std::size_t N>
+constexpr ColorTable<N> turboRamp()
+{
+    ColorTable<N> table{};
+    for (std::size_t i = 0; i < N; ++i) {
+        const double x = static_cast<double>(i) / (N - 1);
+        const double r = 0.13572138 + x * (4.61539260 + x * (-42.66032258 + x * (132.13108234 + x * (-152.94239396 + x * 59.28637943))));
+        const double g = 0.09140261 + x * (2.19418839 + x * (4.84296658 + x * (-14.18503333 + x * (4.27729857 + x * 2.82956604))));
+        const double b = 0.10667330 + x * (12.64194608 + x * (-60.58204836 + x * (110.36276771 + x * (-89.90310912 + x * 27.34824973))));
+        table[i] = {toByte(r), toByte(g), toByte(b)};
+    }
+    return table;
+}
+
+constexpr std::size_t LEGACY_SIZE = 256;
+constexpr std::size_t PERCEPTUAL_SIZE = 1024;
+
+constexpr unsigned char VIRIDIS_ANCHORS[][3] = {
+    {68, 1, 84}, {72, 40, 120}, {62, 73, 137}, {49, 104, 142}, {38, 130, 142},
+    {31, 158, 137}, {53, 183, 121}, {110, 206, 88}, {181, 222, 43}, {253, 231, 37}};
+
+constexpr unsigned char PLASMA_ANCHORS[][3] = {
+    {13, 8, 135}, {65, 4, 157}, {106, 0, 168}, {143, 13, 164}, {177, 42, 144}, {204, 71, 120},
+    {225, 100, 98}, {242, 132, 75}, {252, 166, 54}, {252, 206, 37}, {240, 249, 33}};
+
+constexpr unsigned char INFERNO_ANCHORS[][3] = {
+    {0, 0, 4}, {22, 11, 57}, {66, 10, 104}, {106, 23, 110}, {147, 38, 103}, {188, 55, 84},
+    {221, 81, 58}, {243, 120, 25}, {252, 165, 10}, {246, 215, 70}, {252, 255, 164}};
+
+// Moreland 冷暖发散色
+constexpr unsigned char COOL_WARM_ANCHORS[][3] = {
+    {59, 76, 192}, {98, 130, 234}, {141, 176, 254}, {184, 208, 249}, {221, 221, 221},
+    {245, 196, 173}, {244, 154, 123}, {222, 96, 77}, {180, 4, 38}};
+
+constexpr unsigned char BLUE_WHITE_RED_ANCHORS[][3] = {
+    {0, 0, 255}, {255, 255, 255}, {255, 0, 0}};
+
+constexpr ColorTable<LEGACY_SIZE> RAINBOW = hsvRamp<LEGACY_SIZE>(0.667, 0.0, 1.0, 1.0, 1.0, 1.0);
+constexpr ColorTable<LEGACY_SIZE> HEAT = hsvRamp<LEGACY_SIZE>(0.0, 0.167, 1.0, 1.0, 0.0, 1.0);
+constexpr ColorTable<LEGACY_SIZE> BLUE_WHITE_RED = anchorRamp<LEGACY_SIZE>(BLUE_WHITE_RED_ANCHORS);
+constexpr ColorTable<LEGACY_SIZE> GRAYSCALE = hsvRamp<LEGACY_SIZE>(0.0, 0.0, 0.0, 0.0, 0.0, 1.0);
+constexpr ColorTable<LEGACY_SIZE> GREEN_BLUE = hsvRamp<LEGACY_SIZE>(0.333, 0.667, 1.0, 1.0, 1.0, 1.0);
+constexpr ColorTable<LEGACY_SIZE> PURPLE_RED = hsvRamp<LEGACY_SIZE>(0.833, 0.0, 1.0, 1.0, 1.0, 1.0);
+constexpr ColorTable<PERCEPTUAL_SIZE> VIRIDIS = anchorRamp<PERCEPTUAL_SIZE>(VIRIDIS_ANCHORS);
+constexpr ColorTable<PERCEPTUAL_SIZE> PLASMA = anchorRamp<PERCEPTUAL_SIZE>(PLASMA_ANCHORS);
+constexpr ColorTable<PERCEPTUAL_SIZE> INFERNO = anchorRamp<PERCEPTUAL_SIZE>(INFERNO_ANCHORS);
+constexpr ColorTable<PERCEPTUAL_SIZE> COOL_WARM = anchorRamp<PERCEPTUAL_SIZE>(COOL_WARM_ANCHORS);
+constexpr ColorTable<PERCEPTUAL_SIZE> TURBO = turboRamp<PERCEPTUAL_SIZE>();
+
+struct ColorMapEntry
+{
+    const char *name;
+    const std::array<unsigned char, 3> *colors;
+    std::size_t size;
+};
+
+template <std::size_t N>
+ColorMapEntry entry(const char *name, const ColorTable<N> &table)
+{
+    return {name, table.data(), N};
+}
+
+const std::array<ColorMapEntry, 11> &colorMaps()
+{
+    static const std::array<ColorMapEntry, 11> maps = {
+        entry("彩虹 (蓝→红)", RAINBOW),
+        entry("热力图 (黑→红→黄)", HEAT),
+        entry("蓝白红", BLUE_WHITE_RED),
+        entry("灰度", GRAYSCALE),
+        entry("绿蓝", GREEN_BLUE),
+        entry("紫红", PURPLE_RED),
+        entry("Viridis (感知均匀)", VIRIDIS),
+        entry("Plasma (感知均匀)", PLASMA),
+        entry("Inferno (感知均匀)", INFERNO),
+        entry("冷暖 (发散)", COOL_WARM),
+        entry("Turbo", TURBO)};
+    return maps;
+}
+}
+
+QStringList ColorMaps::names()
+{
+    QStringList result;
+    for (const ColorMapEntry &map : colorMaps()) {
+        result << QString::fromUtf8(map.name);
+    }
+    return result;
+}
+
+bool ColorMaps::apply(const QString &name, vtkLookupTable *lookupTable)
+{
+    if (!lookupTable) {
+        return false;
+    }
+
+    for (const ColorMapEntry &map : colorMaps()) {
+        if (name != QString::fromUtf8(map.name)) {
+            continue;
+        }
+
+        // 直接写入颜色表；不调用 Build()，避免按HSV参数重新生成覆盖表值
+        const vtkIdType size = static_cast<vtkIdType>(map.size);
+        lookupTable->SetNumberOfTableValues(size);
+        unsigned char *rgba = lookupTable->WritePointer(0, size);
+        for (vtkIdType i = 0; i < size; ++i) {
+            rgba[4 * i] = map.colors[i][0];
+            rgba[4 * i + 1] = map.colors[i][1];
+            rgba[4 * i + 2] = map.colors[i][2];
+            rgba[4 * i + 3] = 255;
+        }
+        lookupTable->BuildSpecialColors();
+        lookupTable->Modified();
+        return true;
+    }
+
+    qDebug() << "ColorMaps: 未知颜色映射" << name;
+    return false;
+}
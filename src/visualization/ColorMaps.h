@@ -0,0 +1,21 @@
+#ifndef COLORMAPS_H
+#define COLORMAPS_H
+
+#include <QString>
+#include <QStringList>
+
+#include <vtkLookupTable.h>
+
+// 颜色映射表：所有方案在编译期生成为定长RGB表（传统HSV方案256项，感知均匀方案1024项），
+// 切换方案只需把表拷入查找表，不触发管线重新执行
+class ColorMaps
+{
+public:
+    // 下拉框中显示的方案名称，第一个为默认方案
+    static QStringList names();
+
+    // 将指定方案写入查找表，保留其数值范围；未知名称返回false
+    static bool apply(const QString &name, vtkLookupTable *lookupTable);
+};
+
+#endif // COLORMAPS_H
@@ -1,24 +1,36 @@
 #include "ContourWidget.h"
+#include "core/TraceRecorder.h"
+#include "io/BrickStore.h"
 #include <QMessageBox>
 #include <QDebug>
+#include <QtConcurrent/QtConcurrent>
 #include <vtkPointData.h>
 #include <vtkCellData.h>
 #include <vtkDataArray.h>
+#include <vtkPolyData.h>
 
 ContourWidget::ContourWidget(QWidget *parent)
     : QWidget(parent)
     , m_renderer(nullptr)
     , m_inputData(nullptr)
+    , m_bricks(nullptr)
+    , m_contourPending(false)
+    , m_contourValid(false)
+    , m_contourRevision(0)
+    , m_requestIsPointData(true)
     , m_dataMin(0.0)
     , m_dataMax(1.0)
     , m_contourEnabled(false)
+    , m_activeIsPointData(true)
 {
     setupUI();
     setupVTK();
+    connect(&m_contourWatcher, &QFutureWatcher<ContourResult>::finished, this, &ContourWidget::onBrickContoursReady);
 }
 
 ContourWidget::~ContourWidget()
 {
+    m_contourWatcher.waitForFinished();
 }
 
 void ContourWidget::setupUI()
@@ -127,6 +139,8 @@ void ContourWidget::setupVTK()
     m_contourActor->GetProperty()->SetLineWidth(3.0); // 更粗的线条
     m_contourActor->GetProperty()->SetOpacity(1.0); // 完全不透明
     m_contourActor->GetProperty()->SetRepresentationToWireframe(); // 确保显示为线框
+    
+    m_brickAppend = vtkSmartPointer<vtkAppendPolyData>::New();
 }
 
 void ContourWidget::setData(vtkUnstructuredGrid *data)
@@ -193,6 +207,29 @@ void ContourWidget::setRenderer(vtkRenderer *renderer)
     m_renderer = renderer;
 }
 
+void ContourWidget::setBrickStore(BrickStore *store)
+{
+    // 外表面上只能得到等值线，体内的等值面要从各块提取
+    if (store && store == m_bricks && store->revision() == m_contourRevision) {
+        return; // 同一模型，已有的等值面仍然有效
+    }
+    if (!store) {
+        // 退出分块模式时后台计算不能再访问原来的 BrickStore
+        m_contourWatcher.waitForFinished();
+    }
+    m_contourPending = false;
+    m_contourValid = false;
+    m_contourRevision = store ? store->revision() : 0;
+    m_bricks = store;
+    m_brickAppend->RemoveAllInputs();
+    if (m_bricks) {
+        m_brickAppend->AddInputData(vtkSmartPointer<vtkPolyData>::New());
+        m_contourMapper->SetInputConnection(m_brickAppend->GetOutputPort());
+    } else {
+        m_contourMapper->SetInputConnection(m_contourFilter->GetOutputPort());
+    }
+}
+
 void ContourWidget::setDataRange(double min, double max)
 {
     m_dataMin = min;
@@ -212,6 +249,8 @@ void ContourWidget::setActiveScalarArray(const QString &arrayName, bool isPointD
     if (!m_inputData || arrayName.isEmpty()) return;
     
     qDebug() << "ContourWidget: 设置活动标量数组:" << arrayName << "是否为点数据:" << isPointData;
+    m_activeArrayName = arrayName;
+    m_activeIsPointData = isPointData;
     
     if (isPointData) {
         m_inputData->GetPointData()->SetActiveScalars(arrayName.toStdString().c_str());
@@ -219,14 +258,22 @@ void ContourWidget::setActiveScalarArray(const QString &arrayName, bool isPointD
         m_inputData->GetCellData()->SetActiveScalars(arrayName.toStdString().c_str());
     }
     
-    // 重新获取数据范围
+    // 重新获取数据范围；分块模式下外表面的范围不含体内的值，改用索引中各块范围的并集
     double range[2];
-    m_inputData->GetScalarRange(range);
+    if (!m_bricks || !m_bricks->range(arrayName, isPointData, range)) {
+        m_inputData->GetScalarRange(range);
+    }
     setDataRange(range[0], range[1]);
+    
+    // 普通模式下过滤器随活动标量自动重新执行，分块模式需要重新逐块提取
+    if (m_bricks) {
+        updateContours();
+    }
 }
 
 void ContourWidget::onContourEnabledChanged(bool enabled)
 {
+    TRACE_SCOPE("ContourWidget::onContourEnabledChanged", "ui");
     m_contourEnabled = enabled;
     
     // 设置属性供外部查询
@@ -245,6 +292,7 @@ void ContourWidget::onContourEnabledChanged(bool enabled)
 
 void ContourWidget::onAddContour()
 {
+    TRACE_SCOPE("ContourWidget::onAddContour", "ui");
     double value = m_contourValueSpinBox->value();
     
     // 检查是否已存在相同值
@@ -269,6 +317,7 @@ void ContourWidget::onAddContour()
 
 void ContourWidget::onRemoveContour()
 {
+    TRACE_SCOPE("ContourWidget::onRemoveContour", "ui");
     int currentRow = m_contourListWidget->currentRow();
     if (currentRow >= 0 && currentRow < m_contourValues.size()) {
         m_contourValues.removeAt(currentRow);
@@ -286,6 +335,7 @@ void ContourWidget::onRemoveContour()
 
 void ContourWidget::onClearContours()
 {
+    TRACE_SCOPE("ContourWidget::onClearContours", "ui");
     m_contourValues.clear();
     m_contourListWidget->clear();
     
@@ -298,6 +348,7 @@ void ContourWidget::onClearContours()
 
 void ContourWidget::onAutoContoursChanged()
 {
+    TRACE_SCOPE("ContourWidget::onAutoContoursChanged", "ui");
     bool autoEnabled = m_autoContoursCheckBox->isChecked();
     m_numContoursSpinBox->setEnabled(m_contourEnabled && autoEnabled);
     
@@ -361,15 +412,22 @@ void ContourWidget::updateContours()
             qDebug() << "  等值面" << i << ":" << m_contourValues[i];
         }
         
+        if (m_bricks) {
+            // 各块的等值面在后台提取，完成后再发出 contoursChanged
+            updateBrickContours();
+            emit contoursChanged();
+            return;
+        }
         m_contourFilter->Update();
+        vtkDataSet *output = vtkDataSet::SafeDownCast(getOutputFilter()->GetOutputDataObject(0));
         
         // 调试信息
         qDebug() << "ContourWidget: 更新等值面，数量:" << m_contourValues.size()
-                 << "输出点数:" << m_contourFilter->GetOutput()->GetNumberOfPoints()
-                 << "输出单元数:" << m_contourFilter->GetOutput()->GetNumberOfCells();
+                 << "输出点数:" << output->GetNumberOfPoints()
+                 << "输出单元数:" << output->GetNumberOfCells();
         
         // 如果没有输出，检查可能的原因
-        if (m_contourFilter->GetOutput()->GetNumberOfPoints() == 0) {
+        if (output->GetNumberOfPoints() == 0) {
             qDebug() << "警告: 等值面没有输出，可能原因:";
             qDebug() << "1. 等值面数值超出数据范围";
             qDebug() << "2. 没有正确设置活动标量数组";
@@ -380,3 +438,96 @@ void ContourWidget::updateContours()
     emit contoursChanged();
 }
 
+void ContourWidget::updateBrickContours()
+{
+    const std::vector<double> values(m_contourValues.begin(), m_contourValues.end());
+    if (m_contourValid && m_requestArray == m_activeArrayName && m_requestIsPointData == m_activeIsPointData
+        && m_requestValues == values) {
+        return; // 数组与等值都未变，沿用已有结果
+    }
+    if (m_contourWatcher.isRunning()) {
+        // 连续修改期间只保留最新的请求，中间的请求直接丢弃
+        m_contourPending = true;
+        return;
+    }
+    
+    m_requestArray = m_activeArrayName;
+    m_requestIsPointData = m_activeIsPointData;
+    m_requestValues = values;
+    m_contourValid = true;
+    
+    double arrayRange[2];
+    std::vector<int> ids;
+    if (!m_bricks->range(m_activeArrayName, m_activeIsPointData, arrayRange)) {
+        // 派生场只存在于概览中，块文件里没有
+        qDebug() << "ContourWidget: 分块数据中没有数组" << m_activeArrayName;
+    } else {
+        ids = m_bricks->bricksInRange(m_activeArrayName, m_activeIsPointData, values);
+    }
+    
+    // 只读入数组范围包含某个等值的块，各块在线程池上各自提取；读盘与提取都不占用界面线程
+    BrickStore *bricks = m_bricks;
+    const QByteArray arrayName = m_activeArrayName.toUtf8();
+    const int association = m_activeIsPointData ? vtkDataObject::FIELD_ASSOCIATION_POINTS
+                                                : vtkDataObject::FIELD_ASSOCIATION_CELLS;
+    const int revision = m_contourRevision;
+    m_contourWatcher.setFuture(QtConcurrent::run([bricks, ids, values, arrayName, association, revision]() {
+        TRACE_SCOPE("ContourWidget::updateBrickContours", "compute");
+        ContourResult result;
+        result.revision = revision;
+        if (ids.empty()) {
+            return result;
+        }
+        QString error;
+        const bool ok = bricks->process(ids,
+            [&values, &arrayName, association](vtkUnstructuredGrid *brick) {
+                vtkSmartPointer<vtkContourFilter> contour = vtkSmartPointer<vtkContourFilter>::New();
+                contour->SetInputData(brick);
+                // 按名称指定数组，不改动缓存中块的活动标量
+                contour->SetInputArrayToProcess(0, 0, 0, association, arrayName.constData());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    contour->SetValue(static_cast<int>(i), values[i]);
+                }
+                contour->Update();
+                return vtkSmartPointer<vtkPolyData>(contour->GetOutput());
+            }, result.pieces, &error);
+        if (!ok) {
+            qDebug() << "ContourWidget: 分块等值面失败:" << error;
+        }
+        return result;
+    }));
+}
+
+void ContourWidget::onBrickContoursReady()
+{
+    const ContourResult result = m_contourWatcher.result();
+    if (!m_bricks || result.revision != m_bricks->revision()) {
+        // 属于之前的模型；计算期间为新模型发出的请求被推迟了，现在补上
+        if (m_bricks && m_contourPending) {
+            m_contourPending = false;
+            updateBrickContours();
+        }
+        return;
+    }
+    
+    // 计算期间请求又变了时先显示这次的结果，再按最新请求计算
+    m_brickAppend->RemoveAllInputs();
+    for (const vtkSmartPointer<vtkPolyData> &piece : result.pieces) {
+        if (piece && piece->GetNumberOfCells() > 0) {
+            m_brickAppend->AddInputData(piece);
+        }
+    }
+    if (m_brickAppend->GetNumberOfInputConnections(0) == 0) {
+        m_brickAppend->AddInputData(vtkSmartPointer<vtkPolyData>::New());
+    }
+    m_brickAppend->Update();
+    qDebug() << "ContourWidget: 分块等值面完成，块数:" << result.pieces.size()
+             << "输出单元数:" << m_brickAppend->GetOutput()->GetNumberOfCells();
+    if (m_contourEnabled && m_inputData) {
+        emit contoursChanged();
+    }
+    if (m_contourPending) {
+        m_contourPending = false;
+        updateBrickContours();
+    }
+}
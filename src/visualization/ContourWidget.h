@@ -12,9 +12,11 @@
 #include <QCheckBox>
 #include <QGroupBox>
 #include <QListWidget>
+#include <QFutureWatcher>
 
 #include <vtkSmartPointer.h>
 #include <vtkContourFilter.h>
+#include <vtkAppendPolyData.h>
 #include <vtkDataSetMapper.h>
 #include <vtkActor.h>
 #include <vtkRenderer.h>
@@ -22,8 +24,12 @@
 #include <vtkProperty.h>
 #include <vtkPointData.h>
 #include <vtkCellData.h>
+#include <vtkPolyData.h>
 #include <QList>
 #include <cmath>
+#include <vector>
+
+class BrickStore;
 
 class ContourWidget : public QWidget
 {
@@ -37,7 +43,16 @@ public:
     void setRenderer(vtkRenderer *renderer);
     void setDataRange(double min, double max);
     void setActiveScalarArray(const QString &arrayName, bool isPointData);
+    // 分块模式：data 为模型外表面，等值面改为逐块提取后合并；传入空指针恢复普通模式。
+    // 各块的提取在后台线程上进行，清除前等待正在进行的计算结束
+    void setBrickStore(BrickStore *store);
     vtkActor* getContourActor() const { return m_contourActor; }
+    vtkAlgorithm* getContourFilter() const { return m_contourFilter; }
+    // 显示的等值面（分块模式下为各块结果的合并）
+    vtkAlgorithm* getOutputFilter() const
+    {
+        return m_bricks ? static_cast<vtkAlgorithm *>(m_brickAppend) : static_cast<vtkAlgorithm *>(m_contourFilter);
+    }
 
 signals:
     void contoursChanged();
@@ -48,11 +63,19 @@ private slots:
     void onRemoveContour();
     void onClearContours();
     void onAutoContoursChanged();
+    void onBrickContoursReady();
 
 private:
+    struct ContourResult
+    {
+        int revision = 0;
+        std::vector<vtkSmartPointer<vtkPolyData>> pieces;
+    };
+
     void setupUI();
     void setupVTK();
     void updateContours();
+    void updateBrickContours();
     void generateAutoContours();
 
     // UI组件
@@ -75,12 +98,23 @@ private:
     vtkSmartPointer<vtkActor> m_contourActor;
     vtkSmartPointer<vtkRenderer> m_renderer;
     vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
+    vtkSmartPointer<vtkAppendPolyData> m_brickAppend;  // 分块模式：各块等值面的合并
+    BrickStore *m_bricks;
+    QFutureWatcher<ContourResult> m_contourWatcher;
+    bool m_contourPending;                  // 计算期间请求又变了，结束后按最新请求再算一次
+    bool m_contourValid;                    // 下面的请求已计算或正在计算
+    int m_contourRevision;
+    QString m_requestArray;
+    bool m_requestIsPointData;
+    std::vector<double> m_requestValues;
 
     // 数据
     double m_dataMin;
     double m_dataMax;
     bool m_contourEnabled;
     QList<double> m_contourValues;
+    QString m_activeArrayName;
+    bool m_activeIsPointData;
 };
 
 #endif // CONTOURWIDGET_H
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "EvenlySpacedStreamlines.h"
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <vtkIdList.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int kKeyBits = 21;
+const std::int64_t kKeyBias = std::int64_t(1) << (kKeyBits - 1);
+const std::uint64_t kKeyMask = (std::uint64_t(1) << kKeyBits) - 1;
+
+void normalize(double v[3])
+{
+    double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length > 0.0) {
+        v[0] /= length;
+        v[1] /= length;
+        v[2] /= length;
+    }
+}
+
+void cross(const double a[3], const double b[3], double out[3])
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+} // namespace
+
+void EvenlySpacedStreamlines::OccupancyGrid::reset(const double origin[3], double voxelSize)
+{
+    m_origin[0] = origin[0];
+    m_origin[1] = origin[1];
+    m_origin[2] = origin[2];
+    m_inverseVoxelSize = 1.0 / voxelSize;
+    m_cells.clear();
+}
+
+std::uint64_t EvenlySpacedStreamlines::OccupancyGrid::key(const double x[3]) const
+{
+    std::uint64_t result = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        std::int64_t index = static_cast<std::int64_t>(std::floor((x[axis] - m_origin[axis]) * m_inverseVoxelSize));
+        result |= (static_cast<std::uint64_t>(index + kKeyBias) & kKeyMask) << (axis * kKeyBits);
+    }
+    return result;
+}
+
+std::uint64_t EvenlySpacedStreamlines::OccupancyGrid::offsetKey(std::uint64_t key, int di, int dj, int dk) const
+{
+    const int offsets[3] = {di, dj, dk};
+    std::uint64_t result = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        std::uint64_t index = (key >> (axis * kKeyBits)) & kKeyMask;
+        result |= ((index + offsets[axis]) & kKeyMask) << (axis * kKeyBits);
+    }
+    return result;
+}
+
+int EvenlySpacedStreamlines::OccupancyGrid::owner(std::uint64_t key) const
+{
+    auto it = m_cells.find(key);
+    return it == m_cells.end() ? -1 : it->second;
+}
+
+void EvenlySpacedStreamlines::OccupancyGrid::occupy(std::uint64_t key, int lineId)
+{
+    m_cells.emplace(key, lineId);
+}
+
+EvenlySpacedStreamlines::EvenlySpacedStreamlines()
+    : m_interpolator(nullptr)
+    , m_parameters{0.0, 0.5, 0.0, 0, 0}
+    , m_neighbourRadius(2)
+    , m_lastLineCount(0)
+    , m_lastSeedAttempts(0)
+    , m_lastIntegrationSteps(0)
+{
+}
+
+bool EvenlySpacedStreamlines::unitVelocity(const double x[3], double v[3], FieldInterpolator::Workspace &ws)
+{
+    if (m_interpolator->interpolate(x, v, ws) < 0) {
+        return false;
+    }
+
+    double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length < 1e-12) {
+        return false; // 驻点
+    }
+
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+    return true;
+}
+
+bool EvenlySpacedStreamlines::isSeedFree(const double x[3]) const
+{
+    const std::uint64_t center = m_grid.key(x);
+    for (int di = -m_neighbourRadius; di <= m_neighbourRadius; ++di) {
+        for (int dj = -m_neighbourRadius; dj <= m_neighbourRadius; ++dj) {
+            for (int dk = -m_neighbourRadius; dk <= m_neighbourRadius; ++dk) {
+                if (m_grid.owner(m_grid.offsetKey(center, di, dj, dk)) >= 0) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void EvenlySpacedStreamlines::traceDirection(const double seed[3], int direction, int lineId,
+                                             std::unordered_map<std::uint64_t, int> &visited,
+                                             std::vector<double> &points, FieldInterpolator::Workspace &ws)
+{
+    const double h = m_parameters.stepSize * direction;
+
+    // 同一条流线（含另一方向）回到自身较早经过的体素时视为闭合，避免环状流线重复缠绕
+    const int loopWindow = static_cast<int>(std::ceil(2.0 * m_parameters.separation / m_parameters.stepSize)) + 2;
+
+    double x[3] = {seed[0], seed[1], seed[2]};
+    double k1[3], k2[3], k3[3], k4[3];
+    double probe[3];
+
+    if (!unitVelocity(x, k1, ws)) {
+        return;
+    }
+
+    for (int step = 1; step <= m_parameters.maxSteps; ++step) {
+        // 四阶龙格-库塔，按弧长参数化
+        for (int i = 0; i < 3; ++i) probe[i] = x[i] + 0.5 * h * k1[i];
+        if (!unitVelocity(probe, k2, ws)) break;
+        for (int i = 0; i < 3; ++i) probe[i] = x[i] + 0.5 * h * k2[i];
+        if (!unitVelocity(probe, k3, ws)) break;
+        for (int i = 0; i < 3; ++i) probe[i] = x[i] + h * k3[i];
+        if (!unitVelocity(probe, k4, ws)) break;
+
+        double next[3];
+        for (int i = 0; i < 3; ++i) {
+            next[i] = x[i] + h * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]) / 6.0;
+        }
+        ++m_lastIntegrationSteps;
+
+        // 下一步的 k1 同时用于判断是否离开网格
+        double nextK1[3];
+        if (!unitVelocity(next, nextK1, ws)) break;
+
+        const std::uint64_t key = m_grid.key(next);
+        int owner = m_grid.owner(key);
+        if (owner >= 0 && owner != lineId) {
+            break; // 进入其它流线的占据区域
+        }
+
+        const int stepIndex = step * direction;
+        auto it = visited.find(key);
+        if (it != visited.end()) {
+            if (std::abs(stepIndex - it->second) > loopWindow) {
+                break;
+            }
+        } else {
+            visited.emplace(key, stepIndex);
+        }
+
+        points.insert(points.end(), next, next + 3);
+        std::copy(next, next + 3, x);
+        std::copy(nextK1, nextK1 + 3, k1);
+    }
+}
+
+void EvenlySpacedStreamlines::enqueueNeighbourSeeds(const std::vector<double> &points,
+                                                    std::deque<std::vector<double>> &queue) const
+{
+    const size_t count = points.size() / 3;
+    if (count < 2) return;
+
+    const size_t stride = std::max<size_t>(1, static_cast<size_t>(m_parameters.separation / m_parameters.stepSize));
+    for (size_t i = 0; i < count; i += stride) {
+        size_t a = (i + 1 < count) ? i : i - 1;
+        const double *p = &points[3 * i];
+        double tangent[3] = {
+            points[3 * (a + 1)] - points[3 * a],
+            points[3 * (a + 1) + 1] - points[3 * a + 1],
+            points[3 * (a + 1) + 2] - points[3 * a + 2]
+        };
+        normalize(tangent);
+
+        // 选取与切向最不平行的坐标轴构造两个垂直方向
+        double axis[3] = {0.0, 0.0, 0.0};
+        int minAxis = 0;
+        for (int k = 1; k < 3; ++k) {
+            if (std::abs(tangent[k]) < std::abs(tangent[minAxis])) minAxis = k;
+        }
+        axis[minAxis] = 1.0;
+
+        double n1[3], n2[3];
+        cross(tangent, axis, n1);
+        normalize(n1);
+        cross(tangent, n1, n2);
+
+        const double d = m_parameters.separation;
+        for (int sign = -1; sign <= 1; sign += 2) {
+            queue.push_back({p[0] + sign * d * n1[0], p[1] + sign * d * n1[1], p[2] + sign * d * n1[2]});
+            queue.push_back({p[0] + sign * d * n2[0], p[1] + sign * d * n2[1], p[2] + sign * d * n2[2]});
+        }
+    }
+}
+
+vtkSmartPointer<vtkPolyData> EvenlySpacedStreamlines::generate(const double bounds[6], const Parameters &parameters)
+{
+    m_lastLineCount = 0;
+    m_lastSeedAttempts = 0;
+    m_lastIntegrationSteps = 0;
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+    output->SetPoints(points);
+    output->SetLines(lines);
+
+    if (!m_interpolator || !m_interpolator->isValid() || m_interpolator->numberOfComponents() != 3 ||
+        parameters.separation <= 0.0 || parameters.stepSize <= 0.0) {
+        return output;
+    }
+
+    m_parameters = parameters;
+    const double testDistance = parameters.separation * parameters.testRatio;
+    const double origin[3] = {bounds[0], bounds[2], bounds[4]};
+    m_grid.reset(origin, testDistance);
+    m_neighbourRadius = static_cast<int>(std::ceil(parameters.separation / testDistance));
+
+    FieldInterpolator::Workspace ws;
+    std::deque<std::vector<double>> queue;
+    queue.push_back({(bounds[0] + bounds[1]) / 2.0, (bounds[2] + bounds[3]) / 2.0, (bounds[4] + bounds[5]) / 2.0});
+
+    // 种子队列耗尽后按 d_sep 间隔扫描包围盒，填补剩余空隙
+    int scanDims[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        scanDims[axis] = std::max(1, static_cast<int>(std::ceil((bounds[2 * axis + 1] - bounds[2 * axis]) / parameters.separation)));
+    }
+    const long long scanTotal = static_cast<long long>(scanDims[0]) * scanDims[1] * scanDims[2];
+    long long scanIndex = 0;
+
+    std::vector<double> backward;
+    std::vector<double> forward;
+    std::vector<double> line;
+    std::unordered_map<std::uint64_t, int> visited;
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+
+    int lineId = 0;
+    while (lineId < parameters.maxLines && m_lastSeedAttempts < parameters.maxSeedAttempts) {
+        double seed[3];
+        if (!queue.empty()) {
+            std::copy(queue.front().begin(), queue.front().end(), seed);
+            queue.pop_front();
+        } else if (scanIndex < scanTotal) {
+            long long i = scanIndex % scanDims[0];
+            long long j = (scanIndex / scanDims[0]) % scanDims[1];
+            long long k = scanIndex / (static_cast<long long>(scanDims[0]) * scanDims[1]);
+            seed[0] = bounds[0] + (i + 0.5) * parameters.separation;
+            seed[1] = bounds[2] + (j + 0.5) * parameters.separation;
+            seed[2] = bounds[4] + (k + 0.5) * parameters.separation;
+            ++scanIndex;
+        } else {
+            break;
+        }
+
+        ++m_lastSeedAttempts;
+        if (!isSeedFree(seed)) continue;
+
+        double velocity[3];
+        ws.lastCellId = -1;
+        if (!unitVelocity(seed, velocity, ws)) continue;
+
+        backward.clear();
+        forward.clear();
+        visited.clear();
+        visited.emplace(m_grid.key(seed), 0);
+        traceDirection(seed, -1, lineId, visited, backward, ws);
+        ws.lastCellId = -1;
+        traceDirection(seed, 1, lineId, visited, forward, ws);
+
+        line.clear();
+        for (size_t n = backward.size() / 3; n > 0; --n) {
+            line.insert(line.end(), backward.begin() + 3 * (n - 1), backward.begin() + 3 * n);
+        }
+        line.insert(line.end(), seed, seed + 3);
+        line.insert(line.end(), forward.begin(), forward.end());
+
+        const vtkIdType count = static_cast<vtkIdType>(line.size() / 3);
+        if (count < 3) continue;
+
+        // 整条流线完成后再写入占据网格，追踪过程中只与已提交的流线比较
+        ids->SetNumberOfIds(count);
+        for (vtkIdType n = 0; n < count; ++n) {
+            const double *p = &line[3 * n];
+            m_grid.occupy(m_grid.key(p), lineId);
+            ids->SetId(n, points->InsertNextPoint(p));
+        }
+        lines->InsertNextCell(ids);
+
+        enqueueNeighbourSeeds(line, queue);
+        ++lineId;
+    }
+
+    m_lastLineCount = lineId;
+    return output;
+}
@@ -0,0 +1,77 @@
+#ifndef EVENLYSPACEDSTREAMLINES_H
+#define EVENLYSPACEDSTREAMLINES_H
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkPolyData.h>
+
+#include "core/FieldInterpolator.h"
+
+// 均匀间隔流线生成（Jobard-Lefer 思路的三维版本）
+// 已追踪的流线写入体素哈希占据网格：新流线进入他线占据的体素即终止，
+// 新种子只放在邻域空闲的位置，从而以较少的积分量覆盖整个区域
+class EvenlySpacedStreamlines
+{
+public:
+    struct Parameters
+    {
+        double separation;      // 流线间距 d_sep（世界坐标）
+        double testRatio;       // 终止距离 d_test = testRatio * d_sep
+        double stepSize;        // 积分步长（弧长）
+        int maxSteps;           // 单方向最大步数
+        int maxLines;           // 最大流线数量
+        int maxSeedAttempts;    // 种子尝试次数上限：场稀疏或为零时包围盒扫描几乎全部落空，须另行限制
+    };
+
+    EvenlySpacedStreamlines();
+
+    // 不共享状态：每个线程使用自己的实例（插值器本身可被多个线程同时使用）
+
+    void setInterpolator(const FieldInterpolator *interpolator) { m_interpolator = interpolator; }
+
+    // 在包围盒范围内生成流线，返回折线集合
+    vtkSmartPointer<vtkPolyData> generate(const double bounds[6], const Parameters &parameters);
+
+    int lastLineCount() const { return m_lastLineCount; }
+    int lastSeedAttempts() const { return m_lastSeedAttempts; }
+    long long lastIntegrationSteps() const { return m_lastIntegrationSteps; }
+
+private:
+    // 体素哈希占据网格，记录每个体素被哪条流线占据
+    class OccupancyGrid
+    {
+    public:
+        void reset(const double origin[3], double voxelSize);
+        std::uint64_t key(const double x[3]) const;
+        std::uint64_t offsetKey(std::uint64_t key, int di, int dj, int dk) const;
+        int owner(std::uint64_t key) const;
+        void occupy(std::uint64_t key, int lineId);
+
+    private:
+        double m_origin[3];
+        double m_inverseVoxelSize;
+        std::unordered_map<std::uint64_t, int> m_cells;
+    };
+
+    bool isSeedFree(const double x[3]) const;
+    void traceDirection(const double seed[3], int direction, int lineId,
+                        std::unordered_map<std::uint64_t, int> &visited,
+                        std::vector<double> &points, FieldInterpolator::Workspace &ws);
+    bool unitVelocity(const double x[3], double v[3], FieldInterpolator::Workspace &ws);
+    void enqueueNeighbourSeeds(const std::vector<double> &points, std::deque<std::vector<double>> &queue) const;
+
+    const FieldInterpolator *m_interpolator;
+    Parameters m_parameters;
+    OccupancyGrid m_grid;
+    int m_neighbourRadius;
+
+    int m_lastLineCount;
+    int m_lastSeedAttempts;
+    long long m_lastIntegrationSteps;
+};
+
+#endif // EVENLYSPACEDSTREAMLINES_H
@@ -0,0 +1,232 @@
+#include "HeadlessRenderer.h"
+#include "ImageExporter.h"
+#include "ColorMaps.h"
+#include "io/ReaderRegistry.h"
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFileInfo>
+#include <vtkSmartPointer.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkCamera.h>
+#include <vtkActor.h>
+#include <vtkDataSetMapper.h>
+#include <vtkLookupTable.h>
+#include <vtkScalarBarActor.h>
+#include <vtkTextProperty.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPointData.h>
+#include <vtkCellData.h>
+#include <vtkDataArray.h>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+// 离屏窗口（即每个分块）的最大边长
+const int MAX_TILE_SIZE = 2048;
+
+bool hasArgument(int argc, char *argv[], const char *name)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseSize(const QString &text, int *width, int *height)
+{
+    const QStringList parts = text.toLower().split('x');
+    if (parts.size() != 2) {
+        return false;
+    }
+    bool okWidth = false;
+    bool okHeight = false;
+    *width = parts[0].trimmed().toInt(&okWidth);
+    *height = parts[1].trimmed().toInt(&okHeight);
+    return okWidth && okHeight && *width > 0 && *height > 0;
+}
+
+// 与主窗口一样经读取器注册表读取；纯几何文件或读取失败时返回空网格
+vtkSmartPointer<vtkUnstructuredGrid> readGrid(const QString &fileName)
+{
+    QString error;
+    vtkSmartPointer<vtkUnstructuredGrid> grid =
+        vtkUnstructuredGrid::SafeDownCast(ReaderRegistry::instance().read(fileName, &error));
+    if (!grid) {
+        qWarning() << "HeadlessRenderer:" << error;
+        grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    }
+    return grid;
+}
+}
+
+bool HeadlessRenderer::isRequested(int argc, char *argv[])
+{
+    return hasArgument(argc, argv, "--screenshot");
+}
+
+bool HeadlessRenderer::softwareOpenGLRequested(int argc, char *argv[])
+{
+    return hasArgument(argc, argv, "--software-gl");
+}
+
+int HeadlessRenderer::run(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("无界面导出截图或旋转动画帧序列");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "结果文件 (.vtu / .vtk / .inp / .bdf / .frd 等)");
+    QCommandLineOption screenshotOption("screenshot", "输出 PNG 文件；导出帧序列时为文件名前缀", "文件");
+    QCommandLineOption sizeOption("size", "图像尺寸，如 7680x4320", "宽x高", "3840x2160");
+    QCommandLineOption arrayOption("array", "着色数组名（缺省为第一个点数据数组）", "名称");
+    QCommandLineOption colorMapOption("colormap", "颜色映射名称", "名称", ColorMaps::names().first());
+    QCommandLineOption framesOption("frames", "绕视图上方向旋转一周导出的帧数（0 为单张截图）", "帧数", "0");
+    QCommandLineOption softwareOption("software-gl", "使用软件 OpenGL（OSMesa/llvmpipe）离屏渲染");
+    parser.addOptions({screenshotOption, sizeOption, arrayOption, colorMapOption, framesOption, softwareOption});
+    parser.process(arguments);
+
+    if (parser.positionalArguments().isEmpty()) {
+        qWarning() << "HeadlessRenderer: 未指定结果文件";
+        return 1;
+    }
+    int width = 0;
+    int height = 0;
+    if (!parseSize(parser.value(sizeOption), &width, &height)) {
+        qWarning() << "HeadlessRenderer: 无效的图像尺寸" << parser.value(sizeOption);
+        return 1;
+    }
+
+    // 没有显示服务器或显式要求时改用 VTK 的 OSMesa 离屏窗口（运行时加载软件 OpenGL）
+#ifdef Q_OS_LINUX
+    const bool noDisplay = qEnvironmentVariableIsEmpty("DISPLAY") && qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY");
+#else
+    const bool noDisplay = false;
+#endif
+    if ((parser.isSet(softwareOption) || noDisplay) && qEnvironmentVariableIsEmpty("VTK_DEFAULT_OPENGL_WINDOW")) {
+        qputenv("VTK_DEFAULT_OPENGL_WINDOW", "vtkOSOpenGLRenderWindow");
+        qDebug() << "HeadlessRenderer: 使用软件 OpenGL 离屏渲染";
+    }
+
+    const QString fileName = parser.positionalArguments().first();
+    vtkSmartPointer<vtkUnstructuredGrid> grid = readGrid(fileName);
+    if (grid->GetNumberOfCells() == 0) {
+        qWarning() << "HeadlessRenderer: 无法读取" << fileName;
+        return 1;
+    }
+
+    // 着色数组：与主窗口一致，矢量按模着色
+    QString arrayName = parser.value(arrayOption);
+    bool isPointData = true;
+    vtkDataArray *array = nullptr;
+    if (arrayName.isEmpty()) {
+        if (grid->GetPointData()->GetNumberOfArrays() > 0) {
+            array = grid->GetPointData()->GetArray(0);
+        } else if (grid->GetCellData()->GetNumberOfArrays() > 0) {
+            array = grid->GetCellData()->GetArray(0);
+            isPointData = false;
+        }
+    } else {
+        array = grid->GetPointData()->GetArray(arrayName.toStdString().c_str());
+        if (!array) {
+            array = grid->GetCellData()->GetArray(arrayName.toStdString().c_str());
+            isPointData = false;
+        }
+        if (!array) {
+            qWarning() << "HeadlessRenderer: 找不到数组" << arrayName;
+            return 1;
+        }
+    }
+
+    vtkSmartPointer<vtkLookupTable> lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    if (!ColorMaps::apply(parser.value(colorMapOption), lookupTable)) {
+        qWarning() << "HeadlessRenderer: 未知颜色映射" << parser.value(colorMapOption)
+                   << "可选:" << ColorMaps::names().join(", ");
+        return 1;
+    }
+    lookupTable->SetVectorModeToMagnitude();
+
+    vtkSmartPointer<vtkDataSetMapper> mapper = vtkSmartPointer<vtkDataSetMapper>::New();
+    mapper->SetInputData(grid);
+    mapper->InterpolateScalarsBeforeMappingOn();
+    mapper->ScalarVisibilityOff();
+
+    vtkSmartPointer<vtkScalarBarActor> scalarBar;
+    if (array && array->GetName()) {
+        double range[2];
+        array->GetRange(range, array->GetNumberOfComponents() == 1 ? 0 : -1);
+        lookupTable->SetTableRange(range);
+
+        mapper->ScalarVisibilityOn();
+        if (isPointData) {
+            mapper->SetScalarModeToUsePointFieldData();
+        } else {
+            mapper->SetScalarModeToUseCellFieldData();
+        }
+        mapper->SelectColorArray(array->GetName());
+        mapper->SetLookupTable(lookupTable);
+        mapper->UseLookupTableScalarRangeOn();
+
+        // 标量条与主窗口相同：横向，右下角
+        scalarBar = vtkSmartPointer<vtkScalarBarActor>::New();
+        scalarBar->SetLookupTable(lookupTable);
+        scalarBar->SetTitle(array->GetName());
+        scalarBar->SetNumberOfLabels(5);
+        scalarBar->SetOrientationToHorizontal();
+        scalarBar->SetWidth(0.4);
+        scalarBar->SetHeight(0.08);
+        scalarBar->SetPosition(0.55, 0.05);
+        scalarBar->GetTitleTextProperty()->SetColor(1.0, 1.0, 1.0);
+        scalarBar->GetLabelTextProperty()->SetColor(1.0, 1.0, 1.0);
+    }
+
+    vtkSmartPointer<vtkActor> actor = vtkSmartPointer<vtkActor>::New();
+    actor->SetMapper(mapper);
+
+    vtkSmartPointer<vtkRenderer> renderer = vtkSmartPointer<vtkRenderer>::New();
+    renderer->SetBackground(0.1, 0.1, 0.1);
+    renderer->AddActor(actor);
+    if (scalarBar) {
+        renderer->AddActor2D(scalarBar);
+    }
+
+    // 离屏窗口取分块大小，使 分块 × 放大倍数 恰好覆盖目标尺寸
+    const int magnification = std::max(1, static_cast<int>(std::ceil(static_cast<double>(std::max(width, height)) / MAX_TILE_SIZE)));
+    vtkSmartPointer<vtkRenderWindow> renderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+    renderWindow->SetOffScreenRendering(1);
+    renderWindow->SetSize((width + magnification - 1) / magnification, (height + magnification - 1) / magnification);
+    renderWindow->AddRenderer(renderer);
+
+    // 与主窗口 resetView 相同的初始视角
+    renderer->ResetCamera();
+    vtkCamera *camera = renderer->GetActiveCamera();
+    camera->SetViewUp(0, 1, 0);
+    camera->Azimuth(30);
+    camera->Elevation(30);
+    renderer->ResetCameraClippingRange();
+    renderWindow->Render();
+
+    ImageExporter exporter;
+    const QString output = parser.value(screenshotOption);
+    const int frames = parser.value(framesOption).toInt();
+    if (frames > 0) {
+        QString prefix = output;
+        if (prefix.endsWith(".png", Qt::CaseInsensitive)) {
+            prefix.chop(4);
+        }
+        exporter.exportTurntable(renderWindow, renderer, width, height, frames, prefix);
+    } else {
+        exporter.exportImage(renderWindow, width, height, output);
+    }
+    exporter.waitForFinished();
+
+    if (exporter.failedCount() > 0) {
+        qWarning() << "HeadlessRenderer: 保存失败的图像数" << exporter.failedCount();
+        return 1;
+    }
+    qDebug() << "HeadlessRenderer: 导出完成" << QFileInfo(output).absoluteFilePath();
+    return 0;
+}
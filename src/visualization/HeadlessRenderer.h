@@ -0,0 +1,24 @@
+#ifndef HEADLESSRENDERER_H
+#define HEADLESSRENDERER_H
+
+#include <QStringList>
+
+// 无界面渲染：不创建窗口，读取结果文件后在离屏窗口中按指定数组着色，
+// 导出高分辨率截图或旋转动画帧序列。可在没有 GPU 的机器上使用软件 OpenGL
+//
+// 用法: FEMResultViewer --screenshot out.png [--size 7680x4320] [--array 名称]
+//                       [--colormap 名称] [--frames 72] [--software-gl] 文件.vtu
+class HeadlessRenderer
+{
+public:
+    // 命令行是否请求无界面导出（在创建 QApplication 之前调用）
+    static bool isRequested(int argc, char *argv[]);
+
+    // 是否要求软件 OpenGL
+    static bool softwareOpenGLRequested(int argc, char *argv[]);
+
+    // 在 QCoreApplication 中运行，返回进程退出码
+    static int run(const QStringList &arguments);
+};
+
+#endif // HEADLESSRENDERER_H
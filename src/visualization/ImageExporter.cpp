@@ -0,0 +1,164 @@
+#include "ImageExporter.h"
+#include "core/TraceRecorder.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <vtkCamera.h>
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+#include <vtkWindowToImageFilter.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// 每个编码线程最多排队两帧
+const int QUEUED_FRAMES_PER_THREAD = 2;
+}
+
+ImageExporter::ImageExporter(QObject *parent)
+    : QObject(parent)
+    , m_queueSlots(std::max(1, QThread::idealThreadCount()) * QUEUED_FRAMES_PER_THREAD)
+    , m_failed(0)
+    , m_canceled(false)
+{
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+}
+
+ImageExporter::~ImageExporter()
+{
+    waitForFinished();
+}
+
+QImage ImageExporter::renderImage(vtkRenderWindow *renderWindow, int width, int height)
+{
+    TRACE_SCOPE("ImageExporter::renderImage", "render");
+    if (!renderWindow || width <= 0 || height <= 0) {
+        return QImage();
+    }
+
+    const int *size = renderWindow->GetSize();
+    const int windowWidth = std::max(size[0], 1);
+    const int windowHeight = std::max(size[1], 1);
+
+    // 两个方向取较大的放大倍数，保证裁剪后仍不低于目标分辨率
+    const int magnification = std::max(1, static_cast<int>(std::ceil(
+        std::max(static_cast<double>(width) / windowWidth, static_cast<double>(height) / windowHeight))));
+
+    vtkSmartPointer<vtkWindowToImageFilter> capture = vtkSmartPointer<vtkWindowToImageFilter>::New();
+    capture->SetInput(renderWindow);
+    capture->SetScale(magnification, magnification);
+    capture->SetInputBufferTypeToRGB();
+    capture->ReadFrontBufferOff();
+    capture->ShouldRerenderOn();
+    capture->FixBoundaryOn();
+    capture->Update();
+
+    vtkImageData *image = capture->GetOutput();
+    int dims[3];
+    image->GetDimensions(dims);
+    if (dims[0] <= 0 || dims[1] <= 0 || !image->GetScalarPointer()) {
+        return QImage();
+    }
+
+    // VTK 图像原点在左下角，逐行翻转
+    QImage full(dims[0], dims[1], QImage::Format_RGB888);
+    const unsigned char *pixels = static_cast<const unsigned char *>(image->GetScalarPointer());
+    const size_t rowBytes = static_cast<size_t>(dims[0]) * 3;
+    for (int row = 0; row < dims[1]; ++row) {
+        std::memcpy(full.scanLine(dims[1] - 1 - row), pixels + row * rowBytes, rowBytes);
+    }
+
+    // 居中裁剪到目标宽高比，再缩放到目标尺寸
+    const double targetAspect = static_cast<double>(width) / height;
+    int cropWidth = dims[0];
+    int cropHeight = dims[1];
+    if (cropWidth > cropHeight * targetAspect) {
+        cropWidth = std::max(1, static_cast<int>(std::lround(cropHeight * targetAspect)));
+    } else {
+        cropHeight = std::max(1, static_cast<int>(std::lround(cropWidth / targetAspect)));
+    }
+    if (cropWidth != dims[0] || cropHeight != dims[1]) {
+        full = full.copy((dims[0] - cropWidth) / 2, (dims[1] - cropHeight) / 2, cropWidth, cropHeight);
+    }
+    if (full.width() != width || full.height() != height) {
+        full = full.scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    return full;
+}
+
+void ImageExporter::exportImage(vtkRenderWindow *renderWindow, int width, int height, const QString &fileName)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QImage image = renderImage(renderWindow, width, height);
+    qDebug() << "ImageExporter: 渲染" << width << "x" << height << "耗时(ms):" << timer.elapsed();
+
+    if (image.isNull()) {
+        ++m_failed;
+        emit imageSaved(fileName, false);
+        return;
+    }
+    enqueue(image, fileName);
+}
+
+int ImageExporter::exportTurntable(vtkRenderWindow *renderWindow, vtkRenderer *renderer, int width, int height,
+                                   int frameCount, const QString &filePrefix)
+{
+    if (!renderWindow || !renderer || frameCount <= 0) {
+        return 0;
+    }
+
+    m_canceled = false;
+    vtkCamera *camera = renderer->GetActiveCamera();
+    const double step = 360.0 / frameCount;
+
+    int rendered = 0;
+    for (int frame = 0; frame < frameCount && !m_canceled; ++frame) {
+        const QString fileName = QString("%1_%2.png").arg(filePrefix).arg(frame, 4, 10, QChar('0'));
+        exportImage(renderWindow, width, height, fileName);
+        ++rendered;
+        emit frameRendered(frame + 1, frameCount);
+
+        camera->Azimuth(step);
+        renderer->ResetCameraClippingRange();
+    }
+
+    // 中途取消时把相机转回起始位置
+    if (rendered < frameCount) {
+        camera->Azimuth(-step * rendered);
+        renderer->ResetCameraClippingRange();
+    }
+    renderWindow->Render();
+
+    qDebug() << "ImageExporter: 已渲染帧数" << rendered << "/" << frameCount;
+    return rendered;
+}
+
+void ImageExporter::enqueue(const QImage &image, const QString &fileName)
+{
+    m_queueSlots.acquire();
+
+    // QImage 隐式共享，按值捕获即可在线程间传递
+    m_pool.start([this, image, fileName]() {
+        TRACE_SCOPE("ImageExporter::encodePng", "io");
+        const bool ok = image.save(fileName, "PNG");
+        if (!ok) {
+            ++m_failed;
+            qDebug() << "ImageExporter: 保存失败" << fileName;
+        }
+        m_queueSlots.release();
+        emit imageSaved(fileName, ok);
+    });
+}
+
+void ImageExporter::waitForFinished()
+{
+    m_pool.waitForDone();
+}
+
+void ImageExporter::cancel()
+{
+    m_canceled = true;
+}
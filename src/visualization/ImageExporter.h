@@ -0,0 +1,56 @@
+#ifndef IMAGEEXPORTER_H
+#define IMAGEEXPORTER_H
+
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+#include <QSemaphore>
+
+#include <atomic>
+
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+
+// 图像导出：按任意分辨率分块渲染当前场景，PNG 编码交给后台线程池，
+// 编码上一帧的同时即可渲染下一帧。界面与无界面模式共用
+class ImageExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageExporter(QObject *parent = nullptr);
+    ~ImageExporter();
+
+    // 渲染当前场景到指定尺寸：超出窗口尺寸时按窗口大小分块渲染后拼接，
+    // 宽高比与窗口不同时居中裁剪
+    static QImage renderImage(vtkRenderWindow *renderWindow, int width, int height);
+
+    // 渲染一帧并在后台保存，立即返回
+    void exportImage(vtkRenderWindow *renderWindow, int width, int height, const QString &fileName);
+
+    // 相机绕视图上方向旋转一周，导出 filePrefix_0000.png ... 帧序列，返回已渲染帧数
+    int exportTurntable(vtkRenderWindow *renderWindow, vtkRenderer *renderer, int width, int height,
+                        int frameCount, const QString &filePrefix);
+
+    // 等待所有排队的图像写完
+    void waitForFinished();
+    int failedCount() const { return m_failed.load(); }
+
+public slots:
+    void cancel();
+
+signals:
+    void frameRendered(int frame, int frameCount);
+    void imageSaved(const QString &fileName, bool ok);
+
+private:
+    void enqueue(const QImage &image, const QString &fileName);
+
+    QThreadPool m_pool;
+    QSemaphore m_queueSlots;    // 限制排队帧数，编码跟不上时渲染等待而不是无限占用内存
+    std::atomic<int> m_failed;
+    std::atomic<bool> m_canceled;
+};
+
+#endif // IMAGEEXPORTER_H
@@ -0,0 +1,361 @@
+#include "LineProbeWidget.h"
+#include <QDebug>
+#include <vtkCommand.h>
+#include <vtkPoints.h>
+#include <vtkCellArray.h>
+#include <cstdlib>
+
+LineProbeWidget::LineProbeWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_inputData(nullptr)
+    , m_spatialIndex(nullptr)
+    , m_pressObserver(0)
+    , m_releaseObserver(0)
+    , m_isPointData(true)
+{
+    m_pressPosition[0] = m_pressPosition[1] = 0;
+    setupUI();
+    setupVTK();
+}
+
+LineProbeWidget::~LineProbeWidget()
+{
+    removeInteractorObservers();
+}
+
+void LineProbeWidget::setupUI()
+{
+    setWindowTitle("线探测");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // 探测线定义
+    QGroupBox *lineGroup = new QGroupBox("探测线", this);
+    QVBoxLayout *lineLayout = new QVBoxLayout(lineGroup);
+
+    m_pickModeCheckBox = new QCheckBox("点击模型添加探测点", this);
+    connect(m_pickModeCheckBox, &QCheckBox::toggled, this, &LineProbeWidget::onPickModeToggled);
+    lineLayout->addWidget(m_pickModeCheckBox);
+
+    m_pointListWidget = new QListWidget(this);
+    m_pointListWidget->setMaximumHeight(80);
+    lineLayout->addWidget(m_pointListWidget);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    m_diagonalButton = new QPushButton("包围盒对角线", this);
+    connect(m_diagonalButton, &QPushButton::clicked, this, &LineProbeWidget::onUseDiagonal);
+    buttonLayout->addWidget(m_diagonalButton);
+
+    m_removeLastButton = new QPushButton("删除末点", this);
+    connect(m_removeLastButton, &QPushButton::clicked, this, &LineProbeWidget::onRemoveLastPoint);
+    buttonLayout->addWidget(m_removeLastButton);
+
+    m_clearButton = new QPushButton("清空", this);
+    connect(m_clearButton, &QPushButton::clicked, this, &LineProbeWidget::onClearPoints);
+    buttonLayout->addWidget(m_clearButton);
+    lineLayout->addLayout(buttonLayout);
+
+    mainLayout->addWidget(lineGroup);
+
+    // 采样参数
+    QHBoxLayout *sampleLayout = new QHBoxLayout();
+    sampleLayout->addWidget(new QLabel("采样点数:", this));
+    m_sampleCountSpinBox = new QSpinBox(this);
+    m_sampleCountSpinBox->setRange(2, 100000);
+    m_sampleCountSpinBox->setSingleStep(500);
+    m_sampleCountSpinBox->setValue(2000);
+    sampleLayout->addWidget(m_sampleCountSpinBox);
+    mainLayout->addLayout(sampleLayout);
+
+    m_timeSeriesCheckBox = new QCheckBox("全部时间步", this);
+    m_timeSeriesCheckBox->setEnabled(false);
+    m_timeSeriesCheckBox->setToolTip("数组按 <名称>_t<序号> 命名时，同时绘制所有时间步");
+    connect(m_timeSeriesCheckBox, &QCheckBox::toggled, this, &LineProbeWidget::onProbe);
+    mainLayout->addWidget(m_timeSeriesCheckBox);
+
+    m_probeButton = new QPushButton("探测", this);
+    connect(m_probeButton, &QPushButton::clicked, this, &LineProbeWidget::onProbe);
+    mainLayout->addWidget(m_probeButton);
+
+    m_infoLabel = new QLabel("请先定义探测线", this);
+    mainLayout->addWidget(m_infoLabel);
+
+    // 曲线图
+    m_plotWidget = new PlotWidget(this);
+    m_plotWidget->setAxisLabels("沿线距离", "");
+    mainLayout->addWidget(m_plotWidget, 1);
+
+    setProperty("probeLineVisible", false);
+}
+
+void LineProbeWidget::setupVTK()
+{
+    m_lineData = vtkSmartPointer<vtkPolyData>::New();
+
+    m_lineMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    m_lineMapper->SetInputData(m_lineData);
+    m_lineMapper->ScalarVisibilityOff();
+
+    m_lineActor = vtkSmartPointer<vtkActor>::New();
+    m_lineActor->SetMapper(m_lineMapper);
+    m_lineActor->GetProperty()->SetColor(1.0, 1.0, 1.0);
+    m_lineActor->GetProperty()->SetLineWidth(3.0);
+    m_lineActor->GetProperty()->SetPointSize(8.0);
+    m_lineActor->GetProperty()->RenderPointsAsSpheresOn();
+}
+
+void LineProbeWidget::setData(vtkUnstructuredGrid *data)
+{
+    if (m_inputData == data) {
+        return;
+    }
+
+    m_inputData = data;
+    m_probe.setData(data, m_spatialIndex);
+    m_polyline.clear();
+    m_pointListWidget->clear();
+    m_plotWidget->clear();
+    updateLineGeometry();
+}
+
+void LineProbeWidget::setRenderer(vtkRenderer *renderer)
+{
+    m_renderer = renderer;
+}
+
+void LineProbeWidget::setInteractor(vtkRenderWindowInteractor *interactor)
+{
+    if (m_interactor == interactor) {
+        return;
+    }
+
+    removeInteractorObservers();
+    m_interactor = interactor;
+    if (m_pickModeCheckBox->isChecked()) {
+        onPickModeToggled(true);
+    }
+}
+
+void LineProbeWidget::setSpatialIndex(SpatialIndex *spatialIndex)
+{
+    m_spatialIndex = spatialIndex;
+    m_probe.setData(m_inputData, spatialIndex);
+}
+
+void LineProbeWidget::setActiveScalarArray(const QString &arrayName, bool isPointData)
+{
+    if (m_activeArrayName == arrayName && m_isPointData == isPointData) {
+        return;
+    }
+
+    m_activeArrayName = arrayName;
+    m_isPointData = isPointData;
+    m_plotWidget->setAxisLabels("沿线距离", arrayName);
+    updateTimeSeriesAvailability();
+
+    // 切换数组后自动重新探测（切回旧数组时命中缓存）
+    if (m_polyline.size() >= 2) {
+        onProbe();
+    }
+}
+
+void LineProbeWidget::updateTimeSeriesAvailability()
+{
+    const bool hasSeries = LineProbe::timeSeriesArrays(m_inputData, m_activeArrayName, m_isPointData).size() > 1;
+    m_timeSeriesCheckBox->blockSignals(true);
+    m_timeSeriesCheckBox->setEnabled(hasSeries);
+    if (!hasSeries) {
+        m_timeSeriesCheckBox->setChecked(false);
+    }
+    m_timeSeriesCheckBox->blockSignals(false);
+}
+
+void LineProbeWidget::onPickModeToggled(bool enabled)
+{
+    removeInteractorObservers();
+    if (enabled && m_interactor) {
+        m_pressObserver = m_interactor->AddObserver(vtkCommand::LeftButtonPressEvent,
+                                                    this, &LineProbeWidget::onInteractorEvent);
+        m_releaseObserver = m_interactor->AddObserver(vtkCommand::LeftButtonReleaseEvent,
+                                                      this, &LineProbeWidget::onInteractorEvent);
+    }
+}
+
+void LineProbeWidget::removeInteractorObservers()
+{
+    if (m_interactor) {
+        m_interactor->RemoveObserver(m_pressObserver);
+        m_interactor->RemoveObserver(m_releaseObserver);
+    }
+    m_pressObserver = m_releaseObserver = 0;
+}
+
+void LineProbeWidget::onInteractorEvent(vtkObject *caller, unsigned long eventId, void *callData)
+{
+    Q_UNUSED(caller);
+    Q_UNUSED(callData);
+
+    const int *position = m_interactor->GetEventPosition();
+
+    if (eventId == vtkCommand::LeftButtonPressEvent) {
+        m_pressPosition[0] = position[0];
+        m_pressPosition[1] = position[1];
+        return;
+    }
+
+    // 拖动旋转不算点击
+    if (std::abs(position[0] - m_pressPosition[0]) + std::abs(position[1] - m_pressPosition[1]) > 3) {
+        return;
+    }
+
+    double world[3];
+    if (m_renderer && m_inputData && displayToSurface(position[0], position[1], world)) {
+        addPoint(world);
+    }
+}
+
+bool LineProbeWidget::displayToSurface(int displayX, int displayY, double world[3])
+{
+    // 读取该像素的深度得到可见表面位置，背景处深度为1
+    double z = m_renderer->GetZ(displayX, displayY);
+    if (z >= 1.0) {
+        return false;
+    }
+
+    m_renderer->SetDisplayPoint(displayX, displayY, z);
+    m_renderer->DisplayToWorld();
+    double worldPoint[4];
+    m_renderer->GetWorldPoint(worldPoint);
+    if (worldPoint[3] == 0.0) {
+        return false;
+    }
+
+    world[0] = worldPoint[0] / worldPoint[3];
+    world[1] = worldPoint[1] / worldPoint[3];
+    world[2] = worldPoint[2] / worldPoint[3];
+    return true;
+}
+
+void LineProbeWidget::addPoint(const double point[3])
+{
+    m_polyline.push_back({point[0], point[1], point[2]});
+    m_pointListWidget->addItem(QString("P%1: (%2, %3, %4)")
+                                   .arg(m_polyline.size())
+                                   .arg(point[0], 0, 'f', 3)
+                                   .arg(point[1], 0, 'f', 3)
+                                   .arg(point[2], 0, 'f', 3));
+    updateLineGeometry();
+
+    if (m_polyline.size() >= 2) {
+        onProbe();
+    }
+}
+
+void LineProbeWidget::onUseDiagonal()
+{
+    if (!m_inputData) {
+        return;
+    }
+
+    double bounds[6];
+    m_inputData->GetBounds(bounds);
+    onClearPoints();
+
+    const double start[3] = {bounds[0], bounds[2], bounds[4]};
+    const double end[3] = {bounds[1], bounds[3], bounds[5]};
+    addPoint(start);
+    addPoint(end);
+}
+
+void LineProbeWidget::onRemoveLastPoint()
+{
+    if (m_polyline.empty()) {
+        return;
+    }
+
+    m_polyline.pop_back();
+    delete m_pointListWidget->takeItem(m_pointListWidget->count() - 1);
+    updateLineGeometry();
+
+    if (m_polyline.size() >= 2) {
+        onProbe();
+    } else {
+        m_plotWidget->clear();
+    }
+}
+
+void LineProbeWidget::onClearPoints()
+{
+    m_polyline.clear();
+    m_pointListWidget->clear();
+    m_plotWidget->clear();
+    m_infoLabel->setText("请先定义探测线");
+    updateLineGeometry();
+}
+
+void LineProbeWidget::updateLineGeometry()
+{
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+    vtkSmartPointer<vtkCellArray> lines = vtkSmartPointer<vtkCellArray>::New();
+
+    for (const LineProbe::Point &p : m_polyline) {
+        vtkIdType id = points->InsertNextPoint(p[0], p[1], p[2]);
+        verts->InsertNextCell(1, &id);
+    }
+    if (m_polyline.size() >= 2) {
+        lines->InsertNextCell(static_cast<vtkIdType>(m_polyline.size()));
+        for (vtkIdType i = 0; i < static_cast<vtkIdType>(m_polyline.size()); ++i) {
+            lines->InsertCellPoint(i);
+        }
+    }
+
+    m_lineData->SetPoints(points);
+    m_lineData->SetVerts(verts);
+    m_lineData->SetLines(lines);
+    m_lineData->Modified();
+
+    setProperty("probeLineVisible", !m_polyline.empty());
+    emit probeLineChanged();
+}
+
+void LineProbeWidget::onProbe()
+{
+    if (!m_inputData || !m_spatialIndex || m_activeArrayName.isEmpty() || m_polyline.size() < 2) {
+        return;
+    }
+
+    QStringList arrayNames;
+    if (m_timeSeriesCheckBox->isChecked()) {
+        arrayNames = LineProbe::timeSeriesArrays(m_inputData, m_activeArrayName, m_isPointData);
+    }
+    if (arrayNames.isEmpty()) {
+        arrayNames << m_activeArrayName;
+    }
+
+    LineProbe::Result result = m_probe.probe(m_polyline, arrayNames, m_isPointData, m_sampleCountSpinBox->value());
+    if (result.isEmpty()) {
+        m_infoLabel->setText("探测失败：探测线无效或数组不存在");
+        m_plotWidget->clear();
+        return;
+    }
+
+    // 时间序列按蓝→红着色，单条曲线用黄色
+    QVector<PlotWidget::Curve> curves;
+    const int count = result.values.size();
+    for (int i = 0; i < count; ++i) {
+        PlotWidget::Curve curve;
+        curve.name = result.arrayNames[i];
+        curve.color = count == 1 ? QColor(255, 210, 0)
+                                 : QColor::fromHsvF(0.667 * (1.0 - double(i) / (count - 1)), 0.85, 1.0);
+        curve.values = result.values[i];
+        curves.append(curve);
+    }
+    m_plotWidget->setData(result.distance, curves);
+
+    m_infoLabel->setText(QString("采样 %1 点 × %2 条曲线，耗时 %3 ms%4")
+                             .arg(result.distance.size())
+                             .arg(count)
+                             .arg(result.elapsedMs, 0, 'f', 2)
+                             .arg(result.fromCache ? "（缓存）" : ""));
+}
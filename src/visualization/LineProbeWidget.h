@@ -0,0 +1,99 @@
+#ifndef LINEPROBEWIDGET_H
+#define LINEPROBEWIDGET_H
+
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QGroupBox>
+#include <QListWidget>
+
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkActor.h>
+#include <vtkProperty.h>
+
+#include "analysis/LineProbe.h"
+#include "core/SpatialIndex.h"
+#include "visualization/PlotWidget.h"
+
+// 线探测面板：在模型上点击两点（或多点折线）定义探测线，沿线绘制活动数组曲线
+class LineProbeWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LineProbeWidget(QWidget *parent = nullptr);
+    ~LineProbeWidget();
+
+    void setData(vtkUnstructuredGrid *data);
+    void setRenderer(vtkRenderer *renderer);
+    void setInteractor(vtkRenderWindowInteractor *interactor);
+    void setSpatialIndex(SpatialIndex *spatialIndex);
+    void setActiveScalarArray(const QString &arrayName, bool isPointData);
+    vtkActor *getProbeLineActor() const { return m_lineActor; }
+
+signals:
+    void probeLineChanged();
+
+private slots:
+    void onPickModeToggled(bool enabled);
+    void onUseDiagonal();
+    void onRemoveLastPoint();
+    void onClearPoints();
+    void onProbe();
+
+private:
+    void setupUI();
+    void setupVTK();
+    void onInteractorEvent(vtkObject *caller, unsigned long eventId, void *callData);
+    void removeInteractorObservers();
+    bool displayToSurface(int displayX, int displayY, double world[3]);
+    void addPoint(const double point[3]);
+    void updateLineGeometry();
+    void updateTimeSeriesAvailability();
+
+    // UI组件
+    QCheckBox *m_pickModeCheckBox;
+    QListWidget *m_pointListWidget;
+    QPushButton *m_diagonalButton;
+    QPushButton *m_removeLastButton;
+    QPushButton *m_clearButton;
+    QSpinBox *m_sampleCountSpinBox;
+    QCheckBox *m_timeSeriesCheckBox;
+    QPushButton *m_probeButton;
+    QLabel *m_infoLabel;
+    PlotWidget *m_plotWidget;
+
+    // VTK组件
+    vtkSmartPointer<vtkRenderer> m_renderer;
+    vtkSmartPointer<vtkRenderWindowInteractor> m_interactor;
+    vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
+    vtkSmartPointer<vtkPolyData> m_lineData;
+    vtkSmartPointer<vtkPolyDataMapper> m_lineMapper;
+    vtkSmartPointer<vtkActor> m_lineActor;
+    SpatialIndex *m_spatialIndex;
+
+    // 交互器观察者（点击拾取探测点）
+    unsigned long m_pressObserver;
+    unsigned long m_releaseObserver;
+    int m_pressPosition[2];
+
+    // 探测数据
+    LineProbe m_probe;
+    std::vector<LineProbe::Point> m_polyline;
+    QString m_activeArrayName;
+    bool m_isPointData;
+};
+
+#endif // LINEPROBEWIDGET_H
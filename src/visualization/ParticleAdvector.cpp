@@ -0,0 +1,257 @@
+#include "ParticleAdvector.h"
+#include <vtkSMPTools.h>
+#include <vtkIdList.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+// 可重复的轻量随机数：按粒子序号和注入代数生成，保证多线程下结果确定
+class ParticleRandom
+{
+public:
+    ParticleRandom(vtkIdType index, std::uint32_t generation)
+        : m_state(static_cast<std::uint64_t>(index) * 0x9E3779B97F4A7C15ULL ^
+                  (static_cast<std::uint64_t>(generation) << 32))
+    {
+    }
+
+    double next()
+    {
+        std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return (z >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+const double kMinimumSpeed = 1e-12;
+
+} // namespace
+
+struct ParticleAdvector::AdvectFunctor
+{
+    ParticleAdvector *self;
+    std::atomic<int> *reinjected;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+        FieldInterpolator::Workspace ws;
+        const FieldInterpolator *interpolator = self->m_interpolator;
+        const double dt = self->m_timeStep;
+        const int tail = self->m_tailLength;
+        const int head = self->m_head;
+        float *coords = self->m_pointCoords->GetPointer(0);
+        int localReinjected = 0;
+
+        for (vtkIdType i = begin; i < end; ++i) {
+            double *x = &self->m_positions[3 * i];
+            ws.lastCellId = self->m_cellIds[i];
+
+            // 中点法（RK2）推进，粒子超出寿命、离开网格或停滞时重新注入
+            bool alive = ++self->m_ages[i] <= self->m_lifetime;
+            double v1[3], v2[3], mid[3];
+            if (alive && interpolator->interpolate(x, v1, ws) >= 0) {
+                for (int k = 0; k < 3; ++k) mid[k] = x[k] + 0.5 * dt * v1[k];
+                if (interpolator->interpolate(mid, v2, ws) >= 0 &&
+                    v2[0] * v2[0] + v2[1] * v2[1] + v2[2] * v2[2] > kMinimumSpeed) {
+                    for (int k = 0; k < 3; ++k) x[k] += dt * v2[k];
+                    self->m_cellIds[i] = ws.lastCellId;
+                } else {
+                    alive = false;
+                }
+            } else {
+                alive = false;
+            }
+
+            if (!alive) {
+                self->inject(i, ws);
+                ++localReinjected;
+            }
+
+            float *history = &self->m_history[static_cast<size_t>(i) * tail * 3];
+            float *slot = history + 3 * head;
+            slot[0] = static_cast<float>(x[0]);
+            slot[1] = static_cast<float>(x[1]);
+            slot[2] = static_cast<float>(x[2]);
+
+            // 按时间先后写出彗尾，拓扑保持不变
+            float *out = coords + static_cast<size_t>(i) * tail * 3;
+            for (int j = 0; j < tail; ++j) {
+                const float *src = history + 3 * ((head + 1 + j) % tail);
+                out[3 * j] = src[0];
+                out[3 * j + 1] = src[1];
+                out[3 * j + 2] = src[2];
+            }
+        }
+
+        *reinjected += localReinjected;
+    }
+};
+
+ParticleAdvector::ParticleAdvector()
+    : m_interpolator(nullptr)
+    , m_emitterMode(EMITTER_DOMAIN)
+    , m_speed(1.0)
+    , m_lifetime(300)
+    , m_timeStep(0.0)
+    , m_tailLength(1)
+    , m_head(0)
+{
+    std::fill(m_bounds, m_bounds + 6, 0.0);
+
+    m_pointCoords = vtkSmartPointer<vtkFloatArray>::New();
+    m_pointCoords->SetNumberOfComponents(3);
+    m_points = vtkSmartPointer<vtkPoints>::New();
+    m_points->SetData(m_pointCoords);
+    m_output = vtkSmartPointer<vtkPolyData>::New();
+    m_output->SetPoints(m_points);
+}
+
+void ParticleAdvector::randomPoint(vtkIdType index, double x[3])
+{
+    ParticleRandom random(index, m_generations[index]);
+    const double extent[3] = {
+        m_bounds[1] - m_bounds[0],
+        m_bounds[3] - m_bounds[2],
+        m_bounds[5] - m_bounds[4]
+    };
+
+    switch (m_emitterMode) {
+    case EMITTER_SPHERE: {
+        // 与随机种子点一致：中心球，半径为最大尺寸的30%
+        const double radius = std::max(std::max(extent[0], extent[1]), extent[2]) * 0.3;
+        double d[3];
+        do {
+            for (int k = 0; k < 3; ++k) d[k] = 2.0 * random.next() - 1.0;
+        } while (d[0] * d[0] + d[1] * d[1] + d[2] * d[2] > 1.0);
+        for (int k = 0; k < 3; ++k) {
+            x[k] = (m_bounds[2 * k] + m_bounds[2 * k + 1]) / 2.0 + radius * d[k];
+        }
+        break;
+    }
+    case EMITTER_INLET:
+        x[0] = m_bounds[0] + 0.02 * extent[0] * random.next();
+        x[1] = m_bounds[2] + extent[1] * random.next();
+        x[2] = m_bounds[4] + extent[2] * random.next();
+        break;
+    case EMITTER_DOMAIN:
+    default:
+        for (int k = 0; k < 3; ++k) {
+            x[k] = m_bounds[2 * k] + extent[k] * random.next();
+        }
+        break;
+    }
+}
+
+void ParticleAdvector::inject(vtkIdType index, FieldInterpolator::Workspace &ws)
+{
+    double *x = &m_positions[3 * index];
+    double value[3];
+
+    // 包围盒内的随机点可能落在网格外（空腔、曲面外侧），最多重试若干次
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        ++m_generations[index];
+        randomPoint(index, x);
+        ws.lastCellId = -1;
+        if (m_interpolator->interpolate(x, value, ws) >= 0) {
+            break;
+        }
+    }
+
+    m_cellIds[index] = ws.lastCellId;
+    m_ages[index] = static_cast<int>(m_generations[index] % 16); // 错开寿命，避免同批粒子同时消失
+
+    float *history = &m_history[static_cast<size_t>(index) * m_tailLength * 3];
+    for (int j = 0; j < m_tailLength; ++j) {
+        history[3 * j] = static_cast<float>(x[0]);
+        history[3 * j + 1] = static_cast<float>(x[1]);
+        history[3 * j + 2] = static_cast<float>(x[2]);
+    }
+}
+
+void ParticleAdvector::buildTopology()
+{
+    const vtkIdType count = particleCount();
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->AllocateExact(count, count * m_tailLength);
+
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    ids->SetNumberOfIds(m_tailLength);
+    for (vtkIdType i = 0; i < count; ++i) {
+        for (int j = 0; j < m_tailLength; ++j) {
+            ids->SetId(j, i * m_tailLength + j);
+        }
+        cells->InsertNextCell(ids);
+    }
+
+    if (m_tailLength > 1) {
+        m_output->SetVerts(vtkSmartPointer<vtkCellArray>::New());
+        m_output->SetLines(cells);
+    } else {
+        m_output->SetLines(vtkSmartPointer<vtkCellArray>::New());
+        m_output->SetVerts(cells);
+    }
+}
+
+void ParticleAdvector::reset(const double bounds[6], double cellLength, int numberOfParticles, int tailLength)
+{
+    std::copy(bounds, bounds + 6, m_bounds);
+    m_tailLength = std::max(1, tailLength);
+    m_head = 0;
+
+    const size_t count = static_cast<size_t>(std::max(0, numberOfParticles));
+    m_positions.assign(count * 3, 0.0);
+    m_cellIds.assign(count, -1);
+    m_ages.assign(count, 0);
+    m_generations.assign(count, 0);
+    m_history.assign(count * m_tailLength * 3, 0.0f);
+    m_pointCoords->SetNumberOfTuples(static_cast<vtkIdType>(count * m_tailLength));
+
+    // 时间步长：最快的粒子每帧约移动 m_speed × 半个单元
+    m_timeStep = 0.0;
+    if (m_interpolator && m_interpolator->isValid()) {
+        double maxNorm = m_interpolator->array()->GetMaxNorm();
+        if (maxNorm > kMinimumSpeed) {
+            m_timeStep = 0.5 * cellLength / maxNorm;
+        }
+
+        vtkSMPTools::For(0, static_cast<vtkIdType>(count), [this](vtkIdType begin, vtkIdType end) {
+            FieldInterpolator::Workspace ws;
+            for (vtkIdType i = begin; i < end; ++i) {
+                inject(i, ws);
+            }
+        });
+    }
+
+    // 新注入粒子的彗尾各位置相同，直接作为初始坐标
+    std::copy(m_history.begin(), m_history.end(), m_pointCoords->GetPointer(0));
+
+    buildTopology();
+    m_points->Modified();
+}
+
+int ParticleAdvector::advance()
+{
+    if (!m_interpolator || !m_interpolator->isValid() || m_positions.empty() || m_timeStep <= 0.0) {
+        return 0;
+    }
+
+    const double baseTimeStep = m_timeStep;
+    m_timeStep = baseTimeStep * m_speed;
+    m_head = (m_head + 1) % m_tailLength;
+
+    std::atomic<int> reinjected(0);
+    AdvectFunctor functor{this, &reinjected};
+    vtkSMPTools::For(0, static_cast<vtkIdType>(particleCount()), functor);
+
+    m_timeStep = baseTimeStep;
+    m_pointCoords->Modified();
+    m_points->Modified();
+    return reinjected.load();
+}
@@ -0,0 +1,71 @@
+#ifndef PARTICLEADVECTOR_H
+#define PARTICLEADVECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkPolyData.h>
+#include <vtkPoints.h>
+#include <vtkFloatArray.h>
+#include <vtkCellArray.h>
+
+#include "core/FieldInterpolator.h"
+
+// 粒子平流：在活动矢量场中实时推进大量粒子
+// 每个粒子记住所在单元，相邻帧优先在该单元内求值（单元游走缓存），
+// 粒子推进在 vtkSMPTools 线程池上并行执行
+class ParticleAdvector
+{
+public:
+    enum EmitterMode {
+        EMITTER_DOMAIN,     // 整个区域随机发射
+        EMITTER_SPHERE,     // 中心种子球
+        EMITTER_INLET       // X最小面（入口面）
+    };
+
+    ParticleAdvector();
+
+    void setInterpolator(const FieldInterpolator *interpolator) { m_interpolator = interpolator; }
+    void setEmitterMode(EmitterMode mode) { m_emitterMode = mode; }
+    void setSpeed(double speed) { m_speed = speed; }
+    void setLifetime(int frames) { m_lifetime = frames; }
+
+    // 重新分配并注入全部粒子，tailLength为彗尾长度（1表示仅显示点）
+    void reset(const double bounds[6], double cellLength, int numberOfParticles, int tailLength);
+
+    // 推进一帧，返回本帧重新注入的粒子数
+    int advance();
+
+    vtkPolyData *output() const { return m_output; }
+    int particleCount() const { return static_cast<int>(m_positions.size() / 3); }
+
+private:
+    struct AdvectFunctor;
+
+    void inject(vtkIdType index, FieldInterpolator::Workspace &ws);
+    void randomPoint(vtkIdType index, double x[3]);
+    void buildTopology();
+
+    const FieldInterpolator *m_interpolator;
+    EmitterMode m_emitterMode;
+    double m_speed;
+    int m_lifetime;
+    double m_bounds[6];
+    double m_timeStep;
+    int m_tailLength;
+    int m_head;
+
+    // 粒子状态（结构数组布局，便于并行访问）
+    std::vector<double> m_positions;
+    std::vector<vtkIdType> m_cellIds;
+    std::vector<int> m_ages;
+    std::vector<std::uint32_t> m_generations;
+    std::vector<float> m_history;   // 彗尾环形缓冲：粒子 × 彗尾长度 × 3
+
+    vtkSmartPointer<vtkPolyData> m_output;
+    vtkSmartPointer<vtkPoints> m_points;
+    vtkSmartPointer<vtkFloatArray> m_pointCoords;
+};
+
+#endif // PARTICLEADVECTOR_H
@@ -0,0 +1,227 @@
+#include "PlotWidget.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QMouseEvent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PlotWidget::PlotWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_xMin(0.0)
+    , m_xMax(1.0)
+    , m_yMin(0.0)
+    , m_yMax(1.0)
+    , m_hoverIndex(-1)
+{
+    setMouseTracking(true);
+    setMinimumHeight(180);
+}
+
+void PlotWidget::setData(const std::vector<double> &x, const QVector<Curve> &curves)
+{
+    m_x = x;
+    m_curves = curves;
+    m_hoverIndex = -1;
+    updateRanges();
+    update();
+}
+
+void PlotWidget::setAxisLabels(const QString &xLabel, const QString &yLabel)
+{
+    m_xLabel = xLabel;
+    m_yLabel = yLabel;
+    update();
+}
+
+void PlotWidget::clear()
+{
+    m_x.clear();
+    m_curves.clear();
+    m_hoverIndex = -1;
+    update();
+}
+
+void PlotWidget::updateRanges()
+{
+    m_xMin = m_x.empty() ? 0.0 : m_x.front();
+    m_xMax = m_x.empty() ? 1.0 : m_x.back();
+
+    m_yMin = std::numeric_limits<double>::max();
+    m_yMax = -std::numeric_limits<double>::max();
+    for (const Curve &curve : m_curves) {
+        for (double v : curve.values) {
+            if (std::isfinite(v)) {
+                m_yMin = std::min(m_yMin, v);
+                m_yMax = std::max(m_yMax, v);
+            }
+        }
+    }
+
+    if (m_yMin > m_yMax) {
+        m_yMin = 0.0;
+        m_yMax = 1.0;
+    } else if (m_yMax - m_yMin < 1e-12) {
+        // 常数曲线上下留出余量
+        const double pad = std::max(std::abs(m_yMax) * 0.05, 1e-6);
+        m_yMin -= pad;
+        m_yMax += pad;
+    }
+    if (m_xMax - m_xMin < 1e-12) {
+        m_xMax = m_xMin + 1.0;
+    }
+}
+
+QRectF PlotWidget::plotArea() const
+{
+    return QRectF(60.0, 12.0, std::max(10.0, width() - 72.0), std::max(10.0, height() - 48.0));
+}
+
+QPointF PlotWidget::toScreen(double x, double y, const QRectF &area) const
+{
+    const double sx = area.left() + (x - m_xMin) / (m_xMax - m_xMin) * area.width();
+    const double sy = area.bottom() - (y - m_yMin) / (m_yMax - m_yMin) * area.height();
+    return QPointF(sx, sy);
+}
+
+double PlotWidget::niceStep(double range, int targetTicks)
+{
+    const double raw = range / std::max(1, targetTicks);
+    const double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+    const double normalized = raw / magnitude;
+    if (normalized < 1.5) return magnitude;
+    if (normalized < 3.0) return 2.0 * magnitude;
+    if (normalized < 7.0) return 5.0 * magnitude;
+    return 10.0 * magnitude;
+}
+
+void PlotWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), QColor(30, 30, 30));
+
+    const QRectF area = plotArea();
+    painter.setPen(QColor(90, 90, 90));
+    painter.drawRect(area);
+
+    if (m_x.empty() || m_curves.isEmpty()) {
+        painter.setPen(QColor(160, 160, 160));
+        painter.drawText(area, Qt::AlignCenter, "暂无探测数据");
+        return;
+    }
+
+    // 网格线与刻度
+    QFont font = painter.font();
+    font.setPointSize(8);
+    painter.setFont(font);
+
+    const double xStep = niceStep(m_xMax - m_xMin, 5);
+    for (double x = std::ceil(m_xMin / xStep) * xStep; x <= m_xMax + 1e-9 * xStep; x += xStep) {
+        QPointF p = toScreen(x, m_yMin, area);
+        painter.setPen(QColor(55, 55, 55));
+        painter.drawLine(QPointF(p.x(), area.top()), QPointF(p.x(), area.bottom()));
+        painter.setPen(QColor(180, 180, 180));
+        painter.drawText(QRectF(p.x() - 30, area.bottom() + 2, 60, 14), Qt::AlignHCenter, QString::number(x, 'g', 4));
+    }
+
+    const double yStep = niceStep(m_yMax - m_yMin, 4);
+    for (double y = std::ceil(m_yMin / yStep) * yStep; y <= m_yMax + 1e-9 * yStep; y += yStep) {
+        QPointF p = toScreen(m_xMin, y, area);
+        painter.setPen(QColor(55, 55, 55));
+        painter.drawLine(QPointF(area.left(), p.y()), QPointF(area.right(), p.y()));
+        painter.setPen(QColor(180, 180, 180));
+        painter.drawText(QRectF(0, p.y() - 7, area.left() - 4, 14), Qt::AlignRight | Qt::AlignVCenter,
+                         QString::number(y, 'g', 4));
+    }
+
+    painter.setPen(QColor(200, 200, 200));
+    painter.drawText(QRectF(area.left(), height() - 16, area.width(), 14), Qt::AlignHCenter, m_xLabel);
+    painter.drawText(QRectF(area.left() + 4, area.top(), area.width(), 14), Qt::AlignLeft, m_yLabel);
+
+    // 曲线（遇到 NaN 断开）
+    painter.setClipRect(area);
+    for (const Curve &curve : m_curves) {
+        QPainterPath path;
+        bool penDown = false;
+        const size_t n = std::min(m_x.size(), curve.values.size());
+        for (size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(curve.values[i])) {
+                penDown = false;
+                continue;
+            }
+            QPointF p = toScreen(m_x[i], curve.values[i], area);
+            if (penDown) {
+                path.lineTo(p);
+            } else {
+                path.moveTo(p);
+                penDown = true;
+            }
+        }
+        painter.setPen(QPen(curve.color, 1.5));
+        painter.drawPath(path);
+    }
+    painter.setClipping(false);
+
+    // 图例：曲线较多时（时间序列）只标注首末两条
+    int legendRow = 0;
+    for (int i = 0; i < m_curves.size(); ++i) {
+        if (m_curves.size() > 6 && i != 0 && i != m_curves.size() - 1) {
+            continue;
+        }
+        const QPointF origin(area.right() - 130, area.top() + 6 + legendRow * 14);
+        painter.setPen(QPen(m_curves[i].color, 2));
+        painter.drawLine(origin + QPointF(0, 6), origin + QPointF(16, 6));
+        painter.setPen(QColor(220, 220, 220));
+        painter.drawText(QRectF(origin.x() + 20, origin.y(), 110, 14), Qt::AlignLeft | Qt::AlignVCenter,
+                         m_curves[i].name);
+        ++legendRow;
+    }
+
+    // 悬停读数
+    if (m_hoverIndex >= 0 && m_hoverIndex < static_cast<int>(m_x.size())) {
+        QPointF p = toScreen(m_x[m_hoverIndex], m_yMin, area);
+        painter.setPen(QPen(QColor(255, 255, 255, 120), 1, Qt::DashLine));
+        painter.drawLine(QPointF(p.x(), area.top()), QPointF(p.x(), area.bottom()));
+
+        const double value = m_curves.first().values[m_hoverIndex];
+        QString text = QString("s=%1  %2").arg(m_x[m_hoverIndex], 0, 'g', 5)
+                           .arg(std::isfinite(value) ? QString::number(value, 'g', 6) : QString("网格外"));
+        painter.setPen(QColor(255, 255, 255));
+        painter.drawText(QRectF(area.left() + 4, area.bottom() - 18, area.width() - 8, 14), Qt::AlignLeft, text);
+    }
+}
+
+void PlotWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    const QRectF area = plotArea();
+    if (m_x.empty() || !area.contains(event->position())) {
+        if (m_hoverIndex != -1) {
+            m_hoverIndex = -1;
+            update();
+        }
+        return;
+    }
+
+    // 采样点按弧长递增，二分查找最近采样
+    const double x = m_xMin + (event->position().x() - area.left()) / area.width() * (m_xMax - m_xMin);
+    auto it = std::lower_bound(m_x.begin(), m_x.end(), x);
+    int index = static_cast<int>(it - m_x.begin());
+    if (index > 0 && (index == static_cast<int>(m_x.size()) || std::abs(m_x[index - 1] - x) < std::abs(m_x[index] - x))) {
+        --index;
+    }
+
+    if (index != m_hoverIndex) {
+        m_hoverIndex = index;
+        update();
+    }
+}
+
+void PlotWidget::leaveEvent(QEvent *event)
+{
+    Q_UNUSED(event);
+    m_hoverIndex = -1;
+    update();
+}
@@ -0,0 +1,51 @@
+#ifndef PLOTWIDGET_H
+#define PLOTWIDGET_H
+
+#include <QWidget>
+#include <QColor>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+// 轻量折线图：用 QPainter 绘制若干条共享横轴的曲线，NaN 处断开
+class PlotWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    struct Curve
+    {
+        QString name;
+        QColor color;
+        std::vector<double> values;
+    };
+
+    explicit PlotWidget(QWidget *parent = nullptr);
+
+    void setData(const std::vector<double> &x, const QVector<Curve> &curves);
+    void setAxisLabels(const QString &xLabel, const QString &yLabel);
+    void clear();
+
+    QSize sizeHint() const override { return QSize(320, 220); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+
+private:
+    QRectF plotArea() const;
+    QPointF toScreen(double x, double y, const QRectF &area) const;
+    void updateRanges();
+    static double niceStep(double range, int targetTicks);
+
+    std::vector<double> m_x;
+    QVector<Curve> m_curves;
+    QString m_xLabel;
+    QString m_yLabel;
+    double m_xMin, m_xMax, m_yMin, m_yMax;
+    int m_hoverIndex; // 鼠标所在采样序号，-1 表示无
+};
+
+#endif // PLOTWIDGET_H
@@ -1,24 +1,35 @@
 #include "VectorFieldWidget.h"
+#include "core/TraceRecorder.h"
 #include <QDebug>
 #include <vtkPointData.h>
 #include <vtkCellData.h>
 #include <vtkDataArray.h>
 #include <vtkWarpVector.h>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
+#include <array>
 
 VectorFieldWidget::VectorFieldWidget(QWidget *parent)
     : QWidget(parent)
     , m_renderer(nullptr)
     , m_inputData(nullptr)
+    , m_streamlinePending(false)
+    , m_streamlineGeneration(0)
+    , m_spatialIndex(nullptr)
     , m_isPointData(true)
     , m_warpEnabled(false)
     , m_streamlineEnabled(false)
+    , m_particlesEnabled(false)
 {
     setupUI();
     setupVTK();
+    connect(&m_streamlineWatcher, &QFutureWatcher<StreamlineResult>::finished,
+            this, &VectorFieldWidget::onEvenlySpacedStreamlinesReady);
 }
 
 VectorFieldWidget::~VectorFieldWidget()
 {
+    m_streamlineWatcher.waitForFinished();
 }
 
 void VectorFieldWidget::setupUI()
@@ -113,12 +124,27 @@ void VectorFieldWidget::setupUI()
     m_seedModeComboBox = new QComboBox(this);
     m_seedModeComboBox->addItem("随机分布");
     m_seedModeComboBox->addItem("边界分布");
+    m_seedModeComboBox->addItem("均匀间隔");
     m_seedModeComboBox->setEnabled(false);
     connect(m_seedModeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
-            this, &VectorFieldWidget::onStreamlineParametersChanged);
+            this, &VectorFieldWidget::onSeedModeChanged);
     seedLayout->addWidget(m_seedModeComboBox);
     streamlineLayout->addLayout(seedLayout);
     
+    // 流线间距（均匀间隔模式，相对模型对角线的百分比）
+    QHBoxLayout *separationLayout = new QHBoxLayout();
+    separationLayout->addWidget(new QLabel("流线间距(%):", this));
+    m_separationSpinBox = new QDoubleSpinBox(this);
+    m_separationSpinBox->setRange(0.5, 20.0);
+    m_separationSpinBox->setValue(4.0);
+    m_separationSpinBox->setDecimals(1);
+    m_separationSpinBox->setSingleStep(0.5);
+    m_separationSpinBox->setEnabled(false);
+    connect(m_separationSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &VectorFieldWidget::onStreamlineParametersChanged);
+    separationLayout->addWidget(m_separationSpinBox);
+    streamlineLayout->addLayout(separationLayout);
+    
     // 重新生成按钮
     m_regenerateStreamlinesButton = new QPushButton("重新生成流线", this);
     m_regenerateStreamlinesButton->setEnabled(false);
@@ -128,6 +154,84 @@ void VectorFieldWidget::setupUI()
     
     mainLayout->addWidget(m_streamlineGroup);
     
+    // 粒子动画控制组
+    m_particleGroup = new QGroupBox("粒子动画 (Particle Advection)", this);
+    QVBoxLayout *particleLayout = new QVBoxLayout(m_particleGroup);
+    
+    m_enableParticlesCheckBox = new QCheckBox("启用粒子动画", this);
+    connect(m_enableParticlesCheckBox, &QCheckBox::toggled,
+            this, &VectorFieldWidget::onParticlesEnabledChanged);
+    particleLayout->addWidget(m_enableParticlesCheckBox);
+    
+    // 粒子数量
+    QHBoxLayout *particleCountLayout = new QHBoxLayout();
+    particleCountLayout->addWidget(new QLabel("粒子数量:", this));
+    m_particleCountSpinBox = new QSpinBox(this);
+    m_particleCountSpinBox->setRange(1000, 2000000);
+    m_particleCountSpinBox->setSingleStep(10000);
+    m_particleCountSpinBox->setValue(100000);
+    m_particleCountSpinBox->setEnabled(false);
+    connect(m_particleCountSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &VectorFieldWidget::onParticleParametersChanged);
+    particleCountLayout->addWidget(m_particleCountSpinBox);
+    particleLayout->addLayout(particleCountLayout);
+    
+    // 发射器
+    QHBoxLayout *emitterLayout = new QHBoxLayout();
+    emitterLayout->addWidget(new QLabel("发射器:", this));
+    m_emitterComboBox = new QComboBox(this);
+    m_emitterComboBox->addItem("整个区域");
+    m_emitterComboBox->addItem("中心球");
+    m_emitterComboBox->addItem("入口面 (X最小)");
+    m_emitterComboBox->setEnabled(false);
+    connect(m_emitterComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &VectorFieldWidget::onParticleParametersChanged);
+    emitterLayout->addWidget(m_emitterComboBox);
+    particleLayout->addLayout(emitterLayout);
+    
+    // 彗尾长度（1表示仅显示点）
+    QHBoxLayout *tailLayout = new QHBoxLayout();
+    tailLayout->addWidget(new QLabel("彗尾长度:", this));
+    m_tailLengthSpinBox = new QSpinBox(this);
+    m_tailLengthSpinBox->setRange(1, 16);
+    m_tailLengthSpinBox->setValue(4);
+    m_tailLengthSpinBox->setEnabled(false);
+    connect(m_tailLengthSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &VectorFieldWidget::onParticleParametersChanged);
+    tailLayout->addWidget(m_tailLengthSpinBox);
+    particleLayout->addLayout(tailLayout);
+    
+    // 粒子寿命（帧）
+    QHBoxLayout *lifetimeLayout = new QHBoxLayout();
+    lifetimeLayout->addWidget(new QLabel("寿命(帧):", this));
+    m_lifetimeSpinBox = new QSpinBox(this);
+    m_lifetimeSpinBox->setRange(10, 5000);
+    m_lifetimeSpinBox->setValue(300);
+    m_lifetimeSpinBox->setEnabled(false);
+    connect(m_lifetimeSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, [this](int frames) { m_particleAdvector.setLifetime(frames); });
+    lifetimeLayout->addWidget(m_lifetimeSpinBox);
+    particleLayout->addLayout(lifetimeLayout);
+    
+    // 速度倍率
+    QHBoxLayout *speedLayout = new QHBoxLayout();
+    speedLayout->addWidget(new QLabel("速度:", this));
+    m_particleSpeedSlider = new QSlider(Qt::Horizontal, this);
+    m_particleSpeedSlider->setRange(1, 40);
+    m_particleSpeedSlider->setValue(10);
+    m_particleSpeedSlider->setEnabled(false);
+    connect(m_particleSpeedSlider, &QSlider::valueChanged,
+            this, [this](int value) { m_particleAdvector.setSpeed(value / 10.0); });
+    speedLayout->addWidget(m_particleSpeedSlider);
+    particleLayout->addLayout(speedLayout);
+    
+    mainLayout->addWidget(m_particleGroup);
+    
+    // 动画定时器，按显示帧率推进
+    m_particleTimer = new QTimer(this);
+    m_particleTimer->setInterval(16);
+    connect(m_particleTimer, &QTimer::timeout, this, &VectorFieldWidget::onParticleTimerTick);
+    
     mainLayout->addStretch();
 }
 
@@ -168,10 +272,25 @@ void VectorFieldWidget::setupVTK()
     m_streamlineActor->SetMapper(m_streamlineMapper);
     m_streamlineActor->GetProperty()->SetColor(0.0, 1.0, 0.0); // 绿色流线
     m_streamlineActor->GetProperty()->SetLineWidth(2.0);
+    
+    // 设置粒子组件
+    m_particleMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    m_particleMapper->SetInputData(m_particleAdvector.output());
+    m_particleMapper->ScalarVisibilityOff();
+    
+    m_particleActor = vtkSmartPointer<vtkActor>::New();
+    m_particleActor->SetMapper(m_particleMapper);
+    m_particleActor->GetProperty()->SetColor(1.0, 0.85, 0.2); // 金黄色粒子
+    m_particleActor->GetProperty()->SetPointSize(2.0);
+    m_particleActor->GetProperty()->SetLineWidth(1.5);
 }
 
 void VectorFieldWidget::setData(vtkUnstructuredGrid *data)
 {
+    // 插值器仍指向旧网格与旧数组，须在下次使用前重新初始化；粒子动画先停下，由 restartParticles 重启
+    m_particleTimer->stop();
+    m_vectorInterpolator.reset();
+    ++m_streamlineGeneration;
     m_inputData = data;
     if (m_inputData) {
         qDebug() << "VectorFieldWidget: 设置数据，点数:" << m_inputData->GetNumberOfPoints()
@@ -198,6 +317,11 @@ void VectorFieldWidget::setData(vtkUnstructuredGrid *data)
             }
         }
     }
+    
+    // 新数据中仍有当前矢量数组时在新网格上重新注入粒子
+    if (m_particlesEnabled && activeVectorArray()) {
+        restartParticles();
+    }
 }
 
 void VectorFieldWidget::setRenderer(vtkRenderer *renderer)
@@ -205,12 +329,28 @@ void VectorFieldWidget::setRenderer(vtkRenderer *renderer)
     m_renderer = renderer;
 }
 
+void VectorFieldWidget::setSpatialIndex(SpatialIndex *spatialIndex)
+{
+    m_spatialIndex = spatialIndex;
+}
+
+vtkDataArray *VectorFieldWidget::activeVectorArray() const
+{
+    if (!m_inputData || m_activeVectorArrayName.isEmpty()) return nullptr;
+    
+    if (m_isPointData) {
+        return m_inputData->GetPointData()->GetArray(m_activeVectorArrayName.toStdString().c_str());
+    }
+    return m_inputData->GetCellData()->GetArray(m_activeVectorArrayName.toStdString().c_str());
+}
+
 void VectorFieldWidget::setActiveVectorArray(const QString &arrayName, bool isPointData)
 {
     if (!m_inputData || arrayName.isEmpty()) return;
     
     m_activeVectorArrayName = arrayName;
     m_isPointData = isPointData;
+    ++m_streamlineGeneration;
     
     qDebug() << "VectorFieldWidget: 设置活动矢量数组:" << arrayName << "是否为点数据:" << isPointData;
     
@@ -227,10 +367,14 @@ void VectorFieldWidget::setActiveVectorArray(const QString &arrayName, bool isPo
     if (m_streamlineEnabled) {
         updateStreamlineVisualization();
     }
+    if (m_particlesEnabled) {
+        restartParticles();
+    }
 }
 
 void VectorFieldWidget::onWarpEnabledChanged(bool enabled)
 {
+    TRACE_SCOPE("VectorFieldWidget::onWarpEnabledChanged", "ui");
     m_warpEnabled = enabled;
     
     // 设置属性供外部查询
@@ -258,6 +402,7 @@ void VectorFieldWidget::onWarpEnabledChanged(bool enabled)
 
 void VectorFieldWidget::onStreamlineEnabledChanged(bool enabled)
 {
+    TRACE_SCOPE("VectorFieldWidget::onStreamlineEnabledChanged", "ui");
     m_streamlineEnabled = enabled;
     
     // 设置属性供外部查询
@@ -268,6 +413,7 @@ void VectorFieldWidget::onStreamlineEnabledChanged(bool enabled)
     m_integrationStepSpinBox->setEnabled(enabled);
     m_maxStepsSpinBox->setEnabled(enabled);
     m_seedModeComboBox->setEnabled(enabled);
+    m_separationSpinBox->setEnabled(enabled && m_seedModeComboBox->currentIndex() == 2);
     m_regenerateStreamlinesButton->setEnabled(enabled);
     
     if (enabled) {
@@ -279,6 +425,7 @@ void VectorFieldWidget::onStreamlineEnabledChanged(bool enabled)
 
 void VectorFieldWidget::onWarpParametersChanged()
 {
+    TRACE_SCOPE("VectorFieldWidget::onWarpParametersChanged", "ui");
     // 更新标签
     double scale = m_warpScaleSlider->value() / 10.0;
     m_warpScaleLabel->setText(QString::number(scale, 'f', 1));
@@ -296,8 +443,15 @@ void VectorFieldWidget::onShowOriginalChanged(bool enabled)
     emit vectorVisualizationChanged();
 }
 
+void VectorFieldWidget::onSeedModeChanged(int index)
+{
+    m_separationSpinBox->setEnabled(m_streamlineEnabled && index == 2);
+    onStreamlineParametersChanged();
+}
+
 void VectorFieldWidget::onStreamlineParametersChanged()
 {
+    TRACE_SCOPE("VectorFieldWidget::onStreamlineParametersChanged", "ui");
     if (m_streamlineEnabled) {
         updateStreamlineVisualization();
     }
@@ -329,7 +483,14 @@ void VectorFieldWidget::updateStreamlineVisualization()
 {
     if (!m_inputData || m_activeVectorArrayName.isEmpty()) return;
     
+    if (m_seedModeComboBox->currentIndex() == 2) {
+        // 在后台生成，完成后再发出 vectorVisualizationChanged
+        generateEvenlySpacedStreamlines();
+        return;
+    }
+    
     // 设置流线追踪器的输入
+    m_streamlineMapper->SetInputConnection(m_streamTracer->GetOutputPort());
     m_streamTracer->SetInputData(m_inputData);
     
     // 创建种子点
@@ -379,6 +540,152 @@ void VectorFieldWidget::createStreamlineSeeds()
     m_seedSource->Update();
 }
 
+bool VectorFieldWidget::initializeVectorInterpolator()
+{
+    if (!m_spatialIndex || !m_inputData) return false;
+    
+    m_spatialIndex->setData(m_inputData);
+    if (!m_vectorInterpolator.initialize(m_inputData, m_spatialIndex->cellLocator(),
+                                         activeVectorArray(), m_isPointData, m_spatialIndex->topology())) {
+        qDebug() << "VectorFieldWidget: 无法初始化矢量场插值器";
+        return false;
+    }
+    return m_vectorInterpolator.numberOfComponents() == 3;
+}
+
+void VectorFieldWidget::generateEvenlySpacedStreamlines()
+{
+    if (m_streamlineWatcher.isRunning()) {
+        // 连续调整参数期间只保留最新的请求
+        m_streamlinePending = true;
+        return;
+    }
+    if (!initializeVectorInterpolator()) return;
+    
+    double bounds[6];
+    m_inputData->GetBounds(bounds);
+    double diagonal = m_inputData->GetLength();
+    
+    EvenlySpacedStreamlines::Parameters parameters;
+    parameters.separation = diagonal * m_separationSpinBox->value() / 100.0;
+    parameters.testRatio = 0.5;
+    // 步长按单元尺寸缩放（与 vtkStreamTracer 的单元长度单位一致），且不超过终止距离的一半，保证不跳过体素
+    parameters.stepSize = qMin(m_integrationStepSpinBox->value() * m_spatialIndex->characteristicCellLength(),
+                               0.5 * parameters.separation * parameters.testRatio);
+    parameters.maxSteps = m_maxStepsSpinBox->value();
+    parameters.maxLines = m_streamlineCountSpinBox->value();
+    parameters.maxSeedAttempts = qMax(1000, 100 * parameters.maxLines);
+    
+    // 插值器按值复制：工作线程持有网格、定位器与数组的引用，界面线程随后重新初始化或重置不受影响
+    const FieldInterpolator interpolator = m_vectorInterpolator;
+    const int generation = m_streamlineGeneration;
+    std::array<double, 6> box;
+    std::copy(bounds, bounds + 6, box.begin());
+    m_streamlineWatcher.setFuture(QtConcurrent::run([interpolator, box, parameters, generation]() {
+        TRACE_SCOPE("VectorFieldWidget::generateEvenlySpacedStreamlines", "compute");
+        QElapsedTimer timer;
+        timer.start();
+        EvenlySpacedStreamlines generator;
+        generator.setInterpolator(&interpolator);
+        StreamlineResult result;
+        result.generation = generation;
+        result.lines = generator.generate(box.data(), parameters);
+        result.lineCount = generator.lastLineCount();
+        result.seedAttempts = generator.lastSeedAttempts();
+        result.integrationSteps = generator.lastIntegrationSteps();
+        result.elapsedMs = timer.elapsed();
+        return result;
+    }));
+}
+
+void VectorFieldWidget::onEvenlySpacedStreamlinesReady()
+{
+    const StreamlineResult result = m_streamlineWatcher.result();
+    // 生成期间换了数据或矢量数组，或已切换到其他种子方式时丢弃
+    if (result.generation == m_streamlineGeneration && m_streamlineEnabled && m_seedModeComboBox->currentIndex() == 2) {
+        m_streamlineMapper->SetInputData(result.lines);
+        qDebug() << "VectorFieldWidget: 均匀间隔流线，流线数:" << result.lineCount
+                 << "尝试种子数:" << result.seedAttempts
+                 << "积分步数:" << result.integrationSteps
+                 << "耗时(ms):" << result.elapsedMs;
+        emit vectorVisualizationChanged();
+    }
+    if (m_streamlinePending) {
+        m_streamlinePending = false;
+        if (m_streamlineEnabled && m_seedModeComboBox->currentIndex() == 2) {
+            generateEvenlySpacedStreamlines();
+        }
+    }
+}
+
+void VectorFieldWidget::onParticlesEnabledChanged(bool enabled)
+{
+    TRACE_SCOPE("VectorFieldWidget::onParticlesEnabledChanged", "ui");
+    m_particlesEnabled = enabled;
+    
+    // 设置属性供外部查询
+    setProperty("particlesEnabled", enabled);
+    
+    // 启用/禁用控件
+    m_particleCountSpinBox->setEnabled(enabled);
+    m_emitterComboBox->setEnabled(enabled);
+    m_tailLengthSpinBox->setEnabled(enabled);
+    m_lifetimeSpinBox->setEnabled(enabled);
+    m_particleSpeedSlider->setEnabled(enabled);
+    
+    if (enabled) {
+        restartParticles();
+    } else {
+        m_particleTimer->stop();
+    }
+    
+    emit vectorVisualizationChanged();
+}
+
+void VectorFieldWidget::onParticleParametersChanged()
+{
+    if (m_particlesEnabled) {
+        restartParticles();
+    }
+}
+
+void VectorFieldWidget::restartParticles()
+{
+    m_particleTimer->stop();
+    if (!m_inputData || m_activeVectorArrayName.isEmpty()) return;
+    if (!initializeVectorInterpolator()) return;
+    
+    double bounds[6];
+    m_inputData->GetBounds(bounds);
+    
+    m_particleAdvector.setInterpolator(&m_vectorInterpolator);
+    m_particleAdvector.setEmitterMode(static_cast<ParticleAdvector::EmitterMode>(m_emitterComboBox->currentIndex()));
+    m_particleAdvector.setLifetime(m_lifetimeSpinBox->value());
+    m_particleAdvector.setSpeed(m_particleSpeedSlider->value() / 10.0);
+    m_particleAdvector.reset(bounds, m_spatialIndex->characteristicCellLength(),
+                             m_particleCountSpinBox->value(), m_tailLengthSpinBox->value());
+    m_particleMapper->SetInputData(m_particleAdvector.output());
+    
+    qDebug() << "VectorFieldWidget: 粒子已注入，数量:" << m_particleAdvector.particleCount()
+             << "彗尾长度:" << m_tailLengthSpinBox->value();
+    
+    m_particleTimer->start();
+}
+
+void VectorFieldWidget::onParticleTimerTick()
+{
+    TRACE_SCOPE("VectorFieldWidget::onParticleTimerTick", "ui");
+    // 面板隐藏或被禁用时（例如切换到标量数据）暂停动画
+    if (!m_particlesEnabled || !isEnabled()) return;
+    
+    QElapsedTimer timer;
+    timer.start();
+    int reinjected = m_particleAdvector.advance();
+    double elapsedMs = timer.nsecsElapsed() / 1.0e6;
+    
+    emit particleFrameAdvanced(elapsedMs, m_particleAdvector.particleCount(), reinjected);
+}
+
 void VectorFieldWidget::onVisualizationModeChanged()
 {
     emit vectorVisualizationChanged();
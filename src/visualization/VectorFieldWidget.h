@@ -13,6 +13,8 @@
 #include <QDoubleSpinBox>
 #include <QGroupBox>
 #include <QPushButton>
+#include <QTimer>
+#include <QFutureWatcher>
 
 #include <vtkSmartPointer.h>
 #include <vtkWarpVector.h>
@@ -30,6 +32,11 @@
 #include <vtkProperty.h>
 #include <vtkLookupTable.h>
 
+#include "core/SpatialIndex.h"
+#include "core/FieldInterpolator.h"
+#include "visualization/EvenlySpacedStreamlines.h"
+#include "visualization/ParticleAdvector.h"
+
 class VectorFieldWidget : public QWidget
 {
     Q_OBJECT
@@ -40,14 +47,19 @@ public:
 
     void setData(vtkUnstructuredGrid *data);
     void setRenderer(vtkRenderer *renderer);
+    void setSpatialIndex(SpatialIndex *spatialIndex);
     void setActiveVectorArray(const QString &arrayName, bool isPointData);
     
     vtkActor* getWarpActor() const { return m_warpActor; }
     vtkActor* getOriginalActor() const { return m_originalActor; }
     vtkActor* getStreamlineActor() const { return m_streamlineActor; }
+    vtkActor* getParticleActor() const { return m_particleActor; }
+    vtkAlgorithm* getWarpFilter() const { return m_warpFilter; }
+    vtkAlgorithm* getStreamTracer() const { return m_streamTracer; }
 
 signals:
     void vectorVisualizationChanged();
+    void particleFrameAdvanced(double advectionMs, int particleCount, int reinjectedCount);
 
 private slots:
     void onWarpEnabledChanged(bool enabled);
@@ -56,17 +68,38 @@ private slots:
     void onStreamlineParametersChanged();
     void onShowOriginalChanged(bool enabled);
     void onVisualizationModeChanged();
+    void onSeedModeChanged(int index);
+    void onParticlesEnabledChanged(bool enabled);
+    void onParticleParametersChanged();
+    void onParticleTimerTick();
+    void onEvenlySpacedStreamlinesReady();
 
 private:
+    // 后台生成的均匀间隔流线
+    struct StreamlineResult
+    {
+        int generation = 0;
+        vtkSmartPointer<vtkPolyData> lines;
+        int lineCount = 0;
+        int seedAttempts = 0;
+        long long integrationSteps = 0;
+        qint64 elapsedMs = 0;
+    };
+
     void setupUI();
     void setupVTK();
     void updateWarpVisualization();
     void updateStreamlineVisualization();
     void createStreamlineSeeds();
+    void generateEvenlySpacedStreamlines();
+    vtkDataArray *activeVectorArray() const;
+    bool initializeVectorInterpolator();
+    void restartParticles();
 
     // UI组件
     QCheckBox *m_enableWarpCheckBox;
     QCheckBox *m_enableStreamlineCheckBox;
+    QCheckBox *m_enableParticlesCheckBox;
     
     // 变形图控制
     QGroupBox *m_warpGroup;
@@ -80,7 +113,17 @@ private:
     QDoubleSpinBox *m_integrationStepSpinBox;
     QSpinBox *m_maxStepsSpinBox;
     QComboBox *m_seedModeComboBox;
+    QDoubleSpinBox *m_separationSpinBox;
     QPushButton *m_regenerateStreamlinesButton;
+    
+    // 粒子动画控制
+    QGroupBox *m_particleGroup;
+    QSpinBox *m_particleCountSpinBox;
+    QComboBox *m_emitterComboBox;
+    QSpinBox *m_tailLengthSpinBox;
+    QSpinBox *m_lifetimeSpinBox;
+    QSlider *m_particleSpeedSlider;
+    QTimer *m_particleTimer;
 
     // VTK组件 - 变形图
     vtkSmartPointer<vtkWarpVector> m_warpFilter;
@@ -95,6 +138,18 @@ private:
     vtkSmartPointer<vtkPolyDataMapper> m_streamlineMapper;
     vtkSmartPointer<vtkActor> m_streamlineActor;
     
+    // 均匀间隔流线：在工作线程上生成，插值器按值复制给工作线程
+    QFutureWatcher<StreamlineResult> m_streamlineWatcher;
+    bool m_streamlinePending;               // 生成期间参数又变了，结束后按最新参数再生成一次
+    int m_streamlineGeneration;             // 数据或矢量数组变化时递增，之前的结果丢弃
+    FieldInterpolator m_vectorInterpolator;
+    SpatialIndex *m_spatialIndex;
+    
+    // VTK组件 - 粒子动画
+    ParticleAdvector m_particleAdvector;
+    vtkSmartPointer<vtkPolyDataMapper> m_particleMapper;
+    vtkSmartPointer<vtkActor> m_particleActor;
+    
     // 数据
     vtkSmartPointer<vtkRenderer> m_renderer;
     vtkSmartPointer<vtkUnstructuredGrid> m_inputData;
@@ -102,6 +157,7 @@ private:
     bool m_isPointData;
     bool m_warpEnabled;
     bool m_streamlineEnabled;
+    bool m_particlesEnabled;
 };
 
 #endif // VECTORFIELDWIDGET_H
\ No newline at end of file
@@ -0,0 +1,529 @@
+// 合成大网格生成器：以任意分辨率生成与 create_beautiful_3d_data.py 相同的四类网格
+// （扭转圆柱、径向球体、环形涡流、螺旋结构），用于复现大规模数据下的伸缩性问题。
+//
+// 各数组所在的文件位置可由分辨率预先算出，因此按层分块并行生成后直接写到对应位置，
+// 内存只占一个分块；输出为二进制追加格式（raw）的 VTU，结果只取决于类型与分辨率。
+//
+// 用法: FEMMeshGenerator --family torus_vortex --cells 10000000 [--output-dir 目录]
+//       FEMMeshGenerator --family all --scale 4
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSysInfo>
+
+#include <vtkSMPTools.h>
+#include <vtkCellType.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+const double PI = 3.14159265358979323846;
+
+// 单个网格点上的全部输出：坐标、两个矢量场和两个标量场
+struct PointSample
+{
+    double position[3];
+    double displacement[3];
+    double velocity[3];
+    double scalars[2];
+};
+
+// 结构化索引 (s, m, f) 分别为慢/中/快三个方向，点ID = (s * nm + m) * nf + f
+using EvaluateFunction = void (*)(const int dims[3], int s, int m, int f, PointSample &sample);
+
+struct Family
+{
+    const char *name;
+    const char *description;
+    int baseDims[3];        // 与 Python 脚本相同的默认分辨率
+    bool periodic[2];       // 慢/中方向是否首尾相接
+    const char *displacementName;
+    const char *velocityName;
+    const char *scalarNames[2];
+    const char *activeScalars;
+    EvaluateFunction evaluate;
+};
+
+// 扭转圆柱：s = 高度，m = 周向，f = 半径
+void evaluateTwistedCylinder(const int dims[3], int k, int j, int i, PointSample &sample)
+{
+    const double radius = 2.0;
+    const double height = 6.0;
+    const double z = static_cast<double>(k) / (dims[0] - 1) * height - height / 2;
+    const double theta = static_cast<double>(j) / dims[1] * 2 * PI;
+    const double r = static_cast<double>(i) / (dims[2] - 1) * radius;
+    const double x = r * std::cos(theta);
+    const double y = r * std::sin(theta);
+
+    sample = PointSample{{x, y, z}, {0, 0, 0}, {0, 0, 0}, {0, 0}};
+    if (r <= 0) {
+        return;
+    }
+
+    const double twistAnglePerUnit = PI / height;
+    const double newTheta = theta + twistAnglePerUnit * z * (r / radius);
+    sample.displacement[0] = r * std::cos(newTheta) - x;
+    sample.displacement[1] = r * std::sin(newTheta) - y;
+
+    sample.velocity[0] = -y * (1 + z / height);
+    sample.velocity[1] = x * (1 + z / height);
+    sample.velocity[2] = r * 0.5;
+
+    const double tau = r * twistAnglePerUnit * 50000;
+    sample.scalars[0] = tau;
+    sample.scalars[1] = tau * std::sqrt(3.0);
+}
+
+// 径向球体：s = 半径，m = 方位角，f = 极角
+void evaluateRadialSphere(const int dims[3], int i, int j, int k, PointSample &sample)
+{
+    const double maxRadius = 3.0;
+    const double r = static_cast<double>(i) / (dims[0] - 1) * maxRadius;
+    const double theta = static_cast<double>(j) / dims[1] * 2 * PI;
+    const double phi = static_cast<double>(k) / (dims[2] - 1) * PI;
+    const double x = r * std::sin(phi) * std::cos(theta);
+    const double y = r * std::sin(phi) * std::sin(theta);
+    const double z = r * std::cos(phi);
+
+    sample = PointSample{{x, y, z}, {0, 0, 0}, {0, 0, 0}, {100, 50}};
+    if (r <= 0.01) {
+        return;
+    }
+
+    const double n[3] = {x / r, y / r, z / r};
+    const double displacement = r * 0.2 * (1 - r / maxRadius);
+    const double speed = 2.0 * (1 + std::sin(r * PI / maxRadius));
+    for (int c = 0; c < 3; ++c) {
+        sample.displacement[c] = n[c] * displacement;
+        sample.velocity[c] = n[c] * speed;
+    }
+    sample.scalars[0] = 100 * (maxRadius - r) / maxRadius;
+    sample.scalars[1] = 50 * std::exp(-r / maxRadius * 2);
+}
+
+// 环形涡流：s = 大圆角，m = 小圆角，f = 小圆内的径向分层
+void evaluateTorusVortex(const int dims[3], int i, int j, int k, PointSample &sample)
+{
+    const double R = 3.0;
+    const double rInner = 0.8;
+    const double rOuter = 1.2;
+    const double u = static_cast<double>(i) / dims[0] * 2 * PI;
+    const double v = static_cast<double>(j) / dims[1] * 2 * PI;
+    const double rLocal = rInner + static_cast<double>(k) / (dims[2] - 1) * (rOuter - rInner);
+    const double x = (R + rLocal * std::cos(v)) * std::cos(u);
+    const double y = (R + rLocal * std::cos(v)) * std::sin(u);
+    const double z = rLocal * std::sin(v);
+
+    sample = PointSample{{x, y, z}, {0, 0, 0}, {0, 0, 0}, {0, 0}};
+    const double rho = std::sqrt(x * x + y * y);
+    if (rho <= 0) {
+        return;
+    }
+
+    const double phi = std::atan2(y, x);
+    const double rFromCenter = std::sqrt((rho - R) * (rho - R) + z * z);
+
+    const double pulsation = 0.1 * std::sin(4 * phi) * std::cos(2 * PI * z / (rOuter - rInner));
+    sample.displacement[0] = (x / rho) * pulsation;
+    sample.displacement[1] = (y / rho) * pulsation;
+    sample.displacement[2] = 0.1 * std::sin(2 * phi) * std::sin(PI * rFromCenter / (rOuter - rInner));
+
+    const double vPhi = 3.0 * (rOuter - rFromCenter) / (rOuter - rInner);
+    double vx = -vPhi * y / rho;
+    double vy = vPhi * x / rho;
+    double vz = 0.0;
+    double vSecondary = 0.0;
+    if (rFromCenter > 0.01) {
+        const double smallCirclePhi = std::atan2(z, rho - R);
+        vSecondary = std::sin(2 * phi + smallCirclePhi);
+        vz = vSecondary;
+        const double vr = 0.2 * std::cos(2 * phi + smallCirclePhi);
+        vx += vr * (rho - R) / rFromCenter * x / rho;
+        vy += vr * (rho - R) / rFromCenter * y / rho;
+    }
+    sample.velocity[0] = vx;
+    sample.velocity[1] = vy;
+    sample.velocity[2] = vz;
+
+    sample.scalars[0] = std::abs(vPhi / rho) + std::abs(vSecondary);
+    sample.scalars[1] = 0.5 * (vx * vx + vy * vy + vz * vz);
+}
+
+// 螺旋结构：s = 高度，m = 周向（随高度旋转），f = 半径
+void evaluateHelicalStructure(const int dims[3], int k, int j, int i, PointSample &sample)
+{
+    const double maxRadius = 2.0;
+    const double height = 8.0;
+    const double pitch = 2.0;
+    const double z = static_cast<double>(k) / (dims[0] - 1) * height - height / 2;
+    const double helixAngle = 2 * PI * z / pitch;
+    const double theta0 = static_cast<double>(j) / dims[1] * 2 * PI + helixAngle;
+    const double r = static_cast<double>(i) / (dims[2] - 1) * maxRadius;
+    const double x = r * std::cos(theta0);
+    const double y = r * std::sin(theta0);
+
+    sample = PointSample{{x, y, z}, {0, 0, 0}, {0, 0, 1.0}, {100, 300}};
+    if (r <= 0) {
+        return;
+    }
+
+    const double theta = std::atan2(y, x);
+    const double phase = theta + 2 * PI * z / pitch;
+    const double helixFactor = std::sin(2 * PI * z / pitch + theta);
+    sample.displacement[0] = 0.1 * helixFactor * x / r;
+    sample.displacement[1] = 0.1 * helixFactor * y / r;
+    sample.displacement[2] = 0.05 * std::cos(phase);
+
+    sample.velocity[0] = -y + 0.2 * z * x / maxRadius;
+    sample.velocity[1] = x + 0.2 * z * y / maxRadius;
+    sample.velocity[2] = 1.0 + 0.5 * std::sin(phase);
+
+    sample.scalars[0] = 100 * (1 + 0.5 * std::sin(4 * theta + 4 * PI * z / pitch)) * (maxRadius - r) / maxRadius;
+    sample.scalars[1] = 300 + 100 * std::sin(phase) * (1 - r / maxRadius);
+}
+
+const Family FAMILIES[] = {
+    {"twisted_cylinder", "扭转圆柱体", {30, 24, 12}, {false, true},
+     "Twist_Displacement", "Spiral_Velocity", {"Shear_Stress", "VonMises_Stress"}, "VonMises_Stress",
+     evaluateTwistedCylinder},
+    {"radial_sphere", "径向球体", {15, 24, 16}, {false, true},
+     "Radial_Displacement", "Radial_Velocity", {"Radial_Stress", "Pressure"}, "Pressure",
+     evaluateRadialSphere},
+    {"torus_vortex", "环形涡流", {24, 16, 6}, {true, true},
+     "Torus_Displacement", "Vortex_Velocity", {"Vorticity", "Dynamic_Pressure"}, "Dynamic_Pressure",
+     evaluateTorusVortex},
+    {"helical_structure", "螺旋结构", {40, 32, 8}, {false, true},
+     "Helical_Displacement", "Helical_Velocity", {"Helical_Stress", "Temperature"}, "Temperature",
+     evaluateHelicalStructure}
+};
+
+// 网格分辨率（三个方向的点数）及由此得到的单元数
+struct Resolution
+{
+    int dims[3];
+
+    int cellDim(const Family &family, int axis) const
+    {
+        return axis < 2 && family.periodic[axis] ? dims[axis] : dims[axis] - 1;
+    }
+
+    int64_t numberOfPoints() const
+    {
+        return static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+    }
+
+    int64_t numberOfCells(const Family &family) const
+    {
+        return static_cast<int64_t>(cellDim(family, 0)) * cellDim(family, 1) * cellDim(family, 2);
+    }
+};
+
+Resolution scaledResolution(const Family &family, double scale)
+{
+    Resolution resolution;
+    for (int axis = 0; axis < 3; ++axis) {
+        const int minimum = axis < 2 && family.periodic[axis] ? 3 : 2;
+        resolution.dims[axis] = std::max(minimum, static_cast<int>(std::lround(family.baseDims[axis] * scale)));
+    }
+    return resolution;
+}
+
+// 按目标单元数等比例缩放三个方向
+double scaleForCells(const Family &family, int64_t targetCells)
+{
+    Resolution base;
+    std::copy(family.baseDims, family.baseDims + 3, base.dims);
+    return std::cbrt(static_cast<double>(targetCells) / base.numberOfCells(family));
+}
+
+// 追加数据块：UInt64 字节数头 + 原始数据
+struct Block
+{
+    QString xmlName;
+    const char *type;
+    int components;
+    int elementBytes;
+    int64_t tuples;
+    int64_t offset = 0;  // 相对 '_' 之后的偏移
+
+    int64_t dataBytes() const { return tuples * components * elementBytes; }
+    int64_t totalBytes() const { return sizeof(uint64_t) + dataBytes(); }
+};
+
+enum BlockIndex
+{
+    BLOCK_DISPLACEMENT,
+    BLOCK_VELOCITY,
+    BLOCK_SCALAR0,
+    BLOCK_SCALAR1,
+    BLOCK_POINTS,
+    BLOCK_CONNECTIVITY,
+    BLOCK_OFFSETS,
+    BLOCK_TYPES,
+    BLOCK_COUNT
+};
+
+QByteArray dataArrayXml(const Block &block, const QString &indent)
+{
+    QString xml = QString("%1<DataArray type=\"%2\" Name=\"%3\"").arg(indent, QString::fromUtf8(block.type), block.xmlName);
+    if (block.components > 1) {
+        xml += QString(" NumberOfComponents=\"%1\"").arg(block.components);
+    }
+    xml += QString(" format=\"appended\" offset=\"%1\"/>\n").arg(block.offset);
+    return xml.toUtf8();
+}
+
+bool writeAt(QFile &file, int64_t position, const void *data, int64_t bytes)
+{
+    return file.seek(position) && file.write(static_cast<const char *>(data), bytes) == bytes;
+}
+
+bool generateFamily(const Family &family, const Resolution &resolution, const QString &fileName, int64_t chunkPoints)
+{
+    const int ns = resolution.dims[0];
+    const int nm = resolution.dims[1];
+    const int nf = resolution.dims[2];
+    const int cellsS = resolution.cellDim(family, 0);
+    const int cellsM = resolution.cellDim(family, 1);
+    const int cellsF = resolution.cellDim(family, 2);
+    const int64_t numPoints = resolution.numberOfPoints();
+    const int64_t numCells = resolution.numberOfCells(family);
+
+    qDebug() << "FEMMeshGenerator:" << family.name << "分辨率" << ns << "x" << nm << "x" << nf
+             << "点数:" << numPoints << "单元数:" << numCells;
+
+    std::vector<Block> blocks = {
+        {family.displacementName, "Float32", 3, 4, numPoints},
+        {family.velocityName, "Float32", 3, 4, numPoints},
+        {family.scalarNames[0], "Float32", 1, 4, numPoints},
+        {family.scalarNames[1], "Float32", 1, 4, numPoints},
+        {"Points", "Float32", 3, 4, numPoints},
+        {"connectivity", "Int64", 1, 8, numCells * 8},
+        {"offsets", "Int64", 1, 8, numCells},
+        {"types", "UInt8", 1, 1, numCells}
+    };
+    int64_t offset = 0;
+    for (Block &block : blocks) {
+        block.offset = offset;
+        offset += block.totalBytes();
+    }
+
+    // 原始数据按本机字节序写出
+    const char *byteOrder = QSysInfo::ByteOrder == QSysInfo::LittleEndian ? "LittleEndian" : "BigEndian";
+    QByteArray header;
+    header += "<?xml version=\"1.0\"?>\n";
+    header += QString("<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%1\" header_type=\"UInt64\">\n")
+                  .arg(byteOrder).toUtf8();
+    header += "  <UnstructuredGrid>\n";
+    header += QString("    <Piece NumberOfPoints=\"%1\" NumberOfCells=\"%2\">\n").arg(numPoints).arg(numCells).toUtf8();
+    header += QString("      <PointData Scalars=\"%1\" Vectors=\"%2\">\n").arg(QString::fromUtf8(family.activeScalars), QString::fromUtf8(family.displacementName)).toUtf8();
+    for (int b = BLOCK_DISPLACEMENT; b <= BLOCK_SCALAR1; ++b) {
+        header += dataArrayXml(blocks[b], "        ");
+    }
+    header += "      </PointData>\n";
+    header += "      <CellData>\n      </CellData>\n";
+    header += "      <Points>\n";
+    header += dataArrayXml(blocks[BLOCK_POINTS], "        ");
+    header += "      </Points>\n";
+    header += "      <Cells>\n";
+    for (int b = BLOCK_CONNECTIVITY; b <= BLOCK_TYPES; ++b) {
+        header += dataArrayXml(blocks[b], "        ");
+    }
+    header += "      </Cells>\n";
+    header += "    </Piece>\n";
+    header += "  </UnstructuredGrid>\n";
+    header += "  <AppendedData encoding=\"raw\">\n   _";
+
+    const QByteArray footer = "\n  </AppendedData>\n</VTKFile>\n";
+    const int64_t dataStart = header.size();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qWarning() << "FEMMeshGenerator: 无法创建" << fileName << file.errorString();
+        return false;
+    }
+    // 预先确定文件大小，之后各分块可按任意顺序写入
+    if (!file.resize(dataStart + offset + footer.size())) {
+        qWarning() << "FEMMeshGenerator: 磁盘空间不足" << fileName << file.errorString();
+        return false;
+    }
+    bool ok = writeAt(file, 0, header.constData(), header.size()) &&
+              writeAt(file, dataStart + offset, footer.constData(), footer.size());
+    for (const Block &block : blocks) {
+        const uint64_t bytes = static_cast<uint64_t>(block.dataBytes());
+        ok = ok && writeAt(file, dataStart + block.offset, &bytes, sizeof(bytes));
+    }
+
+    auto blockData = [&](int b, int64_t firstTuple) {
+        const Block &block = blocks[b];
+        return dataStart + block.offset + static_cast<int64_t>(sizeof(uint64_t)) +
+               firstTuple * block.components * block.elementBytes;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 点：按 s 层分块
+    const int64_t pointsPerLayer = static_cast<int64_t>(nm) * nf;
+    const int layersPerPointChunk = static_cast<int>(std::max<int64_t>(1, chunkPoints / pointsPerLayer));
+    std::vector<float> displacement, velocity, scalar0, scalar1, points;
+    for (int s0 = 0; ok && s0 < ns; s0 += layersPerPointChunk) {
+        const int s1 = std::min(ns, s0 + layersPerPointChunk);
+        const int64_t first = s0 * pointsPerLayer;
+        const int64_t count = (s1 - s0) * pointsPerLayer;
+        displacement.resize(count * 3);
+        velocity.resize(count * 3);
+        points.resize(count * 3);
+        scalar0.resize(count);
+        scalar1.resize(count);
+
+        vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+            PointSample sample;
+            for (vtkIdType local = begin; local < end; ++local) {
+                const int64_t id = first + local;
+                const int f = static_cast<int>(id % nf);
+                const int m = static_cast<int>((id / nf) % nm);
+                const int s = static_cast<int>(id / pointsPerLayer);
+                family.evaluate(resolution.dims, s, m, f, sample);
+                for (int c = 0; c < 3; ++c) {
+                    points[local * 3 + c] = static_cast<float>(sample.position[c]);
+                    displacement[local * 3 + c] = static_cast<float>(sample.displacement[c]);
+                    velocity[local * 3 + c] = static_cast<float>(sample.velocity[c]);
+                }
+                scalar0[local] = static_cast<float>(sample.scalars[0]);
+                scalar1[local] = static_cast<float>(sample.scalars[1]);
+            }
+        });
+
+        ok = writeAt(file, blockData(BLOCK_DISPLACEMENT, first), displacement.data(), count * 3 * 4) &&
+             writeAt(file, blockData(BLOCK_VELOCITY, first), velocity.data(), count * 3 * 4) &&
+             writeAt(file, blockData(BLOCK_SCALAR0, first), scalar0.data(), count * 4) &&
+             writeAt(file, blockData(BLOCK_SCALAR1, first), scalar1.data(), count * 4) &&
+             writeAt(file, blockData(BLOCK_POINTS, first), points.data(), count * 3 * 4);
+        qDebug() << "FEMMeshGenerator: 点" << s1 * pointsPerLayer << "/" << numPoints;
+    }
+    std::vector<float>().swap(displacement);
+    std::vector<float>().swap(velocity);
+    std::vector<float>().swap(points);
+
+    // 单元：按 s 方向的单元层分块，连接关系与 Python 脚本的六面体顶点顺序一致
+    const int64_t cellsPerLayer = static_cast<int64_t>(cellsM) * cellsF;
+    const int layersPerCellChunk = static_cast<int>(std::max<int64_t>(1, chunkPoints / cellsPerLayer));
+    std::vector<int64_t> connectivity, offsets;
+    std::vector<uint8_t> types;
+    for (int c0 = 0; ok && c0 < cellsS; c0 += layersPerCellChunk) {
+        const int c1 = std::min(cellsS, c0 + layersPerCellChunk);
+        const int64_t first = c0 * cellsPerLayer;
+        const int64_t count = (c1 - c0) * cellsPerLayer;
+        connectivity.resize(count * 8);
+        offsets.resize(count);
+        types.assign(count, static_cast<uint8_t>(VTK_HEXAHEDRON));
+
+        vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType local = begin; local < end; ++local) {
+                const int64_t cellId = first + local;
+                const int64_t f = cellId % cellsF;
+                const int64_t m = (cellId / cellsF) % cellsM;
+                const int64_t s = cellId / cellsPerLayer;
+                const int64_t sNext = (s + 1) % ns;
+                const int64_t mNext = (m + 1) % nm;
+                auto pointId = [&](int64_t ps, int64_t pm, int64_t pf) { return (ps * nm + pm) * nf + pf; };
+
+                int64_t *ids = &connectivity[local * 8];
+                ids[0] = pointId(s, m, f);
+                ids[1] = pointId(s, m, f + 1);
+                ids[2] = pointId(s, mNext, f + 1);
+                ids[3] = pointId(s, mNext, f);
+                ids[4] = pointId(sNext, m, f);
+                ids[5] = pointId(sNext, m, f + 1);
+                ids[6] = pointId(sNext, mNext, f + 1);
+                ids[7] = pointId(sNext, mNext, f);
+                offsets[local] = (cellId + 1) * 8;
+            }
+        });
+
+        ok = writeAt(file, blockData(BLOCK_CONNECTIVITY, first * 8), connectivity.data(), count * 8 * 8) &&
+             writeAt(file, blockData(BLOCK_OFFSETS, first), offsets.data(), count * 8) &&
+             writeAt(file, blockData(BLOCK_TYPES, first), types.data(), count);
+        qDebug() << "FEMMeshGenerator: 单元" << c1 * cellsPerLayer << "/" << numCells;
+    }
+
+    file.close();
+    if (!ok) {
+        qWarning() << "FEMMeshGenerator: 写入失败" << fileName << file.errorString();
+        return false;
+    }
+
+    qDebug() << "FEMMeshGenerator: 已生成" << fileName << "大小(MB):" << file.size() / (1024.0 * 1024.0)
+             << "耗时(ms):" << timer.elapsed();
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("FEMMeshGenerator");
+
+    QStringList familyNames;
+    for (const Family &family : FAMILIES) {
+        familyNames.append(family.name);
+    }
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("合成大网格生成器（二进制 VTU）");
+    parser.addHelpOption();
+    QCommandLineOption familyOption("family", QString("网格类型: %1 或 all").arg(familyNames.join(", ")), "类型", "all");
+    QCommandLineOption cellsOption("cells", "目标单元数（按比例缩放三个方向，优先于 --scale）", "数量");
+    QCommandLineOption scaleOption("scale", "相对 Python 脚本默认分辨率的缩放倍数", "倍数", "1");
+    QCommandLineOption outputOption("output-dir", "输出目录", "目录", QDir::currentPath());
+    QCommandLineOption chunkOption("chunk-points", "每个分块的点数（决定内存占用）", "数量", "1000000");
+    QCommandLineOption threadsOption("threads", "生成线程数（缺省为全部核心）", "数量");
+    parser.addOptions({familyOption, cellsOption, scaleOption, outputOption, chunkOption, threadsOption});
+    parser.process(app);
+
+    if (parser.isSet(threadsOption)) {
+        vtkSMPTools::Initialize(parser.value(threadsOption).toInt());
+    }
+
+    const QString familyName = parser.value(familyOption);
+    if (familyName != "all" && !familyNames.contains(familyName)) {
+        qWarning() << "FEMMeshGenerator: 未知网格类型" << familyName;
+        return 1;
+    }
+
+    const QDir outputDir(parser.value(outputOption));
+    if (!outputDir.exists() && !QDir().mkpath(outputDir.absolutePath())) {
+        qWarning() << "FEMMeshGenerator: 无法创建输出目录" << outputDir.absolutePath();
+        return 1;
+    }
+    const int64_t chunkPoints = std::max<qint64>(1024, parser.value(chunkOption).toLongLong());
+
+    for (const Family &family : FAMILIES) {
+        if (familyName != "all" && familyName != family.name) {
+            continue;
+        }
+
+        double scale = std::max(parser.value(scaleOption).toDouble(), 0.0);
+        if (parser.isSet(cellsOption)) {
+            scale = scaleForCells(family, parser.value(cellsOption).toLongLong());
+        }
+        const Resolution resolution = scaledResolution(family, scale);
+        const QString fileName = outputDir.filePath(QString("%1_%2.vtu").arg(family.name).arg(resolution.numberOfCells(family)));
+
+        qDebug() << "FEMMeshGenerator: 生成" << family.description;
+        if (!generateFamily(family, resolution, fileName, chunkPoints)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}